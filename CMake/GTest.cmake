@@ -34,7 +34,11 @@ macro(fix_default_compiler_settings_)
 endmacro()
 
 function(add_gtest_with_flags name cxx_flags libs)
-    add_executable(${name} thirdparty/gtest/src/gtest_main.cc ${ARGN})
+    if (MATH_SYSTEM_GTEST)
+        add_executable(${name} ${ARGN})
+    else()
+        add_executable(${name} thirdparty/gtest/src/gtest_main.cc ${ARGN})
+    endif()
     if ( cxx_flags )
         set_target_properties(${name} PROPERTIES COMPILE_FLAGS "${cxx_flags}")
 	else()
@@ -43,7 +47,11 @@ function(add_gtest_with_flags name cxx_flags libs)
     foreach(lib "${libs}")
         target_link_libraries(${name} ${lib})
     endforeach()
-    target_link_libraries(${name} gtest)
+    if (MATH_SYSTEM_GTEST)
+        target_link_libraries(${name} GTest::GTest GTest::Main)
+    else()
+        target_link_libraries(${name} gtest)
+    endif()
     add_test(${name} ${name})
 endfunction()
 
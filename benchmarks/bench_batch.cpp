@@ -0,0 +1,381 @@
+/**
+ * Benchmarks for the runtime dispatched batch kernels at every instruction
+ * set level. The first argument is the Math::InstructionSet level, levels
+ * the CPU or build cannot run are skipped.
+ */
+#include "benchhelpers.h"
+#include <smath/batch.h>
+#include <smath/cpu.h>
+#include <smath/half.h>
+#include <smath/packing.h>
+#include <smath/worldposition.h>
+
+using namespace Bench;
+
+namespace
+{
+    /**
+     * Selects the instruction set named by the first benchmark argument.
+     * Returns false (and skips the benchmark) if it is not available.
+     */
+    bool selectLevel( benchmark::State& state )
+    {
+        Math::InstructionSet isa = static_cast<Math::InstructionSet>( state.range( 0 ) );
+
+        if ( Math::setInstructionSet( isa ) != isa )
+        {
+            state.SkipWithError( "instruction set not supported" );
+            return false;
+        }
+
+        state.SetLabel( Math::instructionSetName( isa ) );
+        return true;
+    }
+}
+
+#define SMATH_BENCHMARK_LEVELS(fn)                                            \
+    BENCHMARK(fn)->ArgsProduct( { { Math::ISA_SCALAR, Math::ISA_SSE2,         \
+                                    Math::ISA_SSE41, Math::ISA_AVX2,          \
+                                    Math::ISA_AVX512 },                       \
+                                  { 4096, 65536 } } )
+
+static void Batch_TransformPoints( benchmark::State& state )
+{
+    const Mat4f m = makeMat4s( 1 )[0];
+    std::vector<Vec3f> v = makeVec3s( state.range( 1 ) );
+    std::vector<Vec3f> out( v.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::transformPoints( m, v.data(), out.data(), v.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_TransformPoints);
+
+static void Batch_Normalize( benchmark::State& state )
+{
+    std::vector<Vec3f> v = makeVec3s( state.range( 1 ) );
+    std::vector<Vec3f> out( v.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::normalize( v.data(), out.data(), v.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_Normalize);
+
+static void Batch_NormalizeDouble( benchmark::State& state )
+{
+    std::vector<Vec3f> v = makeVec3s( state.range( 1 ) );
+    std::vector< TVector3<double> > in( v.size() ), out( v.size() );
+
+    for ( size_t i = 0; i < v.size(); ++i )
+    {
+        in[i] = TVector3<double>( v[i][0], v[i][1], v[i][2] );
+    }
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::normalize( in.data(), out.data(), in.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_NormalizeDouble);
+
+static void Batch_DotInt( benchmark::State& state )
+{
+    std::vector<Vec3f> v = makeVec3s( state.range( 1 ) );
+    std::vector< TVector3<int> > in( v.size() );
+    std::vector<int> out( v.size() );
+
+    for ( size_t i = 0; i < v.size(); ++i )
+    {
+        in[i] = TVector3<int>( static_cast<int>( v[i][0] * 100.0f ),
+                               static_cast<int>( v[i][1] * 100.0f ),
+                               static_cast<int>( v[i][2] * 100.0f ) );
+    }
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::dot( in.data(), in.data(), out.data(), in.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_DotInt);
+
+namespace
+{
+    /**
+     * Positions spread over a world 1000 km across.
+     */
+    std::vector< TVector3<double> > makeWorldPositions( size_t count )
+    {
+        std::vector<Vec3f> v = makeVec3s( count );
+        std::vector< TVector3<double> > positions( count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            positions[i] = TVector3<double>( v[i][0], v[i][1], v[i][2] ) * 5.0e5;
+        }
+
+        return positions;
+    }
+}
+
+static void Batch_Rebase( benchmark::State& state )
+{
+    std::vector< TVector3<double> > positions = makeWorldPositions( state.range( 1 ) );
+    std::vector<Vec3f> high( positions.size() ), low( positions.size() ), out( positions.size() );
+    const Math::WorldPosition origin( positions[0] );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    Math::batch::split( positions.data(), high.data(), low.data(), positions.size() );
+
+    for ( auto _ : state )
+    {
+        Math::batch::rebase( high.data(), low.data(), origin, out.data(), out.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_Rebase);
+
+static void Batch_RebaseDouble( benchmark::State& state )
+{
+    std::vector< TVector3<double> > positions = makeWorldPositions( state.range( 1 ) );
+    std::vector<Vec3f> out( positions.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::rebase( positions.data(), positions[0], out.data(), out.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_RebaseDouble);
+
+static void Batch_Sin( benchmark::State& state )
+{
+    std::vector<float> x = makeFloats( state.range( 1 ), -10.0f, 10.0f );
+    std::vector<float> out( x.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::sin( out.data(), x.data(), x.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_Sin);
+
+static void Batch_PackHalf( benchmark::State& state )
+{
+    std::vector<float> x = makeFloats( state.range( 1 ), -1000.0f, 1000.0f );
+    std::vector<uint16_t> out( x.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::packHalf( x.data(), out.data(), x.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_PackHalf);
+
+static void Batch_UnpackHalf( benchmark::State& state )
+{
+    std::vector<float> x = makeFloats( state.range( 1 ), -1000.0f, 1000.0f );
+    std::vector<uint16_t> halves( x.size() );
+
+    Math::batch::packHalf( x.data(), halves.data(), x.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::unpackHalf( halves.data(), x.data(), x.size() );
+
+        benchmark::DoNotOptimize( x.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_UnpackHalf);
+
+static void Batch_PackBFloat16( benchmark::State& state )
+{
+    std::vector<float> x = makeFloats( state.range( 1 ), -1000.0f, 1000.0f );
+    std::vector<Math::bfloat16> out( x.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::convert( x.data(), out.data(), x.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_PackBFloat16);
+
+static void Batch_PackOctahedral( benchmark::State& state )
+{
+    std::vector<Vec3f> v = makeVec3s( state.range( 1 ) );
+    std::vector<Math::PackedNormal> out( v.size() );
+
+    Math::batch::normalize( v.data(), v.data(), v.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::packOctahedral( v.data(), out.data(), v.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_PackOctahedral);
+
+static void Batch_PackQuaternion( benchmark::State& state )
+{
+    std::vector<Quatf> q = makeQuats( state.range( 1 ) );
+    std::vector<Math::PackedQuaternion> out( q.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::packQuaternion( q.data(), out.data(), q.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_PackQuaternion);
+
+static void Batch_UnpackQuaternion( benchmark::State& state )
+{
+    std::vector<Quatf> q = makeQuats( state.range( 1 ) );
+    std::vector<Math::PackedQuaternion> packed( q.size() );
+
+    Math::batch::packQuaternion( q.data(), packed.data(), q.size() );
+
+    if ( !selectLevel( state ) )
+    {
+        return;
+    }
+
+    for ( auto _ : state )
+    {
+        Math::batch::unpackQuaternion( packed.data(), q.data(), q.size() );
+
+        benchmark::DoNotOptimize( q.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+    Math::resetInstructionSet();
+}
+SMATH_BENCHMARK_LEVELS(Batch_UnpackQuaternion);
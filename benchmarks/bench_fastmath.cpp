@@ -0,0 +1,260 @@
+/**
+ * Benchmarks for the fast math approximations, compared against the
+ * standard library
+ */
+#include "benchhelpers.h"
+#include <smath/fastmath.h>
+#include <smath/util.h>
+
+#include <cmath>
+
+using namespace Bench;
+
+static void FastMath_StdSqrt( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), 0.0f, 1000.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < in.size(); ++i )
+        {
+            out[i] = std::sqrt( in[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_StdSqrt);
+
+static void FastMath_FastSqrt( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), 0.0f, 1000.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < in.size(); ++i )
+        {
+            out[i] = Math::fastSqrt( in[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_FastSqrt);
+
+static void FastMath_StdRsqrt( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), 0.01f, 1000.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < in.size(); ++i )
+        {
+            out[i] = 1.0f / std::sqrt( in[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_StdRsqrt);
+
+static void FastMath_RsqrtArray( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), 0.01f, 1000.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        Math::fast::rsqrt( out.data(), in.data(), in.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_RsqrtArray);
+
+static void FastMath_StdSin( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), -10.0f, 10.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < in.size(); ++i )
+        {
+            out[i] = std::sin( in[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_StdSin);
+
+template<int P>
+static void FastMath_Sin( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), -10.0f, 10.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < in.size(); ++i )
+        {
+            out[i] = Math::fast::sin<P>( in[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_Sin<Math::fast::Low>);
+SMATH_BENCHMARK_SIZES(FastMath_Sin<Math::fast::Full>);
+
+static void FastMath_SinArray( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), -10.0f, 10.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        Math::fast::sin( out.data(), in.data(), in.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_SinArray);
+
+static void FastMath_StdAtan2( benchmark::State& state )
+{
+    std::vector<float> y = makeFloats( state.range( 0 ), -10.0f, 10.0f );
+    std::vector<float> x = makeFloats( state.range( 0 ) + 1, -10.0f, 10.0f );
+    std::vector<float> out( y.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < y.size(); ++i )
+        {
+            out[i] = std::atan2( y[i], x[i + 1] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_StdAtan2);
+
+static void FastMath_Atan2Array( benchmark::State& state )
+{
+    std::vector<float> y = makeFloats( state.range( 0 ), -10.0f, 10.0f );
+    std::vector<float> x = makeFloats( state.range( 0 ) + 1, -10.0f, 10.0f );
+    std::vector<float> out( y.size() );
+
+    for ( auto _ : state )
+    {
+        Math::fast::atan2( out.data(), y.data(), x.data() + 1, y.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_Atan2Array);
+
+static void FastMath_StdExp( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), -20.0f, 20.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < in.size(); ++i )
+        {
+            out[i] = std::exp( in[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_StdExp);
+
+static void FastMath_ExpArray( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), -20.0f, 20.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        Math::fast::exp( out.data(), in.data(), in.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_ExpArray);
+
+static void FastMath_StdLog( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), 0.01f, 1000.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < in.size(); ++i )
+        {
+            out[i] = std::log( in[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_StdLog);
+
+static void FastMath_LogArray( benchmark::State& state )
+{
+    std::vector<float> in = makeFloats( state.range( 0 ), 0.01f, 1000.0f );
+    std::vector<float> out( in.size() );
+
+    for ( auto _ : state )
+    {
+        Math::fast::log( out.data(), in.data(), in.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(FastMath_LogArray);
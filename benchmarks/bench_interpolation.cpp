@@ -0,0 +1,84 @@
+/**
+ * Benchmarks for the interpolation (easing) curves
+ */
+#include "benchhelpers.h"
+#include <smath/interpolation.h>
+
+using namespace Bench;
+
+#define SMATH_BENCHMARK_CURVE(name, expr)                                   \
+    static void Interpolation_##name( benchmark::State& state )             \
+    {                                                                       \
+        std::vector<float> t = makeFloats( state.range( 0 ), 0.0f, 1.0f );  \
+        std::vector<float> out( t.size() );                                 \
+        const float a = -2.0f, b = 5.0f;                                    \
+                                                                            \
+        for ( auto _ : state )                                              \
+        {                                                                   \
+            for ( size_t i = 0; i < t.size(); ++i )                         \
+            {                                                               \
+                const float s = t[i];                                       \
+                out[i] = ( expr );                                          \
+            }                                                               \
+                                                                            \
+            benchmark::DoNotOptimize( out.data() );                         \
+            benchmark::ClobberMemory();                                     \
+        }                                                                   \
+                                                                            \
+        setElementsProcessed( state, 2 * sizeof( float ) );                 \
+    }                                                                       \
+    SMATH_BENCHMARK_SIZES(Interpolation_##name)
+
+SMATH_BENCHMARK_CURVE(Lerp,    Math::lerp( a, b, s ));
+SMATH_BENCHMARK_CURVE(Hermite, Math::hermite( a, b, s ));
+SMATH_BENCHMARK_CURVE(Sinerp,  Math::sinerp( a, b, s ));
+SMATH_BENCHMARK_CURVE(Coserp,  Math::coserp( a, b, s ));
+SMATH_BENCHMARK_CURVE(Bounce,  Math::bounce( a, b, s ));
+
+#define SMATH_BENCHMARK_CURVE_ARRAY(name, fn)                              \
+    static void Interpolation_##name##Array( benchmark::State& state )     \
+    {                                                                       \
+        std::vector<float> t = makeFloats( state.range( 0 ), 0.0f, 1.0f );  \
+        std::vector<float> out( t.size() );                                 \
+                                                                            \
+        for ( auto _ : state )                                              \
+        {                                                                   \
+            fn( out.data(), -2.0f, 5.0f, t.data(), t.size() );              \
+                                                                            \
+            benchmark::DoNotOptimize( out.data() );                         \
+            benchmark::ClobberMemory();                                     \
+        }                                                                   \
+                                                                            \
+        setElementsProcessed( state, 2 * sizeof( float ) );                 \
+    }                                                                       \
+    SMATH_BENCHMARK_SIZES(Interpolation_##name##Array)
+
+SMATH_BENCHMARK_CURVE(Smoothstep, Math::smoothstep( a, b, s ));
+SMATH_BENCHMARK_CURVE(Berp,       Math::berp( a, b, s ));
+
+SMATH_BENCHMARK_CURVE_ARRAY(Lerp,       Math::lerp);
+SMATH_BENCHMARK_CURVE_ARRAY(Smoothstep, Math::smoothstep);
+SMATH_BENCHMARK_CURVE_ARRAY(Hermite,    Math::hermite);
+SMATH_BENCHMARK_CURVE_ARRAY(Sinerp,     Math::sinerp);
+SMATH_BENCHMARK_CURVE_ARRAY(Coserp,     Math::coserp);
+SMATH_BENCHMARK_CURVE_ARRAY(Berp,       Math::berp);
+SMATH_BENCHMARK_CURVE_ARRAY(Bounce,     Math::bounce);
+
+static void Interpolation_SmoothstepArrays( benchmark::State& state )
+{
+    std::vector<float> a = makeFloats( state.range( 0 ), -10.0f, 10.0f );
+    std::vector<float> b = makeFloats( state.range( 0 ), -10.0f, 10.0f );
+    std::vector<float> t = makeFloats( state.range( 0 ), 0.0f, 1.0f );
+    std::vector<float> out( t.size() );
+
+    for ( auto _ : state )
+    {
+        Math::smoothstep( out.data(), a.data(), b.data(), t.data(), t.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 4 * sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(Interpolation_SmoothstepArrays);
@@ -0,0 +1,90 @@
+/**
+ * Benchmarks for sampling many keyframe tracks per frame
+ */
+#include "benchhelpers.h"
+#include <smath/keyframes.h>
+
+using namespace Bench;
+
+namespace
+{
+    /**
+     * Position tracks of 64 keys each at uneven times over ten seconds.
+     */
+    std::vector< Math::KeyframeTrack<Vec3f> > makeTracks( size_t count, Math::KeyframeMode mode )
+    {
+        std::vector< Math::KeyframeTrack<Vec3f> > tracks( count, Math::KeyframeTrack<Vec3f>( mode ) );
+        std::vector<float> times( 64 );
+        std::vector<Vec3f> values( 64 );
+        InputGenerator gen;
+
+        for ( size_t t = 0; t < count; ++t )
+        {
+            float time = 0.0f;
+
+            for ( size_t i = 0; i < times.size(); ++i )
+            {
+                times[i]  = time;
+                values[i] = Vec3f( gen.next( -5.0f, 5.0f ), gen.next( -5.0f, 5.0f ), gen.next( -5.0f, 5.0f ) );
+                time += gen.next( 0.05f, 0.265f );
+            }
+
+            tracks[t].setKeys( &times[0], &values[0], times.size() );
+        }
+
+        return tracks;
+    }
+}
+
+/**
+ * One frame of a 60 Hz animation: every track sampled at the next time,
+ * searching each track from scratch.
+ */
+static void Keyframes_SampleSearch( benchmark::State& state )
+{
+    std::vector< Math::KeyframeTrack<Vec3f> > tracks =
+        makeTracks( state.range( 0 ), static_cast<Math::KeyframeMode>( state.range( 1 ) ) );
+    std::vector<Vec3f> out( tracks.size() );
+    float clock = 0.0f;
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < tracks.size(); ++i )
+        {
+            out[i] = tracks[i].sample( clock );
+        }
+
+        clock = clock < 10.0f ? clock + 1.0f / 60.0f : 0.0f;
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Keyframes_SampleSearch)->Args({ 50000, Math::KeyframeLinear })->Args({ 50000, Math::KeyframeCubic });
+
+/**
+ * The same frames sampled with a cursor per track.
+ */
+static void Keyframes_SampleCursor( benchmark::State& state )
+{
+    std::vector< Math::KeyframeTrack<Vec3f> > tracks =
+        makeTracks( state.range( 0 ), static_cast<Math::KeyframeMode>( state.range( 1 ) ) );
+    std::vector<Math::KeyframeCursor> cursors( tracks.size() );
+    std::vector<Vec3f> out( tracks.size() );
+    float clock = 0.0f;
+
+    for ( auto _ : state )
+    {
+        Math::sampleTracks( tracks.data(), cursors.data(), clock, out.data(), tracks.size() );
+
+        clock = clock < 10.0f ? clock + 1.0f / 60.0f : 0.0f;
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Keyframes_SampleCursor)->Args({ 50000, Math::KeyframeLinear })->Args({ 50000, Math::KeyframeCubic });
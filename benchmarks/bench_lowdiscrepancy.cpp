@@ -0,0 +1,117 @@
+/**
+ * Benchmarks for the low-discrepancy sequences
+ */
+#include "benchhelpers.h"
+#include <smath/lowdiscrepancy.h>
+#include <smath/random.h>
+
+typedef TVector2<float> Vec2f;
+
+static void LowDiscrepancy_Random2( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<Vec2f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            float x = random.nextFloat2();
+            out[i] = Vec2f( x, random.nextFloat2() );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(LowDiscrepancy_Random2)->Arg(4096);
+
+static void LowDiscrepancy_Halton2( benchmark::State& state )
+{
+    Math::HaltonSequence halton( 42 );
+    std::vector<Vec2f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        halton.generate( 0, out.data(), out.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(LowDiscrepancy_Halton2)->Arg(4096);
+
+static void LowDiscrepancy_Sobol2( benchmark::State& state )
+{
+    Math::SobolSequence sobol( 42 );
+    std::vector<Vec2f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        sobol.generate( 0, out.data(), out.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(LowDiscrepancy_Sobol2)->Arg(4096);
+
+static void LowDiscrepancy_Sobol2Unscrambled( benchmark::State& state )
+{
+    Math::SobolSequence sobol;
+    std::vector<Vec2f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        sobol.generate( 0, out.data(), out.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(LowDiscrepancy_Sobol2Unscrambled)->Arg(4096);
+
+static void LowDiscrepancy_Sobol2ByIndex( benchmark::State& state )
+{
+    Math::SobolSequence sobol( 42 );
+    std::vector<Vec2f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = sobol.point2( static_cast<uint32_t>( i ) );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(LowDiscrepancy_Sobol2ByIndex)->Arg(4096);
+
+static void LowDiscrepancy_R2( benchmark::State& state )
+{
+    Math::KroneckerSequence r2;
+    std::vector<Vec2f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        r2.generate( 0, out.data(), out.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(LowDiscrepancy_R2)->Arg(4096);
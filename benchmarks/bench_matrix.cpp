@@ -0,0 +1,153 @@
+/**
+ * Benchmarks for 4x4 matrix operations
+ */
+#include "benchhelpers.h"
+#include <smath/matrix.h>
+#include <smath/matrixutils.h>
+
+using namespace Bench;
+
+static void Matrix4_Multiply( benchmark::State& state )
+{
+    std::vector<Mat4f> a = makeMat4s( state.range( 0 ) );
+    std::vector<Mat4f> b = makeMat4s( state.range( 0 ) + 1 );
+    std::vector<Mat4f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = a[i] * b[i + 1];
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( Mat4f ) );
+}
+BENCHMARK(Matrix4_Multiply)->RangeMultiplier(8)->Range(Bench::MinElements, 1 << 16);
+
+static void Matrix4_TransformVector( benchmark::State& state )
+{
+    const Mat4f m = makeMat4s( 1 )[0];
+    std::vector<Vec3f> v = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> out( v.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < v.size(); ++i )
+        {
+            out[i] = m.transformVector3x4( v[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Matrix4_TransformVector);
+
+static void Matrix4_Determinant( benchmark::State& state )
+{
+    std::vector<Mat4f> a = makeMat4s( state.range( 0 ) );
+    std::vector<float> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = determinant( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, sizeof( Mat4f ) );
+}
+BENCHMARK(Matrix4_Determinant)->RangeMultiplier(8)->Range(Bench::MinElements, 1 << 16);
+
+static void Matrix4_Inverse( benchmark::State& state )
+{
+    std::vector<Mat4f> a = makeMat4s( state.range( 0 ) );
+    std::vector<Mat4f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = inverse( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Mat4f ) );
+}
+BENCHMARK(Matrix4_Inverse)->RangeMultiplier(8)->Range(Bench::MinElements, 1 << 16);
+
+static void Matrix4_Transpose( benchmark::State& state )
+{
+    std::vector<Mat4f> a = makeMat4s( state.range( 0 ) );
+    std::vector<Mat4f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = transpose( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Mat4f ) );
+}
+BENCHMARK(Matrix4_Transpose)->RangeMultiplier(8)->Range(Bench::MinElements, 1 << 16);
+
+static void Matrix4_CreateRotationAroundAxis( benchmark::State& state )
+{
+    std::vector<Vec3f> axes = makeVec3s( state.range( 0 ) );
+    std::vector<float> angles = makeFloats( axes.size(), -3.0f, 3.0f );
+    std::vector<Mat4f> out( axes.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < axes.size(); ++i )
+        {
+            out[i] = Math::createRotationAroundAxis( axes[i], angles[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, sizeof( Mat4f ) );
+}
+BENCHMARK(Matrix4_CreateRotationAroundAxis)->RangeMultiplier(8)->Range(Bench::MinElements, 1 << 16);
+
+static void Matrix4_CreateLookAt( benchmark::State& state )
+{
+    const Vec3f eye( 1.0f, 2.0f, 3.0f );
+    const Vec3f up( 0.0f, 1.0f, 0.0f );
+    std::vector<Vec3f> targets = makeVec3s( state.range( 0 ) );
+    std::vector<Mat4f> out( targets.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < targets.size(); ++i )
+        {
+            out[i] = Math::createLookAt( eye, targets[i], up );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, sizeof( Mat4f ) );
+}
+BENCHMARK(Matrix4_CreateLookAt)->RangeMultiplier(8)->Range(Bench::MinElements, 1 << 16);
@@ -0,0 +1,61 @@
+/**
+ * Benchmarks for the transient buffers of a per-frame pipeline: every
+ * iteration is one frame that fills a scratch buffer of transformed points
+ * and reduces it, with the buffer coming from the heap or an arena.
+ */
+#include "benchhelpers.h"
+#include <smath/batch.h>
+#include <smath/memory.h>
+
+using namespace Bench;
+
+namespace
+{
+    float sumX( const Vec3f * pPoints, size_t count )
+    {
+        float sum = 0.0f;
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            sum += pPoints[i].x();
+        }
+
+        return sum;
+    }
+}
+
+static void Memory_FrameHeap( benchmark::State& state )
+{
+    const Mat4f m = makeMat4s( 1 )[0];
+    std::vector<Vec3f> v = makeVec3s( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        std::vector<Vec3f> scratch( v.size() );
+        Math::batch::transformPoints( m, v.data(), scratch.data(), v.size() );
+
+        benchmark::DoNotOptimize( sumX( scratch.data(), scratch.size() ) );
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Memory_FrameHeap);
+
+static void Memory_FrameArena( benchmark::State& state )
+{
+    const Mat4f m = makeMat4s( 1 )[0];
+    std::vector<Vec3f> v = makeVec3s( state.range( 0 ) );
+    Math::Arena& arena = Math::threadArena();
+
+    for ( auto _ : state )
+    {
+        Vec3f * pScratch = arena.allocateArray<Vec3f>( v.size() );
+        Math::batch::transformPoints( m, v.data(), pScratch, v.size() );
+
+        benchmark::DoNotOptimize( sumX( pScratch, v.size() ) );
+        arena.reset();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Memory_FrameArena);
@@ -0,0 +1,71 @@
+/**
+ * Benchmarks for hashing and vertex welding
+ */
+#include "benchhelpers.h"
+#include <smath/hash.h>
+#include <smath/weld.h>
+
+using namespace Bench;
+
+static void Hash_Vector3( benchmark::State& state )
+{
+    std::vector<Vec3f> v = makeVec3s( state.range( 0 ) );
+    std::vector<uint64_t> out( v.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < v.size(); ++i )
+        {
+            out[i] = Math::hash( v[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Hash_Vector3);
+
+static void Hash_FloatArray( benchmark::State& state )
+{
+    std::vector<float> v = makeFloats( state.range( 0 ), -1.0f, 1.0f );
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( Math::hash( v.data(), v.size() ) );
+    }
+
+    setElementsProcessed( state, sizeof( float ) );
+}
+SMATH_BENCHMARK_SIZES(Hash_FloatArray);
+
+/**
+ * Welds a mesh where every vertex appears four times with jitter well below
+ * the weld distance, in a shuffled order.
+ */
+static void Weld_Vertices( benchmark::State& state )
+{
+    size_t unique = state.range( 0 ) / 4;
+    std::vector<Vec3f> base = makeVec3s( unique );
+    std::vector<float> jitter = makeFloats( state.range( 0 ), -1e-6f, 1e-6f );
+    std::vector<Vec3f> v;
+
+    for ( size_t i = 0; i < static_cast<size_t>( state.range( 0 ) ); ++i )
+    {
+        size_t j = ( i * 2654435761u ) % unique;
+        v.push_back( base[j] + Vec3f( jitter[i], -jitter[i], jitter[i] ) );
+    }
+
+    std::vector<uint32_t> remap;
+    std::vector<Vec3f> welded;
+
+    for ( auto _ : state )
+    {
+        Math::weldVertices( v.data(), v.size(), remap, welded, 1e-5f );
+        benchmark::DoNotOptimize( welded.data() );
+    }
+
+    setElementsProcessed( state, sizeof( Vec3f ) );
+}
+BENCHMARK(Weld_Vertices)->RangeMultiplier(16)->Range(1 << 12, 1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,109 @@
+/**
+ * Benchmarks for Poisson-disk sampling, against dart throwing
+ */
+#include "benchhelpers.h"
+#include <smath/poissondisk.h>
+
+typedef TVector2<float> Vec2f;
+
+/**
+ * Dart throwing: random candidates checked against every accepted point,
+ * until many candidates in a row fail.
+ */
+static void PoissonDisk_DartThrowing( benchmark::State& state )
+{
+    const float Radius = 1.0f;
+    const float Size = static_cast<float>( state.range( 0 ) );
+    std::vector<Vec2f> points;
+
+    for ( auto _ : state )
+    {
+        FastRandom random( 42 );
+        int failures = 0;
+
+        points.clear();
+
+        while ( failures < 1000 )
+        {
+            const Vec2f candidate( random.nextFloat() * Size, random.nextFloat() * Size );
+            bool fits = true;
+
+            for ( size_t i = 0; i < points.size() && fits; ++i )
+            {
+                fits = lengthSquared( points[i] - candidate ) >= Radius * Radius;
+            }
+
+            if ( fits )
+            {
+                points.push_back( candidate );
+                failures = 0;
+            }
+            else
+            {
+                ++failures;
+            }
+        }
+
+        benchmark::DoNotOptimize( points.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() * points.size() );
+}
+BENCHMARK(PoissonDisk_DartThrowing)->Arg(16)->Arg(32);
+
+static void PoissonDisk_Bridson( benchmark::State& state )
+{
+    const float Size = static_cast<float>( state.range( 0 ) );
+    std::vector<Vec2f> points;
+
+    for ( auto _ : state )
+    {
+        FastRandom random( 42 );
+        Math::poissonDisk( RectF( 0.0f, 0.0f, Size, Size ), 1.0f, random, points );
+
+        benchmark::DoNotOptimize( points.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() * points.size() );
+}
+BENCHMARK(PoissonDisk_Bridson)->Arg(16)->Arg(32)->Arg(256);
+
+static void PoissonDisk_Bridson3( benchmark::State& state )
+{
+    const float Size = static_cast<float>( state.range( 0 ) );
+    std::vector< TVector3<float> > points;
+
+    for ( auto _ : state )
+    {
+        FastRandom random( 42 );
+        Math::poissonDisk( TVector3<float>( 0.0f, 0.0f, 0.0f ), TVector3<float>( Size, Size, Size ),
+                           1.0f, random, points );
+
+        benchmark::DoNotOptimize( points.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() * points.size() );
+}
+BENCHMARK(PoissonDisk_Bridson3)->Arg(32);
+
+static void PoissonDisk_TileScatter( benchmark::State& state )
+{
+    const float Size = static_cast<float>( state.range( 0 ) );
+    FastRandom random( 42 );
+    Math::BlueNoiseTile tile;
+    std::vector<Vec2f> points;
+
+    // A 64 x 64 tile of radius one points
+    tile.generate( 1.0f / 64.0f, random );
+
+    for ( auto _ : state )
+    {
+        points.clear();
+        tile.scatter( RectF( 0.0f, 0.0f, Size, Size ), 64.0f, points );
+
+        benchmark::DoNotOptimize( points.data() );
+    }
+
+    state.SetItemsProcessed( state.iterations() * points.size() );
+}
+BENCHMARK(PoissonDisk_TileScatter)->Arg(256);
@@ -0,0 +1,90 @@
+/**
+ * Benchmarks for quaternion operations
+ */
+#include "benchhelpers.h"
+#include <smath/quaternion.h>
+
+using namespace Bench;
+
+static void Quaternion_Multiply( benchmark::State& state )
+{
+    std::vector<Quatf> a = makeQuats( state.range( 0 ) );
+    std::vector<Quatf> b = makeQuats( state.range( 0 ) + 1 );
+    std::vector<Quatf> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = a[i] * b[i + 1];
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( Quatf ) );
+}
+SMATH_BENCHMARK_SIZES(Quaternion_Multiply);
+
+static void Quaternion_Normalize( benchmark::State& state )
+{
+    std::vector<Quatf> a = makeQuats( state.range( 0 ) );
+    std::vector<Quatf> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = normalize( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Quatf ) );
+}
+SMATH_BENCHMARK_SIZES(Quaternion_Normalize);
+
+static void Quaternion_Inverse( benchmark::State& state )
+{
+    std::vector<Quatf> a = makeQuats( state.range( 0 ) );
+    std::vector<Quatf> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = inverse( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Quatf ) );
+}
+SMATH_BENCHMARK_SIZES(Quaternion_Inverse);
+
+static void Quaternion_Lerp( benchmark::State& state )
+{
+    std::vector<Quatf> a = makeQuats( state.range( 0 ) );
+    std::vector<Quatf> b = makeQuats( state.range( 0 ) + 1 );
+    std::vector<float> t = makeFloats( a.size(), 0.0f, 1.0f );
+    std::vector<Quatf> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = lerp( a[i], b[i + 1], t[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( Quatf ) );
+}
+SMATH_BENCHMARK_SIZES(Quaternion_Lerp);
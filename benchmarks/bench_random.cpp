@@ -0,0 +1,223 @@
+/**
+ * Benchmarks for the Random number generator
+ */
+#include "benchhelpers.h"
+#include <smath/random.h>
+
+static void Random_NextUInt( benchmark::State& state )
+{
+    Random random( 42 );
+    std::vector<unsigned int> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextUInt();
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( unsigned int ) );
+}
+BENCHMARK(Random_NextUInt)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+static void Random_NextIntBounded( benchmark::State& state )
+{
+    Random random( 42 );
+    std::vector<int> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextInt( 1000 );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( int ) );
+}
+BENCHMARK(Random_NextIntBounded)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+static void Random_NextInts( benchmark::State& state )
+{
+    Random random( 42 );
+    std::vector<int> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        random.nextInts( out.data(), out.size(), 0, 1000 );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( int ) );
+}
+BENCHMARK(Random_NextInts)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+static void Random_NextFloat( benchmark::State& state )
+{
+    Random random( 42 );
+    std::vector<float> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextFloat();
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( float ) );
+}
+BENCHMARK(Random_NextFloat)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+static void Random_NextGaussian( benchmark::State& state )
+{
+    Random random( 42 );
+    std::vector<float> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextGaussian();
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( float ) );
+}
+BENCHMARK(Random_NextGaussian)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+static void Random_Construct( benchmark::State& state )
+{
+    uint32_t seed = 1;
+
+    for ( auto _ : state )
+    {
+        Random random( seed++ );
+        benchmark::DoNotOptimize( random.nextUInt() );
+    }
+}
+BENCHMARK(Random_Construct);
+
+//
+// Engines side by side, through the shared TRandom interface
+//
+#define SMATH_BENCHMARK_ENGINES(fn)                                           \
+    BENCHMARK_TEMPLATE(fn, Math::MersenneTwister)->Arg(4096);                 \
+    BENCHMARK_TEMPLATE(fn, Math::Xoshiro256)->Arg(4096);                      \
+    BENCHMARK_TEMPLATE(fn, Math::Pcg32)->Arg(4096);                           \
+    BENCHMARK_TEMPLATE(fn, Math::SplitMix64)->Arg(4096)
+
+template<typename Engine>
+static void Random_EngineNextUInt( benchmark::State& state )
+{
+    TRandom<Engine> random( 42 );
+    std::vector<unsigned int> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextUInt();
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( unsigned int ) );
+}
+SMATH_BENCHMARK_ENGINES(Random_EngineNextUInt);
+
+template<typename Engine>
+static void Random_EngineNextFloat( benchmark::State& state )
+{
+    TRandom<Engine> random( 42 );
+    std::vector<float> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextFloat();
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( float ) );
+}
+SMATH_BENCHMARK_ENGINES(Random_EngineNextFloat);
+
+template<typename Engine>
+static void Random_EngineNextIntBounded( benchmark::State& state )
+{
+    TRandom<Engine> random( 42 );
+    std::vector<int> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextInt( 0, 1000 );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( int ) );
+}
+SMATH_BENCHMARK_ENGINES(Random_EngineNextIntBounded);
+
+template<typename Engine>
+static void Random_EngineNextGaussian( benchmark::State& state )
+{
+    TRandom<Engine> random( 42 );
+    std::vector<float> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = random.nextGaussian();
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( float ) );
+}
+SMATH_BENCHMARK_ENGINES(Random_EngineNextGaussian);
+
+template<typename Engine>
+static void Random_EngineConstruct( benchmark::State& state )
+{
+    uint32_t seed = 1;
+
+    for ( auto _ : state )
+    {
+        TRandom<Engine> random( seed++ );
+        benchmark::DoNotOptimize( random.nextUInt() );
+    }
+}
+BENCHMARK_TEMPLATE(Random_EngineConstruct, Math::MersenneTwister);
+BENCHMARK_TEMPLATE(Random_EngineConstruct, Math::Xoshiro256);
+BENCHMARK_TEMPLATE(Random_EngineConstruct, Math::Pcg32);
+BENCHMARK_TEMPLATE(Random_EngineConstruct, Math::SplitMix64);
@@ -0,0 +1,248 @@
+/**
+ * Benchmarks for shuffling and weighted sampling
+ */
+#include "benchhelpers.h"
+#include <smath/random.h>
+#include <smath/sampling.h>
+#include <smath/shapesampling.h>
+
+#include <algorithm>
+
+using namespace Bench;
+
+static void Sampling_Shuffle( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<int> values( state.range( 0 ) );
+
+    for ( size_t i = 0; i < values.size(); ++i )
+    {
+        values[i] = static_cast<int>( i );
+    }
+
+    for ( auto _ : state )
+    {
+        Math::shuffle( values.begin(), values.end(), random );
+
+        benchmark::DoNotOptimize( values.data() );
+        benchmark::ClobberMemory();
+    }
+
+    Bench::setElementsProcessed( state, sizeof( int ) );
+}
+BENCHMARK(Sampling_Shuffle)->Arg(64)->Arg(4096)->Arg(1 << 16);
+
+/**
+ * Weighted choice by scanning the cumulative weights, as the alias table
+ * replaces.
+ */
+static void Sampling_WeightedLinearScan( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<float> weights = Bench::makeFloats( state.range( 0 ), 0.0f, 10.0f );
+    std::vector<float> cumulative( weights.size() );
+    std::vector<uint32_t> out( 4096 );
+
+    float total = 0.0f;
+
+    for ( size_t i = 0; i < weights.size(); ++i )
+    {
+        total += weights[i];
+        cumulative[i] = total;
+    }
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            const float target = random.nextFloat2() * total;
+            size_t j = 0;
+
+            while ( j + 1 < cumulative.size() && cumulative[j] <= target )
+            {
+                ++j;
+            }
+
+            out[i] = static_cast<uint32_t>( j );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * out.size() );
+}
+BENCHMARK(Sampling_WeightedLinearScan)->Arg(16)->Arg(1000);
+
+static void Sampling_WeightedAliasTable( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    Math::AliasTable table( Bench::makeFloats( state.range( 0 ), 0.0f, 10.0f ) );
+    std::vector<uint32_t> out( 4096 );
+
+    for ( auto _ : state )
+    {
+        table.sample( random, out.data(), out.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * out.size() );
+}
+BENCHMARK(Sampling_WeightedAliasTable)->Arg(16)->Arg(1000);
+
+static void Sampling_AliasTableBuild( benchmark::State& state )
+{
+    std::vector<float> weights = Bench::makeFloats( state.range( 0 ), 0.0f, 10.0f );
+    Math::AliasTable table;
+
+    for ( auto _ : state )
+    {
+        table.build( weights.data(), weights.size() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Sampling_AliasTableBuild)->Arg(1000);
+
+/**
+ * Point in the unit ball by rejection from the enclosing cube, as the
+ * direct mapping replaces.
+ */
+static void Sampling_InSphereRejection( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<Vec3f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            Vec3f p;
+
+            do
+            {
+                p = Vec3f( random.nextFloat( -1.0f, 1.0f ),
+                          random.nextFloat( -1.0f, 1.0f ),
+                          random.nextFloat( -1.0f, 1.0f ) );
+            }
+            while ( lengthSquared( p ) > 1.0f );
+
+            out[i] = p;
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Sampling_InSphereRejection)->Arg(4096);
+
+static void Sampling_InSphere( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<Vec3f> out( state.range( 0 ) );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < out.size(); ++i )
+        {
+            out[i] = Math::randomInSphere( random );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Sampling_InSphere)->Arg(4096);
+
+static void Sampling_InSphereArrays( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<float> x( state.range( 0 ) ), y( x.size() ), z( x.size() );
+
+    for ( auto _ : state )
+    {
+        Math::randomInSphere( random, x.data(), y.data(), z.data(), x.size() );
+
+        benchmark::DoNotOptimize( x.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Sampling_InSphereArrays)->Arg(4096);
+
+/**
+ * Point in the unit disk by rejection from the enclosing square.
+ */
+static void Sampling_InDiskRejection( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<float> x( state.range( 0 ) ), y( x.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < x.size(); ++i )
+        {
+            float px, py;
+
+            do
+            {
+                px = random.nextFloat( -1.0f, 1.0f );
+                py = random.nextFloat( -1.0f, 1.0f );
+            }
+            while ( px * px + py * py > 1.0f );
+
+            x[i] = px;
+            y[i] = py;
+        }
+
+        benchmark::DoNotOptimize( x.data() );
+        benchmark::DoNotOptimize( y.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Sampling_InDiskRejection)->Arg(4096);
+
+static void Sampling_InDiskArrays( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<float> x( state.range( 0 ) ), y( x.size() );
+
+    for ( auto _ : state )
+    {
+        Math::randomInDisk( random, x.data(), y.data(), x.size() );
+
+        benchmark::DoNotOptimize( x.data() );
+        benchmark::DoNotOptimize( y.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Sampling_InDiskArrays)->Arg(4096);
+
+static void Sampling_CosineHemisphereArrays( benchmark::State& state )
+{
+    FastRandom random( 42 );
+    std::vector<float> x( state.range( 0 ) ), y( x.size() ), z( x.size() );
+
+    for ( auto _ : state )
+    {
+        Math::randomCosineHemisphere( random, x.data(), y.data(), z.data(), x.size() );
+
+        benchmark::DoNotOptimize( x.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Sampling_CosineHemisphereArrays)->Arg(4096);
@@ -0,0 +1,132 @@
+/**
+ * Benchmarks for spline evaluation and arc length lookups
+ */
+#include "benchhelpers.h"
+#include <smath/spline.h>
+
+using namespace Bench;
+
+namespace
+{
+    Math::Spline<Vec3f> makeRail( size_t points )
+    {
+        std::vector<Vec3f> controls( points );
+        InputGenerator gen;
+
+        for ( size_t i = 0; i < points; ++i )
+        {
+            controls[i] = Vec3f( 10.0f * i, gen.next( -5.0f, 5.0f ), gen.next( -5.0f, 5.0f ) );
+        }
+
+        return Math::createCatmullRom( &controls[0], controls.size() );
+    }
+
+    /**
+     * Centripetal Catmull-Rom evaluated from the control points on every
+     * call, the Barry-Goldman pyramid, for comparison.
+     */
+    Vec3f catmullRomDirect( const std::vector<Vec3f>& p, float t )
+    {
+        const size_t segments = p.size() - 3;
+        const float scaled = t * segments;
+        const size_t s = std::min( static_cast<size_t>( scaled ), segments - 1 );
+        const float u = scaled - s;
+
+        const Vec3f& p0 = p[s];
+        const Vec3f& p1 = p[s + 1];
+        const Vec3f& p2 = p[s + 2];
+        const Vec3f& p3 = p[s + 3];
+
+        const float t0 = 0.0f;
+        const float t1 = t0 + std::sqrt( std::sqrt( lengthSquared( p1 - p0 ) ) );
+        const float t2 = t1 + std::sqrt( std::sqrt( lengthSquared( p2 - p1 ) ) );
+        const float t3 = t2 + std::sqrt( std::sqrt( lengthSquared( p3 - p2 ) ) );
+        const float x  = t1 + u * ( t2 - t1 );
+
+        const Vec3f a1 = p0 * ( ( t1 - x ) / ( t1 - t0 ) ) + p1 * ( ( x - t0 ) / ( t1 - t0 ) );
+        const Vec3f a2 = p1 * ( ( t2 - x ) / ( t2 - t1 ) ) + p2 * ( ( x - t1 ) / ( t2 - t1 ) );
+        const Vec3f a3 = p2 * ( ( t3 - x ) / ( t3 - t2 ) ) + p3 * ( ( x - t2 ) / ( t3 - t2 ) );
+        const Vec3f b1 = a1 * ( ( t2 - x ) / ( t2 - t0 ) ) + a2 * ( ( x - t0 ) / ( t2 - t0 ) );
+        const Vec3f b2 = a2 * ( ( t3 - x ) / ( t3 - t1 ) ) + a3 * ( ( x - t1 ) / ( t3 - t1 ) );
+
+        return b1 * ( ( t2 - x ) / ( t2 - t1 ) ) + b2 * ( ( x - t1 ) / ( t2 - t1 ) );
+    }
+}
+
+static void Spline_CatmullRomDirect( benchmark::State& state )
+{
+    std::vector<Vec3f> controls( 66 );
+    InputGenerator gen;
+
+    for ( size_t i = 0; i < controls.size(); ++i )
+    {
+        controls[i] = Vec3f( 10.0f * i, gen.next( -5.0f, 5.0f ), gen.next( -5.0f, 5.0f ) );
+    }
+
+    std::vector<float> t = makeFloats( state.range( 0 ), 0.0f, 1.0f );
+    std::vector<Vec3f> out( t.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < t.size(); ++i )
+        {
+            out[i] = catmullRomDirect( controls, t[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Spline_CatmullRomDirect)->Arg(4096);
+
+static void Spline_Evaluate( benchmark::State& state )
+{
+    Math::Spline<Vec3f> spline = makeRail( 64 );
+    std::vector<float> t = makeFloats( state.range( 0 ), 0.0f, 1.0f );
+    std::vector<Vec3f> out( t.size() );
+
+    for ( auto _ : state )
+    {
+        spline.evaluate( t.data(), out.data(), t.size() );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK(Spline_Evaluate)->Arg(4096);
+
+static void Spline_EvaluateAtDistance( benchmark::State& state )
+{
+    Math::Spline<Vec3f> spline = makeRail( 64 );
+    spline.computeArcLength();
+
+    std::vector<float> d = makeFloats( 4096, 0.0f, spline.length() );
+    std::vector<Vec3f> out( d.size() );
+
+    for ( auto _ : state )
+    {
+        spline.evaluateAtDistance( d.data(), out.data(), d.size(), static_cast<int>( state.range( 0 ) ) );
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed( state.iterations() * d.size() );
+}
+BENCHMARK(Spline_EvaluateAtDistance)->Arg(0)->Arg(1);
+
+static void Spline_ComputeArcLength( benchmark::State& state )
+{
+    Math::Spline<Vec3f> spline = makeRail( 64 );
+
+    for ( auto _ : state )
+    {
+        spline.computeArcLength();
+        benchmark::DoNotOptimize( spline.length() );
+    }
+}
+BENCHMARK(Spline_ComputeArcLength);
@@ -0,0 +1,297 @@
+/**
+ * Benchmarks for vector operations, over arrays of structures (TVector3) and
+ * the equivalent structure of arrays layout.
+ */
+#include "benchhelpers.h"
+#include <smath/vector.h>
+
+using namespace Bench;
+
+static void Vector3_Dot( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> b = makeVec3s( state.range( 0 ) + 1 );
+    std::vector<float> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = dot( a[i], b[i + 1] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_Dot);
+
+static void Vector3_DotSoA( benchmark::State& state )
+{
+    size_t n = state.range( 0 );
+    std::vector<float> ax = makeFloats( n, -1, 1 ), ay = ax, az = ax;
+    std::vector<float> bx = makeFloats( n + 1, -1, 1 ), by = bx, bz = bx;
+    std::vector<float> out( n );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < n; ++i )
+        {
+            out[i] = ax[i] * bx[i + 1] + ay[i] * by[i + 1] + az[i] * bz[i + 1];
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_DotSoA);
+
+static void Vector3_Cross( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> b = makeVec3s( state.range( 0 ) + 1 );
+    std::vector<Vec3f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = cross( a[i], b[i + 1] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_Cross);
+
+static void Vector3_AddScale( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> b = makeVec3s( state.range( 0 ) + 1 );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            a[i] += b[i + 1] * 0.5f;
+        }
+
+        benchmark::DoNotOptimize( a.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_AddScale);
+
+static void Vector3_Length( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<float> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = length( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_Length);
+
+static void Vector3_Normalized( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = normalized( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_Normalized);
+
+static void Vector3_NormalizedFast( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = normalizedFast( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_NormalizedFast);
+
+static void Vector3_NormalizedSoA( benchmark::State& state )
+{
+    size_t n = state.range( 0 );
+    std::vector<float> x = makeFloats( n, -1, 1 ), y = x, z = x;
+    std::vector<float> lenSq( n ), scale( n );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < n; ++i )
+        {
+            lenSq[i] = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+        }
+
+        Math::fast::rsqrt( scale.data(), lenSq.data(), n );
+
+        for ( size_t i = 0; i < n; ++i )
+        {
+            x[i] *= scale[i];
+            y[i] *= scale[i];
+            z[i] *= scale[i];
+        }
+
+        benchmark::DoNotOptimize( x.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_NormalizedSoA);
+
+static void Vector4_Normalized( benchmark::State& state )
+{
+    std::vector<Vec4f> a = makeVec4s( state.range( 0 ) );
+    std::vector<Vec4f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = normalized( a[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec4f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector4_Normalized);
+
+static void Vector3_RotateAround( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<float> angles = makeFloats( a.size(), 0.0f, 360.0f );
+    std::vector<Vec3f> out( a.size() );
+    const Vec3f axis( 0.3f, 0.9f, -0.2f );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = rotateAround( a[i], axis, angles[i] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_RotateAround);
+
+static void Vector3_AngleBetween( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> b = makeVec3s( state.range( 0 ) + 1 );
+    std::vector<float> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = angleBetween( a[i], b[i + 1] );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 2 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_AngleBetween);
+
+/**
+ * Vector3_Swizzle and Vector3_SwizzleByHand compute the same expression, the
+ * first through swizzle accessors and the second by constructing the
+ * shuffled vectors from x(), y() and z(). They should run at the same speed.
+ */
+static void Vector3_Swizzle( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> b = makeVec3s( state.range( 0 ) + 1 );
+    std::vector<Vec3f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            out[i] = a[i].yzx() * b[i + 1].z() - a[i].zxy() + b[i + 1].zzx();
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_Swizzle);
+
+static void Vector3_SwizzleByHand( benchmark::State& state )
+{
+    std::vector<Vec3f> a = makeVec3s( state.range( 0 ) );
+    std::vector<Vec3f> b = makeVec3s( state.range( 0 ) + 1 );
+    std::vector<Vec3f> out( a.size() );
+
+    for ( auto _ : state )
+    {
+        for ( size_t i = 0; i < a.size(); ++i )
+        {
+            const Vec3f& u = a[i];
+            const Vec3f& v = b[i + 1];
+
+            out[i] = Vec3f( u.y(), u.z(), u.x() ) * v.z() -
+                     Vec3f( u.z(), u.x(), u.y() ) +
+                     Vec3f( v.z(), v.z(), v.x() );
+        }
+
+        benchmark::DoNotOptimize( out.data() );
+        benchmark::ClobberMemory();
+    }
+
+    setElementsProcessed( state, 3 * sizeof( Vec3f ) );
+}
+SMATH_BENCHMARK_SIZES(Vector3_SwizzleByHand);
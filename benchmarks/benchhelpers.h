@@ -0,0 +1,172 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_BENCHHELPERS_H
+#define SCOTT_MATH_BENCHHELPERS_H
+
+//
+// Shared input generation for the smath benchmarks. Inputs are produced from
+// a fixed seed so that runs are comparable with each other and with the
+// checked-in baselines.
+//
+#include <benchmark/benchmark.h>
+#include <smath/vector.h>
+#include <smath/matrix.h>
+#include <smath/quaternion.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace Bench
+{
+    typedef TVector3<float> Vec3f;
+    typedef TVector4<float> Vec4f;
+    typedef TMatrix4<float> Mat4f;
+    typedef TQuaternion<float> Quatf;
+
+    // Array sizes used by the throughput benchmarks: from L1 resident up to
+    // well beyond the last level cache
+    const int MinElements = 64;
+    const int MaxElements = 1 << 20;
+
+    /**
+     * Small deterministic generator, so that benchmark inputs don't depend
+     * on the Random class being measured.
+     */
+    class InputGenerator
+    {
+    public:
+        explicit InputGenerator( uint32_t seed = 0x5eed )
+            : mState( seed * 2654435761u + 1 )
+        {
+        }
+
+        float next( float min = -1.0f, float max = 1.0f )
+        {
+            mState ^= mState << 13;
+            mState ^= mState >> 17;
+            mState ^= mState << 5;
+
+            float unit = static_cast<float>( mState >> 8 ) / 16777216.0f;
+            return min + ( max - min ) * unit;
+        }
+
+    private:
+        uint32_t mState;
+    };
+
+    inline std::vector<float> makeFloats( size_t count, float min, float max )
+    {
+        InputGenerator gen;
+        std::vector<float> values( count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            values[i] = gen.next( min, max );
+        }
+
+        return values;
+    }
+
+    inline std::vector<Vec3f> makeVec3s( size_t count )
+    {
+        InputGenerator gen;
+        std::vector<Vec3f> values;
+        values.reserve( count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            float x = gen.next(), y = gen.next(), z = gen.next();
+            values.push_back( Vec3f( x, y, z ) );
+        }
+
+        return values;
+    }
+
+    inline std::vector<Vec4f> makeVec4s( size_t count )
+    {
+        InputGenerator gen;
+        std::vector<Vec4f> values;
+        values.reserve( count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            float x = gen.next(), y = gen.next(), z = gen.next(), w = gen.next();
+            values.push_back( Vec4f( x, y, z, w ) );
+        }
+
+        return values;
+    }
+
+    /**
+     * Generates well conditioned (invertible) matrices.
+     */
+    inline std::vector<Mat4f> makeMat4s( size_t count )
+    {
+        InputGenerator gen;
+        std::vector<Mat4f> values;
+        values.reserve( count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            // Diagonally dominant affine transforms
+            float v[16];
+
+            for ( int j = 0; j < 12; ++j )
+            {
+                v[j] = gen.next() + ( j % 5 == 0 ? 4.0f : 0.0f );
+            }
+
+            v[12] = 0.0f; v[13] = 0.0f; v[14] = 0.0f; v[15] = 1.0f;
+            values.push_back( Mat4f( v ) );
+        }
+
+        return values;
+    }
+
+    inline std::vector<Quatf> makeQuats( size_t count )
+    {
+        InputGenerator gen;
+        std::vector<Quatf> values;
+        values.reserve( count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            float w = gen.next(), x = gen.next(), y = gen.next(), z = gen.next();
+            values.push_back( normalize( Quatf( w, x, y, z ) ) );
+        }
+
+        return values;
+    }
+
+    /**
+     * Reports per-element throughput for a benchmark that processes
+     * state.range(0) elements per iteration.
+     */
+    inline void setElementsProcessed( benchmark::State& state, size_t bytesPerElement )
+    {
+        state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+        state.SetBytesProcessed( state.iterations() * state.range( 0 ) *
+                                 static_cast<int64_t>( bytesPerElement ) );
+    }
+}
+
+/**
+ * Registers a benchmark over the standard range of array sizes.
+ */
+#define SMATH_BENCHMARK_SIZES(fn) \
+    BENCHMARK(fn)->RangeMultiplier(8)->Range(Bench::MinElements, Bench::MaxElements)
+
+#endif
@@ -0,0 +1,303 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/batch.h>
+#include "batchkernels.h"
+
+// The kernels treat vectors as packed float arrays
+static_assert( sizeof( TVector3<float> ) == 3 * sizeof( float ),
+               "TVector3<float> must be three packed floats" );
+static_assert( sizeof( TVector4<float> ) == 4 * sizeof( float ),
+               "TVector4<float> must be four packed floats" );
+static_assert( sizeof( TMatrix4<float> ) == 16 * sizeof( float ),
+               "TMatrix4<float> must be sixteen packed floats" );
+static_assert( sizeof( TVector3<double> ) == 3 * sizeof( double ),
+               "TVector3<double> must be three packed doubles" );
+static_assert( sizeof( TVector3<int> ) == 3 * sizeof( int32_t ),
+               "TVector3<int> must be three packed 32 bit ints" );
+
+using namespace Math::detail;
+
+namespace
+{
+    const float * floats( const TVector3<float> * p )
+    {
+        return reinterpret_cast<const float *>( p );
+    }
+
+    float * floats( TVector3<float> * p )
+    {
+        return reinterpret_cast<float *>( p );
+    }
+
+    const float * floats( const TVector4<float> * p )
+    {
+        return reinterpret_cast<const float *>( p );
+    }
+
+    float * floats( TVector4<float> * p )
+    {
+        return reinterpret_cast<float *>( p );
+    }
+
+    const double * doubles( const TVector3<double> * p )
+    {
+        return reinterpret_cast<const double *>( p );
+    }
+
+    double * doubles( TVector3<double> * p )
+    {
+        return reinterpret_cast<double *>( p );
+    }
+
+    const int32_t * ints( const TVector3<int> * p )
+    {
+        return reinterpret_cast<const int32_t *>( p );
+    }
+
+    int32_t * ints( TVector3<int> * p )
+    {
+        return reinterpret_cast<int32_t *>( p );
+    }
+
+    int32_t * ints( int * p )
+    {
+        return reinterpret_cast<int32_t *>( p );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Baseline kernel tables, compiled with the library's default flags
+/////////////////////////////////////////////////////////////////////////////
+const BatchKernels * Math::detail::batchKernelsScalar()
+{
+    static const BatchKernels kernels = makeBatchKernels<float>( ISA_SCALAR );
+    return &kernels;
+}
+
+#ifdef MATH_SSE2
+const BatchKernels * Math::detail::batchKernelsSse2()
+{
+    static const BatchKernels kernels = makeBatchKernels<__m128>( ISA_SSE2 );
+    return &kernels;
+}
+#endif
+
+const BatchKernels * Math::detail::batchKernelsFor( InstructionSet isa )
+{
+    switch ( isa )
+    {
+        case ISA_SCALAR:
+            return batchKernelsScalar();
+#ifdef MATH_SSE2
+        case ISA_SSE2:
+            return batchKernelsSse2();
+#endif
+#ifdef MATH_DISPATCH_SSE41
+        case ISA_SSE41:
+            return batchKernelsSse41();
+#endif
+#ifdef MATH_DISPATCH_AVX2
+        case ISA_AVX2:
+            return batchKernelsAvx2();
+#endif
+#ifdef MATH_DISPATCH_AVX512
+        case ISA_AVX512:
+            return batchKernelsAvx512();
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Public entry points
+/////////////////////////////////////////////////////////////////////////////
+void Math::batch::transformPoints( const TMatrix4<float>& matrix,
+                                   const TVector3<float> * pIn,
+                                   TVector3<float> * pOut,
+                                   size_t count )
+{
+    activeBatchKernels().transformPoints( matrix.ptr(), floats( pIn ), floats( pOut ), count );
+}
+
+void Math::batch::transformDirections( const TMatrix4<float>& matrix,
+                                       const TVector3<float> * pIn,
+                                       TVector3<float> * pOut,
+                                       size_t count )
+{
+    activeBatchKernels().transformDirections( matrix.ptr(), floats( pIn ), floats( pOut ), count );
+}
+
+void Math::batch::transform( const TMatrix4<float>& matrix,
+                             const TVector4<float> * pIn,
+                             TVector4<float> * pOut,
+                             size_t count )
+{
+    activeBatchKernels().transform( matrix.ptr(), floats( pIn ), floats( pOut ), count );
+}
+
+void Math::batch::dot( const TVector3<float> * pA,
+                       const TVector3<float> * pB,
+                       float * pOut,
+                       size_t count )
+{
+    activeBatchKernels().dot( floats( pA ), floats( pB ), pOut, count );
+}
+
+void Math::batch::cross( const TVector3<float> * pA,
+                         const TVector3<float> * pB,
+                         TVector3<float> * pOut,
+                         size_t count )
+{
+    activeBatchKernels().cross( floats( pA ), floats( pB ), floats( pOut ), count );
+}
+
+void Math::batch::length( const TVector3<float> * pIn, float * pOut, size_t count )
+{
+    activeBatchKernels().length( floats( pIn ), pOut, count );
+}
+
+void Math::batch::normalize( const TVector3<float> * pIn,
+                             TVector3<float> * pOut,
+                             size_t count )
+{
+    activeBatchKernels().normalize( floats( pIn ), floats( pOut ), count );
+}
+
+void Math::batch::scaleAdd( const TVector3<float> * pA,
+                            const TVector3<float> * pB,
+                            float scale,
+                            TVector3<float> * pOut,
+                            size_t count )
+{
+    activeBatchKernels().scaleAdd( floats( pA ), floats( pB ), scale, floats( pOut ), count );
+}
+
+void Math::batch::dot( const TVector3<double> * pA,
+                       const TVector3<double> * pB,
+                       double * pOut,
+                       size_t count )
+{
+    activeBatchKernels().dotDouble( doubles( pA ), doubles( pB ), pOut, count );
+}
+
+void Math::batch::cross( const TVector3<double> * pA,
+                         const TVector3<double> * pB,
+                         TVector3<double> * pOut,
+                         size_t count )
+{
+    activeBatchKernels().crossDouble( doubles( pA ), doubles( pB ), doubles( pOut ), count );
+}
+
+void Math::batch::length( const TVector3<double> * pIn, double * pOut, size_t count )
+{
+    activeBatchKernels().lengthDouble( doubles( pIn ), pOut, count );
+}
+
+void Math::batch::normalize( const TVector3<double> * pIn,
+                             TVector3<double> * pOut,
+                             size_t count )
+{
+    activeBatchKernels().normalizeDouble( doubles( pIn ), doubles( pOut ), count );
+}
+
+void Math::batch::scaleAdd( const TVector3<double> * pA,
+                            const TVector3<double> * pB,
+                            double scale,
+                            TVector3<double> * pOut,
+                            size_t count )
+{
+    activeBatchKernels().scaleAddDouble( doubles( pA ), doubles( pB ), scale, doubles( pOut ), count );
+}
+
+void Math::batch::dot( const TVector3<int> * pA,
+                       const TVector3<int> * pB,
+                       int * pOut,
+                       size_t count )
+{
+    activeBatchKernels().dotInt( ints( pA ), ints( pB ), ints( pOut ), count );
+}
+
+void Math::batch::cross( const TVector3<int> * pA,
+                         const TVector3<int> * pB,
+                         TVector3<int> * pOut,
+                         size_t count )
+{
+    activeBatchKernels().crossInt( ints( pA ), ints( pB ), ints( pOut ), count );
+}
+
+void Math::batch::scaleAdd( const TVector3<int> * pA,
+                            const TVector3<int> * pB,
+                            int scale,
+                            TVector3<int> * pOut,
+                            size_t count )
+{
+    activeBatchKernels().scaleAddInt( ints( pA ), ints( pB ), scale, ints( pOut ), count );
+}
+
+void Math::batch::sin( float * pOut, const float * pIn, size_t count )
+{
+    activeBatchKernels().sin( pOut, pIn, count );
+}
+
+void Math::batch::cos( float * pOut, const float * pIn, size_t count )
+{
+    activeBatchKernels().cos( pOut, pIn, count );
+}
+
+void Math::batch::exp( float * pOut, const float * pIn, size_t count )
+{
+    activeBatchKernels().exp( pOut, pIn, count );
+}
+
+void Math::batch::log( float * pOut, const float * pIn, size_t count )
+{
+    activeBatchKernels().log( pOut, pIn, count );
+}
+
+void Math::batch::sqrt( float * pOut, const float * pIn, size_t count )
+{
+    activeBatchKernels().sqrt( pOut, pIn, count );
+}
+
+void Math::batch::rsqrt( float * pOut, const float * pIn, size_t count )
+{
+    activeBatchKernels().rsqrt( pOut, pIn, count );
+}
+
+void Math::batch::unitFloats( const uint32_t * pIn, float * pOut, size_t count )
+{
+    activeBatchKernels().unitFloats( pIn, pOut, count );
+}
+
+void Math::batch::mapToSphere( const float * pU1,
+                               const float * pU2,
+                               float * pX,
+                               float * pY,
+                               float * pZ,
+                               size_t count )
+{
+    activeBatchKernels().mapToSphere( pU1, pU2, pX, pY, pZ, count );
+}
+
+void Math::batch::mapToDisk( const float * pU1,
+                             const float * pU2,
+                             float * pX,
+                             float * pY,
+                             size_t count )
+{
+    activeBatchKernels().mapToDisk( pU1, pU2, pX, pY, count );
+}
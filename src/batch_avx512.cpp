@@ -0,0 +1,34 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+// GCC's AVX-512 headers start many intrinsics from _mm512_undefined_ps()
+// and friends, which -Wmaybe-uninitialized reports at every kernel they are
+// inlined into. The values are never read.
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic ignored "-Wuninitialized"
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include "batchkernels.h"
+
+#if !defined(MATH_AVX512)
+#   error "batch_avx512.cpp must be compiled with AVX-512F enabled"
+#endif
+
+const Math::detail::BatchKernels * Math::detail::batchKernelsAvx512()
+{
+    static const BatchKernels kernels = makeBatchKernels<__m512>( ISA_AVX512 );
+    return &kernels;
+}
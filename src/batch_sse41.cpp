@@ -0,0 +1,26 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "batchkernels.h"
+
+#if !defined(MATH_SSE41)
+#   error "batch_sse41.cpp must be compiled with SSE4.1 enabled"
+#endif
+
+const Math::detail::BatchKernels * Math::detail::batchKernelsSse41()
+{
+    static const BatchKernels kernels = makeBatchKernels<__m128>( ISA_SSE41 );
+    return &kernels;
+}
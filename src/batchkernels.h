@@ -0,0 +1,1342 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_BATCHKERNELS_H
+#define SCOTT_MATH_BATCHKERNELS_H
+
+//
+// Internal: the batch kernels, written once against the Math::simd lane
+// types and included by one translation unit per instruction set level.
+//
+// Everything here has internal linkage, and the kernels only call into
+// Math::simd and Math::fast, whose inline functions are tagged with the
+// instruction set they were compiled for. Kernels must not call any other
+// inline function (vector and matrix members, std::min and so on): the
+// linker would be free to keep this translation unit's copy of it, compiled
+// with instructions that the CPU running the baseline code may not have.
+//
+#include "dispatch.h"
+
+#include <smath/constants.h>
+#include <smath/simd.h>
+#include <smath/fastmath.h>
+
+#include <cfloat>
+#include <cstddef>
+
+namespace
+{
+    using namespace Math::simd;
+    using Math::detail::BatchKernels;
+
+    /**
+     * Calls kernel.apply<V>( i ) for each block of lanes in [0, count),
+     * followed by kernel.apply<S>( i ) for the remaining elements. S is
+     * double or int32_t for kernels on double or integer lanes.
+     */
+    template<typename V, typename S = float, typename Kernel>
+    inline void run( size_t count, const Kernel& kernel )
+    {
+        const size_t Width = LaneCount<V>::value;
+        size_t i = 0;
+
+        for ( ; i + Width <= count; i += Width )
+        {
+            kernel.template apply<V>( i );
+        }
+
+        for ( ; i < count; ++i )
+        {
+            kernel.template apply<S>( i );
+        }
+    }
+
+    /**
+     * Sets every lane to a float or double kernel argument.
+     */
+    template<typename T>
+    inline T broadcast( float v )
+    {
+        return splat<T>( v );
+    }
+
+    template<typename T>
+    inline T broadcast( double v )
+    {
+        return splatDouble<T>( v );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Matrix transforms
+    /////////////////////////////////////////////////////////////////////////
+    template<bool Translate>
+    struct TransformKernel
+    {
+        const float * pM;
+        const float * pIn;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T x, y, z;
+            load3( pIn + 3 * i, x, y, z );
+
+            T rx = mul( splat<T>( pM[2] ), z );
+            T ry = mul( splat<T>( pM[6] ), z );
+            T rz = mul( splat<T>( pM[10] ), z );
+
+            if ( Translate )
+            {
+                rx = add( rx, splat<T>( pM[3] ) );
+                ry = add( ry, splat<T>( pM[7] ) );
+                rz = add( rz, splat<T>( pM[11] ) );
+            }
+
+            rx = madd( splat<T>( pM[0] ), x, madd( splat<T>( pM[1] ), y, rx ) );
+            ry = madd( splat<T>( pM[4] ), x, madd( splat<T>( pM[5] ), y, ry ) );
+            rz = madd( splat<T>( pM[8] ), x, madd( splat<T>( pM[9] ), y, rz ) );
+
+            store3( pOut + 3 * i, rx, ry, rz );
+        }
+    };
+
+    template<typename V>
+    void transformPoints( const float * pM, const float * pIn, float * pOut, size_t count )
+    {
+        TransformKernel<true> kernel = { pM, pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void transformDirections( const float * pM, const float * pIn, float * pOut, size_t count )
+    {
+        TransformKernel<false> kernel = { pM, pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    /**
+     * Transforms one 4d vector as the sum of the matrix columns scaled by
+     * the vector components.
+     */
+    inline void transform4( const float * pM, const float * pIn, float * pOut )
+    {
+        float x = pIn[0], y = pIn[1], z = pIn[2], w = pIn[3];
+
+        for ( int r = 0; r < 4; ++r )
+        {
+            pOut[r] = madd( pM[4 * r], x,
+                      madd( pM[4 * r + 1], y,
+                      madd( pM[4 * r + 2], z, mul( pM[4 * r + 3], w ) ) ) );
+        }
+    }
+
+    /**
+     * Transforms one vector at a time, the scalar level has no groups of
+     * four lanes to work with.
+     */
+    template<typename V>
+    struct Transform4;
+
+    template<>
+    struct Transform4<float>
+    {
+        static void run( const float * pM, const float * pIn, float * pOut, size_t count )
+        {
+            for ( size_t i = 0; i < count; ++i )
+            {
+                float v[4] = { pIn[4 * i], pIn[4 * i + 1], pIn[4 * i + 2], pIn[4 * i + 3] };
+                transform4( pM, v, pOut + 4 * i );
+            }
+        }
+    };
+
+    /**
+     * Transforms LaneCount / 4 vectors per iteration, with every group of
+     * four lanes holding one vector.
+     */
+    template<typename V>
+    struct Transform4
+    {
+        static void run( const float * pM, const float * pIn, float * pOut, size_t count )
+        {
+            const size_t PerBlock = LaneCount<V>::value / 4;
+            float columns[4][4];
+
+            for ( int c = 0; c < 4; ++c )
+            {
+                for ( int r = 0; r < 4; ++r )
+                {
+                    columns[c][r] = pM[4 * r + c];
+                }
+            }
+
+            V c0 = loadGroup4<V>( columns[0] );
+            V c1 = loadGroup4<V>( columns[1] );
+            V c2 = loadGroup4<V>( columns[2] );
+            V c3 = loadGroup4<V>( columns[3] );
+            size_t i = 0;
+
+            for ( ; i + PerBlock <= count; i += PerBlock )
+            {
+                V v = load<V>( pIn + 4 * i );
+                V r = mul( c3, permute4<3>( v ) );
+
+                r = madd( c2, permute4<2>( v ), r );
+                r = madd( c1, permute4<1>( v ), r );
+                r = madd( c0, permute4<0>( v ), r );
+
+                store( pOut + 4 * i, r );
+            }
+
+            Transform4<float>::run( pM, pIn + 4 * i, pOut + 4 * i, count - i );
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    // Vector streams, on float or double arrays. sqrt is qualified as the C
+    // library's sqrt( double ) would make double calls ambiguous.
+    /////////////////////////////////////////////////////////////////////////
+    template<typename S>
+    struct DotKernel
+    {
+        const S * pA;
+        const S * pB;
+        S * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T ax, ay, az, bx, by, bz;
+            load3( pA + 3 * i, ax, ay, az );
+            load3( pB + 3 * i, bx, by, bz );
+
+            store( pOut + i, madd( ax, bx, madd( ay, by, mul( az, bz ) ) ) );
+        }
+    };
+
+    template<typename S>
+    struct CrossKernel
+    {
+        const S * pA;
+        const S * pB;
+        S * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T ax, ay, az, bx, by, bz;
+            load3( pA + 3 * i, ax, ay, az );
+            load3( pB + 3 * i, bx, by, bz );
+
+            store3( pOut + 3 * i,
+                    sub( mul( ay, bz ), mul( az, by ) ),
+                    sub( mul( az, bx ), mul( ax, bz ) ),
+                    sub( mul( ax, by ), mul( ay, bx ) ) );
+        }
+    };
+
+    template<typename S>
+    struct LengthKernel
+    {
+        const S * pIn;
+        S * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T x, y, z;
+            load3( pIn + 3 * i, x, y, z );
+
+            store( pOut + i, Math::simd::sqrt( madd( x, x, madd( y, y, mul( z, z ) ) ) ) );
+        }
+    };
+
+    template<typename S>
+    struct NormalizeKernel
+    {
+        const S * pIn;
+        S * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T x, y, z;
+            load3( pIn + 3 * i, x, y, z );
+
+            // One divide instead of three, the divider is the bottleneck
+            T length = Math::simd::sqrt( madd( x, x, madd( y, y, mul( z, z ) ) ) );
+            T inverse = div( broadcast<T>( static_cast<S>( 1 ) ), length );
+            store3( pOut + 3 * i, mul( x, inverse ), mul( y, inverse ), mul( z, inverse ) );
+        }
+    };
+
+    template<typename S>
+    struct ScaleAddKernel
+    {
+        const S * pA;
+        const S * pB;
+        S scale;
+        S * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T ax, ay, az, bx, by, bz;
+            load3( pA + 3 * i, ax, ay, az );
+            load3( pB + 3 * i, bx, by, bz );
+
+            T s = broadcast<T>( scale );
+            store3( pOut + 3 * i, madd( bx, s, ax ), madd( by, s, ay ), madd( bz, s, az ) );
+        }
+    };
+
+    template<typename V>
+    void dot( const float * pA, const float * pB, float * pOut, size_t count )
+    {
+        DotKernel<float> kernel = { pA, pB, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void cross( const float * pA, const float * pB, float * pOut, size_t count )
+    {
+        CrossKernel<float> kernel = { pA, pB, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void length( const float * pIn, float * pOut, size_t count )
+    {
+        LengthKernel<float> kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void normalize( const float * pIn, float * pOut, size_t count )
+    {
+        NormalizeKernel<float> kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void scaleAdd( const float * pA, const float * pB, float scale, float * pOut, size_t count )
+    {
+        ScaleAddKernel<float> kernel = { pA, pB, scale, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename D>
+    void dot( const double * pA, const double * pB, double * pOut, size_t count )
+    {
+        DotKernel<double> kernel = { pA, pB, pOut };
+        run<D, double>( count, kernel );
+    }
+
+    template<typename D>
+    void cross( const double * pA, const double * pB, double * pOut, size_t count )
+    {
+        CrossKernel<double> kernel = { pA, pB, pOut };
+        run<D, double>( count, kernel );
+    }
+
+    template<typename D>
+    void length( const double * pIn, double * pOut, size_t count )
+    {
+        LengthKernel<double> kernel = { pIn, pOut };
+        run<D, double>( count, kernel );
+    }
+
+    template<typename D>
+    void normalize( const double * pIn, double * pOut, size_t count )
+    {
+        NormalizeKernel<double> kernel = { pIn, pOut };
+        run<D, double>( count, kernel );
+    }
+
+    template<typename D>
+    void scaleAdd( const double * pA, const double * pB, double scale, double * pOut, size_t count )
+    {
+        ScaleAddKernel<double> kernel = { pA, pB, scale, pOut };
+        run<D, double>( count, kernel );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Integer vector streams, on int32 lanes. The lanes wrap on overflow
+    // where the scalar int operators would be undefined.
+    /////////////////////////////////////////////////////////////////////////
+    struct IntDotKernel
+    {
+        const int32_t * pA;
+        const int32_t * pB;
+        int32_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T ax, ay, az, bx, by, bz;
+            load3( pA + 3 * i, ax, ay, az );
+            load3( pB + 3 * i, bx, by, bz );
+
+            store( pOut + i, iadd( imul( ax, bx ), iadd( imul( ay, by ), imul( az, bz ) ) ) );
+        }
+    };
+
+    struct IntCrossKernel
+    {
+        const int32_t * pA;
+        const int32_t * pB;
+        int32_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T ax, ay, az, bx, by, bz;
+            load3( pA + 3 * i, ax, ay, az );
+            load3( pB + 3 * i, bx, by, bz );
+
+            store3( pOut + 3 * i,
+                    isub( imul( ay, bz ), imul( az, by ) ),
+                    isub( imul( az, bx ), imul( ax, bz ) ),
+                    isub( imul( ax, by ), imul( ay, bx ) ) );
+        }
+    };
+
+    struct IntScaleAddKernel
+    {
+        const int32_t * pA;
+        const int32_t * pB;
+        int32_t scale;
+        int32_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T ax, ay, az, bx, by, bz;
+            load3( pA + 3 * i, ax, ay, az );
+            load3( pB + 3 * i, bx, by, bz );
+
+            T s = splatInt<T>( scale );
+            store3( pOut + 3 * i,
+                    iadd( ax, imul( bx, s ) ),
+                    iadd( ay, imul( by, s ) ),
+                    iadd( az, imul( bz, s ) ) );
+        }
+    };
+
+    template<typename I>
+    void dot( const int32_t * pA, const int32_t * pB, int32_t * pOut, size_t count )
+    {
+        IntDotKernel kernel = { pA, pB, pOut };
+        run<I, int32_t>( count, kernel );
+    }
+
+    template<typename I>
+    void cross( const int32_t * pA, const int32_t * pB, int32_t * pOut, size_t count )
+    {
+        IntCrossKernel kernel = { pA, pB, pOut };
+        run<I, int32_t>( count, kernel );
+    }
+
+    template<typename I>
+    void scaleAdd( const int32_t * pA, const int32_t * pB, int32_t scale, int32_t * pOut, size_t count )
+    {
+        IntScaleAddKernel kernel = { pA, pB, scale, pOut };
+        run<I, int32_t>( count, kernel );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // World positions. Splitting and rebasing work on each component alone,
+    // so rather than transposing xyz triples, a block of positions is three
+    // plain vectors of components. The origin is repeated in a pattern that
+    // lines up with the k'th vector of a block at offset k * width % 3.
+    /////////////////////////////////////////////////////////////////////////
+    template<typename S, size_t N>
+    void repeatOrigin( const S * pOrigin, S (&pattern)[N] )
+    {
+        for ( size_t j = 0; j < N; ++j )
+        {
+            pattern[j] = pOrigin[ j % 3 ];
+        }
+    }
+
+    struct SplitKernel
+    {
+        const double * pIn;
+        float * pHigh;
+        float * pLow;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            const size_t Width = LaneCount<T>::value;
+
+            for ( size_t k = 0; k < 3; ++k )
+            {
+                // The remainder is exact in double, and rounds to float again
+                const size_t j = 3 * i + k * Width;
+                T value = load<T>( pIn + j );
+                T high = roundToFloat( value );
+
+                storeFloat( pHigh + j, high );
+                storeFloat( pLow + j, sub( value, high ) );
+            }
+        }
+    };
+
+    struct RebaseKernel
+    {
+        const float * pHigh;
+        const float * pLow;
+        const float * pOriginHigh;
+        const float * pOriginLow;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            const size_t Width = LaneCount<T>::value;
+
+            for ( size_t k = 0; k < 3; ++k )
+            {
+                // The high difference is exact for positions near the
+                // origin, which are the ones that need the precision
+                const size_t j = 3 * i + k * Width;
+                const size_t phase = k * Width % 3;
+
+                store( pOut + j, add( sub( load<T>( pHigh + j ), load<T>( pOriginHigh + phase ) ),
+                                      sub( load<T>( pLow + j ), load<T>( pOriginLow + phase ) ) ) );
+            }
+        }
+    };
+
+    struct RebaseDoubleKernel
+    {
+        const double * pIn;
+        const double * pOrigin;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            const size_t Width = LaneCount<T>::value;
+
+            for ( size_t k = 0; k < 3; ++k )
+            {
+                const size_t j = 3 * i + k * Width;
+                storeFloat( pOut + j, sub( load<T>( pIn + j ), load<T>( pOrigin + k * Width % 3 ) ) );
+            }
+        }
+    };
+
+    template<typename D>
+    void splitDouble( const double * pIn, float * pHigh, float * pLow, size_t count )
+    {
+        SplitKernel kernel = { pIn, pHigh, pLow };
+        run<D, double>( count, kernel );
+    }
+
+    template<typename V>
+    void rebase( const float * pHigh, const float * pLow, const float * pOrigin, float * pOut, size_t count )
+    {
+        float high[ 2 + LaneCount<V>::value ];
+        float low[ 2 + LaneCount<V>::value ];
+
+        repeatOrigin( pOrigin, high );
+        repeatOrigin( pOrigin + 3, low );
+
+        RebaseKernel kernel = { pHigh, pLow, high, low, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename D>
+    void rebaseDouble( const double * pIn, const double * pOrigin, float * pOut, size_t count )
+    {
+        double origin[ 2 + LaneCount<D>::value ];
+        repeatOrigin( pOrigin, origin );
+
+        RebaseDoubleKernel kernel = { pIn, origin, pOut };
+        run<D, double>( count, kernel );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Float streams
+    /////////////////////////////////////////////////////////////////////////
+    template<typename Op>
+    struct StreamKernel
+    {
+        float * pOut;
+        const float * pIn;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            store( pOut + i, Op()( load<T>( pIn + i ) ) );
+        }
+    };
+
+    template<typename V, typename Op>
+    void stream( float * pOut, const float * pIn, size_t count )
+    {
+        StreamKernel<Op> kernel = { pOut, pIn };
+        run<V>( count, kernel );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Packed formats. The codecs are also used one value at a time by the
+    // scalar functions in packing.h, with float lanes; abs is qualified as
+    // the global std::abs overloads would make float calls ambiguous.
+    /////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Returns 1 with the sign of each lane, so zero counts as positive.
+     */
+    template<typename V>
+    inline V signNotZero( V v )
+    {
+        return asFloat( ior( ixor( asInt( v ), asInt( Math::simd::abs( v ) ) ), asInt( splat<V>( 1.0f ) ) ) );
+    }
+
+    /**
+     * Converts floats to IEEE half precision bits, rounding to nearest even.
+     * Values too large for a half become infinity, NaNs stay NaNs.
+     */
+    template<typename V>
+    inline typename IntLanes<V>::type encodeHalf( V x )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        const V a    = Math::simd::abs( x );
+        const I ai   = asInt( a );
+        const I sign = ixor( asInt( x ), ai );
+
+        // Below the smallest normal half, adding 0.5 shifts the mantissa so
+        // that the float addition rounds it to the last half subnormal bit
+        const V Magic = splat<V>( 0.5f );
+        const I subnormal = isub( asInt( add( a, Magic ) ), asInt( Magic ) );
+
+        // Rebias the exponent and round the mantissa to nearest even; a
+        // carry out of the mantissa correctly bumps the exponent
+        const I odd    = iand( shiftRight<13>( ai ), splatInt<I>( 1 ) );
+        const I normal = shiftRight<13>( iadd( isub( ai, splatInt<I>( ( 127 - 15 ) << 23 ) ),
+                                               iadd( splatInt<I>( 0xfff ), odd ) ) );
+
+        const V special = select( equal( x, x ), asFloat( splatInt<I>( 0x7c00 ) ),
+                                                 asFloat( splatInt<I>( 0x7e00 ) ) );
+
+        V result = select( lessThan( a, splat<V>( 6.103515625e-05f ) ), asFloat( subnormal ),
+                                                                        asFloat( normal ) );
+        result = select( lessThan( a, splat<V>( 65536.0f ) ), result, special );
+
+        return ior( asInt( result ), shiftRight<16>( sign ) );
+    }
+
+    /**
+     * Converts IEEE half precision bits to floats, exactly.
+     */
+    template<typename V>
+    inline V decodeHalf( typename IntLanes<V>::type h )
+    {
+        typedef typename IntLanes<V>::type I;
+        const I ExponentMask = splatInt<I>( 0x7c00 << 13 );
+
+        const I magnitude = shiftLeft<13>( iand( h, splatInt<I>( 0x7fff ) ) );
+        const I exponent  = iand( magnitude, ExponentMask );
+        const I rebased   = iadd( magnitude, splatInt<I>( ( 127 - 15 ) << 23 ) );
+
+        // Infinity and NaN keep the largest exponent, subnormals are
+        // normalized by a float subtraction
+        const V special   = asFloat( iadd( rebased, splatInt<I>( ( 128 - 16 ) << 23 ) ) );
+        const V subnormal = sub( asFloat( iadd( rebased, splatInt<I>( 1 << 23 ) ) ),
+                                 splat<V>( 6.103515625e-05f ) );
+
+        V result = select( iequal( exponent, ExponentMask ), special, asFloat( rebased ) );
+        result = select( iequal( exponent, splatInt<I>( 0 ) ), subnormal, result );
+
+        return asFloat( ior( asInt( result ), shiftLeft<16>( iand( h, splatInt<I>( 0x8000 ) ) ) ) );
+    }
+
+    /**
+     * Loads and stores halves, using the F16C conversions where the level
+     * has them. F16C keeps NaN payloads, so only NaN bits may differ from
+     * the scalar functions.
+     */
+    template<typename V>
+    inline V loadHalf( const uint16_t * p )
+    {
+        return decodeHalf<V>( loadUInt16<typename IntLanes<V>::type>( p ) );
+    }
+
+    template<typename V>
+    inline void storeHalf( uint16_t * p, V x )
+    {
+        storeUInt16( p, encodeHalf( x ) );
+    }
+
+#ifdef MATH_F16C
+    template<>
+    inline __m256 loadHalf<__m256>( const uint16_t * p )
+    {
+        return _mm256_cvtph_ps( _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) ) );
+    }
+
+    template<>
+    inline void storeHalf( uint16_t * p, __m256 x )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( p ),
+                          _mm256_cvtps_ph( x, _MM_FROUND_TO_NEAREST_INT ) );
+    }
+#endif
+
+#ifdef MATH_AVX512
+    template<>
+    inline __m512 loadHalf<__m512>( const uint16_t * p )
+    {
+        return _mm512_cvtph_ps( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( p ) ) );
+    }
+
+    template<>
+    inline void storeHalf( uint16_t * p, __m512 x )
+    {
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( p ),
+                             _mm512_cvtps_ph( x, _MM_FROUND_TO_NEAREST_INT ) );
+    }
+#endif
+
+    /**
+     * Converts floats to bfloat16 bits, the upper half of the float,
+     * rounding to nearest even. NaNs are kept quiet so that rounding
+     * cannot turn them into infinity.
+     */
+    template<typename V>
+    inline typename IntLanes<V>::type encodeBFloat16( V x )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        const I bits    = asInt( x );
+        const I odd     = iand( shiftRight<16>( bits ), splatInt<I>( 1 ) );
+        const I rounded = shiftRight<16>( iadd( bits, iadd( splatInt<I>( 0x7fff ), odd ) ) );
+        const I quiet   = ior( shiftRight<16>( bits ), splatInt<I>( 0x0040 ) );
+
+        return asInt( select( equal( x, x ), asFloat( rounded ), asFloat( quiet ) ) );
+    }
+
+    /**
+     * Converts bfloat16 bits to floats, exactly.
+     */
+    template<typename V>
+    inline V decodeBFloat16( typename IntLanes<V>::type h )
+    {
+        return asFloat( shiftLeft<16>( h ) );
+    }
+
+    /**
+     * Converts floats in [-1,1] to 16 bit signed normalized integers, in
+     * the low 16 bits of each lane. Values outside are clamped.
+     */
+    template<typename V>
+    inline typename IntLanes<V>::type encodeSnorm16( V x )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        const V clamped = minimum( maximum( x, splat<V>( -1.0f ) ), splat<V>( 1.0f ) );
+        return iand( roundToInt( mul( clamped, splat<V>( 32767.0f ) ) ), splatInt<I>( 0xffff ) );
+    }
+
+    template<typename V>
+    inline V decodeSnorm16( typename IntLanes<V>::type h )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        // Sign extend the low 16 bits; -32768 decodes to -1 like -32767
+        const I value = isub( ixor( iand( h, splatInt<I>( 0xffff ) ), splatInt<I>( 0x8000 ) ),
+                              splatInt<I>( 0x8000 ) );
+
+        return maximum( mul( toFloat( value ), splat<V>( 1.0f / 32767.0f ) ), splat<V>( -1.0f ) );
+    }
+
+    /**
+     * Maps unit vectors onto an octahedron and unfolds it into the square
+     * [-1,1]^2, then stores the square coordinates as snorm16.
+     */
+    template<typename V>
+    inline void encodeOctahedral( V x, V y, V z,
+                                  typename IntLanes<V>::type& u,
+                                  typename IntLanes<V>::type& v )
+    {
+        const V One   = splat<V>( 1.0f );
+        const V scale = div( One, add( Math::simd::abs( x ), add( Math::simd::abs( y ), Math::simd::abs( z ) ) ) );
+        const V px    = mul( x, scale );
+        const V py    = mul( y, scale );
+
+        // The lower half is folded over the diagonals onto the corners
+        const V fx = mul( sub( One, Math::simd::abs( py ) ), signNotZero( px ) );
+        const V fy = mul( sub( One, Math::simd::abs( px ) ), signNotZero( py ) );
+        const V Zero = splat<V>( 0.0f );
+
+        u = encodeSnorm16( select( lessThan( z, Zero ), fx, px ) );
+        v = encodeSnorm16( select( lessThan( z, Zero ), fy, py ) );
+    }
+
+    template<typename V>
+    inline void decodeOctahedral( typename IntLanes<V>::type u,
+                                  typename IntLanes<V>::type v,
+                                  V& x, V& y, V& z )
+    {
+        const V One = splat<V>( 1.0f );
+
+        x = decodeSnorm16<V>( u );
+        y = decodeSnorm16<V>( v );
+        z = sub( sub( One, Math::simd::abs( x ) ), Math::simd::abs( y ) );
+
+        const V fold = maximum( sub( splat<V>( 0.0f ), z ), splat<V>( 0.0f ) );
+        x = sub( x, mul( signNotZero( x ), fold ) );
+        y = sub( y, mul( signNotZero( y ), fold ) );
+
+        const V scale = div( One, sqrt( madd( x, x, madd( y, y, mul( z, z ) ) ) ) );
+        x = mul( x, scale );
+        y = mul( y, scale );
+        z = mul( z, scale );
+    }
+
+    /**
+     * Maps [-1/sqrt(2), 1/sqrt(2)] to [0, 32767]. No fused multiply-add, so
+     * every level packs to the same bits.
+     */
+    template<typename V>
+    inline typename IntLanes<V>::type quantizeSmallest( V value )
+    {
+        const V scaled = add( mul( value, splat<V>( 32767.0f * 0.70710678118654752f ) ),
+                              splat<V>( 32767.0f * 0.5f ) );
+
+        return roundToInt( minimum( maximum( scaled, splat<V>( 0.0f ) ), splat<V>( 32767.0f ) ) );
+    }
+
+    /**
+     * Smallest three quaternion compression in three 16 bit words: the
+     * largest magnitude component is dropped and rebuilt from the unit
+     * length, the sign of the quaternion is chosen to make it positive and
+     * the other three, which lie in [-1/sqrt(2), 1/sqrt(2)], are stored in
+     * memory order as 15 bit fractions. The index of the dropped component
+     * takes the top bits of the first two words.
+     */
+    template<typename V>
+    inline void encodeQuaternion( const V * c, typename IntLanes<V>::type * pWords )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        const V a0 = Math::simd::abs( c[0] ), a1 = Math::simd::abs( c[1] );
+        const V a2 = Math::simd::abs( c[2] ), a3 = Math::simd::abs( c[3] );
+        const V best01  = maximum( a0, a1 );
+        const V best23  = maximum( a2, a3 );
+        const V index01 = select( greaterThan( a1, a0 ), splat<V>( 1.0f ), splat<V>( 0.0f ) );
+        const V index23 = select( greaterThan( a3, a2 ), splat<V>( 3.0f ), splat<V>( 2.0f ) );
+        const V index   = select( greaterThan( best23, best01 ), index23, index01 );
+
+        const auto is0 = equal( index, splat<V>( 0.0f ) );
+        const auto is1 = equal( index, splat<V>( 1.0f ) );
+        const auto is3 = equal( index, splat<V>( 3.0f ) );
+
+        const V largest = select( is0, c[0], select( is1, c[1], select( is3, c[3], c[2] ) ) );
+        const V sign    = signNotZero( largest );
+
+        const V first  = select( is0, c[1], c[0] );
+        const V second = select( is0, c[2], select( is1, c[2], c[1] ) );
+        const V third  = select( is3, c[2], c[3] );
+
+        const I i = roundToInt( index );
+
+        pWords[0] = quantizeSmallest( mul( first, sign ) );
+        pWords[1] = quantizeSmallest( mul( second, sign ) );
+        pWords[2] = quantizeSmallest( mul( third, sign ) );
+
+        pWords[0] = ior( pWords[0], shiftLeft<14>( iand( i, splatInt<I>( 2 ) ) ) );
+        pWords[1] = ior( pWords[1], shiftLeft<15>( iand( i, splatInt<I>( 1 ) ) ) );
+    }
+
+    template<typename V>
+    inline void decodeQuaternion( const typename IntLanes<V>::type * pWords, V * c )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        const I Mask = splatInt<I>( 0x7fff );
+        const I i = ior( shiftLeft<1>( shiftRight<15>( pWords[0] ) ),
+                         iand( shiftRight<15>( pWords[1] ), splatInt<I>( 1 ) ) );
+
+        const V Scale  = splat<V>( 1.41421356237309505f / 32767.0f );
+        const V Offset = splat<V>( -0.70710678118654752f );
+
+        const V first  = madd( toFloat( iand( pWords[0], Mask ) ), Scale, Offset );
+        const V second = madd( toFloat( iand( pWords[1], Mask ) ), Scale, Offset );
+        const V third  = madd( toFloat( iand( pWords[2], Mask ) ), Scale, Offset );
+
+        const V rest    = madd( first, first, madd( second, second, mul( third, third ) ) );
+        const V largest = sqrt( maximum( sub( splat<V>( 1.0f ), rest ), splat<V>( 0.0f ) ) );
+
+        const auto is0 = iequal( i, splatInt<I>( 0 ) );
+        const auto is1 = iequal( i, splatInt<I>( 1 ) );
+        const auto is2 = iequal( i, splatInt<I>( 2 ) );
+        const auto is3 = iequal( i, splatInt<I>( 3 ) );
+
+        c[0] = select( is0, largest, first );
+        c[1] = select( is1, largest, select( is0, first, second ) );
+        c[2] = select( is2, largest, select( is3, third, second ) );
+        c[3] = select( is3, largest, third );
+    }
+
+    /**
+     * Loads element k of Width consecutive records of Stride floats into
+     * lanes, and the reverse. Used for records that have no transposing
+     * load like load3.
+     */
+    template<typename T>
+    inline T gather( const float * p, size_t stride )
+    {
+        float lanes[ LaneCount<T>::value ];
+
+        for ( int j = 0; j < LaneCount<T>::value; ++j )
+        {
+            lanes[j] = p[ j * stride ];
+        }
+
+        return load<T>( lanes );
+    }
+
+    template<typename T>
+    inline void scatter( float * p, size_t stride, T v )
+    {
+        float lanes[ LaneCount<T>::value ];
+        store( lanes, v );
+
+        for ( int j = 0; j < LaneCount<T>::value; ++j )
+        {
+            p[ j * stride ] = lanes[j];
+        }
+    }
+
+    template<typename T>
+    inline typename IntLanes<T>::type gatherUInt16( const uint16_t * p, size_t stride )
+    {
+        uint16_t lanes[ LaneCount<T>::value ];
+
+        for ( int j = 0; j < LaneCount<T>::value; ++j )
+        {
+            lanes[j] = p[ j * stride ];
+        }
+
+        return loadUInt16<typename IntLanes<T>::type>( lanes );
+    }
+
+    template<typename T>
+    inline void scatterUInt16( uint16_t * p, size_t stride, typename IntLanes<T>::type v )
+    {
+        uint16_t lanes[ LaneCount<T>::value ];
+        storeUInt16( lanes, v );
+
+        for ( int j = 0; j < LaneCount<T>::value; ++j )
+        {
+            p[ j * stride ] = lanes[j];
+        }
+    }
+
+    struct PackHalfKernel
+    {
+        const float * pIn;
+        uint16_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            storeHalf( pOut + i, load<T>( pIn + i ) );
+        }
+    };
+
+    struct UnpackHalfKernel
+    {
+        const uint16_t * pIn;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            store( pOut + i, loadHalf<T>( pIn + i ) );
+        }
+    };
+
+    struct PackBFloat16Kernel
+    {
+        const float * pIn;
+        uint16_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            storeUInt16( pOut + i, encodeBFloat16( load<T>( pIn + i ) ) );
+        }
+    };
+
+    struct UnpackBFloat16Kernel
+    {
+        const uint16_t * pIn;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            store( pOut + i, decodeBFloat16<T>( loadUInt16<typename IntLanes<T>::type>( pIn + i ) ) );
+        }
+    };
+
+    struct PackSnorm16Kernel
+    {
+        const float * pIn;
+        float scale;
+        uint16_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            storeUInt16( pOut + i, encodeSnorm16( mul( load<T>( pIn + i ), splat<T>( scale ) ) ) );
+        }
+    };
+
+    struct UnpackSnorm16Kernel
+    {
+        const uint16_t * pIn;
+        float scale;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            const T value = decodeSnorm16<T>( loadUInt16<typename IntLanes<T>::type>( pIn + i ) );
+            store( pOut + i, mul( value, splat<T>( scale ) ) );
+        }
+    };
+
+    struct PackOctahedralKernel
+    {
+        const float * pIn;
+        uint16_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            typename IntLanes<T>::type u, v;
+            T x, y, z;
+
+            load3( pIn + 3 * i, x, y, z );
+            encodeOctahedral( x, y, z, u, v );
+
+            scatterUInt16<T>( pOut + 2 * i, 2, u );
+            scatterUInt16<T>( pOut + 2 * i + 1, 2, v );
+        }
+    };
+
+    struct UnpackOctahedralKernel
+    {
+        const uint16_t * pIn;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T x, y, z;
+
+            decodeOctahedral( gatherUInt16<T>( pIn + 2 * i, 2 ), gatherUInt16<T>( pIn + 2 * i + 1, 2 ),
+                              x, y, z );
+            store3( pOut + 3 * i, x, y, z );
+        }
+    };
+
+    struct PackQuaternionKernel
+    {
+        const float * pIn;
+        uint16_t * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T c[4];
+            typename IntLanes<T>::type words[3];
+
+            for ( int k = 0; k < 4; ++k )
+            {
+                c[k] = gather<T>( pIn + 4 * i + k, 4 );
+            }
+
+            encodeQuaternion( c, words );
+
+            for ( int k = 0; k < 3; ++k )
+            {
+                scatterUInt16<T>( pOut + 3 * i + k, 3, words[k] );
+            }
+        }
+    };
+
+    struct UnpackQuaternionKernel
+    {
+        const uint16_t * pIn;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            T c[4];
+            typename IntLanes<T>::type words[3];
+
+            for ( int k = 0; k < 3; ++k )
+            {
+                words[k] = gatherUInt16<T>( pIn + 3 * i + k, 3 );
+            }
+
+            decodeQuaternion( words, c );
+
+            for ( int k = 0; k < 4; ++k )
+            {
+                scatter( pOut + 4 * i + k, 4, c[k] );
+            }
+        }
+    };
+
+    template<typename V>
+    void packHalf( const float * pIn, uint16_t * pOut, size_t count )
+    {
+        PackHalfKernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void unpackHalf( const uint16_t * pIn, float * pOut, size_t count )
+    {
+        UnpackHalfKernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void packBFloat16( const float * pIn, uint16_t * pOut, size_t count )
+    {
+        PackBFloat16Kernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void unpackBFloat16( const uint16_t * pIn, float * pOut, size_t count )
+    {
+        UnpackBFloat16Kernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void packSnorm16( const float * pIn, float scale, uint16_t * pOut, size_t count )
+    {
+        PackSnorm16Kernel kernel = { pIn, scale, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void unpackSnorm16( const uint16_t * pIn, float scale, float * pOut, size_t count )
+    {
+        UnpackSnorm16Kernel kernel = { pIn, scale, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void packOctahedral( const float * pIn, uint16_t * pOut, size_t count )
+    {
+        PackOctahedralKernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void unpackOctahedral( const uint16_t * pIn, float * pOut, size_t count )
+    {
+        UnpackOctahedralKernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void packQuaternion( const float * pIn, uint16_t * pOut, size_t count )
+    {
+        PackQuaternionKernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V>
+    void unpackQuaternion( const uint16_t * pIn, float * pOut, size_t count )
+    {
+        UnpackQuaternionKernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Random values. The generators are sequential and stay scalar; these
+    // map their raw output to uniform floats, and uniform floats to shapes
+    // as the mappings in shapesampling.h do.
+    /////////////////////////////////////////////////////////////////////////
+    struct UnitFloatKernel
+    {
+        const uint32_t * pIn;
+        float * pOut;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            // The top 24 bits convert exactly, so every level agrees
+            typedef typename IntLanes<T>::type I;
+            const I bits = shiftRight<8>( loadUInt32<I>( pIn + i ) );
+
+            store( pOut + i, mul( toFloat( bits ), splat<T>( 1.0f / 16777216.0f ) ) );
+        }
+    };
+
+    template<int P>
+    struct SphereKernel
+    {
+        const float * pU1;
+        const float * pU2;
+        float * pX;
+        float * pY;
+        float * pZ;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            const T z = sub( splat<T>( 1.0f ), mul( splat<T>( 2.0f ), load<T>( pU1 + i ) ) );
+            const T r = Math::simd::sqrt( maximum( sub( splat<T>( 1.0f ), mul( z, z ) ), splat<T>( 0.0f ) ) );
+
+            T s, c;
+            Math::fast::detail::sincos<P>( mul( splat<T>( Math::TwoPi ), load<T>( pU2 + i ) ), s, c );
+
+            store( pX + i, mul( r, c ) );
+            store( pY + i, mul( r, s ) );
+            store( pZ + i, z );
+        }
+    };
+
+    template<int P>
+    struct DiskKernel
+    {
+        const float * pU1;
+        const float * pU2;
+        float * pX;
+        float * pY;
+
+        template<typename T>
+        void apply( size_t i ) const
+        {
+            const T a = madd( splat<T>( 2.0f ), load<T>( pU1 + i ), splat<T>( -1.0f ) );
+            const T b = madd( splat<T>( 2.0f ), load<T>( pU2 + i ), splat<T>( -1.0f ) );
+
+            // Concentric mapping, the wedge is picked by selects. The other
+            // coordinate is never larger than r, so a tiny r can divide by
+            // one instead.
+            const auto horizontal = greaterThan( mul( a, a ), mul( b, b ) );
+            const T r       = select( horizontal, a, b );
+            const T other   = select( horizontal, b, a );
+            const T divisor = select( lessThan( Math::simd::abs( r ), splat<T>( FLT_MIN ) ), splat<T>( 1.0f ), r );
+            const T ratio   = div( other, divisor );
+            const T phi     = select( horizontal,
+                                      mul( splat<T>( Math::QuarterPi ), ratio ),
+                                      madd( splat<T>( -Math::QuarterPi ), ratio, splat<T>( Math::HalfPi ) ) );
+
+            T s, c;
+            Math::fast::detail::sincos<P>( phi, s, c );
+
+            store( pX + i, mul( r, c ) );
+            store( pY + i, mul( r, s ) );
+        }
+    };
+
+    template<typename V>
+    void unitFloats( const uint32_t * pIn, float * pOut, size_t count )
+    {
+        UnitFloatKernel kernel = { pIn, pOut };
+        run<V>( count, kernel );
+    }
+
+    template<typename V, int P>
+    void mapToSphere( const float * pU1, const float * pU2,
+                      float * pX, float * pY, float * pZ, size_t count )
+    {
+        SphereKernel<P> kernel = { pU1, pU2, pX, pY, pZ };
+        run<V>( count, kernel );
+    }
+
+    template<typename V, int P>
+    void mapToDisk( const float * pU1, const float * pU2, float * pX, float * pY, size_t count )
+    {
+        DiskKernel<P> kernel = { pU1, pU2, pX, pY };
+        run<V>( count, kernel );
+    }
+
+    /**
+     * Builds the kernel table for lane type V.
+     */
+    template<typename V>
+    BatchKernels makeBatchKernels( Math::InstructionSet isa )
+    {
+        using namespace Math::fast::detail;
+        const int P = MATH_FAST_PRECISION;
+        typedef typename DoubleLanes<V>::type D;
+        typedef typename IntLanes<V>::type I;
+
+        BatchKernels kernels;
+
+        kernels.isa                 = isa;
+        kernels.transformPoints     = &transformPoints<V>;
+        kernels.transformDirections = &transformDirections<V>;
+        kernels.transform           = &Transform4<V>::run;
+        kernels.dot                 = &dot<V>;
+        kernels.cross               = &cross<V>;
+        kernels.length              = &length<V>;
+        kernels.normalize           = &normalize<V>;
+        kernels.scaleAdd            = &scaleAdd<V>;
+        kernels.dotDouble           = &dot<D>;
+        kernels.crossDouble         = &cross<D>;
+        kernels.lengthDouble        = &length<D>;
+        kernels.normalizeDouble     = &normalize<D>;
+        kernels.scaleAddDouble      = &scaleAdd<D>;
+        kernels.dotInt              = &dot<I>;
+        kernels.crossInt            = &cross<I>;
+        kernels.scaleAddInt         = &scaleAdd<I>;
+        kernels.splitDouble         = &splitDouble<D>;
+        kernels.rebase              = &rebase<V>;
+        kernels.rebaseDouble        = &rebaseDouble<D>;
+        kernels.sin                 = &stream< V, SinOp<P> >;
+        kernels.cos                 = &stream< V, CosOp<P> >;
+        kernels.exp                 = &stream< V, ExpOp<P> >;
+        kernels.log                 = &stream< V, LogOp<P> >;
+        kernels.sqrt                = &stream< V, SqrtOp<P> >;
+        kernels.rsqrt               = &stream< V, RsqrtOp<P> >;
+        kernels.packHalf            = &packHalf<V>;
+        kernels.unpackHalf          = &unpackHalf<V>;
+        kernels.packBFloat16        = &packBFloat16<V>;
+        kernels.unpackBFloat16      = &unpackBFloat16<V>;
+        kernels.packSnorm16         = &packSnorm16<V>;
+        kernels.unpackSnorm16       = &unpackSnorm16<V>;
+        kernels.packOctahedral      = &packOctahedral<V>;
+        kernels.unpackOctahedral    = &unpackOctahedral<V>;
+        kernels.packQuaternion      = &packQuaternion<V>;
+        kernels.unpackQuaternion    = &unpackQuaternion<V>;
+        kernels.unitFloats          = &unitFloats<V>;
+        kernels.mapToSphere         = &mapToSphere<V, P>;
+        kernels.mapToDisk           = &mapToDisk<V, P>;
+
+        return kernels;
+    }
+}
+
+#endif
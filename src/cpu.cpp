@@ -0,0 +1,317 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/cpu.h>
+#include "dispatch.h"
+
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#   define MATH_X86
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+using namespace Math;
+using namespace Math::detail;
+
+namespace
+{
+    const char * const InstructionSetNames[] =
+    {
+        "scalar", "sse2", "sse4.1", "avx2", "avx512"
+    };
+
+    const int InstructionSetCount = 5;
+
+    // Selected kernel table, null until the first batch call
+    std::atomic<const BatchKernels *> gActiveKernels( NULL );
+
+#ifdef MATH_X86
+    void cpuid( unsigned int leaf, unsigned int subleaf, unsigned int regs[4] )
+    {
+#if defined(_MSC_VER)
+        int r[4];
+        __cpuidex( r, static_cast<int>( leaf ), static_cast<int>( subleaf ) );
+
+        for ( int i = 0; i < 4; ++i )
+        {
+            regs[i] = static_cast<unsigned int>( r[i] );
+        }
+#else
+        __cpuid_count( leaf, subleaf, regs[0], regs[1], regs[2], regs[3] );
+#endif
+    }
+
+    /**
+     * Reads the XCR0 register, which tells which register files the
+     * operating system saves on context switches.
+     */
+    uint64_t xgetbv0()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv( 0 );
+#else
+        unsigned int lo, hi;
+        __asm__ __volatile__( "xgetbv" : "=a"( lo ), "=d"( hi ) : "c"( 0 ) );
+        return ( static_cast<uint64_t>( hi ) << 32 ) | lo;
+#endif
+    }
+
+    bool hasBit( unsigned int reg, int bit )
+    {
+        return ( reg & ( 1u << bit ) ) != 0;
+    }
+
+    InstructionSet queryCpu()
+    {
+        unsigned int regs[4];
+        cpuid( 0, 0, regs );
+
+        unsigned int maxLeaf = regs[0];
+        InstructionSet isa = ISA_SCALAR;
+
+        if ( maxLeaf < 1 )
+        {
+            return isa;
+        }
+
+        cpuid( 1, 0, regs );
+        unsigned int ecx1 = regs[2], edx1 = regs[3];
+
+        if ( !hasBit( edx1, 26 ) )
+        {
+            return isa;
+        }
+
+        isa = ISA_SSE2;
+
+        if ( !hasBit( ecx1, 19 ) )
+        {
+            return isa;
+        }
+
+        isa = ISA_SSE41;
+
+        // AVX needs OS support for saving the YMM registers (XCR0 bits 1, 2).
+        // The AVX2 level also uses FMA and F16C, which every AVX2 part has
+        if ( !hasBit( ecx1, 27 ) || !hasBit( ecx1, 28 ) || !hasBit( ecx1, 12 ) ||
+             !hasBit( ecx1, 29 ) || maxLeaf < 7 )
+        {
+            return isa;
+        }
+
+        uint64_t xcr0 = xgetbv0();
+
+        if ( ( xcr0 & 0x6 ) != 0x6 )
+        {
+            return isa;
+        }
+
+        cpuid( 7, 0, regs );
+        unsigned int ebx7 = regs[1];
+
+        if ( !hasBit( ebx7, 5 ) )
+        {
+            return isa;
+        }
+
+        isa = ISA_AVX2;
+
+        // AVX-512F also needs the opmask and ZMM state (XCR0 bits 5, 6, 7)
+        if ( hasBit( ebx7, 16 ) && ( xcr0 & 0xe6 ) == 0xe6 )
+        {
+            isa = ISA_AVX512;
+        }
+
+        return isa;
+    }
+#else
+    InstructionSet queryCpu()
+    {
+        return ISA_SCALAR;
+    }
+#endif
+
+    /**
+     * Returns the best compiled kernel table at or below the given level.
+     */
+    const BatchKernels * kernelsAtOrBelow( InstructionSet isa )
+    {
+        InstructionSet detected = Math::detectInstructionSet();
+
+        if ( isa > detected )
+        {
+            isa = detected;
+        }
+
+        for ( int level = isa; level >= ISA_SCALAR; --level )
+        {
+            const BatchKernels * pKernels =
+                batchKernelsFor( static_cast<InstructionSet>( level ) );
+
+            if ( pKernels != NULL )
+            {
+                return pKernels;
+            }
+        }
+
+        return batchKernelsScalar();
+    }
+
+    /**
+     * Selects the best kernels, lowered to the level named by SMATH_ISA if
+     * it is set.
+     */
+    const BatchKernels * selectDefault()
+    {
+        InstructionSet isa = ISA_AVX512;
+        const char * pOverride = std::getenv( "SMATH_ISA" );
+
+        if ( pOverride != NULL && pOverride[0] != '\0' )
+        {
+            Math::parseInstructionSet( pOverride, isa );
+        }
+
+        return kernelsAtOrBelow( isa );
+    }
+}
+
+Math::InstructionSet Math::detectInstructionSet()
+{
+    static const InstructionSet detected = queryCpu();
+    return detected;
+}
+
+Math::InstructionSet Math::compiledInstructionSet()
+{
+    for ( int level = InstructionSetCount - 1; level > ISA_SCALAR; --level )
+    {
+        if ( batchKernelsFor( static_cast<InstructionSet>( level ) ) != NULL )
+        {
+            return static_cast<InstructionSet>( level );
+        }
+    }
+
+    return ISA_SCALAR;
+}
+
+Math::InstructionSet Math::activeInstructionSet()
+{
+    return activeBatchKernels().isa;
+}
+
+Math::InstructionSet Math::setInstructionSet( InstructionSet isa )
+{
+    const BatchKernels * pKernels = kernelsAtOrBelow( isa );
+    gActiveKernels.store( pKernels, std::memory_order_release );
+
+    return pKernels->isa;
+}
+
+Math::InstructionSet Math::resetInstructionSet()
+{
+    const BatchKernels * pKernels = selectDefault();
+    gActiveKernels.store( pKernels, std::memory_order_release );
+
+    return pKernels->isa;
+}
+
+const char * Math::instructionSetName( InstructionSet isa )
+{
+    if ( isa < ISA_SCALAR || isa >= InstructionSetCount )
+    {
+        return "unknown";
+    }
+
+    return InstructionSetNames[isa];
+}
+
+bool Math::parseInstructionSet( const char * pName, InstructionSet& isa )
+{
+    if ( pName == NULL )
+    {
+        return false;
+    }
+
+    // Lower case copy without the dot, so "SSE4.1" and "sse41" both match
+    char name[16];
+    size_t length = 0;
+
+    for ( ; *pName != '\0' && length + 1 < sizeof( name ); ++pName )
+    {
+        if ( *pName != '.' )
+        {
+            name[length++] = static_cast<char>(
+                std::tolower( static_cast<unsigned char>( *pName ) ) );
+        }
+    }
+
+    name[length] = '\0';
+
+    for ( int level = 0; level < InstructionSetCount; ++level )
+    {
+        char candidate[16];
+        size_t j = 0;
+
+        for ( const char * p = InstructionSetNames[level]; *p != '\0'; ++p )
+        {
+            if ( *p != '.' )
+            {
+                candidate[j++] = *p;
+            }
+        }
+
+        candidate[j] = '\0';
+
+        if ( std::strcmp( name, candidate ) == 0 )
+        {
+            isa = static_cast<InstructionSet>( level );
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Returns the selected kernel table. Two threads racing on the first call
+ * both select the same table, so the race is benign.
+ */
+const BatchKernels& Math::detail::activeBatchKernels()
+{
+    const BatchKernels * pKernels = gActiveKernels.load( std::memory_order_acquire );
+
+    if ( pKernels == NULL )
+    {
+        pKernels = selectDefault();
+
+        const BatchKernels * pExpected = NULL;
+
+        if ( !gActiveKernels.compare_exchange_strong( pExpected, pKernels ) )
+        {
+            pKernels = pExpected;
+        }
+    }
+
+    return *pKernels;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_DISPATCH_H
+#define SCOTT_MATH_DISPATCH_H
+
+//
+// Internal: the table of batch kernels that is compiled once per instruction
+// set level and selected at runtime. Not installed.
+//
+#include <smath/config.h>
+#include <smath/cpu.h>
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace Math
+{
+namespace detail
+{
+    /**
+     * Batch kernels for one instruction set level. Vectors are passed as
+     * interleaved float arrays and matrices as 16 row major floats, so the
+     * per level translation units never instantiate the vector and matrix
+     * templates.
+     */
+    struct BatchKernels
+    {
+        InstructionSet isa;
+
+        void (*transformPoints)( const float * pMatrix, const float * pIn, float * pOut, size_t count );
+        void (*transformDirections)( const float * pMatrix, const float * pIn, float * pOut, size_t count );
+        void (*transform)( const float * pMatrix, const float * pIn, float * pOut, size_t count );
+
+        void (*dot)( const float * pA, const float * pB, float * pOut, size_t count );
+        void (*cross)( const float * pA, const float * pB, float * pOut, size_t count );
+        void (*length)( const float * pIn, float * pOut, size_t count );
+        void (*normalize)( const float * pIn, float * pOut, size_t count );
+        void (*scaleAdd)( const float * pA, const float * pB, float scale, float * pOut, size_t count );
+
+        void (*dotDouble)( const double * pA, const double * pB, double * pOut, size_t count );
+        void (*crossDouble)( const double * pA, const double * pB, double * pOut, size_t count );
+        void (*lengthDouble)( const double * pIn, double * pOut, size_t count );
+        void (*normalizeDouble)( const double * pIn, double * pOut, size_t count );
+        void (*scaleAddDouble)( const double * pA, const double * pB, double scale, double * pOut, size_t count );
+
+        void (*dotInt)( const int32_t * pA, const int32_t * pB, int32_t * pOut, size_t count );
+        void (*crossInt)( const int32_t * pA, const int32_t * pB, int32_t * pOut, size_t count );
+        void (*scaleAddInt)( const int32_t * pA, const int32_t * pB, int32_t scale, int32_t * pOut, size_t count );
+
+        void (*splitDouble)( const double * pIn, float * pHigh, float * pLow, size_t count );
+        void (*rebase)( const float * pHigh, const float * pLow, const float * pOrigin, float * pOut, size_t count );
+        void (*rebaseDouble)( const double * pIn, const double * pOrigin, float * pOut, size_t count );
+
+        void (*sin)( float * pOut, const float * pIn, size_t count );
+        void (*cos)( float * pOut, const float * pIn, size_t count );
+        void (*exp)( float * pOut, const float * pIn, size_t count );
+        void (*log)( float * pOut, const float * pIn, size_t count );
+        void (*sqrt)( float * pOut, const float * pIn, size_t count );
+        void (*rsqrt)( float * pOut, const float * pIn, size_t count );
+
+        void (*packHalf)( const float * pIn, uint16_t * pOut, size_t count );
+        void (*unpackHalf)( const uint16_t * pIn, float * pOut, size_t count );
+        void (*packBFloat16)( const float * pIn, uint16_t * pOut, size_t count );
+        void (*unpackBFloat16)( const uint16_t * pIn, float * pOut, size_t count );
+        void (*packSnorm16)( const float * pIn, float scale, uint16_t * pOut, size_t count );
+        void (*unpackSnorm16)( const uint16_t * pIn, float scale, float * pOut, size_t count );
+        void (*packOctahedral)( const float * pIn, uint16_t * pOut, size_t count );
+        void (*unpackOctahedral)( const uint16_t * pIn, float * pOut, size_t count );
+        void (*packQuaternion)( const float * pIn, uint16_t * pOut, size_t count );
+        void (*unpackQuaternion)( const uint16_t * pIn, float * pOut, size_t count );
+
+        void (*unitFloats)( const uint32_t * pIn, float * pOut, size_t count );
+        void (*mapToSphere)( const float * pU1, const float * pU2, float * pX, float * pY, float * pZ, size_t count );
+        void (*mapToDisk)( const float * pU1, const float * pU2, float * pX, float * pY, size_t count );
+    };
+
+    /**
+     * Per level kernel tables, each defined in a translation unit compiled
+     * for that level.
+     */
+    const BatchKernels * batchKernelsScalar();
+    const BatchKernels * batchKernelsSse2();
+    const BatchKernels * batchKernelsSse41();
+    const BatchKernels * batchKernelsAvx2();
+    const BatchKernels * batchKernelsAvx512();
+
+    /**
+     * Returns the kernel table compiled for an instruction set level, or
+     * null if this build has no kernels for that level.
+     */
+    const BatchKernels * batchKernelsFor( InstructionSet isa );
+
+    /**
+     * Returns the kernel table selected for the running CPU, selecting it
+     * on first use.
+     */
+    const BatchKernels& activeBatchKernels();
+}
+}
+
+#endif
@@ -15,27 +15,15 @@
  */
 #include <smath/util.h>
 #include <smath/config.h>
+#include <smath/fastmath.h>
 
 /**
  * Calculate the square root of a value using a fast approximation method.
  *
- * Credit for the original implementation of fastSqrt goes to the Quake III
- * arena source code. More information about this can be read on Wikipedia:
- *   http://en.wikipedia.org/wiki/Fast_inverse_square_root
+ * Uses the hardware reciprocal square root estimate refined with one
+ * Newton-Raphson step, see Math::fast::sqrt.
  */
 float Math::fastSqrt( float v )
 {
-    long i;
-    float x2, y;
-    const float threehalfs = 1.5f;
-
-    x2 = v * 0.5f;
-    y  = v;
-    i  = *( long *) &y;             // evil floating point bit level hack
-    i  = 0x5f3759df - ( i >> 1 );   // seriously, wtf
-    y  = *( float *) &i;            // more magic
-    y  = y * (threehalfs - (x2 * y * y));   // 1st iteration
-//  y  = y * (threehalfs - (x2 * y * y));   // 2nd itr, can be removed
-
-    return y;
+    return Math::fast::sqrt( v );
 }
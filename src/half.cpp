@@ -0,0 +1,63 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/half.h>
+#include "dispatch.h"
+
+// The batch conversions treat 16 bit values and vectors of them as flat
+// arrays of words
+static_assert( sizeof( Math::half ) == sizeof( uint16_t ), "half must be one word" );
+static_assert( sizeof( Math::bfloat16 ) == sizeof( uint16_t ), "bfloat16 must be one word" );
+static_assert( sizeof( TVector3<Math::half> ) == 3 * sizeof( uint16_t ),
+               "TVector3<half> must be three packed words" );
+static_assert( sizeof( TVector4<Math::bfloat16> ) == 4 * sizeof( uint16_t ),
+               "TVector4<bfloat16> must be four packed words" );
+
+using namespace Math::detail;
+
+namespace
+{
+    template<typename T>
+    const uint16_t * words( const T * p )
+    {
+        return reinterpret_cast<const uint16_t *>( p );
+    }
+
+    template<typename T>
+    uint16_t * words( T * p )
+    {
+        return reinterpret_cast<uint16_t *>( p );
+    }
+}
+
+void Math::batch::convert( const float * pIn, half * pOut, size_t count )
+{
+    activeBatchKernels().packHalf( pIn, words( pOut ), count );
+}
+
+void Math::batch::convert( const half * pIn, float * pOut, size_t count )
+{
+    activeBatchKernels().unpackHalf( words( pIn ), pOut, count );
+}
+
+void Math::batch::convert( const float * pIn, bfloat16 * pOut, size_t count )
+{
+    activeBatchKernels().packBFloat16( pIn, words( pOut ), count );
+}
+
+void Math::batch::convert( const bfloat16 * pIn, float * pOut, size_t count )
+{
+    activeBatchKernels().unpackBFloat16( words( pIn ), pOut, count );
+}
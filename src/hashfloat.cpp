@@ -15,34 +15,199 @@
  */
 #include <smath/util.h>
 #include <smath/config.h>
+#include <smath/hash.h>
+#include <smath/simd.h>
+
+#include <cstring>
+
+using namespace Math::detail;
+
+namespace
+{
+    /**
+     * Maps -0 to +0 and any NaN to the canonical quiet NaN, one lane at a
+     * time.
+     */
+    template<typename V>
+    V canonicalize( V v )
+    {
+        using namespace Math::simd;
+
+        V zero = splat<V>( 0.0f );
+        V nan  = splat<V>( asFloat( 0x7fc00000 ) );
+
+        v = select( equal( v, zero ), zero, v );
+        return select( equal( v, v ), v, nan );
+    }
+
+    /**
+     * Writes the canonical bits of eight floats to pOut.
+     */
+    void canonicalize8( const float * pIn, uint64_t pOut[4] )
+    {
+        float values[8];
+
+#if defined(MATH_AVX2)
+        Math::simd::store( values,     canonicalize( Math::simd::load<__m256>( pIn ) ) );
+#elif defined(MATH_SSE2)
+        Math::simd::store( values,     canonicalize( Math::simd::load<__m128>( pIn ) ) );
+        Math::simd::store( values + 4, canonicalize( Math::simd::load<__m128>( pIn + 4 ) ) );
+#else
+        for ( int i = 0; i < 8; ++i )
+        {
+            values[i] = canonicalize( pIn[i] );
+        }
+#endif
+
+        std::memcpy( pOut, values, sizeof( values ) );
+    }
+}
 
 /**
- * Computes a 32 bit hash from a floating point value. This is used to
- * quickly cache floats into a hashmap, but care must be taken since two
- * seemingly identical floating point values can have different memory values
- * and hence different hash values
+ * Hashes the array in blocks of eight floats, using two independent
+ * accumulators so the multiplies of consecutive blocks can overlap. The
+ * final partial block is zero padded; the byte count mixed in by hashFinish
+ * keeps padded and unpadded inputs distinct.
  */
-inline unsigned int hashfloat( float value )
+uint64_t Math::hash( const float * pValues, size_t count, uint64_t seed )
 {
-    const unsigned int *intPtr =
-        reinterpret_cast<unsigned int *>( &value );
-    return *intPtr;
+    uint64_t see0 = seed ^ HashSecret0;
+    uint64_t see1 = see0;
+    size_t i = 0;
+
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        uint64_t w[4];
+        canonicalize8( pValues + i, w );
+
+        see0 = mum( w[0] ^ HashSecret1, w[1] ^ see0 );
+        see1 = mum( w[2] ^ HashSecret2, w[3] ^ see1 );
+    }
+
+    if ( count >= 8 )
+    {
+        see0 ^= see1;
+    }
+
+    // Remaining zero to seven values
+    uint32_t tail[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    size_t remaining = count - i;
+
+    for ( size_t j = 0; j < remaining; ++j )
+    {
+        tail[j] = canonicalBits( pValues[i + j] );
+    }
+
+    uint64_t w[4];
+    std::memcpy( w, tail, sizeof( w ) );
+
+    if ( remaining > 4 )
+    {
+        see0 = mum( w[0] ^ HashSecret1, w[1] ^ see0 );
+        return hashFinish( w[2], w[3], see0, count * sizeof( float ) );
+    }
+    else
+    {
+        return hashFinish( w[0], w[1], see0, count * sizeof( float ) );
+    }
 }
 
 /**
- * Computes an unsigned 32 bit hash value from an array of floating
- * point values.
+ * Same block structure as the float version, four doubles at a time.
+ */
+uint64_t Math::hash( const double * pValues, size_t count, uint64_t seed )
+{
+    uint64_t see0 = seed ^ HashSecret0;
+    uint64_t see1 = see0;
+    size_t i = 0;
+
+    for ( ; i + 4 <= count; i += 4 )
+    {
+        see0 = mum( canonicalBits( pValues[i] ) ^ HashSecret1,
+                    canonicalBits( pValues[i + 1] ) ^ see0 );
+        see1 = mum( canonicalBits( pValues[i + 2] ) ^ HashSecret2,
+                    canonicalBits( pValues[i + 3] ) ^ see1 );
+    }
+
+    if ( count >= 4 )
+    {
+        see0 ^= see1;
+    }
+
+    uint64_t w[4] = { 0, 0, 0, 0 };
+    size_t remaining = count - i;
+
+    for ( size_t j = 0; j < remaining; ++j )
+    {
+        w[j] = canonicalBits( pValues[i + j] );
+    }
+
+    if ( remaining > 2 )
+    {
+        see0 = mum( w[0] ^ HashSecret1, w[1] ^ see0 );
+        return hashFinish( w[2], w[3], see0, count * sizeof( double ) );
+    }
+    else
+    {
+        return hashFinish( w[0], w[1], see0, count * sizeof( double ) );
+    }
+}
+
+/**
+ * Same block structure as the float version, on the raw bits.
  */
-inline unsigned int hashfloat( const float * pArray, size_t arraySize )
+uint64_t Math::hash( const int32_t * pValues, size_t count, uint64_t seed )
 {
-    unsigned int hash             = 0u;
-    const unsigned int *pIntArray =
-        reinterpret_cast<const unsigned int*>( pArray );
+    uint64_t see0 = seed ^ HashSecret0;
+    uint64_t see1 = see0;
+    size_t i = 0;
+
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        uint64_t w[4];
+        std::memcpy( w, pValues + i, sizeof( w ) );
+
+        see0 = mum( w[0] ^ HashSecret1, w[1] ^ see0 );
+        see1 = mum( w[2] ^ HashSecret2, w[3] ^ see1 );
+    }
 
-    for ( size_t i = 0; i < arraySize; ++i )
+    if ( count >= 8 )
     {
-        hash ^= pIntArray[i];
+        see0 ^= see1;
     }
 
-    return hash;
+    int32_t tail[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    size_t remaining = count - i;
+
+    std::memcpy( tail, pValues + i, remaining * sizeof( int32_t ) );
+
+    uint64_t w[4];
+    std::memcpy( w, tail, sizeof( w ) );
+
+    if ( remaining > 4 )
+    {
+        see0 = mum( w[0] ^ HashSecret1, w[1] ^ see0 );
+        return hashFinish( w[2], w[3], see0, count * sizeof( int32_t ) );
+    }
+    else
+    {
+        return hashFinish( w[0], w[1], see0, count * sizeof( int32_t ) );
+    }
+}
+
+/**
+ * Computes a 32 bit hash from a floating point value, see Math::hash.
+ */
+unsigned int Math::hashfloat( float value )
+{
+    return Math::hash32( Math::hash( value ) );
+}
+
+/**
+ * Computes an unsigned 32 bit hash value from an array of floating
+ * point values, see Math::hash.
+ */
+unsigned int Math::hashfloat( const float * pArray, size_t arraySize )
+{
+    return Math::hash32( Math::hash( pArray, arraySize ) );
 }
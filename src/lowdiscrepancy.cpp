@@ -0,0 +1,479 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/lowdiscrepancy.h>
+#include <smath/random.h>
+#include <smath/sampling.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Math;
+
+static_assert( sizeof( TVector2<float> ) == 2 * sizeof( float ),
+               "Sobol batches require tightly packed TVector2<float>" );
+static_assert( sizeof( TVector3<float> ) == 3 * sizeof( float ),
+               "Sobol batches require tightly packed TVector3<float>" );
+
+namespace
+{
+    /**
+     * Converts a 32 bit fixed point fraction to a float in [0,1). Only the
+     * top 24 bits are kept so the result never rounds up to 1.
+     */
+    inline float toFloat( uint32_t fraction )
+    {
+        return static_cast<float>( fraction >> 8 ) * ( 1.0f / 16777216.0f );
+    }
+
+    inline uint32_t reverseBits( uint32_t x )
+    {
+        x = ( ( x >> 1 ) & 0x55555555u ) | ( ( x & 0x55555555u ) << 1 );
+        x = ( ( x >> 2 ) & 0x33333333u ) | ( ( x & 0x33333333u ) << 2 );
+        x = ( ( x >> 4 ) & 0x0f0f0f0fu ) | ( ( x & 0x0f0f0f0fu ) << 4 );
+#if defined(__GNUC__)
+        return __builtin_bswap32( x );
+#else
+        x = ( ( x >> 8 ) & 0x00ff00ffu ) | ( ( x & 0x00ff00ffu ) << 8 );
+        return ( x >> 16 ) | ( x << 16 );
+#endif
+    }
+
+    /**
+     * Number of trailing zero bits, index must not be zero.
+     */
+    inline int trailingZeros( uint32_t index )
+    {
+#if defined(__GNUC__)
+        return __builtin_ctz( index );
+#else
+        int count = 0;
+
+        while ( ( index & 1u ) == 0 )
+        {
+            index >>= 1;
+            ++count;
+        }
+
+        return count;
+#endif
+    }
+
+    /**
+     * Sobol direction numbers: for each dimension the 32 columns of its
+     * generator matrix, from the Joe-Kuo "new-joe-kuo-6.21201" table.
+     */
+    struct SobolMatrices
+    {
+        uint32_t v[SobolSequence::Dimensions][32];
+
+        SobolMatrices()
+        {
+            // First dimension is the van der Corput sequence
+            for ( int k = 0; k < 32; ++k )
+            {
+                v[0][k] = 1u << ( 31 - k );
+            }
+
+            // Then primitive polynomials of degree s with coefficients a
+            // and initial direction numbers m
+            const int Degree[] = { 1, 2 };
+            const uint32_t Coefficients[] = { 0, 1 };
+            const uint32_t Initial[][2] = { { 1, 0 }, { 1, 3 } };
+
+            for ( int d = 1; d < SobolSequence::Dimensions; ++d )
+            {
+                const int s = Degree[d - 1];
+                const uint32_t a = Coefficients[d - 1];
+                uint32_t * pV = v[d];
+
+                for ( int k = 0; k < s; ++k )
+                {
+                    pV[k] = Initial[d - 1][k] << ( 31 - k );
+                }
+
+                for ( int k = s; k < 32; ++k )
+                {
+                    pV[k] = pV[k - s] ^ ( pV[k - s] >> s );
+
+                    for ( int j = 1; j < s; ++j )
+                    {
+                        pV[k] ^= ( ( a >> ( s - 1 - j ) ) & 1u ) * pV[k - j];
+                    }
+                }
+            }
+        }
+    };
+
+    const SobolMatrices& sobolMatrices()
+    {
+        static const SobolMatrices matrices;
+        return matrices;
+    }
+
+    /**
+     * Burley's improved Laine-Karras permutation ("Practical Hash-based
+     * Owen Scrambling", 2020). Applied to bit reversed values it is a
+     * nested uniform (Owen) scramble: each bit is flipped based on a hash
+     * of the bits above it.
+     */
+    inline uint32_t laineKarras( uint32_t x, uint32_t seed )
+    {
+        x += seed;
+        x ^= x * 0x6c50b47cu;
+        x ^= x * 0xb82f1e52u;
+        x ^= x * 0xc7afe638u;
+        x ^= x * 0x8d22f6e6u;
+        return x;
+    }
+
+    // Digits needed to resolve the 24 bits of a float in each base, the
+    // later digits of an index move the point by less than 2^-24
+    const int Base3Digits = 16;
+    const int Base5Digits = 11;
+
+    // Kronecker sequence steps in 32 bit fixed point: inverse powers of the
+    // plastic number for R2, and of the root of x^4 = x + 1 for R3
+    const uint32_t R2Alpha[2] = { 0xc13fa9a9u, 0x91e10da6u };
+    const uint32_t R3Alpha[3] = { 0xd1b54a33u, 0xabc98389u, 0x8cb92ba7u };
+
+    /**
+     * Radical inverse with every digit passed through the permutation,
+     * including the zeros beyond the last digit of the index. Only the
+     * Digits lowest digits are kept, enough to resolve a float, so the
+     * mirrored digits fit in an integer; with the base a template parameter
+     * the loop has a fixed trip count and its divisions are multiplications.
+     */
+    template<uint32_t Base, int Digits>
+    float scrambledInverse( uint32_t index, const uint8_t * pPermutation )
+    {
+        uint32_t reversed = 0;
+        uint32_t scale = 1;
+
+        for ( int i = 0; i < Digits; ++i )
+        {
+            reversed = reversed * Base + pPermutation[ index % Base ];
+            index /= Base;
+            scale *= Base;
+        }
+
+        const float value = static_cast<float>( static_cast<double>( reversed ) / scale );
+        return std::min( value, 1.0f - 1.0f / 16777216.0f );
+    }
+
+    /**
+     * Owen scrambles a block of Sobol values in place. Kept apart from the
+     * serial Gray code walk so the loop vectorizes.
+     */
+    void scrambleBlock( uint32_t * pValues, size_t count, uint32_t seed )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            pValues[i] = reverseBits( laineKarras( reverseBits( pValues[i] ), seed ) );
+        }
+    }
+
+    /**
+     * Converts a block of fixed point values to floats, writing every
+     * stride-th float of pOut.
+     */
+    void storeBlock( const uint32_t * pValues, size_t count, float * pOut, size_t stride )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            pOut[i * stride] = toFloat( pValues[i] );
+        }
+    }
+
+    // Points generated per block in SobolSequence::generate
+    const size_t SobolBlock = 64;
+
+    inline uint32_t toFixed( float fraction )
+    {
+        const double wrapped = fraction - std::floor( fraction );
+        return static_cast<uint32_t>( static_cast<uint64_t>( wrapped * 4294967296.0 ) );
+    }
+}
+
+float Math::radicalInverse2( uint32_t index )
+{
+    return toFloat( reverseBits( index ) );
+}
+
+float Math::radicalInverse( uint32_t index, uint32_t base )
+{
+    SMATH_ASSERT( base >= 2, "Radical inverse needs a base of at least two" );
+
+    if ( base == 2 )
+    {
+        return radicalInverse2( index );
+    }
+
+    const double invBase = 1.0 / base;
+    double scale = invBase;
+    double value = 0.0;
+
+    while ( index > 0 )
+    {
+        value += ( index % base ) * scale;
+        index /= base;
+        scale *= invBase;
+    }
+
+    // Never round up to one
+    return std::min( static_cast<float>( value ), 1.0f - 1.0f / 16777216.0f );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Halton
+/////////////////////////////////////////////////////////////////////////////
+
+HaltonSequence::HaltonSequence( uint32_t seed )
+    : mScramble2( 0 )
+{
+    for ( uint8_t i = 0; i < 3; ++i )
+    {
+        mPermutation3[i] = i;
+    }
+
+    for ( uint8_t i = 0; i < 5; ++i )
+    {
+        mPermutation5[i] = i;
+    }
+
+    if ( seed != 0 )
+    {
+        SmallRandom random( seed );
+
+        mScramble2 = random.nextUInt();
+        Math::shuffle( mPermutation3, mPermutation3 + 3, random );
+        Math::shuffle( mPermutation5, mPermutation5 + 5, random );
+    }
+}
+
+TVector2<float> HaltonSequence::point2( uint32_t index ) const
+{
+    return TVector2<float>( toFloat( reverseBits( index ) ^ mScramble2 ),
+                            scrambledInverse<3, Base3Digits>( index, mPermutation3 ) );
+}
+
+TVector3<float> HaltonSequence::point3( uint32_t index ) const
+{
+    return TVector3<float>( toFloat( reverseBits( index ) ^ mScramble2 ),
+                            scrambledInverse<3, Base3Digits>( index, mPermutation3 ),
+                            scrambledInverse<5, Base5Digits>( index, mPermutation5 ) );
+}
+
+void HaltonSequence::generate( uint32_t first, TVector2<float> * pOut, size_t count ) const
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        pOut[i] = point2( first + static_cast<uint32_t>( i ) );
+    }
+}
+
+void HaltonSequence::generate( uint32_t first, TVector3<float> * pOut, size_t count ) const
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        pOut[i] = point3( first + static_cast<uint32_t>( i ) );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Sobol
+/////////////////////////////////////////////////////////////////////////////
+
+const int SobolSequence::Dimensions;
+
+SobolSequence::SobolSequence( uint32_t seed )
+    : mSeeds()
+{
+    if ( seed != 0 )
+    {
+        // Independent seeds per dimension so the scrambles are uncorrelated
+        SplitMix64 expander( seed );
+
+        for ( int d = 0; d < Dimensions; ++d )
+        {
+            mSeeds[d] = expander.next();
+        }
+    }
+}
+
+uint32_t SobolSequence::scramble( uint32_t value, int dimension ) const
+{
+    if ( mSeeds[dimension] == 0 )
+    {
+        return value;
+    }
+
+    return reverseBits( laineKarras( reverseBits( value ), mSeeds[dimension] ) );
+}
+
+uint32_t SobolSequence::sample( uint32_t index, int dimension ) const
+{
+    SMATH_ASSERT( dimension >= 0 && dimension < Dimensions, "Sobol dimension out of range" );
+
+    const uint32_t * pV = sobolMatrices().v[dimension];
+    uint32_t gray = index ^ ( index >> 1 );
+    uint32_t value = 0;
+
+    // Masked rather than branching, the bits of the index are unpredictable
+    for ( int k = 0; gray != 0; ++k, gray >>= 1 )
+    {
+        value ^= pV[k] & ( 0u - ( gray & 1u ) );
+    }
+
+    return scramble( value, dimension );
+}
+
+TVector2<float> SobolSequence::point2( uint32_t index ) const
+{
+    return TVector2<float>( toFloat( sample( index, 0 ) ), toFloat( sample( index, 1 ) ) );
+}
+
+TVector3<float> SobolSequence::point3( uint32_t index ) const
+{
+    return TVector3<float>( toFloat( sample( index, 0 ) ),
+                            toFloat( sample( index, 1 ) ),
+                            toFloat( sample( index, 2 ) ) );
+}
+
+void SobolSequence::generate( uint32_t first, TVector2<float> * pOut, size_t count ) const
+{
+    generate( first, reinterpret_cast<float *>( pOut ), 2, count );
+}
+
+void SobolSequence::generate( uint32_t first, TVector3<float> * pOut, size_t count ) const
+{
+    generate( first, reinterpret_cast<float *>( pOut ), 3, count );
+}
+
+/**
+ * Writes count points of the first dimensions coordinates each, with pOut
+ * advancing by dimensions floats per point. Points are produced in blocks:
+ * the unscrambled values are found with one XOR per coordinate walking the
+ * Gray code, then scrambled and converted a whole block at a time.
+ */
+void SobolSequence::generate( uint32_t first, float * pOut, int dimensions, size_t count ) const
+{
+    const SobolMatrices& matrices = sobolMatrices();
+    uint32_t values[Dimensions][SobolBlock];
+    uint32_t current[Dimensions];
+
+    for ( int d = 0; d < dimensions; ++d )
+    {
+        const uint32_t gray = first ^ ( first >> 1 );
+        current[d] = 0;
+
+        for ( int k = 0; k < 32; ++k )
+        {
+            if ( gray & ( 1u << k ) )
+            {
+                current[d] ^= matrices.v[d][k];
+            }
+        }
+    }
+
+    for ( size_t done = 0; done < count; )
+    {
+        const size_t block = std::min( count - done, SobolBlock );
+
+        for ( int d = 0; d < dimensions; ++d )
+        {
+            const uint32_t * pV = matrices.v[d];
+            uint32_t * pValues  = values[d];
+            uint32_t value      = current[d];
+            uint32_t index      = first + static_cast<uint32_t>( done );
+
+            // Each step flips the column of the lowest set bit of the next index
+            pValues[0] = value;
+
+            for ( size_t i = 1; i < block; ++i )
+            {
+                value ^= pV[ trailingZeros( ++index ) ];
+                pValues[i] = value;
+            }
+
+            // Step to the first point of the next block
+            if ( ++index != 0 )
+            {
+                current[d] = value ^ pV[ trailingZeros( index ) ];
+            }
+
+            if ( mSeeds[d] != 0 )
+            {
+                scrambleBlock( pValues, block, mSeeds[d] );
+            }
+
+            storeBlock( pValues, block, pOut + done * dimensions + d, dimensions );
+        }
+
+        done += block;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Kronecker
+/////////////////////////////////////////////////////////////////////////////
+
+KroneckerSequence::KroneckerSequence( float offset )
+{
+    mOffset[0] = mOffset[1] = mOffset[2] = toFixed( offset );
+}
+
+KroneckerSequence::KroneckerSequence( const TVector3<float>& offset )
+{
+    mOffset[0] = toFixed( offset.x() );
+    mOffset[1] = toFixed( offset.y() );
+    mOffset[2] = toFixed( offset.z() );
+}
+
+TVector2<float> KroneckerSequence::point2( uint32_t index ) const
+{
+    return TVector2<float>( toFloat( mOffset[0] + index * R2Alpha[0] ),
+                            toFloat( mOffset[1] + index * R2Alpha[1] ) );
+}
+
+TVector3<float> KroneckerSequence::point3( uint32_t index ) const
+{
+    return TVector3<float>( toFloat( mOffset[0] + index * R3Alpha[0] ),
+                            toFloat( mOffset[1] + index * R3Alpha[1] ),
+                            toFloat( mOffset[2] + index * R3Alpha[2] ) );
+}
+
+void KroneckerSequence::generate( uint32_t first, TVector2<float> * pOut, size_t count ) const
+{
+    uint32_t x = mOffset[0] + first * R2Alpha[0];
+    uint32_t y = mOffset[1] + first * R2Alpha[1];
+
+    for ( size_t i = 0; i < count; ++i, x += R2Alpha[0], y += R2Alpha[1] )
+    {
+        pOut[i] = TVector2<float>( toFloat( x ), toFloat( y ) );
+    }
+}
+
+void KroneckerSequence::generate( uint32_t first, TVector3<float> * pOut, size_t count ) const
+{
+    uint32_t x = mOffset[0] + first * R3Alpha[0];
+    uint32_t y = mOffset[1] + first * R3Alpha[1];
+    uint32_t z = mOffset[2] + first * R3Alpha[2];
+
+    for ( size_t i = 0; i < count; ++i, x += R3Alpha[0], y += R3Alpha[1], z += R3Alpha[2] )
+    {
+        pOut[i] = TVector3<float>( toFloat( x ), toFloat( y ), toFloat( z ) );
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/memory.h>
+
+#include <cstdlib>
+#include <stdint.h>
+#include <utility>
+
+#if defined(_WIN32)
+#   include <malloc.h>
+#endif
+
+using namespace Math;
+
+namespace
+{
+    /**
+     * Returns the number of bytes needed to round address up to alignment.
+     */
+    size_t paddingFor( const char * pAddress, size_t alignment )
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>( pAddress );
+        return static_cast<size_t>( ( alignment - ( address & ( alignment - 1 ) ) ) &
+                                    ( alignment - 1 ) );
+    }
+}
+
+void * Math::alignedAlloc( size_t bytes, size_t alignment )
+{
+    SMATH_ASSERT( alignment != 0 && ( alignment & ( alignment - 1 ) ) == 0,
+                  "Alignment must be a power of two" );
+
+    // posix_memalign needs at least pointer alignment
+    if ( alignment < sizeof( void * ) )
+    {
+        alignment = sizeof( void * );
+    }
+
+#if defined(_WIN32)
+    return _aligned_malloc( bytes, alignment );
+#else
+    void * pMemory = NULL;
+
+    if ( posix_memalign( &pMemory, alignment, bytes ) != 0 )
+    {
+        return NULL;
+    }
+
+    return pMemory;
+#endif
+}
+
+void Math::alignedFree( void * pMemory )
+{
+#if defined(_WIN32)
+    _aligned_free( pMemory );
+#else
+    std::free( pMemory );
+#endif
+}
+
+const size_t Arena::DefaultBlockSize;
+
+Arena::Arena( size_t blockSize )
+    : mBlocks(),
+      mBlockSize( blockSize > 0 ? blockSize : DefaultBlockSize ),
+      mBlock( 0 ),
+      mOffset( 0 ),
+      mUsed( 0 )
+{
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+void * Arena::allocate( size_t bytes, size_t alignment )
+{
+    SMATH_ASSERT( alignment != 0 && ( alignment & ( alignment - 1 ) ) == 0,
+                  "Alignment must be a power of two" );
+    SMATH_ASSERT( alignment <= CacheLineSize, "Arena alignment is at most a cache line" );
+
+    if ( mBlock < mBlocks.size() )
+    {
+        const Block& block = mBlocks[mBlock];
+        size_t padding = paddingFor( block.pData + mOffset, alignment );
+
+        if ( padding <= block.size - mOffset && bytes <= block.size - mOffset - padding )
+        {
+            char * pMemory = block.pData + mOffset + padding;
+
+            mOffset += padding + bytes;
+            mUsed   += padding + bytes;
+
+            return pMemory;
+        }
+    }
+
+    if ( !nextBlock( bytes ) )
+    {
+        return NULL;
+    }
+
+    // Blocks are cache line aligned, so the start of a block needs no padding
+    char * pMemory = mBlocks[mBlock].pData;
+
+    mOffset = bytes;
+    mUsed  += bytes;
+
+    return pMemory;
+}
+
+/**
+ * Makes the block after the current one (allocating it if needed) large
+ * enough for the request and moves to it. Smaller blocks that are skipped
+ * over stay in place for the next reset.
+ */
+bool Arena::nextBlock( size_t bytes )
+{
+    size_t next = mBlocks.empty() ? 0 : mBlock + 1;
+
+    for ( size_t i = next; i < mBlocks.size(); ++i )
+    {
+        if ( mBlocks[i].size >= bytes )
+        {
+            std::swap( mBlocks[i], mBlocks[next] );
+
+            mBlock  = next;
+            mOffset = 0;
+
+            return true;
+        }
+    }
+
+    Block block;
+    block.size  = bytes > mBlockSize ? bytes : mBlockSize;
+    block.pData = static_cast<char *>( alignedAlloc( block.size, CacheLineSize ) );
+
+    if ( block.pData == NULL )
+    {
+        return false;
+    }
+
+    mBlocks.insert( mBlocks.begin() + next, block );
+
+    mBlock  = next;
+    mOffset = 0;
+
+    return true;
+}
+
+Arena::Marker Arena::mark() const
+{
+    Marker marker = { mBlock, mOffset, mUsed };
+    return marker;
+}
+
+void Arena::rewind( const Marker& marker )
+{
+    SMATH_ASSERT( marker.used <= mUsed, "Arena marker is newer than the arena" );
+
+    mBlock  = marker.block;
+    mOffset = marker.offset;
+    mUsed   = marker.used;
+}
+
+void Arena::reset()
+{
+    mBlock  = 0;
+    mOffset = 0;
+    mUsed   = 0;
+}
+
+void Arena::release()
+{
+    for ( size_t i = 0; i < mBlocks.size(); ++i )
+    {
+        alignedFree( mBlocks[i].pData );
+    }
+
+    mBlocks.clear();
+    reset();
+}
+
+size_t Arena::bytesUsed() const
+{
+    return mUsed;
+}
+
+size_t Arena::capacity() const
+{
+    size_t total = 0;
+
+    for ( size_t i = 0; i < mBlocks.size(); ++i )
+    {
+        total += mBlocks[i].size;
+    }
+
+    return total;
+}
+
+Arena& Math::threadArena()
+{
+    static thread_local Arena arena;
+    return arena;
+}
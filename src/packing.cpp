@@ -0,0 +1,228 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/packing.h>
+#include "batchkernels.h"
+
+// The kernels treat vectors, quaternions and packed values as flat arrays
+static_assert( sizeof( TVector3<float> ) == 3 * sizeof( float ),
+               "TVector3<float> must be three packed floats" );
+static_assert( sizeof( TVector4<float> ) == 4 * sizeof( float ),
+               "TVector4<float> must be four packed floats" );
+static_assert( sizeof( TQuaternion<float> ) == 4 * sizeof( float ),
+               "TQuaternion<float> must be four packed floats" );
+static_assert( sizeof( Math::PackedNormal ) == 2 * sizeof( uint16_t ),
+               "PackedNormal must be two packed words" );
+static_assert( sizeof( Math::PackedQuaternion ) == 3 * sizeof( uint16_t ),
+               "PackedQuaternion must be three packed words" );
+
+using namespace Math::detail;
+
+namespace
+{
+    template<typename T>
+    const float * floats( const T * p )
+    {
+        return reinterpret_cast<const float *>( p );
+    }
+
+    template<typename T>
+    float * floats( T * p )
+    {
+        return reinterpret_cast<float *>( p );
+    }
+
+    template<typename T>
+    const uint16_t * words( const T * p )
+    {
+        return reinterpret_cast<const uint16_t *>( p );
+    }
+
+    template<typename T>
+    uint16_t * words( T * p )
+    {
+        return reinterpret_cast<uint16_t *>( p );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Single values, using the batch codecs with scalar lanes
+/////////////////////////////////////////////////////////////////////////////
+uint16_t Math::packHalf( float value )
+{
+    return static_cast<uint16_t>( encodeHalf( value ) );
+}
+
+float Math::unpackHalf( uint16_t bits )
+{
+    return decodeHalf<float>( bits );
+}
+
+uint16_t Math::packBFloat16( float value )
+{
+    return static_cast<uint16_t>( encodeBFloat16( value ) );
+}
+
+float Math::unpackBFloat16( uint16_t bits )
+{
+    return decodeBFloat16<float>( bits );
+}
+
+int16_t Math::packSnorm16( float value )
+{
+    return static_cast<int16_t>( static_cast<uint16_t>( encodeSnorm16( value ) ) );
+}
+
+float Math::unpackSnorm16( int16_t bits )
+{
+    return decodeSnorm16<float>( static_cast<uint16_t>( bits ) );
+}
+
+Math::PackedNormal Math::packOctahedral( const TVector3<float>& normal )
+{
+    int32_t u, v;
+    encodeOctahedral( normal[0], normal[1], normal[2], u, v );
+
+    PackedNormal packed = { { static_cast<uint16_t>( u ), static_cast<uint16_t>( v ) } };
+    return packed;
+}
+
+TVector3<float> Math::unpackOctahedral( const PackedNormal& packed )
+{
+    float x, y, z;
+    decodeOctahedral( packed.bits[0], packed.bits[1], x, y, z );
+
+    return TVector3<float>( x, y, z );
+}
+
+Math::PackedQuaternion Math::packQuaternion( const TQuaternion<float>& q )
+{
+    const float c[4] = { q[0], q[1], q[2], q[3] };
+    int32_t w[3];
+
+    encodeQuaternion( c, w );
+
+    PackedQuaternion packed = { { static_cast<uint16_t>( w[0] ),
+                                  static_cast<uint16_t>( w[1] ),
+                                  static_cast<uint16_t>( w[2] ) } };
+    return packed;
+}
+
+TQuaternion<float> Math::unpackQuaternion( const PackedQuaternion& packed )
+{
+    const int32_t w[3] = { packed.bits[0], packed.bits[1], packed.bits[2] };
+    float c[4];
+
+    decodeQuaternion( w, c );
+
+    return TQuaternion<float>( c[0], c[1], c[2], c[3] );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Batch entry points
+/////////////////////////////////////////////////////////////////////////////
+void Math::batch::packHalf( const float * pIn, uint16_t * pOut, size_t count )
+{
+    activeBatchKernels().packHalf( pIn, pOut, count );
+}
+
+void Math::batch::packHalf( const TVector3<float> * pIn, uint16_t * pOut, size_t count )
+{
+    activeBatchKernels().packHalf( floats( pIn ), pOut, 3 * count );
+}
+
+void Math::batch::packHalf( const TVector4<float> * pIn, uint16_t * pOut, size_t count )
+{
+    activeBatchKernels().packHalf( floats( pIn ), pOut, 4 * count );
+}
+
+void Math::batch::unpackHalf( const uint16_t * pIn, float * pOut, size_t count )
+{
+    activeBatchKernels().unpackHalf( pIn, pOut, count );
+}
+
+void Math::batch::unpackHalf( const uint16_t * pIn, TVector3<float> * pOut, size_t count )
+{
+    activeBatchKernels().unpackHalf( pIn, floats( pOut ), 3 * count );
+}
+
+void Math::batch::unpackHalf( const uint16_t * pIn, TVector4<float> * pOut, size_t count )
+{
+    activeBatchKernels().unpackHalf( pIn, floats( pOut ), 4 * count );
+}
+
+void Math::batch::packBFloat16( const float * pIn, uint16_t * pOut, size_t count )
+{
+    activeBatchKernels().packBFloat16( pIn, pOut, count );
+}
+
+void Math::batch::unpackBFloat16( const uint16_t * pIn, float * pOut, size_t count )
+{
+    activeBatchKernels().unpackBFloat16( pIn, pOut, count );
+}
+
+void Math::batch::packSnorm16( const float * pIn, int16_t * pOut, size_t count, float range )
+{
+    activeBatchKernels().packSnorm16( pIn, 1.0f / range, words( pOut ), count );
+}
+
+void Math::batch::packSnorm16( const TVector3<float> * pIn, int16_t * pOut, size_t count, float range )
+{
+    activeBatchKernels().packSnorm16( floats( pIn ), 1.0f / range, words( pOut ), 3 * count );
+}
+
+void Math::batch::packSnorm16( const TVector4<float> * pIn, int16_t * pOut, size_t count, float range )
+{
+    activeBatchKernels().packSnorm16( floats( pIn ), 1.0f / range, words( pOut ), 4 * count );
+}
+
+void Math::batch::unpackSnorm16( const int16_t * pIn, float * pOut, size_t count, float range )
+{
+    activeBatchKernels().unpackSnorm16( words( pIn ), range, pOut, count );
+}
+
+void Math::batch::unpackSnorm16( const int16_t * pIn, TVector3<float> * pOut, size_t count, float range )
+{
+    activeBatchKernels().unpackSnorm16( words( pIn ), range, floats( pOut ), 3 * count );
+}
+
+void Math::batch::unpackSnorm16( const int16_t * pIn, TVector4<float> * pOut, size_t count, float range )
+{
+    activeBatchKernels().unpackSnorm16( words( pIn ), range, floats( pOut ), 4 * count );
+}
+
+void Math::batch::packOctahedral( const TVector3<float> * pIn, PackedNormal * pOut, size_t count )
+{
+    activeBatchKernels().packOctahedral( floats( pIn ), words( pOut ), count );
+}
+
+void Math::batch::unpackOctahedral( const PackedNormal * pIn, TVector3<float> * pOut, size_t count )
+{
+    activeBatchKernels().unpackOctahedral( words( pIn ), floats( pOut ), count );
+}
+
+void Math::batch::packQuaternion( const TQuaternion<float> * pIn,
+                                  PackedQuaternion * pOut,
+                                  size_t count )
+{
+    activeBatchKernels().packQuaternion( floats( pIn ), words( pOut ), count );
+}
+
+void Math::batch::unpackQuaternion( const PackedQuaternion * pIn,
+                                    TQuaternion<float> * pOut,
+                                    size_t count )
+{
+    activeBatchKernels().unpackQuaternion( words( pIn ), floats( pOut ), count );
+}
@@ -0,0 +1,580 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/poissondisk.h>
+#include <smath/constants.h>
+#include <smath/fastmath.h>
+#include <smath/shapesampling.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdint.h>
+
+using namespace Math;
+
+namespace
+{
+    /// Grid cell that holds no point
+    const uint32_t EmptyCell = 0xffffffffu;
+
+    /**
+     * Rounds a / b towards negative infinity, b must be positive.
+     */
+    inline int floorDivide( int a, int b )
+    {
+        const int q = a / b;
+        return ( a % b != 0 && a < 0 ) ? q - 1 : q;
+    }
+
+    /**
+     * Returns the cell containing a coordinate, clamped to [0, count).
+     */
+    inline int cellOf( float offset, float invCellSize, int count )
+    {
+        const int cell = static_cast<int>( offset * invCellSize );
+        return std::min( std::max( cell, 0 ), count - 1 );
+    }
+
+    /**
+     * Number of cells along an axis of the given length, with cells no
+     * wider than maxCellSize so each holds at most one point.
+     */
+    inline int cellCount( float length, float maxCellSize )
+    {
+        return std::max( 1, static_cast<int>( std::ceil( length / maxCellSize ) ) );
+    }
+
+    /**
+     * Background grid of the 2D sampler. A periodic grid wraps around at
+     * its edges: points near one edge are checked against points near the
+     * opposite edge, as if the area were tiled.
+     */
+    class Grid2
+    {
+    public:
+        Grid2( const TVector2<float>& origin,
+               const TVector2<float>& size,
+               float radius,
+               bool periodic )
+            : mOriginX( origin.x() ),
+              mOriginY( origin.y() ),
+              mWidth( size.x() ),
+              mHeight( size.y() ),
+              mRadiusSquared( radius * radius ),
+              mColumns( cellCount( size.x(), radius * SqrtOneHalf ) ),
+              mRows( cellCount( size.y(), radius * SqrtOneHalf ) ),
+              mInvCellWidth( mColumns / size.x() ),
+              mInvCellHeight( mRows / size.y() ),
+              mPeriodic( periodic ),
+              mCells( static_cast<size_t>( mColumns ) * mRows, EmptyCell )
+        {
+            const int rangeX = static_cast<int>( std::ceil( radius * mInvCellWidth ) );
+            const int rangeY = static_cast<int>( std::ceil( radius * mInvCellHeight ) );
+
+            // Cells that can hold a point within the radius of anywhere in
+            // the centre cell, nearest first so conflicts are found early
+            for ( int dy = -rangeY; dy <= rangeY; ++dy )
+            {
+                for ( int dx = -rangeX; dx <= rangeX; ++dx )
+                {
+                    const float gapX = std::max( std::abs( dx ) - 1, 0 ) / mInvCellWidth;
+                    const float gapY = std::max( std::abs( dy ) - 1, 0 ) / mInvCellHeight;
+
+                    if ( gapX * gapX + gapY * gapY < mRadiusSquared )
+                    {
+                        Offset offset = { dx, dy, std::abs( dx ) + std::abs( dy ) };
+                        mNeighbours.push_back( offset );
+                    }
+                }
+            }
+
+            std::stable_sort( mNeighbours.begin(), mNeighbours.end(), nearer );
+        }
+
+        /**
+         * Moves a candidate into the grid's area, wrapping it around if the
+         * grid is periodic. Returns false if it lies outside a bounded grid.
+         */
+        bool place( float& x, float& y ) const
+        {
+            if ( mPeriodic )
+            {
+                x = wrap( x - mOriginX, mWidth ) + mOriginX;
+                y = wrap( y - mOriginY, mHeight ) + mOriginY;
+                return true;
+            }
+
+            return x >= mOriginX && x < mOriginX + mWidth &&
+                   y >= mOriginY && y < mOriginY + mHeight;
+        }
+
+        /**
+         * Returns true if no point lies within the radius of (x, y).
+         */
+        bool fits( float x, float y, const std::vector< TVector2<float> >& points ) const
+        {
+            const int cx = cellOf( x - mOriginX, mInvCellWidth, mColumns );
+            const int cy = cellOf( y - mOriginY, mInvCellHeight, mRows );
+
+            for ( size_t i = 0; i < mNeighbours.size(); ++i )
+            {
+                int column = cx + mNeighbours[i].dx;
+                int row    = cy + mNeighbours[i].dy;
+                float shiftX = 0.0f, shiftY = 0.0f;
+
+                if ( column < 0 || column >= mColumns || row < 0 || row >= mRows )
+                {
+                    if ( !mPeriodic )
+                    {
+                        continue;
+                    }
+
+                    const int turnsX = floorDivide( column, mColumns );
+                    const int turnsY = floorDivide( row, mRows );
+
+                    column -= turnsX * mColumns;
+                    row    -= turnsY * mRows;
+                    shiftX  = turnsX * mWidth;
+                    shiftY  = turnsY * mHeight;
+                }
+
+                const uint32_t index = mCells[ row * mColumns + column ];
+
+                if ( index != EmptyCell )
+                {
+                    const float ox = points[index].x() + shiftX - x;
+                    const float oy = points[index].y() + shiftY - y;
+
+                    if ( ox * ox + oy * oy < mRadiusSquared )
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void insert( float x, float y, uint32_t index )
+        {
+            const int cx = cellOf( x - mOriginX, mInvCellWidth, mColumns );
+            const int cy = cellOf( y - mOriginY, mInvCellHeight, mRows );
+
+            mCells[ cy * mColumns + cx ] = index;
+        }
+
+    private:
+        struct Offset
+        {
+            int dx, dy;
+            int distance;
+        };
+
+        static bool nearer( const Offset& a, const Offset& b )
+        {
+            return a.distance < b.distance;
+        }
+
+        /**
+         * Wraps an offset into [0, length).
+         */
+        static float wrap( float offset, float length )
+        {
+            offset -= length * std::floor( offset / length );
+            return offset < length ? offset : 0.0f;
+        }
+
+    private:
+        float mOriginX, mOriginY;
+        float mWidth, mHeight;
+        float mRadiusSquared;
+        int mColumns, mRows;
+        float mInvCellWidth, mInvCellHeight;
+        bool mPeriodic;
+        std::vector<uint32_t> mCells;
+        std::vector<Offset> mNeighbours;
+    };
+
+    /**
+     * Bridson's algorithm over a 2D grid. Starting from one random point,
+     * candidates are drawn around a random active point; the first that
+     * fits is added and becomes active, and a point whose candidates all
+     * fail is retired.
+     */
+    template<typename Engine>
+    void bridson2( Grid2& grid,
+                   const TVector2<float>& origin,
+                   const TVector2<float>& size,
+                   float radius,
+                   TRandom<Engine>& random,
+                   std::vector< TVector2<float> >& points,
+                   int attempts )
+    {
+        std::vector<uint32_t> active;
+
+        points.clear();
+
+        const float firstX = origin.x() + detail::unitFloat( random.nextUInt() ) * size.x();
+        const float firstY = origin.y() + detail::unitFloat( random.nextUInt() ) * size.y();
+
+        points.push_back( TVector2<float>( firstX, firstY ) );
+        grid.insert( firstX, firstY, 0 );
+        active.push_back( 0 );
+
+        while ( !active.empty() )
+        {
+            const uint32_t slot = random.nextUInt( static_cast<unsigned int>( active.size() - 1 ) );
+            const TVector2<float> center = points[ active[slot] ];
+            bool found = false;
+
+            for ( int attempt = 0; attempt < attempts && !found; ++attempt )
+            {
+                // Uniform in radius over [r, 2r), which favours candidates
+                // near the inner edge and packs the points more tightly
+                const float angle    = TwoPi * detail::unitFloat( random.nextUInt() );
+                const float distance = radius * ( 1.0f + detail::unitFloat( random.nextUInt() ) );
+                float s, c;
+
+                fast::sincos( angle, s, c );
+
+                float x = center.x() + c * distance;
+                float y = center.y() + s * distance;
+
+                if ( grid.place( x, y ) && grid.fits( x, y, points ) )
+                {
+                    const uint32_t index = static_cast<uint32_t>( points.size() );
+
+                    points.push_back( TVector2<float>( x, y ) );
+                    grid.insert( x, y, index );
+                    active.push_back( index );
+
+                    found = true;
+                }
+            }
+
+            if ( !found )
+            {
+                active[slot] = active.back();
+                active.pop_back();
+            }
+        }
+    }
+
+    /**
+     * Background grid of the 3D sampler.
+     */
+    class Grid3
+    {
+    public:
+        Grid3( const TVector3<float>& minCorner, const TVector3<float>& size, float radius )
+            : mOrigin( minCorner ),
+              mSize( size ),
+              mRadiusSquared( radius * radius )
+        {
+            size_t cellTotal = 1;
+            int ranges[3];
+
+            for ( int axis = 0; axis < 3; ++axis )
+            {
+                mCounts[axis]   = cellCount( size[axis], radius * SqrtOneThird );
+                mInvCells[axis] = mCounts[axis] / size[axis];
+                ranges[axis]    = static_cast<int>( std::ceil( radius * mInvCells[axis] ) );
+
+                cellTotal *= static_cast<size_t>( mCounts[axis] );
+            }
+
+            mCells.assign( cellTotal, EmptyCell );
+
+            // Cells that can hold a point within the radius of anywhere in
+            // the centre cell, nearest first so conflicts are found early
+            for ( int dz = -ranges[2]; dz <= ranges[2]; ++dz )
+            {
+                for ( int dy = -ranges[1]; dy <= ranges[1]; ++dy )
+                {
+                    for ( int dx = -ranges[0]; dx <= ranges[0]; ++dx )
+                    {
+                        const float gapX = std::max( std::abs( dx ) - 1, 0 ) / mInvCells[0];
+                        const float gapY = std::max( std::abs( dy ) - 1, 0 ) / mInvCells[1];
+                        const float gapZ = std::max( std::abs( dz ) - 1, 0 ) / mInvCells[2];
+
+                        if ( gapX * gapX + gapY * gapY + gapZ * gapZ < mRadiusSquared )
+                        {
+                            Offset offset = { { dx, dy, dz }, std::abs( dx ) + std::abs( dy ) + std::abs( dz ) };
+                            mNeighbours.push_back( offset );
+                        }
+                    }
+                }
+            }
+
+            std::stable_sort( mNeighbours.begin(), mNeighbours.end(), nearer );
+        }
+
+        bool contains( const TVector3<float>& p ) const
+        {
+            for ( int axis = 0; axis < 3; ++axis )
+            {
+                if ( !( p[axis] >= mOrigin[axis] && p[axis] < mOrigin[axis] + mSize[axis] ) )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool fits( const TVector3<float>& p, const std::vector< TVector3<float> >& points ) const
+        {
+            int cell[3];
+
+            for ( int axis = 0; axis < 3; ++axis )
+            {
+                cell[axis] = cellOf( p[axis] - mOrigin[axis], mInvCells[axis], mCounts[axis] );
+            }
+
+            for ( size_t i = 0; i < mNeighbours.size(); ++i )
+            {
+                const int x = cell[0] + mNeighbours[i].d[0];
+                const int y = cell[1] + mNeighbours[i].d[1];
+                const int z = cell[2] + mNeighbours[i].d[2];
+
+                if ( x < 0 || x >= mCounts[0] || y < 0 || y >= mCounts[1] || z < 0 || z >= mCounts[2] )
+                {
+                    continue;
+                }
+
+                const uint32_t index = mCells[ cellIndex( x, y, z ) ];
+
+                if ( index != EmptyCell )
+                {
+                    const TVector3<float>& q = points[index];
+                    const float ox = q.x() - p.x();
+                    const float oy = q.y() - p.y();
+                    const float oz = q.z() - p.z();
+
+                    if ( ox * ox + oy * oy + oz * oz < mRadiusSquared )
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        void insert( const TVector3<float>& p, uint32_t index )
+        {
+            int cell[3];
+
+            for ( int axis = 0; axis < 3; ++axis )
+            {
+                cell[axis] = cellOf( p[axis] - mOrigin[axis], mInvCells[axis], mCounts[axis] );
+            }
+
+            mCells[ cellIndex( cell[0], cell[1], cell[2] ) ] = index;
+        }
+
+    private:
+        struct Offset
+        {
+            int d[3];
+            int distance;
+        };
+
+        static bool nearer( const Offset& a, const Offset& b )
+        {
+            return a.distance < b.distance;
+        }
+
+        size_t cellIndex( int x, int y, int z ) const
+        {
+            return ( static_cast<size_t>( z ) * mCounts[1] + y ) * mCounts[0] + x;
+        }
+
+    private:
+        TVector3<float> mOrigin;
+        TVector3<float> mSize;
+        float mRadiusSquared;
+        int mCounts[3];
+        float mInvCells[3];
+        std::vector<uint32_t> mCells;
+        std::vector<Offset> mNeighbours;
+    };
+}
+
+template<typename Engine>
+void Math::poissonDisk( const RectF& bounds,
+                        float radius,
+                        TRandom<Engine>& random,
+                        std::vector< TVector2<float> >& points,
+                        int attempts )
+{
+    SMATH_ASSERT( radius > 0.0f, "Poisson disk radius must be positive" );
+
+    Grid2 grid( bounds.topLeft(), bounds.size(), radius, false );
+    bridson2( grid, bounds.topLeft(), bounds.size(), radius, random, points, attempts );
+}
+
+template<typename Engine>
+void Math::poissonDisk( const TVector3<float>& minCorner,
+                        const TVector3<float>& maxCorner,
+                        float radius,
+                        TRandom<Engine>& random,
+                        std::vector< TVector3<float> >& points,
+                        int attempts )
+{
+    SMATH_ASSERT( radius > 0.0f, "Poisson disk radius must be positive" );
+    SMATH_ASSERT( maxCorner.x() > minCorner.x() && maxCorner.y() > minCorner.y() &&
+                  maxCorner.z() > minCorner.z(), "Invalid box" );
+
+    const TVector3<float> size = maxCorner - minCorner;
+    Grid3 grid( minCorner, size, radius );
+    std::vector<uint32_t> active;
+
+    points.clear();
+    points.push_back( minCorner + TVector3<float>( detail::unitFloat( random.nextUInt() ) * size.x(),
+                                        detail::unitFloat( random.nextUInt() ) * size.y(),
+                                        detail::unitFloat( random.nextUInt() ) * size.z() ) );
+    grid.insert( points[0], 0 );
+    active.push_back( 0 );
+
+    while ( !active.empty() )
+    {
+        const uint32_t slot = random.nextUInt( static_cast<unsigned int>( active.size() - 1 ) );
+        const TVector3<float> center = points[ active[slot] ];
+        bool found = false;
+
+        for ( int attempt = 0; attempt < attempts && !found; ++attempt )
+        {
+            const float u1 = detail::unitFloat( random.nextUInt() );
+            const float u2 = detail::unitFloat( random.nextUInt() );
+            const float distance = radius * ( 1.0f + detail::unitFloat( random.nextUInt() ) );
+
+            const TVector3<float> candidate = center + mapToSphere( u1, u2 ) * distance;
+
+            if ( grid.contains( candidate ) && grid.fits( candidate, points ) )
+            {
+                const uint32_t index = static_cast<uint32_t>( points.size() );
+
+                points.push_back( candidate );
+                grid.insert( candidate, index );
+                active.push_back( index );
+
+                found = true;
+            }
+        }
+
+        if ( !found )
+        {
+            active[slot] = active.back();
+            active.pop_back();
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Blue noise tile
+/////////////////////////////////////////////////////////////////////////////
+
+BlueNoiseTile::BlueNoiseTile()
+    : mPoints(),
+      mRadius( 0.0f )
+{
+}
+
+template<typename Engine>
+void BlueNoiseTile::generate( float radius, TRandom<Engine>& random, int attempts )
+{
+    SMATH_ASSERT( radius > 0.0f && radius < 0.5f, "Blue noise radius must be in (0, 0.5)" );
+
+    const TVector2<float> origin( 0.0f, 0.0f );
+    const TVector2<float> size( 1.0f, 1.0f );
+
+    Grid2 grid( origin, size, radius, true );
+    bridson2( grid, origin, size, radius, random, mPoints, attempts );
+
+    mRadius = radius;
+}
+
+void BlueNoiseTile::scatter( const RectF& region,
+                             float tileSize,
+                             std::vector< TVector2<float> >& points ) const
+{
+    SMATH_ASSERT( tileSize > 0.0f, "Tile size must be positive" );
+
+    const float left   = region.left();
+    const float right  = region.right();
+    const float top    = region.top();
+    const float bottom = region.bottom();
+
+    const int firstColumn = static_cast<int>( std::floor( left / tileSize ) );
+    const int lastColumn  = static_cast<int>( std::floor( right / tileSize ) );
+    const int firstRow    = static_cast<int>( std::floor( top / tileSize ) );
+    const int lastRow     = static_cast<int>( std::floor( bottom / tileSize ) );
+
+    const double tileArea = static_cast<double>( tileSize ) * tileSize;
+    points.reserve( points.size() + static_cast<size_t>( mPoints.size() * region.area() / tileArea ) );
+
+    for ( int row = firstRow; row <= lastRow; ++row )
+    {
+        for ( int column = firstColumn; column <= lastColumn; ++column )
+        {
+            const float ox = column * tileSize;
+            const float oy = row * tileSize;
+
+            // Half open bounds, so regions that share an edge share no points
+            for ( size_t i = 0; i < mPoints.size(); ++i )
+            {
+                const float x = ox + mPoints[i].x() * tileSize;
+                const float y = oy + mPoints[i].y() * tileSize;
+
+                if ( x >= left && x < right && y >= top && y < bottom )
+                {
+                    points.push_back( TVector2<float>( x, y ) );
+                }
+            }
+        }
+    }
+}
+
+template void Math::poissonDisk( const RectF&, float, TRandom<Math::MersenneTwister>&,
+                                 std::vector< TVector2<float> >&, int );
+template void Math::poissonDisk( const TVector3<float>&, const TVector3<float>&, float,
+                                 TRandom<Math::MersenneTwister>&, std::vector< TVector3<float> >&, int );
+template void BlueNoiseTile::generate( float, TRandom<Math::MersenneTwister>&, int );
+
+template void Math::poissonDisk( const RectF&, float, TRandom<Math::AlignedMersenneTwister>&,
+                                 std::vector< TVector2<float> >&, int );
+template void Math::poissonDisk( const TVector3<float>&, const TVector3<float>&, float,
+                                 TRandom<Math::AlignedMersenneTwister>&, std::vector< TVector3<float> >&, int );
+template void BlueNoiseTile::generate( float, TRandom<Math::AlignedMersenneTwister>&, int );
+
+template void Math::poissonDisk( const RectF&, float, TRandom<Math::SplitMix64>&,
+                                 std::vector< TVector2<float> >&, int );
+template void Math::poissonDisk( const TVector3<float>&, const TVector3<float>&, float,
+                                 TRandom<Math::SplitMix64>&, std::vector< TVector3<float> >&, int );
+template void BlueNoiseTile::generate( float, TRandom<Math::SplitMix64>&, int );
+
+template void Math::poissonDisk( const RectF&, float, TRandom<Math::Xoshiro256>&,
+                                 std::vector< TVector2<float> >&, int );
+template void Math::poissonDisk( const TVector3<float>&, const TVector3<float>&, float,
+                                 TRandom<Math::Xoshiro256>&, std::vector< TVector3<float> >&, int );
+template void BlueNoiseTile::generate( float, TRandom<Math::Xoshiro256>&, int );
+
+template void Math::poissonDisk( const RectF&, float, TRandom<Math::Pcg32>&,
+                                 std::vector< TVector2<float> >&, int );
+template void Math::poissonDisk( const TVector3<float>&, const TVector3<float>&, float,
+                                 TRandom<Math::Pcg32>&, std::vector< TVector3<float> >&, int );
+template void BlueNoiseTile::generate( float, TRandom<Math::Pcg32>&, int );
@@ -13,55 +13,192 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+
+//
+//  C++ implementation of the MT19937 random number generator. The original implementation was
+//  coded by Takuji Nishmura and Makoto Matsumoto. Modified and ported to C++ by Scott MacDonald
+//  on 2013/03/25. The generators returning floating point values are based on code written by
+//  Isaku Wada, 2002/01/09. The original license is reproduced below:
+//
+// A C-program for MT19937, with initialization improved 2002/1/26.
+// Coded by Takuji Nishimura and Makoto Matsumoto.
+//
+// Before using, initialize the state by using init_genrand(seed)  
+// or init_by_array(init_key, key_length).
+//
+// Copyright (C) 1997 - 2002, Makoto Matsumoto and Takuji Nishimura,
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+// are met:
+//
+//   1. Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//   2. Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//   3. The names of its contributors may not be used to endorse or promote 
+//      products derived from this software without specific prior written 
+//      permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+// CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Any feedback is very welcome.
+// http://www.math.sci.hiroshima-u.ac.jp/~m-mat/MT/emt.html
+// email: m-mat @ math.sci.hiroshima-u.ac.jp (remove space)
+//
+// ---
+//
+// Feedback about this C++ port should be sent to Scott MacDonald. See
+// http://whitespaceconsideredharmful.com/ for contact information.
 #include <smath/randomstate.h>
-#include <algorithm>
 #include <cassert>
 
 using namespace RandomConstants;
+using namespace Math;
 
-random_state_t::random_state_t()
-    : vals(),
-      seed( 0u ),
-      index( 0u )
+MersenneTwister::MersenneTwister( uint32_t seedValue )
+    : mState()
 {
+    seed( seedValue );
 }
 
-random_state_t::random_state_t( const random_state_t& rhs )
-    : vals(),
-      seed( rhs.seed ),
-      index( rhs.index )
+void MersenneTwister::seed( uint32_t seedValue )
 {
-    std::copy( &rhs.vals[0], &rhs.vals[N], &vals[0] );
+    mState.vals[0] = seedValue & 0xffffffffUL;
+    mState.seed    = seedValue;
+
+    uint32_t * pVals = mState.vals;
+    size_t& index = mState.index;
+
+    for ( index = 1; index < N; ++index )
+    {
+        pVals[index] = (1812433253UL * (pVals[index-1] ^ (pVals[index-1] >> 30)) + index);
+
+        // See Knuth TAOCP Vol2. 3rd Ed. P.106 for multiplier.
+        // In the previous versions, MSBs of the seed affect
+        // only MSBs of the array mt[].
+        // 2002/01/09 modified by Makoto Matsumoto
+        pVals[index] &= 0xffffffffUL; // for 32 bit machines
+    }
 }
 
-random_state_t::random_state_t( const random_state_t* rhs )
-    : vals(),
-      seed(),
-      index()
+void MersenneTwister::seed( const uint32_t * pKey, size_t length )
 {
-    assert( rhs != NULL );
+    assert( pKey != NULL );
 
-    seed = rhs->seed;
-    index = rhs->index;
+    // Initial values.
+    size_t i = 1, j = 0;
+    size_t k = ( N > length ? N : length );
+    
+    // Initialize the mersenne twister state once with an initial seed value.
+    seed( 19650218UL );     // what's this magic number represent?
 
-    std::copy( &rhs->vals[0], &rhs->vals[N], &vals[0] );
-}
+    // Shortcut to avoid verbose referencing of mState.
+    uint32_t * pVals = mState.vals;
+
+    // Now initialize the mersenne twister state again with the provided state array.
+    for ( ; k; --k )
+    {
+        pVals[i]  = ( pVals[i] ^ (( pVals[i - 1] ^ ( pVals[i-1] >> 30 )) * 1664525UL))
+            + pKey[j] + static_cast<uint32_t>( j );   // non-linear... ?
+        pVals[i] &= 0xffffffffUL; // for WORDSIZE > 32 machines
+
+        i++;
+        j++;
+
+        if ( i >= N )
+        {
+            pVals[0] = pVals[N - 1];
+            i = 1;
+        }
+
+        if ( j >= length )
+        {
+            j = 0;
+        }
+    }
+
+    for ( k = N - 1; k; k-- )
+    {
+        pVals[i]  = ( pVals[i] ^ (( pVals[i - 1] ^ ( pVals[i - 1] >> 30 )) * 1566083941UL))
+            - static_cast<uint32_t>( i ); // non linear. again - ?
+        pVals[i] &= 0xffffffffUL; // for WORDSIZE > 32 machines
+
+        i++;
 
+        if ( i >= N )
+        {
+            pVals[0] = pVals[N - 1];
+            i = 1;
+        }
+    }
+    
+    pVals[0] = 0x80000000UL; // MSB is 1; assuring non-zero initial array
+}
 
-random_state_t::~random_state_t()
+/**
+ * Generates the next N words of state at once.
+ */
+void MersenneTwister::regenerate()
 {
-    // empty
+    static const uint32_t MAG01[2] = { 0x0UL, MATRIX_A };
+    uint32_t * pVals = mState.vals;
+    uint32_t y;
+    uint32_t kk;
+
+    for ( kk = 0; kk < N - M; ++kk )
+    {
+        y = ( pVals[kk] & UPPER_MASK ) | ( pVals[kk+1] & LOWER_MASK );
+        pVals[kk] = pVals[kk + M] ^ ( y >> 1 ) ^ MAG01[y & 0x1UL];
+    }
+
+    for ( ; kk < N - 1; ++kk )
+    {
+        y = ( pVals[kk] & UPPER_MASK ) | ( pVals[kk + 1] & LOWER_MASK );
+        pVals[kk] = pVals[kk + ( M - N )] ^ ( y >> 1 ) ^ MAG01[y & 0x1UL];
+    }
+
+    y = ( pVals[N - 1] & UPPER_MASK ) | ( pVals[0] & LOWER_MASK );
+    pVals[N-1] = pVals[M - 1] ^ ( y >> 1 ) ^ MAG01[y & 0x1UL];
+
+    mState.index = 0;
 }
 
-random_state_t& random_state_t::operator = ( const random_state_t& rhs )
+void Xoshiro256::jump()
 {
-    if ( &rhs != this )
+    static const uint64_t JUMP[4] = { 0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                      0xa9582618e03fc9aaull, 0x39abdc4529b1661cull };
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+    for ( int i = 0; i < 4; ++i )
     {
-        seed  = rhs.seed;
-        index = rhs.index;
+        for ( int b = 0; b < 64; ++b )
+        {
+            if ( JUMP[i] & ( 1ull << b ) )
+            {
+                s0 ^= mState[0];
+                s1 ^= mState[1];
+                s2 ^= mState[2];
+                s3 ^= mState[3];
+            }
 
-        std::copy( &rhs.vals[0], &rhs.vals[N], &vals[0] );
+            next64();
+        }
     }
 
-    return *this;
+    seed( s0, s1, s2, s3 );
 }
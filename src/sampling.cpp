@@ -0,0 +1,150 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/sampling.h>
+
+#include <limits>
+
+using namespace Math;
+
+namespace
+{
+    const double TwoPow32 = 4294967296.0;
+
+    /**
+     * Converts a probability in [0, 1] into a 32 bit comparison threshold.
+     */
+    uint32_t toThreshold( double probability )
+    {
+        double scaled = probability * TwoPow32;
+
+        if ( scaled <= 0.0 )
+        {
+            return 0u;
+        }
+
+        if ( scaled >= TwoPow32 - 1.0 )
+        {
+            return std::numeric_limits<uint32_t>::max();
+        }
+
+        return static_cast<uint32_t>( scaled + 0.5 );
+    }
+}
+
+AliasTable::AliasTable()
+    : mEntries()
+{
+}
+
+AliasTable::AliasTable( const std::vector<float>& weights )
+    : mEntries()
+{
+    build( weights.empty() ? NULL : &weights[0], weights.size() );
+}
+
+void AliasTable::build( const float * pWeights, size_t count )
+{
+    SMATH_ASSERT( pWeights != NULL || count == 0, "Missing weights" );
+    SMATH_ASSERT( count <= std::numeric_limits<uint32_t>::max(), "Too many outcomes" );
+
+    mEntries.resize( count );
+
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    double total = 0.0;
+
+    for ( size_t i = 0; i < count; ++i )
+    {
+        SMATH_ASSERT( pWeights[i] >= 0.0f, "Weights must not be negative" );
+        total += pWeights[i];
+    }
+
+    // Scale the weights so the average column holds exactly 1, then split
+    // them into columns that are under and over full
+    std::vector<double> scaled( count );
+    std::vector<uint32_t> small, large;
+
+    small.reserve( count );
+    large.reserve( count );
+
+    for ( size_t i = 0; i < count; ++i )
+    {
+        scaled[i] = total > 0.0 ? pWeights[i] * count / total : 1.0;
+        ( scaled[i] < 1.0 ? small : large ).push_back( static_cast<uint32_t>( i ) );
+    }
+
+    // Fill each under full column with probability from an over full one
+    while ( !small.empty() && !large.empty() )
+    {
+        uint32_t less = small.back();
+        uint32_t more = large.back();
+
+        small.pop_back();
+
+        mEntries[less].threshold = toThreshold( scaled[less] );
+        mEntries[less].alias     = more;
+
+        scaled[more] = ( scaled[more] + scaled[less] ) - 1.0;
+
+        if ( scaled[more] < 1.0 )
+        {
+            large.pop_back();
+            small.push_back( more );
+        }
+    }
+
+    // Whatever is left is full, up to rounding error
+    for ( size_t i = 0; i < large.size(); ++i )
+    {
+        mEntries[ large[i] ].threshold = std::numeric_limits<uint32_t>::max();
+        mEntries[ large[i] ].alias     = large[i];
+    }
+
+    for ( size_t i = 0; i < small.size(); ++i )
+    {
+        mEntries[ small[i] ].threshold = std::numeric_limits<uint32_t>::max();
+        mEntries[ small[i] ].alias     = small[i];
+    }
+}
+
+double AliasTable::probability( uint32_t index ) const
+{
+    SMATH_ASSERT( index < mEntries.size(), "Outcome out of range" );
+
+    // The chance of landing in the outcome's own column and keeping it, plus
+    // landing in every column that aliases to it and not keeping that
+    double columns = 0.0;
+
+    for ( size_t i = 0; i < mEntries.size(); ++i )
+    {
+        const double keep = mEntries[i].alias == i ? 1.0 : mEntries[i].threshold / TwoPow32;
+
+        if ( i == index )
+        {
+            columns += keep;
+        }
+
+        if ( mEntries[i].alias == index && i != index )
+        {
+            columns += 1.0 - keep;
+        }
+    }
+
+    return columns / mEntries.size();
+}
@@ -19,6 +19,25 @@
 #include <smath/config.h>
 #include <smath/util.h>
 
+#include <cmath>
+#include <limits>
+
+namespace Math
+{
+namespace detail
+{
+    /**
+     * Magnitude from which every value of T is an integer. Below it, an
+     * angle divided by a turn fits a long long with room to spare.
+     */
+    template<typename T>
+    constexpr T TruncationLimit()
+    {
+        return static_cast<T>(1) / std::numeric_limits<T>::epsilon();
+    }
+}
+}
+
 // Forward declaration
 template<typename T> class Degrees;
 template<typename T> class Radians;
@@ -30,22 +49,22 @@ template<typename T>
 class Degrees
 {
 public:
-    Degrees()
+    constexpr Degrees()
         : mValue( static_cast<T>(0) )
     {
     }
 
-    explicit Degrees( T angle )
+    explicit constexpr Degrees( T angle )
         : mValue( wrap( angle ) )
     {
     }
 
-    Degrees( const Radians<T>& r )
-        : mValue( r.as<T>() * Math::Rad2Deg )
+    constexpr Degrees( const Radians<T>& r )
+        : mValue( r.template as<T>() * Math::Rad2Deg )
     {
     }
 
-    Degrees( const Degrees& d )
+    constexpr Degrees( const Degrees& d )
         : mValue( d.mValue )
     {
     }
@@ -58,7 +77,7 @@ public:
 
     Degrees& operator = ( const Radians<T>& rhs )
     {
-        mValue = rhs.as<T>() * Math::Rad2Deg;
+        mValue = rhs.template as<T>() * Math::Rad2Deg;
         return *this;
     }
 
@@ -69,7 +88,7 @@ public:
 
     bool operator == ( const Radians<T>& rhs ) const
     {
-        return Math::equalsClose( mValue, rhs.as<T>() * Math::Rad2Deg );
+        return Math::equalsClose( mValue, rhs.template as<T>() * Math::Rad2Deg );
     }
 
     bool operator != ( const Degrees& rhs ) const
@@ -79,26 +98,34 @@ public:
 
     bool operator != ( const Radians<T>& rhs ) const
     {
-        return (! Math::equalsClose( mValue, rhs.as<T>() * Math::Rad2Deg ) );
+        return (! Math::equalsClose( mValue, rhs.template as<T>() * Math::Rad2Deg ) );
     }
 
     template<typename U>
-    U as() const
+    constexpr U as() const
     {
         return static_cast<U>( mValue );
     }
 
 private:
-    T wrap( T v ) const
+    /**
+     * Wraps the angle into [0,360). Angles below TruncationLimit are reduced
+     * by truncating through an integer, so they can be built in constant
+     * expressions; a rounded quotient is off by at most one turn, which
+     * reduce() corrects. Larger, infinite and NaN angles use std::fmod.
+     */
+    static constexpr T wrap( T v )
     {
-        T a = std::fmod( v, static_cast<T>(360) );
-
-        if ( a < static_cast<T>(0) )
-        {
-            a += static_cast<T>(360);
-        }
+        return ( v > -Math::detail::TruncationLimit<T>() && v < Math::detail::TruncationLimit<T>() )
+            ? reduce( v - static_cast<T>(360) *
+                          static_cast<T>( static_cast<long long>( v / static_cast<T>(360) ) ) )
+            : reduce( std::fmod( v, static_cast<T>(360) ) );
+    }
 
-        return a;
+    static constexpr T reduce( T a )
+    {
+        return ( a < static_cast<T>(0)    ? a + static_cast<T>(360) :
+                 a >= static_cast<T>(360) ? a - static_cast<T>(360) : a );
     }
 
 private:
@@ -112,22 +139,22 @@ template<typename T>
 class Radians
 {
 public:
-    Radians()
+    constexpr Radians()
         : mValue( static_cast<T>(0) )
     {
     }
 
-    explicit Radians( T angle )
+    explicit constexpr Radians( T angle )
         : mValue( wrap( angle ) )
     {
     }
 
-    Radians( const Degrees<T>& r )
-        : mValue( r.as<T>() * Math::Deg2Rad )
+    constexpr Radians( const Degrees<T>& r )
+        : mValue( r.template as<T>() * Math::Deg2Rad )
     {
     }
 
-    Radians( const Radians& d )
+    constexpr Radians( const Radians& d )
         : mValue( d.mValue )
     {
     }
@@ -140,7 +167,7 @@ public:
 
     Radians& operator = ( const Degrees<T>& rhs )
     {
-        mValue = rhs.as<T>() * Math::Deg2Rad;
+        mValue = rhs.template as<T>() * Math::Deg2Rad;
         return *this;
     }
 
@@ -151,7 +178,7 @@ public:
 
     bool operator == ( const Degrees<T>& rhs ) const
     {
-        return Math::equalsClose( mValue, rhs.as<T>() * Math::Deg2Rad );
+        return Math::equalsClose( mValue, rhs.template as<T>() * Math::Deg2Rad );
     }
 
     bool operator != ( const Radians& rhs ) const
@@ -161,26 +188,31 @@ public:
 
     bool operator != ( const Degrees<T>& rhs ) const
     {
-        return (! Math::equalsClose( mValue, rhs.as<T>() * Math::Deg2Rad ) );
+        return (! Math::equalsClose( mValue, rhs.template as<T>() * Math::Deg2Rad ) );
     }
 
     template<typename U>
-    U as() const
+    constexpr U as() const
     {
         return static_cast<U>( mValue );
     }
 
 private:
-    T wrap( T v ) const
+    /**
+     * Wraps the angle into [0,2pi), see Degrees::wrap.
+     */
+    static constexpr T wrap( T v )
     {
-        T a = std::fmod( v, static_cast<T>(Math::TwoPi) );
-
-        if ( a < static_cast<T>(0) )
-        {
-            a += static_cast<T>(Math::TwoPi);
-        }
+        return ( v > -Math::detail::TruncationLimit<T>() && v < Math::detail::TruncationLimit<T>() )
+            ? reduce( v - static_cast<T>(Math::TwoPi) *
+                          static_cast<T>( static_cast<long long>( v / static_cast<T>(Math::TwoPi) ) ) )
+            : reduce( std::fmod( v, static_cast<T>(Math::TwoPi) ) );
+    }
 
-        return a;
+    static constexpr T reduce( T a )
+    {
+        return ( a < static_cast<T>(0)            ? a + static_cast<T>(Math::TwoPi) :
+                 a >= static_cast<T>(Math::TwoPi) ? a - static_cast<T>(Math::TwoPi) : a );
     }
 
 private:
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_BATCH_H
+#define SCOTT_MATH_BATCH_H
+
+//
+// Batch kernels that process whole arrays of vectors or floats per call.
+//
+// Every kernel is compiled for several instruction set levels and the best
+// one for the running CPU is selected the first time a kernel is called, so
+// a single binary uses AVX2 or AVX-512 where available and still runs on
+// plain SSE2 machines. See cpu.h to query or override the selected level.
+//
+// Results may differ in the last bit between levels because the wider
+// levels use fused multiply-adds. Outputs may alias inputs unless noted
+// otherwise.
+//
+#include <smath/config.h>
+#include <smath/vector.h>
+#include <smath/matrix.h>
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace Math
+{
+namespace batch
+{
+    /**
+     * Transforms an array of points by a matrix, treating each point as
+     * (x, y, z, 1) and multiplying as M * p, the convention used by
+     * createTranslation and the other matrix builders. The resulting w is
+     * discarded.
+     *
+     * \param  matrix  Transformation to apply
+     * \param  pIn     Points to transform
+     * \param  pOut    Receives the transformed points
+     * \param  count   Number of points
+     */
+    void transformPoints( const TMatrix4<float>& matrix,
+                          const TVector3<float> * pIn,
+                          TVector3<float> * pOut,
+                          size_t count );
+
+    /**
+     * Transforms an array of directions by a matrix, treating each vector as
+     * (x, y, z, 0) so the matrix translation is ignored.
+     *
+     * \param  matrix  Transformation to apply
+     * \param  pIn     Directions to transform
+     * \param  pOut    Receives the transformed directions
+     * \param  count   Number of directions
+     */
+    void transformDirections( const TMatrix4<float>& matrix,
+                              const TVector3<float> * pIn,
+                              TVector3<float> * pOut,
+                              size_t count );
+
+    /**
+     * Transforms an array of 4d vectors by a matrix, as M * v.
+     *
+     * \param  matrix  Transformation to apply
+     * \param  pIn     Vectors to transform
+     * \param  pOut    Receives the transformed vectors
+     * \param  count   Number of vectors
+     */
+    void transform( const TMatrix4<float>& matrix,
+                    const TVector4<float> * pIn,
+                    TVector4<float> * pOut,
+                    size_t count );
+
+    /**
+     * Computes the dot product of every pair of vectors in two arrays.
+     */
+    void dot( const TVector3<float> * pA,
+              const TVector3<float> * pB,
+              float * pOut,
+              size_t count );
+
+    /**
+     * Computes the cross product of every pair of vectors in two arrays.
+     */
+    void cross( const TVector3<float> * pA,
+                const TVector3<float> * pB,
+                TVector3<float> * pOut,
+                size_t count );
+
+    /**
+     * Computes the length of every vector in an array.
+     */
+    void length( const TVector3<float> * pIn, float * pOut, size_t count );
+
+    /**
+     * Normalizes every vector in an array. Zero length vectors produce
+     * non-finite results, as with TVector3::normalized.
+     */
+    void normalize( const TVector3<float> * pIn,
+                    TVector3<float> * pOut,
+                    size_t count );
+
+    /**
+     * Computes a[i] + b[i] * scale for every pair of vectors in two arrays.
+     */
+    void scaleAdd( const TVector3<float> * pA,
+                   const TVector3<float> * pB,
+                   float scale,
+                   TVector3<float> * pOut,
+                   size_t count );
+
+    /**
+     * Double precision versions of the vector streams above. A register
+     * holds half as many doubles as floats, so expect about half the
+     * throughput.
+     */
+    void dot( const TVector3<double> * pA,
+              const TVector3<double> * pB,
+              double * pOut,
+              size_t count );
+
+    void cross( const TVector3<double> * pA,
+                const TVector3<double> * pB,
+                TVector3<double> * pOut,
+                size_t count );
+
+    void length( const TVector3<double> * pIn, double * pOut, size_t count );
+
+    void normalize( const TVector3<double> * pIn,
+                    TVector3<double> * pOut,
+                    size_t count );
+
+    void scaleAdd( const TVector3<double> * pA,
+                   const TVector3<double> * pB,
+                   double scale,
+                   TVector3<double> * pOut,
+                   size_t count );
+
+    /**
+     * Integer versions of the vector streams, for grid coordinates. They
+     * give the same results as the scalar int operators, except that
+     * overflow wraps instead of being undefined.
+     */
+    void dot( const TVector3<int> * pA,
+              const TVector3<int> * pB,
+              int * pOut,
+              size_t count );
+
+    void cross( const TVector3<int> * pA,
+                const TVector3<int> * pB,
+                TVector3<int> * pOut,
+                size_t count );
+
+    void scaleAdd( const TVector3<int> * pA,
+                   const TVector3<int> * pB,
+                   int scale,
+                   TVector3<int> * pOut,
+                   size_t count );
+
+    /**
+     * Array versions of the Math::fast approximations, evaluated with the
+     * MATH_FAST_PRECISION accuracy tier.
+     */
+    void sin( float * pOut, const float * pIn, size_t count );
+    void cos( float * pOut, const float * pIn, size_t count );
+    void exp( float * pOut, const float * pIn, size_t count );
+    void log( float * pOut, const float * pIn, size_t count );
+    void sqrt( float * pOut, const float * pIn, size_t count );
+    void rsqrt( float * pOut, const float * pIn, size_t count );
+
+    /**
+     * Converts raw 32 bit generator output to uniform floats in [0,1), from
+     * the top 24 bits of each value. The results are exact, and the same at
+     * every level.
+     */
+    void unitFloats( const uint32_t * pIn, float * pOut, size_t count );
+
+    /**
+     * Maps pairs of uniform values in [0,1) to points on the unit sphere,
+     * as Math::mapToSphere does, written to separate x, y and z arrays.
+     */
+    void mapToSphere( const float * pU1,
+                      const float * pU2,
+                      float * pX,
+                      float * pY,
+                      float * pZ,
+                      size_t count );
+
+    /**
+     * Maps pairs of uniform values in [0,1) to points inside the unit disk
+     * with the concentric mapping of Math::mapToDisk.
+     */
+    void mapToDisk( const float * pU1,
+                    const float * pU2,
+                    float * pX,
+                    float * pY,
+                    size_t count );
+}
+}
+
+#endif
@@ -0,0 +1,416 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_CAMERA_H
+#define SCOTT_MATH_CAMERA_H
+
+#include <smath/config.h>
+#include <smath/constants.h>
+#include <smath/vector.h>
+#include <smath/matrix.h>
+#include <smath/matrixutils.h>
+
+/**
+ * A camera that owns the view and projection parameters of a scene, and
+ * caches the matrices derived from them.
+ *
+ * Every matrix (view, projection, view-projection and their inverses) is
+ * computed lazily the first time it is requested after one of the
+ * parameters it depends on was changed. Rendering passes that share a camera
+ * can therefore request the matrices as often as they like, and only pay for
+ * a rebuild (and inversion) when the camera actually moves or the viewport
+ * changes.
+ *
+ * Matrices follow the same conventions as the Math::create* builders: right
+ * handed view space looking down -Z, and matrices that transform column
+ * vectors (projection * view * point).
+ */
+template<typename T>
+class TCamera
+{
+public:
+    typedef T value_type;
+
+    /// Type of projection used by the camera
+    enum ProjectionType
+    {
+        PERSPECTIVE,
+        ORTHOGRAPHIC
+    };
+
+    /**
+     * Creates a camera at the origin looking down the negative Z axis, with
+     * a 90 degree perspective projection.
+     */
+    TCamera()
+        : mEye( 0, 0, 0 ),
+          mTarget( 0, 0, -1 ),
+          mUp( 0, 1, 0 ),
+          mProjectionType( PERSPECTIVE ),
+          mFovY( static_cast<T>( Math::HalfPi ) ),
+          mAspect( 1 ),
+          mLeft( -1 ),
+          mRight( 1 ),
+          mBottom( -1 ),
+          mTop( 1 ),
+          mNear( static_cast<T>( 0.1 ) ),
+          mFar( 1000 ),
+          mInfiniteFar( false ),
+          mReversedZ( false ),
+          mValid( 0 )
+    {
+    }
+
+    /**
+     * Sets the position, target and up direction of the camera.
+     */
+    void setView( const TVector3<T>& eye,
+                  const TVector3<T>& target,
+                  const TVector3<T>& up )
+    {
+        mEye    = eye;
+        mTarget = target;
+        mUp     = up;
+
+        invalidate( VIEW_BITS );
+    }
+
+    /**
+     * Moves the camera to a new position without changing its target.
+     */
+    void setPosition( const TVector3<T>& eye )
+    {
+        mEye = eye;
+        invalidate( VIEW_BITS );
+    }
+
+    /**
+     * Changes the position that the camera is looking at.
+     */
+    void setTarget( const TVector3<T>& target )
+    {
+        mTarget = target;
+        invalidate( VIEW_BITS );
+    }
+
+    /**
+     * Changes the camera's up direction.
+     */
+    void setUp( const TVector3<T>& up )
+    {
+        mUp = up;
+        invalidate( VIEW_BITS );
+    }
+
+    /**
+     * Switches the camera to a perspective projection.
+     *
+     * \param  fovY    Vertical field of view, in radians
+     * \param  aspect  Aspect ratio of the viewport (width / height)
+     * \param  zNear   Distance to the near clipping plane
+     * \param  zFar    Distance to the far clipping plane
+     */
+    void setPerspective( T fovY, T aspect, T zNear, T zFar )
+    {
+        mProjectionType = PERSPECTIVE;
+        mFovY           = fovY;
+        mAspect         = aspect;
+        mNear           = zNear;
+        mFar            = zFar;
+        mInfiniteFar    = false;
+
+        invalidate( PROJECTION_BITS );
+    }
+
+    /**
+     * Switches the camera to a perspective projection with no far clipping
+     * plane.
+     *
+     * \param  fovY    Vertical field of view, in radians
+     * \param  aspect  Aspect ratio of the viewport (width / height)
+     * \param  zNear   Distance to the near clipping plane
+     */
+    void setInfinitePerspective( T fovY, T aspect, T zNear )
+    {
+        mProjectionType = PERSPECTIVE;
+        mFovY           = fovY;
+        mAspect         = aspect;
+        mNear           = zNear;
+        mInfiniteFar    = true;
+
+        invalidate( PROJECTION_BITS );
+    }
+
+    /**
+     * Switches the camera to an orthographic projection.
+     */
+    void setOrtho( T left, T right, T bottom, T top, T zNear, T zFar )
+    {
+        mProjectionType = ORTHOGRAPHIC;
+        mLeft           = left;
+        mRight          = right;
+        mBottom         = bottom;
+        mTop            = top;
+        mNear           = zNear;
+        mFar            = zFar;
+        mInfiniteFar    = false;
+
+        invalidate( PROJECTION_BITS );
+    }
+
+    /**
+     * Changes the aspect ratio of a perspective camera. Typically called when
+     * the viewport is resized.
+     */
+    void setAspectRatio( T aspect )
+    {
+        mAspect = aspect;
+        invalidate( PROJECTION_BITS );
+    }
+
+    /**
+     * Enables or disables reversed-Z depth for perspective projections. When
+     * enabled the near plane maps to a depth of 1 and the far plane to 0, see
+     * Math::createPerspectiveReversedZ.
+     */
+    void setReversedZ( bool reversed )
+    {
+        mReversedZ = reversed;
+        invalidate( PROJECTION_BITS );
+    }
+
+    TVector3<T> position() const
+    {
+        return mEye;
+    }
+
+    TVector3<T> target() const
+    {
+        return mTarget;
+    }
+
+    TVector3<T> up() const
+    {
+        return mUp;
+    }
+
+    ProjectionType projectionType() const
+    {
+        return mProjectionType;
+    }
+
+    value_type fieldOfView() const
+    {
+        return mFovY;
+    }
+
+    value_type aspectRatio() const
+    {
+        return mAspect;
+    }
+
+    value_type nearPlane() const
+    {
+        return mNear;
+    }
+
+    value_type farPlane() const
+    {
+        return mFar;
+    }
+
+    bool isInfinite() const
+    {
+        return mInfiniteFar;
+    }
+
+    bool isReversedZ() const
+    {
+        return mReversedZ;
+    }
+
+    /**
+     * Returns the world to view space transform.
+     */
+    const TMatrix4<T>& view() const
+    {
+        if (! isValid( VIEW ) )
+        {
+            mView = Math::createLookAt( mEye, mTarget, mUp );
+            validate( VIEW );
+        }
+
+        return mView;
+    }
+
+    /**
+     * Returns the view to clip space transform.
+     */
+    const TMatrix4<T>& projection() const
+    {
+        if (! isValid( PROJECTION ) )
+        {
+            mProjection = buildProjection();
+            validate( PROJECTION );
+        }
+
+        return mProjection;
+    }
+
+    /**
+     * Returns the world to clip space transform (projection * view).
+     */
+    const TMatrix4<T>& viewProjection() const
+    {
+        if (! isValid( VIEW_PROJECTION ) )
+        {
+            mViewProjection = projection() * view();
+            validate( VIEW_PROJECTION );
+        }
+
+        return mViewProjection;
+    }
+
+    /**
+     * Returns the view to world space transform. The view matrix is a rigid
+     * transform, so this is built directly from the camera basis rather than
+     * by a general 4x4 inversion.
+     */
+    const TMatrix4<T>& inverseView() const
+    {
+        if (! isValid( INVERSE_VIEW ) )
+        {
+            const TMatrix4<T>& v = view();
+
+            mInverseView = TMatrix4<T>( v.at(0,0), v.at(1,0), v.at(2,0), mEye.x(),
+                                        v.at(0,1), v.at(1,1), v.at(2,1), mEye.y(),
+                                        v.at(0,2), v.at(1,2), v.at(2,2), mEye.z(),
+                                        0,         0,         0,         1 );
+            validate( INVERSE_VIEW );
+        }
+
+        return mInverseView;
+    }
+
+    /**
+     * Returns the clip to view space transform.
+     */
+    const TMatrix4<T>& inverseProjection() const
+    {
+        if (! isValid( INVERSE_PROJECTION ) )
+        {
+            mInverseProjection = inverse( projection() );
+            validate( INVERSE_PROJECTION );
+        }
+
+        return mInverseProjection;
+    }
+
+    /**
+     * Returns the clip to world space transform.
+     */
+    const TMatrix4<T>& inverseViewProjection() const
+    {
+        if (! isValid( INVERSE_VIEW_PROJECTION ) )
+        {
+            mInverseViewProjection = inverseView() * inverseProjection();
+            validate( INVERSE_VIEW_PROJECTION );
+        }
+
+        return mInverseViewProjection;
+    }
+
+private:
+    /// Bit flags identifying each of the cached matrices
+    enum
+    {
+        VIEW                    = 0x01,
+        PROJECTION              = 0x02,
+        VIEW_PROJECTION         = 0x04,
+        INVERSE_VIEW            = 0x08,
+        INVERSE_PROJECTION      = 0x10,
+        INVERSE_VIEW_PROJECTION = 0x20,
+
+        VIEW_BITS       = VIEW | INVERSE_VIEW |
+                          VIEW_PROJECTION | INVERSE_VIEW_PROJECTION,
+        PROJECTION_BITS = PROJECTION | INVERSE_PROJECTION |
+                          VIEW_PROJECTION | INVERSE_VIEW_PROJECTION
+    };
+
+    bool isValid( unsigned int bit ) const
+    {
+        return ( mValid & bit ) != 0;
+    }
+
+    void validate( unsigned int bit ) const
+    {
+        mValid |= bit;
+    }
+
+    void invalidate( unsigned int bits )
+    {
+        mValid &= ~bits;
+    }
+
+    TMatrix4<T> buildProjection() const
+    {
+        if ( mProjectionType == ORTHOGRAPHIC )
+        {
+            return Math::createOrtho( mLeft, mRight, mBottom, mTop, mNear, mFar );
+        }
+        else if ( mInfiniteFar )
+        {
+            return ( mReversedZ ?
+                Math::createInfinitePerspectiveReversedZ( mFovY, mAspect, mNear ) :
+                Math::createInfinitePerspective( mFovY, mAspect, mNear ) );
+        }
+        else
+        {
+            return ( mReversedZ ?
+                Math::createPerspectiveReversedZ( mFovY, mAspect, mNear, mFar ) :
+                Math::createPerspective( mFovY, mAspect, mNear, mFar ) );
+        }
+    }
+
+private:
+    TVector3<T> mEye;
+    TVector3<T> mTarget;
+    TVector3<T> mUp;
+
+    ProjectionType mProjectionType;
+    T mFovY;
+    T mAspect;
+    T mLeft, mRight, mBottom, mTop;
+    T mNear;
+    T mFar;
+    bool mInfiniteFar;
+    bool mReversedZ;
+
+    mutable unsigned int mValid;
+    mutable TMatrix4<T> mView;
+    mutable TMatrix4<T> mProjection;
+    mutable TMatrix4<T> mViewProjection;
+    mutable TMatrix4<T> mInverseView;
+    mutable TMatrix4<T> mInverseProjection;
+    mutable TMatrix4<T> mInverseViewProjection;
+};
+
+#ifdef MATH_TYPEDEFS
+typedef TCamera<float> Camera;
+typedef TCamera<float> Cameraf;
+typedef TCamera<double> Camerad;
+#endif
+
+#endif
@@ -24,41 +24,46 @@
 namespace Math
 {
     // Zero delta
-    const float  ZeroEpsilonF  = 1e-5f;
-    const double ZeroEpsilonD  = 1e-9;
-    const float ZeroEpsilon    = 1e-5f;
+    constexpr float  ZeroEpsilonF  = 1e-5f;
+    constexpr double ZeroEpsilonD  = 1e-9;
+    constexpr float ZeroEpsilon    = 1e-5f;
 
     // Pi
-    const float Pi           = 3.14159265358979323842f; // pi
-    const float TwoPi        = 6.28318530717958647695f; // 2 * pi
-    const float InvPi        = 0.31830988618379067154f; // 1 / pi
-    const float TwoOverPi    = 0.63661977236758134308f; // 2 / pi
-    const float HalfPi       = 1.57079632679489661921f; // pi / 2
-    const float QuarterPi    = 0.78539816339744830962f; // pi / 4
-    const float SqrtPi       = 1.77245385090551602729f; // sqrt(PI)
+    constexpr float Pi           = 3.14159265358979323842f; // pi
+    constexpr float TwoPi        = 6.28318530717958647695f; // 2 * pi
+    constexpr float InvPi        = 0.31830988618379067154f; // 1 / pi
+    constexpr float TwoOverPi    = 0.63661977236758134308f; // 2 / pi
+    constexpr float HalfPi       = 1.57079632679489661921f; // pi / 2
+    constexpr float QuarterPi    = 0.78539816339744830962f; // pi / 4
+    constexpr float SqrtPi       = 1.77245385090551602729f; // sqrt(PI)
 
     // e constant
-    const float E            = 2.71828182845904523536f;
-    const float Log10E       = 0.4342944819032518f;
-    const float Log2E        = 1.4426950408889633f;
+    constexpr float E            = 2.71828182845904523536f;
+    constexpr float Log10E       = 0.4342944819032518f;
+    constexpr float Log2E        = 1.4426950408889633f;
 
-    const float Ln2          = 0.69314718055994530942f;
-    const float Ln10         = 2.30258509299404568402f;
+    constexpr float Ln2          = 0.69314718055994530942f;
+    constexpr float Ln10         = 2.30258509299404568402f;
 
     // sqrt
-    const float SqrtTwo      = 1.41421356237309504880f;  // sqrt(2)
-    const float SqrtTwoInv   = 0.70710678118654752440f;  // 1 / sqrt(2)
-    const float SqrtThree    = 1.73205080756887729352f;  // sqrt(3)
-    const float SqrtOneHalf  = 0.70710678118654752440f;  // sqrt(1/2)
-    const float SqrtOneThird = 0.57735026918962576450f;  // sqrt(1/3)
+    constexpr float SqrtTwo      = 1.41421356237309504880f;  // sqrt(2)
+    constexpr float SqrtTwoInv   = 0.70710678118654752440f;  // 1 / sqrt(2)
+    constexpr float SqrtThree    = 1.73205080756887729352f;  // sqrt(3)
+    constexpr float SqrtOneHalf  = 0.70710678118654752440f;  // sqrt(1/2)
+    constexpr float SqrtOneThird = 0.57735026918962576450f;  // sqrt(1/3)
 
     // deg and radian conversions
-    const float Deg2Rad = Pi / 180.0f;
-    const float Rad2Deg = 180.0f / Pi;
+    constexpr float Deg2Rad = Pi / 180.0f;
+    constexpr float Rad2Deg = 180.0f / Pi;
+
+    // Double precision versions for the generic templates
+    constexpr double PiD      = 3.14159265358979323846;
+    constexpr double Deg2RadD = PiD / 180.0;
+    constexpr double Rad2DegD = 180.0 / PiD;
 
     // Time conversions
-    const float SecToMillisec = 1000.0f;
-    const float MillisecToSec = 0.001f;
+    constexpr float SecToMillisec = 1000.0f;
+    constexpr float MillisecToSec = 0.001f;
 }
 
 #endif
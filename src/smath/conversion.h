@@ -27,7 +27,7 @@ namespace Math
      * \return      Radians output
      */
     template<typename T>
-    inline T deg2rad( T deg )
+    constexpr T deg2rad( T deg )
     {
         return static_cast<T>(Pi) / static_cast<T>(180.0) * deg;
     }
@@ -39,7 +39,7 @@ namespace Math
      * \return      Degrees output
      */
     template<typename T>
-    inline T rad2deg( T rad )
+    constexpr T rad2deg( T rad )
     {
         return static_cast<T>(180.0) / static_cast<T>(Pi) * rad;
     }
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_CPU_H
+#define SCOTT_MATH_CPU_H
+
+//
+// Runtime instruction set selection for the batch kernels (see batch.h).
+//
+// The batch kernels are compiled several times, once for each instruction
+// set level listed below that the compiler supports. The first batch call
+// queries the CPU with CPUID and selects the best level that both the CPU
+// and the build support.
+//
+// The level can be lowered for testing and benchmarking, either from code
+// with setInstructionSet() or by setting the SMATH_ISA environment variable
+// to one of "scalar", "sse2", "sse4.1", "avx2" or "avx512" before the first
+// batch call.
+//
+#include <smath/config.h>
+
+namespace Math
+{
+    /**
+     * Instruction set levels the batch kernels are compiled for, in order of
+     * increasing capability. Each level includes the ones before it.
+     */
+    enum InstructionSet
+    {
+        ISA_SCALAR = 0,     ///< Portable C++, one value at a time
+        ISA_SSE2,           ///< 4-wide SSE2
+        ISA_SSE41,          ///< 4-wide SSE4.1 (blends)
+        ISA_AVX2,           ///< 8-wide AVX2 with FMA and F16C
+        ISA_AVX512          ///< 16-wide AVX-512F
+    };
+
+    /**
+     * Returns the best instruction set supported by both the CPU and the
+     * operating system, regardless of what the library was built with.
+     */
+    InstructionSet detectInstructionSet();
+
+    /**
+     * Returns the best instruction set that this build of the library has
+     * batch kernels for.
+     */
+    InstructionSet compiledInstructionSet();
+
+    /**
+     * Returns the instruction set that the batch kernels currently use.
+     */
+    InstructionSet activeInstructionSet();
+
+    /**
+     * Forces the batch kernels to use the given instruction set. Levels the
+     * CPU or the build do not support are lowered to the best supported
+     * level.
+     *
+     * Switching levels is thread safe, but calls already in progress on
+     * other threads finish with the previous level.
+     *
+     * \param  isa  Instruction set to use
+     * \return      Instruction set actually selected
+     */
+    InstructionSet setInstructionSet( InstructionSet isa );
+
+    /**
+     * Discards any forced instruction set and selects the best supported
+     * level again, honoring the SMATH_ISA environment variable.
+     *
+     * \return  Instruction set selected
+     */
+    InstructionSet resetInstructionSet();
+
+    /**
+     * Returns the lower case name of an instruction set, eg "avx2".
+     */
+    const char * instructionSetName( InstructionSet isa );
+
+    /**
+     * Parses an instruction set name as returned by instructionSetName. The
+     * comparison is case insensitive, and "sse41" is accepted for "sse4.1".
+     *
+     * \param  pName  Name to parse
+     * \param  isa    Receives the instruction set if the name is valid
+     * \return        True if the name was recognized
+     */
+    bool parseInstructionSet( const char * pName, InstructionSet& isa );
+}
+
+#endif
@@ -0,0 +1,920 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_FASTMATH_H
+#define SCOTT_MATH_FASTMATH_H
+
+//
+// Fast approximations of the common transcendental functions and of the
+// (reciprocal) square root.
+//
+// Each function comes in a scalar float version, a 4-wide SSE version, an
+// 8-wide AVX2 version (when compiled for AVX2) and an array version that
+// processes a buffer using the widest lanes available. All versions share one
+// kernel, so they return the same results for the same inputs.
+//
+// The lanes used by the array versions are fixed when the calling code is
+// compiled. The equivalent functions in batch.h pick the widest lanes the
+// CPU supports at runtime instead.
+//
+// The polynomials are minimax fits, and the accuracy tier is picked at
+// compile time either globally with the MATH_FAST_PRECISION build option or
+// per call with the template argument:
+//
+//    Math::fast::sin( x );                       // MATH_FAST_PRECISION
+//    Math::fast::sin<Math::fast::Low>( x );      // ~1e-3 absolute error
+//
+// Double precision overloads simply forward to the standard library, which
+// allows templated code to call Math::fast for any floating point type.
+//
+#include <smath/config.h>
+#include <smath/constants.h>
+#include <smath/simd.h>
+
+#include <cmath>
+#include <cstddef>
+
+#ifndef MATH_FAST_PRECISION
+#   define MATH_FAST_PRECISION 3
+#endif
+
+namespace Math
+{
+namespace fast
+{
+inline namespace MATH_ISA_NAMESPACE
+{
+    /**
+     * Accuracy tiers for the fast math functions. Error bounds are the
+     * maximum absolute error (relative error for exp, pow and atan2) over
+     * the supported input range.
+     */
+    enum Precision
+    {
+        Low    = 1,     ///< Around 1e-3, fewest polynomial terms
+        Medium = 2,     ///< Around 1e-5
+        Full   = 3      ///< Within a few ulps of the correctly rounded result
+    };
+
+namespace detail
+{
+    using namespace Math::simd;
+
+    /**
+     * Polynomial coefficients for each accuracy tier. Each polynomial is
+     * evaluated in a reduced argument, see the kernels below.
+     */
+    template<int P> struct Tier;
+
+    template<> struct Tier<Low>
+    {
+        // sin(r) = r + r^3 * P(r^2), |r| <= pi/4
+        template<typename V> static V sinPoly( V z )
+        {
+            return horner( z, -1.624649254e-01f );
+        }
+
+        // cos(r) = 1 + r^2 * P(r^2), |r| <= pi/4
+        template<typename V> static V cosPoly( V z )
+        {
+            return horner( z, -4.997763071e-01f, 4.048893588e-02f );
+        }
+
+        // atan(t) = t + t^3 * P(t^2), |t| <= tan(pi/8)
+        template<typename V> static V atanPoly( V z )
+        {
+            return horner( z, -3.077358984e-01f );
+        }
+
+        // acos(x) = sqrt(1 - x) * P(x), 0 <= x <= 1
+        template<typename V> static V acosPoly( V x )
+        {
+            return horner( x, 1.570470259e+00f, -2.054975128e-01f,
+                              5.138949489e-02f );
+        }
+
+        // exp(r) = 1 + r + r^2 * P(r), |r| <= ln(2)/2
+        template<typename V> static V expPoly( V r )
+        {
+            return horner( r, 5.039410292e-01f, 1.666281108e-01f );
+        }
+
+        // log((1+s)/(1-s)) = 2s + s^3 * P(s^2), |s| <= 3 - 2*sqrt(2)
+        template<typename V> static V logPoly( V z )
+        {
+            return horner( z, 6.771028599e-01f );
+        }
+    };
+
+    template<> struct Tier<Medium>
+    {
+        template<typename V> static V sinPoly( V z )
+        {
+            return horner( z, -1.666345853e-01f, 8.164608749e-03f );
+        }
+
+        template<typename V> static V cosPoly( V z )
+        {
+            return horner( z, -4.999989478e-01f, 4.165629458e-02f,
+                              -1.359782313e-03f );
+        }
+
+        template<typename V> static V atanPoly( V z )
+        {
+            return horner( z, -3.332561496e-01f, 1.971615897e-01f,
+                              -1.123359070e-01f );
+        }
+
+        template<typename V> static V acosPoly( V x )
+        {
+            return horner( x, 1.570791534e+00f, -2.142806083e-01f,
+                              8.563836112e-02f, -3.761818520e-02f,
+                              9.732950632e-03f );
+        }
+
+        template<typename V> static V expPoly( V r )
+        {
+            return horner( r, 5.000511603e-01f, 1.675351393e-01f,
+                              4.127774709e-02f );
+        }
+
+        template<typename V> static V logPoly( V z )
+        {
+            return horner( z, 6.665342763e-01f, 4.128747222e-01f );
+        }
+    };
+
+    template<> struct Tier<Full>
+    {
+        template<typename V> static V sinPoly( V z )
+        {
+            return horner( z, -1.666665494e-01f, 8.332178147e-03f,
+                              -1.951729908e-04f );
+        }
+
+        template<typename V> static V cosPoly( V z )
+        {
+            return horner( z, -4.999999973e-01f, 4.166662332e-02f,
+                              -1.388676379e-03f, 2.439044988e-05f );
+        }
+
+        template<typename V> static V atanPoly( V z )
+        {
+            return horner( z, -3.333331551e-01f, 1.999848944e-01f,
+                              -1.424384875e-01f, 1.059600180e-01f,
+                              -6.083454197e-02f );
+        }
+
+        template<typename V> static V acosPoly( V x )
+        {
+            return horner( x, 1.570796314e+00f, -2.145998924e-01f,
+                              8.899926467e-02f, -5.031278199e-02f,
+                              3.133545954e-02f, -1.780896284e-02f,
+                              7.245428493e-03f, -1.441473156e-03f );
+        }
+
+        template<typename V> static V expPoly( V r )
+        {
+            return horner( r, 4.999999345e-01f, 1.666652069e-01f,
+                              4.166838738e-02f, 8.368709896e-03f,
+                              1.381461256e-03f );
+        }
+
+        template<typename V> static V logPoly( V z )
+        {
+            return horner( z, 6.666681670e-01f, 3.997360349e-01f,
+                              2.996126484e-01f );
+        }
+    };
+
+    // pi/2 split into three parts for Cody-Waite argument reduction
+    const float PiOver2A = 1.5703125f;
+    const float PiOver2B = 4.837512969970703125e-4f;
+    const float PiOver2C = 7.54978995489188216e-8f;
+
+    // ln(2) split into two parts for exp/log argument reduction
+    const float Ln2A = 0.693359375f;
+    const float Ln2B = -2.12194440e-4f;
+
+    /**
+     * Computes sine and cosine together. The argument is reduced to
+     * [-pi/4,pi/4] and the quadrant is used to pick and negate the
+     * polynomial results.
+     */
+    template<int P, typename V>
+    inline void sincos( V x, V& s, V& c )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        I q = roundToInt( mul( x, splat<V>( TwoOverPi ) ) );
+        V k = toFloat( q );
+
+        V r = madd( k, splat<V>( -PiOver2A ), x );
+        r   = madd( k, splat<V>( -PiOver2B ), r );
+        r   = madd( k, splat<V>( -PiOver2C ), r );
+
+        V z  = mul( r, r );
+        V sr = madd( mul( r, z ), Tier<P>::sinPoly( z ), r );
+        V cr = madd( z, Tier<P>::cosPoly( z ), splat<V>( 1.0f ) );
+
+        // Odd quadrants swap sine and cosine
+        I one  = splatInt<I>( 1 );
+        I two  = splatInt<I>( 2 );
+        auto swap = iequal( iand( q, one ), one );
+
+        s = select( swap, cr, sr );
+        c = select( swap, sr, cr );
+
+        // Quadrants 2,3 negate sine and quadrants 1,2 negate cosine
+        I sinSign = shiftLeft<30>( iand( q, two ) );
+        I cosSign = shiftLeft<30>( iand( iadd( q, one ), two ) );
+
+        s = asFloat( ixor( asInt( s ), sinSign ) );
+        c = asFloat( ixor( asInt( c ), cosSign ) );
+    }
+
+    template<int P, typename V>
+    inline V sin( V x )
+    {
+        V s, c;
+        sincos<P>( x, s, c );
+        return s;
+    }
+
+    template<int P, typename V>
+    inline V cos( V x )
+    {
+        V s, c;
+        sincos<P>( x, s, c );
+        return c;
+    }
+
+    /**
+     * Four quadrant arctangent. The ratio of the smaller to larger magnitude
+     * is reduced to [-tan(pi/8),tan(pi/8)] before evaluating the polynomial,
+     * and the octant is restored afterwards.
+     */
+    template<int P, typename V>
+    inline V atan2( V y, V x )
+    {
+        V one  = splat<V>( 1.0f );
+        V ax   = abs( x );
+        V ay   = abs( y );
+        V hi   = maximum( ax, ay );
+        V lo   = minimum( ax, ay );
+
+        // Ratio in [0,1], atan2(0,0) is defined to be zero
+        V t = select( equal( hi, splat<V>( 0.0f ) ),
+                      splat<V>( 0.0f ),
+                      div( lo, hi ) );
+
+        // atan(t) = pi/4 + atan((t-1)/(t+1)) for t > tan(pi/8)
+        auto upper = greaterThan( t, splat<V>( 0.41421356237f ) );
+        t = select( upper, div( sub( t, one ), add( t, one ) ), t );
+
+        V z = mul( t, t );
+        V a = madd( mul( t, z ), Tier<P>::atanPoly( z ), t );
+        a   = add( a, select( upper, splat<V>( QuarterPi ), splat<V>( 0.0f ) ) );
+
+        // Restore the octant and quadrant
+        a = select( greaterThan( ay, ax ), sub( splat<V>( HalfPi ), a ), a );
+        a = select( lessThan( x, splat<V>( 0.0f ) ), sub( splat<V>( Pi ), a ), a );
+
+        typedef typename IntLanes<V>::type I;
+        I signBit = iand( asInt( y ), splatInt<I>( static_cast<int32_t>( 0x80000000u ) ) );
+
+        return asFloat( ixor( asInt( a ), signBit ) );
+    }
+
+    /**
+     * Arc cosine for x in [-1,1], using acos(-x) = pi - acos(x).
+     */
+    template<int P, typename V>
+    inline V acos( V x )
+    {
+        V ax = abs( x );
+        V r  = mul( sqrt( sub( splat<V>( 1.0f ), ax ) ), Tier<P>::acosPoly( ax ) );
+
+        return select( lessThan( x, splat<V>( 0.0f ) ),
+                       sub( splat<V>( Pi ), r ),
+                       r );
+    }
+
+    /**
+     * Natural exponent. The input is split into k*ln(2) + r, and 2^k is
+     * applied by writing k directly into the exponent bits. Inputs are
+     * clamped to [-87,88] so the result never overflows or goes denormal.
+     */
+    template<int P, typename V>
+    inline V exp( V x )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        x = minimum( maximum( x, splat<V>( -87.0f ) ), splat<V>( 88.0f ) );
+
+        I k  = roundToInt( mul( x, splat<V>( Log2E ) ) );
+        V kf = toFloat( k );
+
+        V r = madd( kf, splat<V>( -Ln2A ), x );
+        r   = madd( kf, splat<V>( -Ln2B ), r );
+
+        V p = madd( mul( r, r ), Tier<P>::expPoly( r ),
+                    add( r, splat<V>( 1.0f ) ) );
+
+        V scale = asFloat( shiftLeft<23>( iadd( k, splatInt<I>( 127 ) ) ) );
+        return mul( p, scale );
+    }
+
+    /**
+     * Natural logarithm for positive, normal inputs. The input is split into
+     * m * 2^e with m in [sqrt(1/2),sqrt(2)), and log(m) is evaluated using
+     * s = (m-1)/(m+1).
+     */
+    template<int P, typename V>
+    inline V log( V x )
+    {
+        typedef typename IntLanes<V>::type I;
+
+        I bits = asInt( x );
+        I e    = isub( shiftRight<23>( bits ), splatInt<I>( 127 ) );
+        V m    = asFloat( ior( iand( bits, splatInt<I>( 0x007fffff ) ),
+                               splatInt<I>( 0x3f800000 ) ) );
+
+        auto upper = greaterThan( m, splat<V>( SqrtTwo ) );
+        m = select( upper, mul( m, splat<V>( 0.5f ) ), m );
+
+        V ef = add( toFloat( e ),
+                    select( upper, splat<V>( 1.0f ), splat<V>( 0.0f ) ) );
+
+        V one = splat<V>( 1.0f );
+        V s   = div( sub( m, one ), add( m, one ) );
+        V z   = mul( s, s );
+        V lm  = madd( mul( s, z ), Tier<P>::logPoly( z ), add( s, s ) );
+
+        return madd( ef, splat<V>( Ln2A ), madd( ef, splat<V>( Ln2B ), lm ) );
+    }
+
+    /**
+     * Power function for positive x, computed as exp(y * log(x)).
+     */
+    template<int P, typename V>
+    inline V pow( V x, V y )
+    {
+        return exp<P>( mul( y, log<P>( x ) ) );
+    }
+
+    /**
+     * Reciprocal square root. The hardware estimate is refined with one
+     * Newton-Raphson step, y' = y * (1.5 - 0.5 * x * y * y), except at the
+     * lowest tier which uses the raw estimate.
+     */
+    template<int P, typename V>
+    inline V rsqrt( V x )
+    {
+        V y = rsqrtEstimate( x );
+
+        if ( P != Low )
+        {
+            V hx = mul( x, splat<V>( 0.5f ) );
+            y = mul( y, sub( splat<V>( 1.5f ), mul( mul( hx, y ), y ) ) );
+
+#ifndef MATH_SSE2
+            // The integer estimate needs a second step to reach full accuracy
+            if ( P == Full )
+            {
+                y = mul( y, sub( splat<V>( 1.5f ), mul( mul( hx, y ), y ) ) );
+            }
+#endif
+        }
+
+        return y;
+    }
+
+    /**
+     * Square root computed as x * rsqrt(x), with zero mapped to zero.
+     */
+    template<int P, typename V>
+    inline V sqrt( V x )
+    {
+        V zero = splat<V>( 0.0f );
+        return select( equal( x, zero ), zero, mul( x, rsqrt<P>( x ) ) );
+    }
+
+    /**
+     * Applies a unary lane operation over an array, using the widest lanes
+     * available and falling back to scalar code for the remainder.
+     */
+    template<typename Op>
+    inline void transform( float * pOut, const float * pIn, size_t count, Op op )
+    {
+        size_t i = 0;
+
+#ifdef MATH_AVX512
+        for ( ; i + 16 <= count; i += 16 )
+        {
+            store( pOut + i, op( load<__m512>( pIn + i ) ) );
+        }
+#endif
+
+#ifdef MATH_AVX2
+        for ( ; i + 8 <= count; i += 8 )
+        {
+            store( pOut + i, op( load<__m256>( pIn + i ) ) );
+        }
+#endif
+
+#ifdef MATH_SSE2
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            store( pOut + i, op( load<__m128>( pIn + i ) ) );
+        }
+#endif
+
+        for ( ; i < count; ++i )
+        {
+            pOut[i] = op( pIn[i] );
+        }
+    }
+
+    /**
+     * Applies a binary lane operation over a pair of arrays.
+     */
+    template<typename Op>
+    inline void transform( float * pOut,
+                           const float * pA,
+                           const float * pB,
+                           size_t count,
+                           Op op )
+    {
+        size_t i = 0;
+
+#ifdef MATH_AVX512
+        for ( ; i + 16 <= count; i += 16 )
+        {
+            store( pOut + i, op( load<__m512>( pA + i ), load<__m512>( pB + i ) ) );
+        }
+#endif
+
+#ifdef MATH_AVX2
+        for ( ; i + 8 <= count; i += 8 )
+        {
+            store( pOut + i, op( load<__m256>( pA + i ), load<__m256>( pB + i ) ) );
+        }
+#endif
+
+#ifdef MATH_SSE2
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            store( pOut + i, op( load<__m128>( pA + i ), load<__m128>( pB + i ) ) );
+        }
+#endif
+
+        for ( ; i < count; ++i )
+        {
+            pOut[i] = op( pA[i], pB[i] );
+        }
+    }
+
+    /**
+     * Applies a ternary lane operation over three arrays.
+     */
+    template<typename Op>
+    inline void transform( float * pOut,
+                           const float * pA,
+                           const float * pB,
+                           const float * pC,
+                           size_t count,
+                           Op op )
+    {
+        size_t i = 0;
+
+#ifdef MATH_AVX512
+        for ( ; i + 16 <= count; i += 16 )
+        {
+            store( pOut + i, op( load<__m512>( pA + i ),
+                                 load<__m512>( pB + i ),
+                                 load<__m512>( pC + i ) ) );
+        }
+#endif
+
+#ifdef MATH_AVX2
+        for ( ; i + 8 <= count; i += 8 )
+        {
+            store( pOut + i, op( load<__m256>( pA + i ),
+                                 load<__m256>( pB + i ),
+                                 load<__m256>( pC + i ) ) );
+        }
+#endif
+
+#ifdef MATH_SSE2
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            store( pOut + i, op( load<__m128>( pA + i ),
+                                 load<__m128>( pB + i ),
+                                 load<__m128>( pC + i ) ) );
+        }
+#endif
+
+        for ( ; i < count; ++i )
+        {
+            pOut[i] = op( pA[i], pB[i], pC[i] );
+        }
+    }
+
+    /**
+     * Applies a lane operation with two results over an array, such as
+     * computing the sine and cosine together.
+     */
+    template<typename Op>
+    inline void transform( float * pOutA,
+                           float * pOutB,
+                           const float * pIn,
+                           size_t count,
+                           Op op )
+    {
+        size_t i = 0;
+
+#ifdef MATH_AVX512
+        for ( ; i + 16 <= count; i += 16 )
+        {
+            __m512 a, b;
+            op( load<__m512>( pIn + i ), a, b );
+
+            store( pOutA + i, a );
+            store( pOutB + i, b );
+        }
+#endif
+
+#ifdef MATH_AVX2
+        for ( ; i + 8 <= count; i += 8 )
+        {
+            __m256 a, b;
+            op( load<__m256>( pIn + i ), a, b );
+
+            store( pOutA + i, a );
+            store( pOutB + i, b );
+        }
+#endif
+
+#ifdef MATH_SSE2
+        for ( ; i + 4 <= count; i += 4 )
+        {
+            __m128 a, b;
+            op( load<__m128>( pIn + i ), a, b );
+
+            store( pOutA + i, a );
+            store( pOutB + i, b );
+        }
+#endif
+
+        for ( ; i < count; ++i )
+        {
+            op( pIn[i], pOutA[i], pOutB[i] );
+        }
+    }
+
+    template<int P> struct SinCosOp
+    {
+        template<typename V> void operator()( V x, V& s, V& c ) const { sincos<P>( x, s, c ); }
+    };
+
+    template<int P> struct SinOp
+    {
+        template<typename V> V operator()( V x ) const { return sin<P>( x ); }
+    };
+
+    template<int P> struct CosOp
+    {
+        template<typename V> V operator()( V x ) const { return cos<P>( x ); }
+    };
+
+    template<int P> struct AcosOp
+    {
+        template<typename V> V operator()( V x ) const { return acos<P>( x ); }
+    };
+
+    template<int P> struct ExpOp
+    {
+        template<typename V> V operator()( V x ) const { return exp<P>( x ); }
+    };
+
+    template<int P> struct LogOp
+    {
+        template<typename V> V operator()( V x ) const { return log<P>( x ); }
+    };
+
+    template<int P> struct RsqrtOp
+    {
+        template<typename V> V operator()( V x ) const { return rsqrt<P>( x ); }
+    };
+
+    template<int P> struct SqrtOp
+    {
+        template<typename V> V operator()( V x ) const { return sqrt<P>( x ); }
+    };
+
+    template<int P> struct Atan2Op
+    {
+        template<typename V> V operator()( V y, V x ) const { return atan2<P>( y, x ); }
+    };
+
+    template<int P> struct PowOp
+    {
+        template<typename V> V operator()( V x, V y ) const { return pow<P>( x, y ); }
+    };
+}
+
+    /////////////////////////////////////////////////////////////////////////
+    // Scalar single precision
+    /////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Approximates sin(x) for x in radians. Argument reduction is accurate
+     * for |x| up to about 1e5.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float sin( float x )
+    {
+        return detail::sin<P>( x );
+    }
+
+    /**
+     * Approximates cos(x) for x in radians. Argument reduction is accurate
+     * for |x| up to about 1e5.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float cos( float x )
+    {
+        return detail::cos<P>( x );
+    }
+
+    /**
+     * Approximates the sine and cosine of x at the cost of a single call.
+     *
+     * \param  x  Angle in radians
+     * \param  s  Receives the sine of x
+     * \param  c  Receives the cosine of x
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline void sincos( float x, float& s, float& c )
+    {
+        detail::sincos<P>( x, s, c );
+    }
+
+    /**
+     * Approximates the four quadrant arctangent of y/x, in [-pi,pi].
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float atan2( float y, float x )
+    {
+        return detail::atan2<P>( y, x );
+    }
+
+    /**
+     * Approximates acos(x) for x in [-1,1], returning a value in [0,pi].
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float acos( float x )
+    {
+        return detail::acos<P>( x );
+    }
+
+    /**
+     * Approximates e^x. Inputs are clamped to [-87,88].
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float exp( float x )
+    {
+        return detail::exp<P>( x );
+    }
+
+    /**
+     * Approximates the natural logarithm of x. The result is undefined
+     * for zero, negative and denormal inputs.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float log( float x )
+    {
+        return detail::log<P>( x );
+    }
+
+    /**
+     * Approximates x^y for positive x.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float pow( float x, float y )
+    {
+        return detail::pow<P>( x, y );
+    }
+
+    /**
+     * Approximates 1/sqrt(x) for positive x. Returns infinity for zero.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float rsqrt( float x )
+    {
+        return detail::rsqrt<P>( x );
+    }
+
+    /**
+     * Approximates sqrt(x) for non-negative, finite x.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline float sqrt( float x )
+    {
+        return detail::sqrt<P>( x );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Scalar double precision (forwards to the standard library)
+    /////////////////////////////////////////////////////////////////////////
+    inline double sin( double x ) { return std::sin( x ); }
+    inline double cos( double x ) { return std::cos( x ); }
+    inline double atan2( double y, double x ) { return std::atan2( y, x ); }
+    inline double acos( double x ) { return std::acos( x ); }
+    inline double exp( double x ) { return std::exp( x ); }
+    inline double log( double x ) { return std::log( x ); }
+    inline double pow( double x, double y ) { return std::pow( x, y ); }
+    inline double rsqrt( double x ) { return 1.0 / std::sqrt( x ); }
+    inline double sqrt( double x ) { return std::sqrt( x ); }
+
+    inline void sincos( double x, double& s, double& c )
+    {
+        s = std::sin( x );
+        c = std::cos( x );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // 4-wide SSE
+    /////////////////////////////////////////////////////////////////////////
+#ifdef MATH_SSE2
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 sin( __m128 x ) { return detail::sin<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 cos( __m128 x ) { return detail::cos<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline void sincos( __m128 x, __m128& s, __m128& c ) { detail::sincos<P>( x, s, c ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 atan2( __m128 y, __m128 x ) { return detail::atan2<P>( y, x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 acos( __m128 x ) { return detail::acos<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 exp( __m128 x ) { return detail::exp<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 log( __m128 x ) { return detail::log<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 pow( __m128 x, __m128 y ) { return detail::pow<P>( x, y ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 rsqrt( __m128 x ) { return detail::rsqrt<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m128 sqrt( __m128 x ) { return detail::sqrt<P>( x ); }
+#endif
+
+    /////////////////////////////////////////////////////////////////////////
+    // 8-wide AVX2
+    /////////////////////////////////////////////////////////////////////////
+#ifdef MATH_AVX2
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 sin( __m256 x ) { return detail::sin<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 cos( __m256 x ) { return detail::cos<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline void sincos( __m256 x, __m256& s, __m256& c ) { detail::sincos<P>( x, s, c ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 atan2( __m256 y, __m256 x ) { return detail::atan2<P>( y, x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 acos( __m256 x ) { return detail::acos<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 exp( __m256 x ) { return detail::exp<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 log( __m256 x ) { return detail::log<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 pow( __m256 x, __m256 y ) { return detail::pow<P>( x, y ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 rsqrt( __m256 x ) { return detail::rsqrt<P>( x ); }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline __m256 sqrt( __m256 x ) { return detail::sqrt<P>( x ); }
+#endif
+
+    /////////////////////////////////////////////////////////////////////////
+    // Arrays
+    /////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Computes sin() for every value in an array. The output may alias the
+     * input.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline void sin( float * pOut, const float * pIn, size_t count )
+    {
+        detail::transform( pOut, pIn, count, detail::SinOp<P>() );
+    }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline void cos( float * pOut, const float * pIn, size_t count )
+    {
+        detail::transform( pOut, pIn, count, detail::CosOp<P>() );
+    }
+
+    /**
+     * Computes the sine and cosine of every value in an array at the cost of
+     * one evaluation each.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline void sincos( float * pSin, float * pCos, const float * pIn, size_t count )
+    {
+        detail::transform( pSin, pCos, pIn, count, detail::SinCosOp<P>() );
+    }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline void acos( float * pOut, const float * pIn, size_t count )
+    {
+        detail::transform( pOut, pIn, count, detail::AcosOp<P>() );
+    }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline void exp( float * pOut, const float * pIn, size_t count )
+    {
+        detail::transform( pOut, pIn, count, detail::ExpOp<P>() );
+    }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline void log( float * pOut, const float * pIn, size_t count )
+    {
+        detail::transform( pOut, pIn, count, detail::LogOp<P>() );
+    }
+
+    /**
+     * Computes 1/sqrt() for every value in an array, eg to normalize a batch
+     * of vectors from their squared lengths.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline void rsqrt( float * pOut, const float * pIn, size_t count )
+    {
+        detail::transform( pOut, pIn, count, detail::RsqrtOp<P>() );
+    }
+
+    template<int P = MATH_FAST_PRECISION>
+    inline void sqrt( float * pOut, const float * pIn, size_t count )
+    {
+        detail::transform( pOut, pIn, count, detail::SqrtOp<P>() );
+    }
+
+    /**
+     * Computes atan2(y[i], x[i]) for every pair of values in two arrays.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline void atan2( float * pOut,
+                       const float * pY,
+                       const float * pX,
+                       size_t count )
+    {
+        detail::transform( pOut, pY, pX, count, detail::Atan2Op<P>() );
+    }
+
+    /**
+     * Computes pow(x[i], y[i]) for every pair of values in two arrays.
+     */
+    template<int P = MATH_FAST_PRECISION>
+    inline void pow( float * pOut,
+                     const float * pX,
+                     const float * pY,
+                     size_t count )
+    {
+        detail::transform( pOut, pX, pY, count, detail::PowOp<P>() );
+    }
+}
+}
+}
+
+#endif
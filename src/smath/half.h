@@ -0,0 +1,318 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_HALF_H
+#define SCOTT_MATH_HALF_H
+
+//
+// 16 bit floating point scalar types for storing large vector buffers at
+// half the memory and bandwidth:
+//
+//   Type       Significant bits   Range
+//   half       11                 65504, subnormals down to 6e-8
+//   bfloat16   8                  same as float
+//
+// Both are storage types. They convert implicitly to and from float, and
+// all arithmetic happens in float with the result rounded back when it is
+// stored, so TVector3<Math::half> and friends work like their float
+// versions with a rounding after every operation. For anything more than a
+// few operations, convert whole arrays to float with Math::batch::convert,
+// do the work, and convert back.
+//
+// Single half conversions use the F16C instructions when the code is built
+// for them, and the portable conversion in packing.h otherwise. The batch
+// conversions always use the best instruction set the CPU has.
+//
+#include <smath/config.h>
+#include <smath/packing.h>
+#include <smath/simd.h>
+#include <smath/vector.h>
+
+#include <cstddef>
+#include <limits>
+#include <stdint.h>
+
+namespace Math
+{
+    /**
+     * IEEE 754 half precision float.
+     */
+    class half
+    {
+    public:
+        /**
+         * Leaves the value uninitialized, like a float.
+         */
+        half() = default;
+
+        /**
+         * Converts a float to the nearest half, see Math::packHalf.
+         */
+        half( float value )
+#ifdef MATH_F16C
+            : mBits( static_cast<uint16_t>( _cvtss_sh( value, _MM_FROUND_TO_NEAREST_INT ) ) )
+#else
+            : mBits( packHalf( value ) )
+#endif
+        {
+        }
+
+        /**
+         * Converts the half to float, exactly.
+         */
+        operator float() const
+        {
+#ifdef MATH_F16C
+            return _cvtsh_ss( mBits );
+#else
+            return unpackHalf( mBits );
+#endif
+        }
+
+        /**
+         * Returns a half with the given IEEE binary16 bits.
+         */
+        static constexpr half fromBits( uint16_t bits )
+        {
+            return half( bits, BitsTag() );
+        }
+
+        /**
+         * Returns the IEEE binary16 bits of the value.
+         */
+        constexpr uint16_t bits() const
+        {
+            return mBits;
+        }
+
+        half& operator += ( float rhs ) { return *this = *this + rhs; }
+        half& operator -= ( float rhs ) { return *this = *this - rhs; }
+        half& operator *= ( float rhs ) { return *this = *this * rhs; }
+        half& operator /= ( float rhs ) { return *this = *this / rhs; }
+
+    private:
+        struct BitsTag { };
+
+        constexpr half( uint16_t bits, BitsTag )
+            : mBits( bits )
+        {
+        }
+
+    private:
+        uint16_t mBits;
+    };
+
+    /**
+     * Brain floating point, the upper 16 bits of a float. It has the range
+     * of a float with less precision than half, which suits values that span
+     * many magnitudes.
+     */
+    class bfloat16
+    {
+    public:
+        /**
+         * Leaves the value uninitialized, like a float.
+         */
+        bfloat16() = default;
+
+        /**
+         * Converts a float to the nearest bfloat16, see Math::packBFloat16.
+         */
+        bfloat16( float value )
+            : mBits( packBFloat16( value ) )
+        {
+        }
+
+        /**
+         * Converts the bfloat16 to float, exactly.
+         */
+        operator float() const
+        {
+            return unpackBFloat16( mBits );
+        }
+
+        /**
+         * Returns a bfloat16 with the given bits.
+         */
+        static constexpr bfloat16 fromBits( uint16_t bits )
+        {
+            return bfloat16( bits, BitsTag() );
+        }
+
+        /**
+         * Returns the bits of the value, the upper half of the float bits.
+         */
+        constexpr uint16_t bits() const
+        {
+            return mBits;
+        }
+
+        bfloat16& operator += ( float rhs ) { return *this = *this + rhs; }
+        bfloat16& operator -= ( float rhs ) { return *this = *this - rhs; }
+        bfloat16& operator *= ( float rhs ) { return *this = *this * rhs; }
+        bfloat16& operator /= ( float rhs ) { return *this = *this / rhs; }
+
+    private:
+        struct BitsTag { };
+
+        constexpr bfloat16( uint16_t bits, BitsTag )
+            : mBits( bits )
+        {
+        }
+
+    private:
+        uint16_t mBits;
+    };
+
+namespace batch
+{
+    /**
+     * Converts count values between float and a 16 bit type, rounding to
+     * nearest even. Vector overloads convert every component.
+     */
+    void convert( const float * pIn, half * pOut, size_t count );
+    void convert( const half * pIn, float * pOut, size_t count );
+    void convert( const float * pIn, bfloat16 * pOut, size_t count );
+    void convert( const bfloat16 * pIn, float * pOut, size_t count );
+
+    template<typename T>
+    void convert( const TVector2<float> * pIn, TVector2<T> * pOut, size_t count )
+    {
+        convert( reinterpret_cast<const float *>( pIn ), reinterpret_cast<T *>( pOut ), 2 * count );
+    }
+
+    template<typename T>
+    void convert( const TVector3<float> * pIn, TVector3<T> * pOut, size_t count )
+    {
+        convert( reinterpret_cast<const float *>( pIn ), reinterpret_cast<T *>( pOut ), 3 * count );
+    }
+
+    template<typename T>
+    void convert( const TVector4<float> * pIn, TVector4<T> * pOut, size_t count )
+    {
+        convert( reinterpret_cast<const float *>( pIn ), reinterpret_cast<T *>( pOut ), 4 * count );
+    }
+
+    template<typename T>
+    void convert( const TVector2<T> * pIn, TVector2<float> * pOut, size_t count )
+    {
+        convert( reinterpret_cast<const T *>( pIn ), reinterpret_cast<float *>( pOut ), 2 * count );
+    }
+
+    template<typename T>
+    void convert( const TVector3<T> * pIn, TVector3<float> * pOut, size_t count )
+    {
+        convert( reinterpret_cast<const T *>( pIn ), reinterpret_cast<float *>( pOut ), 3 * count );
+    }
+
+    template<typename T>
+    void convert( const TVector4<T> * pIn, TVector4<float> * pOut, size_t count )
+    {
+        convert( reinterpret_cast<const T *>( pIn ), reinterpret_cast<float *>( pOut ), 4 * count );
+    }
+}
+}
+
+namespace std
+{
+    template<>
+    class numeric_limits<Math::half>
+    {
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = false;
+        static constexpr bool has_infinity = true;
+        static constexpr bool has_quiet_NaN = true;
+        static constexpr bool has_signaling_NaN = true;
+        static constexpr float_denorm_style has_denorm = denorm_present;
+        static constexpr bool has_denorm_loss = false;
+        static constexpr float_round_style round_style = round_to_nearest;
+        static constexpr bool is_iec559 = true;
+        static constexpr bool is_bounded = true;
+        static constexpr bool is_modulo = false;
+        static constexpr int digits = 11;
+        static constexpr int digits10 = 3;
+        static constexpr int max_digits10 = 5;
+        static constexpr int radix = 2;
+        static constexpr int min_exponent = -13;
+        static constexpr int min_exponent10 = -4;
+        static constexpr int max_exponent = 16;
+        static constexpr int max_exponent10 = 4;
+        static constexpr bool traps = false;
+        static constexpr bool tinyness_before = false;
+
+        static constexpr Math::half min() { return Math::half::fromBits( 0x0400 ); }
+        static constexpr Math::half lowest() { return Math::half::fromBits( 0xfbff ); }
+        static constexpr Math::half max() { return Math::half::fromBits( 0x7bff ); }
+        static constexpr Math::half epsilon() { return Math::half::fromBits( 0x1400 ); }
+        static constexpr Math::half round_error() { return Math::half::fromBits( 0x3800 ); }
+        static constexpr Math::half infinity() { return Math::half::fromBits( 0x7c00 ); }
+        static constexpr Math::half quiet_NaN() { return Math::half::fromBits( 0x7e00 ); }
+        static constexpr Math::half signaling_NaN() { return Math::half::fromBits( 0x7d00 ); }
+        static constexpr Math::half denorm_min() { return Math::half::fromBits( 0x0001 ); }
+    };
+
+    template<>
+    class numeric_limits<Math::bfloat16>
+    {
+    public:
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = false;
+        static constexpr bool is_exact = false;
+        static constexpr bool has_infinity = true;
+        static constexpr bool has_quiet_NaN = true;
+        static constexpr bool has_signaling_NaN = true;
+        static constexpr float_denorm_style has_denorm = denorm_present;
+        static constexpr bool has_denorm_loss = false;
+        static constexpr float_round_style round_style = round_to_nearest;
+        static constexpr bool is_iec559 = false;
+        static constexpr bool is_bounded = true;
+        static constexpr bool is_modulo = false;
+        static constexpr int digits = 8;
+        static constexpr int digits10 = 2;
+        static constexpr int max_digits10 = 4;
+        static constexpr int radix = 2;
+        static constexpr int min_exponent = -125;
+        static constexpr int min_exponent10 = -37;
+        static constexpr int max_exponent = 128;
+        static constexpr int max_exponent10 = 38;
+        static constexpr bool traps = false;
+        static constexpr bool tinyness_before = false;
+
+        static constexpr Math::bfloat16 min() { return Math::bfloat16::fromBits( 0x0080 ); }
+        static constexpr Math::bfloat16 lowest() { return Math::bfloat16::fromBits( 0xff7f ); }
+        static constexpr Math::bfloat16 max() { return Math::bfloat16::fromBits( 0x7f7f ); }
+        static constexpr Math::bfloat16 epsilon() { return Math::bfloat16::fromBits( 0x3c00 ); }
+        static constexpr Math::bfloat16 round_error() { return Math::bfloat16::fromBits( 0x3f00 ); }
+        static constexpr Math::bfloat16 infinity() { return Math::bfloat16::fromBits( 0x7f80 ); }
+        static constexpr Math::bfloat16 quiet_NaN() { return Math::bfloat16::fromBits( 0x7fc0 ); }
+        static constexpr Math::bfloat16 signaling_NaN() { return Math::bfloat16::fromBits( 0x7fa0 ); }
+        static constexpr Math::bfloat16 denorm_min() { return Math::bfloat16::fromBits( 0x0001 ); }
+    };
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Vector typedefs
+/////////////////////////////////////////////////////////////////////////////
+#ifdef MATH_TYPEDEFS
+typedef TVector4<Math::half> Vec4h;
+typedef TVector3<Math::half> Vec3h;
+typedef TVector2<Math::half> Vec2h;
+#endif
+
+#endif
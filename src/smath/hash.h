@@ -0,0 +1,356 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_HASH_H
+#define SCOTT_MATH_HASH_H
+
+//
+// Hash functions for floating point values, vectors, quaternions and
+// matrices, intended for use as hash table keys (vertex welding, transform
+// caches and so on). Integer vectors, such as grid cell coordinates, hash
+// their raw bits.
+//
+// Values are canonicalized before hashing so that values with the same
+// exact value hash equal: -0 and +0 produce the same hash, as do all NaN
+// payloads. The canonical bits are then mixed with a wyhash style
+// 64x64 -> 128 bit multiply-fold, which is order sensitive and passes
+// avalanche tests unlike the XOR folding it replaces.
+//
+// Vector operator== compares within an epsilon when MATH_FUZZY_EQUALS is
+// on, and values that are only close hash differently. Hash tables must
+// pair Hasher with ExactEqual, which compares the canonical bits.
+//
+// Hashes are stable across platforms and instruction sets, but not across
+// library versions; don't persist them.
+//
+#include <smath/config.h>
+#include <smath/vector.h>
+#include <smath/quaternion.h>
+#include <smath/matrix.h>
+
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#   include <intrin.h>
+#   pragma intrinsic(_umul128)
+#endif
+
+namespace Math
+{
+namespace detail
+{
+    // Mixing constants from wyhash (public domain)
+    const uint64_t HashSecret0 = 0xa0761d6478bd642full;
+    const uint64_t HashSecret1 = 0xe7037ed1a0b428dbull;
+    const uint64_t HashSecret2 = 0x8ebc6af09c88c6e3ull;
+    const uint64_t HashSecret3 = 0x589965cc75374cc3ull;
+
+    /**
+     * Multiplies two 64 bit values into a 128 bit product, and folds the
+     * product back into 64 bits by XORing the halves.
+     */
+    inline uint64_t mum( uint64_t a, uint64_t b )
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 uint128;
+        uint128 r = static_cast<uint128>( a ) * b;
+        return static_cast<uint64_t>( r ) ^ static_cast<uint64_t>( r >> 64 );
+#elif defined(_MSC_VER) && defined(_M_X64)
+        uint64_t hi;
+        uint64_t lo = _umul128( a, b, &hi );
+        return lo ^ hi;
+#else
+        uint64_t ha = a >> 32, la = a & 0xffffffffull;
+        uint64_t hb = b >> 32, lb = b & 0xffffffffull;
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+        uint64_t t  = rl + ( rm0 << 32 );
+        uint64_t c  = ( t < rl );
+        uint64_t lo = t + ( rm1 << 32 );
+        c += ( lo < t );
+        uint64_t hi = rh + ( rm0 >> 32 ) + ( rm1 >> 32 ) + c;
+        return lo ^ hi;
+#endif
+    }
+
+    /**
+     * Finalizes a hash state and the number of bytes that were hashed.
+     */
+    inline uint64_t hashFinish( uint64_t a, uint64_t b, uint64_t seed, size_t bytes )
+    {
+        return mum( HashSecret1 ^ static_cast<uint64_t>( bytes ),
+                    mum( a ^ HashSecret1, b ^ seed ) );
+    }
+
+    /**
+     * Returns the bits of a float, with -0 mapped to +0 and every NaN mapped
+     * to the same quiet NaN.
+     */
+    inline uint32_t canonicalBits( float v )
+    {
+        if ( v != v )
+        {
+            return 0x7fc00000u;
+        }
+        else if ( v == 0.0f )
+        {
+            return 0u;
+        }
+
+        uint32_t bits;
+        std::memcpy( &bits, &v, sizeof( bits ) );
+        return bits;
+    }
+
+    /**
+     * Returns the bits of a double, with -0 mapped to +0 and every NaN
+     * mapped to the same quiet NaN.
+     */
+    inline uint64_t canonicalBits( double v )
+    {
+        if ( v != v )
+        {
+            return 0x7ff8000000000000ull;
+        }
+        else if ( v == 0.0 )
+        {
+            return 0u;
+        }
+
+        uint64_t bits;
+        std::memcpy( &bits, &v, sizeof( bits ) );
+        return bits;
+    }
+}
+
+    /**
+     * Computes a 64 bit hash of an array of floats. Large arrays are
+     * canonicalized several values at a time with SSE/AVX2.
+     *
+     * \param  pValues  Pointer to the values to hash
+     * \param  count    Number of values in the array
+     * \param  seed     Optional seed, to produce independent hash functions
+     * \return          Numeric hash code
+     */
+    uint64_t hash( const float * pValues, size_t count, uint64_t seed = 0 );
+
+    /**
+     * Computes a 64 bit hash of an array of doubles.
+     *
+     * \param  pValues  Pointer to the values to hash
+     * \param  count    Number of values in the array
+     * \param  seed     Optional seed, to produce independent hash functions
+     * \return          Numeric hash code
+     */
+    uint64_t hash( const double * pValues, size_t count, uint64_t seed = 0 );
+
+    /**
+     * Computes a 64 bit hash of an array of 32 bit integers. Integers have
+     * a single representation per value, and are hashed as they are.
+     *
+     * \param  pValues  Pointer to the values to hash
+     * \param  count    Number of values in the array
+     * \param  seed     Optional seed, to produce independent hash functions
+     * \return          Numeric hash code
+     */
+    uint64_t hash( const int32_t * pValues, size_t count, uint64_t seed = 0 );
+
+    /**
+     * Computes a 64 bit hash of a single float.
+     */
+    inline uint64_t hash( float value, uint64_t seed = 0 )
+    {
+        uint64_t bits = detail::canonicalBits( value );
+        return detail::hashFinish( bits, 0, seed ^ detail::HashSecret0, sizeof( float ) );
+    }
+
+    /**
+     * Computes a 64 bit hash of a single double.
+     */
+    inline uint64_t hash( double value, uint64_t seed = 0 )
+    {
+        uint64_t bits = detail::canonicalBits( value );
+        return detail::hashFinish( bits, 0, seed ^ detail::HashSecret0, sizeof( double ) );
+    }
+
+    /**
+     * Computes a 64 bit hash of a single 32 bit integer.
+     */
+    inline uint64_t hash( int32_t value, uint64_t seed = 0 )
+    {
+        uint64_t bits = static_cast<uint32_t>( value );
+        return detail::hashFinish( bits, 0, seed ^ detail::HashSecret0, sizeof( int32_t ) );
+    }
+
+    template<typename T>
+    uint64_t hash( const TVector2<T>& v, uint64_t seed = 0 )
+    {
+        return hash( v.ptr(), 2, seed );
+    }
+
+    template<typename T>
+    uint64_t hash( const TVector3<T>& v, uint64_t seed = 0 )
+    {
+        return hash( v.ptr(), 3, seed );
+    }
+
+    template<typename T>
+    uint64_t hash( const TVector4<T>& v, uint64_t seed = 0 )
+    {
+        return hash( v.ptr(), 4, seed );
+    }
+
+    /**
+     * Compares values the way they are hashed: equal when every component
+     * has the same canonical bits, so -0 equals +0 and NaN equals NaN, and
+     * with no epsilon.
+     */
+    inline bool exactlyEqual( const float * pA, const float * pB, size_t count )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            if ( detail::canonicalBits( pA[i] ) != detail::canonicalBits( pB[i] ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline bool exactlyEqual( const double * pA, const double * pB, size_t count )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            if ( detail::canonicalBits( pA[i] ) != detail::canonicalBits( pB[i] ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline bool exactlyEqual( const int32_t * pA, const int32_t * pB, size_t count )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            if ( pA[i] != pB[i] )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline bool exactlyEqual( float a, float b )
+    {
+        return detail::canonicalBits( a ) == detail::canonicalBits( b );
+    }
+
+    inline bool exactlyEqual( double a, double b )
+    {
+        return detail::canonicalBits( a ) == detail::canonicalBits( b );
+    }
+
+    inline bool exactlyEqual( int32_t a, int32_t b )
+    {
+        return a == b;
+    }
+
+    template<typename T>
+    bool exactlyEqual( const TVector2<T>& a, const TVector2<T>& b )
+    {
+        return exactlyEqual( a.ptr(), b.ptr(), 2 );
+    }
+
+    template<typename T>
+    bool exactlyEqual( const TVector3<T>& a, const TVector3<T>& b )
+    {
+        return exactlyEqual( a.ptr(), b.ptr(), 3 );
+    }
+
+    template<typename T>
+    bool exactlyEqual( const TVector4<T>& a, const TVector4<T>& b )
+    {
+        return exactlyEqual( a.ptr(), b.ptr(), 4 );
+    }
+
+    template<typename T>
+    bool exactlyEqual( const TQuaternion<T>& a, const TQuaternion<T>& b )
+    {
+        return exactlyEqual( &a[0], &b[0], 4 );
+    }
+
+    template<typename T>
+    bool exactlyEqual( const TMatrix4<T>& a, const TMatrix4<T>& b )
+    {
+        return exactlyEqual( a.ptr(), b.ptr(), 16 );
+    }
+
+    /**
+     * Hashes the quaternion's components. Note that q and -q represent the
+     * same rotation but do not compare equal, and so hash differently.
+     */
+    template<typename T>
+    uint64_t hash( const TQuaternion<T>& q, uint64_t seed = 0 )
+    {
+        return hash( &q[0], 4, seed );
+    }
+
+    template<typename T>
+    uint64_t hash( const TMatrix4<T>& m, uint64_t seed = 0 )
+    {
+        return hash( m.ptr(), 16, seed );
+    }
+
+    /**
+     * Folds a 64 bit hash down to 32 bits.
+     */
+    inline uint32_t hash32( uint64_t h )
+    {
+        return static_cast<uint32_t>( h ) ^ static_cast<uint32_t>( h >> 32 );
+    }
+
+    /**
+     * Hash function object for use with std::unordered_map and friends,
+     * together with ExactEqual, eg
+     * std::unordered_map<Vector3, int, Math::Hasher, Math::ExactEqual>.
+     */
+    struct Hasher
+    {
+        template<typename K>
+        size_t operator()( const K& key ) const
+        {
+            return static_cast<size_t>( hash( key ) );
+        }
+    };
+
+    /**
+     * Key equality function object matching Hasher, see exactlyEqual.
+     */
+    struct ExactEqual
+    {
+        template<typename K>
+        bool operator()( const K& a, const K& b ) const
+        {
+            return exactlyEqual( a, b );
+        }
+    };
+}
+
+#endif
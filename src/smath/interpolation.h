@@ -17,6 +17,7 @@
 #define SCOTT_MATH_INTERPOLATION_H
 
 #include <smath/util.h>
+#include <smath/fastmath.h>
 #include <cmath>
 
 namespace Math
@@ -43,40 +44,24 @@ namespace Math
         return static_cast<T>( x + ( ( y - x ) * s) );
     }
 
-    /**
-     * Performs a smooth step interpolation on the range [x, y] using s
-     * as the ratio. Works very similiarly to lerp, however it eases in
-     * and out at the edges.
-     *
-     * \param  x  Starting value
-     * \param  y  Ending value
-     * \param  s  Interpolation factor [0,1]
-     * \return    Interpolated value in the range [x,y] biased by s
-     */
-    template<typename T, typename U>
-    T smoothstep( T x, T y, U s )
-    {
-    }
-
     /**
      * Smoothstep performs a smoother version of a linear interpolation
-     * between two values. This implementation uses an improved version
-     * proposed by Ken Perlin
+     * between two values, easing in and out at the edges. This
+     * implementation uses the improved version proposed by Ken Perlin,
+     * whose first and second derivatives are zero at both ends.
      *
-     * \param  x  Starting value
-     * \param  y  Ending value
-     * \param  s  Interpolation factor [0,1]
-     * \return    Interpolated value in the range [x,y] biased by s
+     * \param  a  Starting value
+     * \param  b  Ending value
+     * \param  s  Interpolation factor, clamped to [0,1]
+     * \return    Interpolated value in the range [a,b] biased by s
      *
      * s(t) = 6t^5 - 15t^4 + 10t^3
      */
     template<typename T, typename U>
     T smoothstep( const T& a, const T& b, const U& s )
     {
-        T v = ( s - a ) / ( b - a );
-        T x = Math::clamp( v, static_cast<T>(0), static_cast<T>(1) );
-        
-        return x * x * x * ( x * ( x * 6 - 15 ) + 10 );
+        U x = Math::clamp( s, static_cast<U>(0), static_cast<U>(1) );
+        return lerp( a, b, x * x * x * ( x * ( x * 6 - 15 ) + 10 ) );
     }
 
     /**
@@ -99,7 +84,7 @@ namespace Math
     template<typename T, typename U>
     T sinerp( const T& a, const T& b, const U& s )
     {
-        return lerp( a, b, sin( s * Math::Pi * 0.5f ) );
+        return lerp( a, b, Math::fast::sin( s * Math::Pi * 0.5f ) );
     }
 
     /**
@@ -110,7 +95,7 @@ namespace Math
     template<typename T, typename U>
     T coserp( const T& a, const T& b, const U& s )
     {
-        return lerp( a, b, cos( s * Math::Pi * 0.5f ) );
+        return lerp( a, b, 1.0f - Math::fast::cos( s * Math::Pi * 0.5f ) );
     }
 
     /**
@@ -122,12 +107,12 @@ namespace Math
     template<typename T, typename U>
     T berp( T a, T b, U s )
     {
-        T v = clamp( s, 0, 1 );
-        v = ( sin( s * Math::Pi * ( 0.2f + 2.5f * s * s * s ) ) *
-              pow( 1.0f - s, 2.2f ) + v ) *
+        U v = Math::clamp( s, static_cast<U>(0), static_cast<U>(1) );
+        v = ( Math::fast::sin( v * Math::Pi * ( 0.2f + 2.5f * v * v * v ) ) *
+              Math::fast::pow( 1.0f - v, static_cast<U>( 2.2f ) ) + v ) *
               ( 1.0f + 1.2f * ( 1.0f - v ) );
 
-        return a + ( b - a ) * s;
+        return a + ( b - a ) * v;
     }
 
     /**
@@ -141,9 +126,247 @@ namespace Math
     template<typename T, typename U>
     T bounce( const T& a, const T& b, const U& s )
     {
-        U x = abs( sin( 6.28f * (s + 1.0f) * (s + 1.0f) ) * (1.0f - s) );
+        U x = std::abs( Math::fast::sin( 6.28f * (s + 1.0f) * (s + 1.0f) ) * (1.0f - s) );
         return a + ( b - a ) * x;
     }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Arrays
+    /////////////////////////////////////////////////////////////////////////
+
+namespace fast
+{
+inline namespace MATH_ISA_NAMESPACE
+{
+namespace detail
+{
+    //
+    // Easing weights of the curves above, written once over the lane types
+    // of Math::simd. Each maps the interpolation factor to the weight of
+    // the ending value.
+    //
+    struct LerpCurve
+    {
+        template<typename V> V operator()( V s ) const { return s; }
+    };
+
+    struct SmoothstepCurve
+    {
+        template<typename V> V operator()( V s ) const
+        {
+            V x = minimum( maximum( s, splat<V>( 0.0f ) ), splat<V>( 1.0f ) );
+            V p = madd( x, madd( x, splat<V>( 6.0f ), splat<V>( -15.0f ) ), splat<V>( 10.0f ) );
+
+            return mul( mul( mul( x, x ), x ), p );
+        }
+    };
+
+    struct HermiteCurve
+    {
+        template<typename V> V operator()( V s ) const
+        {
+            return mul( mul( s, s ), madd( s, splat<V>( -2.0f ), splat<V>( 3.0f ) ) );
+        }
+    };
+
+    struct SinerpCurve
+    {
+        template<typename V> V operator()( V s ) const
+        {
+            return sin<MATH_FAST_PRECISION>( mul( s, splat<V>( HalfPi ) ) );
+        }
+    };
+
+    struct CoserpCurve
+    {
+        template<typename V> V operator()( V s ) const
+        {
+            return sub( splat<V>( 1.0f ), cos<MATH_FAST_PRECISION>( mul( s, splat<V>( HalfPi ) ) ) );
+        }
+    };
+
+    struct BerpCurve
+    {
+        template<typename V> V operator()( V s ) const
+        {
+            V one = splat<V>( 1.0f );
+            V v   = minimum( maximum( s, splat<V>( 0.0f ) ), one );
+            V inv = sub( one, v );
+
+            V frequency = madd( mul( mul( v, v ), v ), splat<V>( 2.5f * Pi ), splat<V>( 0.2f * Pi ) );
+            V wave      = mul( sin<MATH_FAST_PRECISION>( mul( v, frequency ) ),
+                               pow<MATH_FAST_PRECISION>( inv, splat<V>( 2.2f ) ) );
+
+            return mul( add( wave, v ), madd( inv, splat<V>( 1.2f ), one ) );
+        }
+    };
+
+    struct BounceCurve
+    {
+        template<typename V> V operator()( V s ) const
+        {
+            V one = splat<V>( 1.0f );
+            V s1  = add( s, one );
+
+            return abs( mul( sin<MATH_FAST_PRECISION>( mul( mul( s1, s1 ), splat<V>( 6.28f ) ) ),
+                             sub( one, s ) ) );
+        }
+    };
+
+    /**
+     * Interpolates between two constant values.
+     */
+    template<typename Curve>
+    struct EaseConstantOp
+    {
+        float a;
+        float b;
+
+        template<typename V> V operator()( V s ) const
+        {
+            return madd( splat<V>( b - a ), Curve()( s ), splat<V>( a ) );
+        }
+    };
+
+    /**
+     * Interpolates between values read from arrays.
+     */
+    template<typename Curve>
+    struct EaseArraysOp
+    {
+        template<typename V> V operator()( V a, V b, V s ) const
+        {
+            return madd( sub( b, a ), Curve()( s ), a );
+        }
+    };
+
+    template<typename Curve>
+    inline void ease( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        EaseConstantOp<Curve> op = { a, b };
+        transform( pOut, pS, count, op );
+    }
+
+    template<typename Curve>
+    inline void ease( float * pOut, const float * pA, const float * pB, const float * pS, size_t count )
+    {
+        transform( pOut, pA, pB, pS, count, EaseArraysOp<Curve>() );
+    }
+}
+}
+}
+
+    //
+    // Array versions of the curves, for animation and tweening systems that
+    // evaluate many curves per frame. Each comes in two forms: one
+    // interpolates between two constant values for an array of factors,
+    // the other between values read from arrays a and b with one factor
+    // each. They process the arrays with the widest lanes available and use
+    // the Math::fast approximations, and the output may alias any input.
+    //
+    //   Math::sinerp( pOut, 0.0f, 1.0f, pTimes, count );
+    //   Math::smoothstep( pOut, pStart, pEnd, pTimes, count );
+    //
+inline namespace MATH_ISA_NAMESPACE
+{
+    inline void lerp( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        fast::detail::ease<fast::detail::LerpCurve>( pOut, a, b, pS, count );
+    }
+
+    inline void lerp( float * pOut,
+                     const float * pA,
+                     const float * pB,
+                     const float * pS,
+                     size_t count )
+    {
+        fast::detail::ease<fast::detail::LerpCurve>( pOut, pA, pB, pS, count );
+    }
+
+    inline void smoothstep( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        fast::detail::ease<fast::detail::SmoothstepCurve>( pOut, a, b, pS, count );
+    }
+
+    inline void smoothstep( float * pOut,
+                     const float * pA,
+                     const float * pB,
+                     const float * pS,
+                     size_t count )
+    {
+        fast::detail::ease<fast::detail::SmoothstepCurve>( pOut, pA, pB, pS, count );
+    }
+
+    inline void hermite( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        fast::detail::ease<fast::detail::HermiteCurve>( pOut, a, b, pS, count );
+    }
+
+    inline void hermite( float * pOut,
+                     const float * pA,
+                     const float * pB,
+                     const float * pS,
+                     size_t count )
+    {
+        fast::detail::ease<fast::detail::HermiteCurve>( pOut, pA, pB, pS, count );
+    }
+
+    inline void sinerp( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        fast::detail::ease<fast::detail::SinerpCurve>( pOut, a, b, pS, count );
+    }
+
+    inline void sinerp( float * pOut,
+                     const float * pA,
+                     const float * pB,
+                     const float * pS,
+                     size_t count )
+    {
+        fast::detail::ease<fast::detail::SinerpCurve>( pOut, pA, pB, pS, count );
+    }
+
+    inline void coserp( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        fast::detail::ease<fast::detail::CoserpCurve>( pOut, a, b, pS, count );
+    }
+
+    inline void coserp( float * pOut,
+                     const float * pA,
+                     const float * pB,
+                     const float * pS,
+                     size_t count )
+    {
+        fast::detail::ease<fast::detail::CoserpCurve>( pOut, pA, pB, pS, count );
+    }
+
+    inline void berp( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        fast::detail::ease<fast::detail::BerpCurve>( pOut, a, b, pS, count );
+    }
+
+    inline void berp( float * pOut,
+                     const float * pA,
+                     const float * pB,
+                     const float * pS,
+                     size_t count )
+    {
+        fast::detail::ease<fast::detail::BerpCurve>( pOut, pA, pB, pS, count );
+    }
+
+    inline void bounce( float * pOut, float a, float b, const float * pS, size_t count )
+    {
+        fast::detail::ease<fast::detail::BounceCurve>( pOut, a, b, pS, count );
+    }
+
+    inline void bounce( float * pOut,
+                     const float * pA,
+                     const float * pB,
+                     const float * pS,
+                     size_t count )
+    {
+        fast::detail::ease<fast::detail::BounceCurve>( pOut, pA, pB, pS, count );
+    }
+}
 }
 
 #endif
@@ -0,0 +1,419 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_KEYFRAMES_H
+#define SCOTT_MATH_KEYFRAMES_H
+
+//
+// Keyframe tracks: values of one animated property (a float, a TVector3 or
+// a TQuaternion) at increasing times, sampled with step, linear or cubic
+// Hermite interpolation between the keys.
+//
+//   Math::KeyframeTrack<Vec3> track( Math::KeyframeLinear );
+//   track.setKeys( &times[0], &positions[0], times.size() );
+//
+//   Math::KeyframeCursor cursor;
+//   Vec3 p = track.sample( clock, cursor );
+//
+// Finding the keys around a time is a binary search, which dominates the
+// cost of sampling short segments. A KeyframeCursor remembers the segment
+// found by the previous sample, so when time moves forward (or stays put)
+// the next sample usually needs one or two comparisons instead. Cursors
+// are kept apart from the track so a track can be shared by many animated
+// instances and threads, each with its own cursor; sampleTracks() samples
+// many tracks at one time with a cursor per track.
+//
+// Samples before the first key or after the last hold the value of that
+// key. Quaternion keys are moved into the same hemisphere as the key
+// before them when they are set, and interpolated components are
+// normalized, so rotations take the shorter way around.
+//
+#include <smath/config.h>
+#include <smath/interpolation.h>
+#include <smath/quaternion.h>
+#include <smath/vector.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Math
+{
+    /**
+     * How a keyframe track fills in values between its keys.
+     */
+    enum KeyframeMode
+    {
+        KeyframeStep,       // hold each key until the next one
+        KeyframeLinear,     // straight line between keys
+        KeyframeCubic       // cubic Hermite curve through keys and tangents
+    };
+
+namespace detail
+{
+    /**
+     * Interpolation of scalar and vector keyframe values, which support
+     * the arithmetic operators.
+     */
+    template<typename V>
+    struct KeyframeTraits
+    {
+        static V align( const V& /*previous*/, const V& value ) { return value; }
+
+        static V slope( const V& a, const V& b, float scale )
+        {
+            return ( b - a ) * scale;
+        }
+
+        static V linear( const V& a, const V& b, float u )
+        {
+            return Math::lerp( a, b, u );
+        }
+
+        static V cubic( const V& a, const V& ma, const V& b, const V& mb, const float * pW )
+        {
+            return a * pW[0] + ma * pW[1] + b * pW[2] + mb * pW[3];
+        }
+    };
+
+    template<typename T>
+    struct KeyframeTraits< TQuaternion<T> >
+    {
+        typedef TQuaternion<T> Q;
+
+        static Q align( const Q& previous, const Q& value )
+        {
+            T dot = 0;
+
+            for ( int c = 0; c < 4; ++c )
+            {
+                dot += previous[c] * value[c];
+            }
+
+            return dot < 0 ? Q( -value[0], -value[1], -value[2], -value[3] ) : value;
+        }
+
+        static Q slope( const Q& a, const Q& b, float scale )
+        {
+            return Q( ( b[0] - a[0] ) * scale, ( b[1] - a[1] ) * scale,
+                      ( b[2] - a[2] ) * scale, ( b[3] - a[3] ) * scale );
+        }
+
+        static Q linear( const Q& a, const Q& b, float u )
+        {
+            return normalize( ::lerp( a, b, static_cast<T>( u ) ) );
+        }
+
+        static Q cubic( const Q& a, const Q& ma, const Q& b, const Q& mb, const float * pW )
+        {
+            T c[4];
+
+            for ( int i = 0; i < 4; ++i )
+            {
+                c[i] = a[i] * pW[0] + ma[i] * pW[1] + b[i] * pW[2] + mb[i] * pW[3];
+            }
+
+            return normalize( Q( c[0], c[1], c[2], c[3] ) );
+        }
+    };
+}
+
+    /**
+     * Remembers where a keyframe track was last sampled. A cursor starts at
+     * the first segment and may be used with any track; a cursor left
+     * pointing past the end of a shorter track is simply searched again.
+     */
+    struct KeyframeCursor
+    {
+        KeyframeCursor()
+            : segment( 0 )
+        {
+        }
+
+        size_t segment;
+    };
+
+    /**
+     * Values of an animated property at increasing times.
+     */
+    template<typename V>
+    class KeyframeTrack
+    {
+    public:
+        /**
+         * Creates an empty track.
+         */
+        explicit KeyframeTrack( KeyframeMode mode = KeyframeLinear )
+            : mMode( mode ),
+              mTimes(),
+              mValues(),
+              mTangents()
+        {
+        }
+
+        /**
+         * Replaces the keys of the track. Cubic tracks get Catmull-Rom
+         * tangents: the slope between the neighbours of each key, or of the
+         * one neighbour at either end.
+         *
+         * \param  pTimes   Key times, strictly increasing
+         * \param  pValues  Key values
+         * \param  count    Number of keys
+         */
+        void setKeys( const float * pTimes, const V * pValues, size_t count )
+        {
+            assignKeys( pTimes, pValues, count );
+            mTangents.resize( count );
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                const size_t prev = i > 0 ? i - 1 : i;
+                const size_t next = i + 1 < count ? i + 1 : i;
+
+                const float scale = prev == next ? 0.0f : 1.0f / ( mTimes[next] - mTimes[prev] );
+
+                mTangents[i] = detail::KeyframeTraits<V>::slope( mValues[prev], mValues[next], scale );
+            }
+        }
+
+        /**
+         * Replaces the keys of the track, with the tangent (rate of change
+         * per unit of time) at each key given for cubic interpolation.
+         * Quaternion tangents are used as they are, so they must agree with
+         * the hemisphere the key ends up in.
+         */
+        void setKeys( const float * pTimes, const V * pValues, const V * pTangents, size_t count )
+        {
+            assignKeys( pTimes, pValues, count );
+            mTangents.assign( pTangents, pTangents + count );
+        }
+
+        KeyframeMode mode() const
+        {
+            return mMode;
+        }
+
+        void setMode( KeyframeMode mode )
+        {
+            mMode = mode;
+        }
+
+        /**
+         * Returns the number of keys.
+         */
+        size_t size() const
+        {
+            return mTimes.size();
+        }
+
+        bool empty() const
+        {
+            return mTimes.empty();
+        }
+
+        /**
+         * Returns the time of the first key, the track must not be empty.
+         */
+        float startTime() const
+        {
+            return mTimes.front();
+        }
+
+        /**
+         * Returns the time of the last key, the track must not be empty.
+         */
+        float endTime() const
+        {
+            return mTimes.back();
+        }
+
+        /**
+         * Returns the value at a time, searching all of the keys.
+         */
+        V sample( float time ) const
+        {
+            SMATH_ASSERT( !mTimes.empty(), "Cannot sample an empty keyframe track" );
+
+            if ( mTimes.size() == 1 )
+            {
+                return mValues[0];
+            }
+
+            return interpolate( search( time ), time );
+        }
+
+        /**
+         * Returns the value at a time, starting from the segment the cursor
+         * points at and leaving it pointing at the segment of this time.
+         * Sampling at the same or slightly later times than the last call
+         * takes constant time.
+         */
+        V sample( float time, KeyframeCursor& cursor ) const
+        {
+            SMATH_ASSERT( !mTimes.empty(), "Cannot sample an empty keyframe track" );
+
+            if ( mTimes.size() == 1 )
+            {
+                return mValues[0];
+            }
+
+            return interpolate( locate( time, cursor ), time );
+        }
+
+        /**
+         * Samples the track at count times, which are quickest to sample in
+         * increasing order.
+         */
+        void sample( const float * pTimes, V * pOut, size_t count ) const
+        {
+            KeyframeCursor cursor;
+
+            for ( size_t i = 0; i < count; ++i )
+            {
+                pOut[i] = sample( pTimes[i], cursor );
+            }
+        }
+
+    private:
+        void assignKeys( const float * pTimes, const V * pValues, size_t count )
+        {
+            mTimes.assign( pTimes, pTimes + count );
+            mValues.assign( pValues, pValues + count );
+
+            for ( size_t i = 1; i < count; ++i )
+            {
+                SMATH_ASSERT( mTimes[i] > mTimes[ i - 1 ], "Key times must increase" );
+                mValues[i] = detail::KeyframeTraits<V>::align( mValues[ i - 1 ], mValues[i] );
+            }
+        }
+
+        /**
+         * Returns true if the time is sampled from the segment, including
+         * the times clamped onto the first and last segments.
+         */
+        bool contains( size_t segment, float time ) const
+        {
+            const size_t last = mTimes.size() - 2;
+
+            return ( segment == 0 || time >= mTimes[segment] ) &&
+                   ( segment == last || time < mTimes[ segment + 1 ] );
+        }
+
+        /**
+         * Finds the segment of a time by checking the segment of the cursor
+         * and the one after it before falling back to a search.
+         */
+        size_t locate( float time, KeyframeCursor& cursor ) const
+        {
+            const size_t segment = cursor.segment;
+
+            if ( segment + 1 < mTimes.size() && contains( segment, time ) )
+            {
+                return segment;
+            }
+
+            if ( segment + 2 < mTimes.size() && contains( segment + 1, time ) )
+            {
+                return cursor.segment = segment + 1;
+            }
+
+            return cursor.segment = search( time );
+        }
+
+        /**
+         * Returns the index of the last key at or before the time, clamped
+         * to a valid segment.
+         */
+        size_t search( float time ) const
+        {
+            const size_t upper = std::upper_bound( mTimes.begin(), mTimes.end(), time ) - mTimes.begin();
+            return std::min( upper > 0 ? upper - 1 : 0, mTimes.size() - 2 );
+        }
+
+        V interpolate( size_t segment, float time ) const
+        {
+            const float start = mTimes[segment];
+            const float span  = mTimes[ segment + 1 ] - start;
+            const float u     = std::min( std::max( ( time - start ) / span, 0.0f ), 1.0f );
+
+            const V& a = mValues[segment];
+            const V& b = mValues[ segment + 1 ];
+
+            switch ( mMode )
+            {
+                case KeyframeStep:
+                    return u < 1.0f ? a : b;
+
+                case KeyframeLinear:
+                    return detail::KeyframeTraits<V>::linear( a, b, u );
+
+                default:
+                {
+                    // Hermite basis, with the tangents scaled from per unit
+                    // of time to per segment
+                    const float u2 = u * u;
+                    const float u3 = u2 * u;
+                    const float w[4] = { 2.0f * u3 - 3.0f * u2 + 1.0f,
+                                         ( u3 - 2.0f * u2 + u ) * span,
+                                         3.0f * u2 - 2.0f * u3,
+                                         ( u3 - u2 ) * span };
+
+                    return detail::KeyframeTraits<V>::cubic( a, mTangents[segment],
+                                                             b, mTangents[ segment + 1 ], w );
+                }
+            }
+        }
+
+    private:
+        KeyframeMode mMode;
+        std::vector<float> mTimes;
+        std::vector<V> mValues;
+        std::vector<V> mTangents;
+    };
+
+    /**
+     * Samples count tracks at the same time, each with its own cursor.
+     */
+    template<typename V>
+    void sampleTracks( const KeyframeTrack<V> * pTracks,
+                       KeyframeCursor * pCursors,
+                       float time,
+                       V * pOut,
+                       size_t count )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            pOut[i] = pTracks[i].sample( time, pCursors[i] );
+        }
+    }
+
+    /**
+     * Samples count tracks, each at its own time and with its own cursor.
+     */
+    template<typename V>
+    void sampleTracks( const KeyframeTrack<V> * pTracks,
+                       KeyframeCursor * pCursors,
+                       const float * pTimes,
+                       V * pOut,
+                       size_t count )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            pOut[i] = pTracks[i].sample( pTimes[i], pCursors[i] );
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_LOW_DISCREPANCY_H
+#define SCOTT_MATH_LOW_DISCREPANCY_H
+
+//
+// Low-discrepancy (quasi-random) sequences in [0,1)^2 and [0,1)^3.
+//
+// The points fill the unit square or cube far more evenly than random
+// points, so Monte Carlo estimates (baking, ambient occlusion, sampling
+// area lights) converge faster. Every sequence is a pure function of the
+// point index: any thread can compute any point without shared state, and
+// the generate() functions fill arrays of consecutive points. Feed the
+// points to the mapToX() functions in shapesampling.h to distribute them
+// over spheres, disks and hemispheres.
+//
+// The Halton and Sobol sequences take a seed for randomized (scrambled)
+// variants that keep their stratification; different seeds give
+// independent estimates, which removes the structured artifacts of the
+// plain sequences. A seed of zero gives the plain sequence.
+//
+#include <smath/config.h>
+#include <smath/vector.h>
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace Math
+{
+    /**
+     * Returns the base 2 radical inverse of index: its binary digits
+     * mirrored around the binary point, so 1, 2, 3 map to 0.5, 0.25, 0.75.
+     * This is the van der Corput sequence.
+     */
+    float radicalInverse2( uint32_t index );
+
+    /**
+     * Returns the radical inverse of index in the given base, with the
+     * digits mirrored around the point in that base.
+     */
+    float radicalInverse( uint32_t index, uint32_t base );
+
+    /**
+     * Halton sequence, using the radical inverses of the point index in
+     * bases 2, 3 (and 5) for its coordinates. Scrambled variants apply a
+     * random permutation to the digits of each base; the first 2^i * 3^j
+     * points still fall one per cell of a 2^i by 3^j grid.
+     */
+    class HaltonSequence
+    {
+    public:
+        /**
+         * \param  seed  Seed of the digit permutations, zero for the plain
+         *               sequence
+         */
+        explicit HaltonSequence( uint32_t seed = 0 );
+
+        TVector2<float> point2( uint32_t index ) const;
+        TVector3<float> point3( uint32_t index ) const;
+
+        /**
+         * Writes count consecutive points, starting with point first.
+         */
+        void generate( uint32_t first, TVector2<float> * pOut, size_t count ) const;
+        void generate( uint32_t first, TVector3<float> * pOut, size_t count ) const;
+
+    private:
+        uint32_t mScramble2;
+        uint8_t mPermutation3[3];
+        uint8_t mPermutation5[5];
+    };
+
+    /**
+     * Sobol sequence using the Joe-Kuo direction numbers, with optional
+     * Owen scrambling computed by Burley's hashed Laine-Karras permutation.
+     * Points are produced in Gray code order (Antonov-Saleev), which lets
+     * generate() step from one point to the next with a single XOR per
+     * coordinate. Every power of two block of points starting at a multiple
+     * of its size is stratified: the first 2^2k two dimensional points fall
+     * one per cell of a 2^k by 2^k grid.
+     */
+    class SobolSequence
+    {
+    public:
+        /// Number of dimensions available
+        static const int Dimensions = 3;
+
+        /**
+         * \param  seed  Seed of the Owen scrambling, zero for the plain
+         *               sequence
+         */
+        explicit SobolSequence( uint32_t seed = 0 );
+
+        /**
+         * Returns one coordinate of a point as a 32 bit fixed point
+         * fraction, for dimension in [0, Dimensions).
+         */
+        uint32_t sample( uint32_t index, int dimension ) const;
+
+        TVector2<float> point2( uint32_t index ) const;
+        TVector3<float> point3( uint32_t index ) const;
+
+        /**
+         * Writes count consecutive points, starting with point first.
+         */
+        void generate( uint32_t first, TVector2<float> * pOut, size_t count ) const;
+        void generate( uint32_t first, TVector3<float> * pOut, size_t count ) const;
+
+    private:
+        uint32_t scramble( uint32_t value, int dimension ) const;
+        void generate( uint32_t first, float * pOut, int dimensions, size_t count ) const;
+
+    private:
+        uint32_t mSeeds[Dimensions];
+    };
+
+    /**
+     * Additive recurrence (Kronecker) sequences by Roberts: point n is
+     * fract( offset + n * alpha ) with alpha built from the generalized
+     * golden ratio of the dimension, the "R2" sequence in two dimensions
+     * and "R3" in three. The cheapest sequence here, with no visible
+     * structure and good stratification at every point count, not only at
+     * powers of two. Computed in 32 bit fixed point so the points stay
+     * exact for every index.
+     */
+    class KroneckerSequence
+    {
+    public:
+        /**
+         * \param  offset  Starting point, 0.5 in each dimension by default.
+         *                 Use a random offset for randomized variants.
+         */
+        explicit KroneckerSequence( float offset = 0.5f );
+        explicit KroneckerSequence( const TVector3<float>& offset );
+
+        TVector2<float> point2( uint32_t index ) const;
+        TVector3<float> point3( uint32_t index ) const;
+
+        /**
+         * Writes count consecutive points, starting with point first.
+         */
+        void generate( uint32_t first, TVector2<float> * pOut, size_t count ) const;
+        void generate( uint32_t first, TVector3<float> * pOut, size_t count ) const;
+
+    private:
+        uint32_t mOffset[3];
+    };
+}
+
+#endif
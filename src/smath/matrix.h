@@ -30,12 +30,12 @@ namespace boost { namespace serialization { class access; } }
 
 template<typename T> bool isZeroMatrix( const TMatrix4<T>& );
 template<typename T> bool isIdentityMatrix( const TMatrix4<T>& );
-template<typename T> TMatrix4<T> transpose( const TMatrix4<T>& );
-template<typename T> T determinant( const TMatrix4<T>& );
+template<typename T> constexpr TMatrix4<T> transpose( const TMatrix4<T>& );
+template<typename T> constexpr T determinant( const TMatrix4<T>& );
 template<typename T> TMatrix4<T> tryInverse( const TMatrix4<T>&, bool* = NULL);
 template<typename T> TMatrix4<T> inverse( const TMatrix4<T>& );
 template<typename T> TMatrix4<T> calculateInverse( const TMatrix4<T>&, T );
-template<typename T> T trace( const TMatrix4<T>& );
+template<typename T> constexpr T trace( const TMatrix4<T>& );
 
 /**
  * A standard templated 4x4 matrix, with values sotred in row major memory
@@ -94,11 +94,11 @@ public:
      * 4x4 matrix constructor. Arguments are to be specified in row
      * major format.
      */
-    TMatrix4( value_type m34, value_type m41, value_type m42, value_type m43,
-              value_type M21, value_type M22, value_type M23, value_type M24,
-              value_type M31, value_type M32, value_type M33, value_type M34,
-              value_type M41, value_type M42, value_type M43, value_type M44 )
-        : m11(m34), m12(m41), m13(m42), m14(m43),
+    constexpr TMatrix4( value_type M11, value_type M12, value_type M13, value_type M14,
+                        value_type M21, value_type M22, value_type M23, value_type M24,
+                        value_type M31, value_type M32, value_type M33, value_type M34,
+                        value_type M41, value_type M42, value_type M43, value_type M44 )
+        : m11(M11), m12(M12), m13(M13), m14(M14),
           m21(M21), m22(M22), m23(M23), m24(M24),
           m31(M31), m32(M32), m33(M33), m34(M34),
           m41(M41), m42(M42), m43(M43), m44(M44)
@@ -111,7 +111,7 @@ public:
      * \param  pVals  Pointer to an array of 16 values. Must be in row-major
      *                order
      */
-    explicit TMatrix4( const_pointer pVals )
+    explicit constexpr TMatrix4( const_pointer pVals )
         : m11( pVals[0]  ), m12( pVals[1]  ), m13( pVals[2]   ), m14( pVals[3]  ),
           m21( pVals[4]  ), m22( pVals[5]  ), m23( pVals[6]   ), m24( pVals[7]  ),
           m31( pVals[8]  ), m32( pVals[9]  ), m33( pVals[10] ),  m34( pVals[11] ),
@@ -124,7 +124,7 @@ public:
      *
      * \param  m  Matrix to copy values from
      */
-    TMatrix4( const TMatrix4<T>& m )
+    constexpr TMatrix4( const TMatrix4<T>& m )
         : m11( m.m11 ), m12( m.m12 ), m13( m.m13 ), m14( m.m14 ),
           m21( m.m21 ), m22( m.m22 ), m23( m.m23 ), m24( m.m24 ),
           m31( m.m31 ), m32( m.m32 ), m33( m.m33 ), m34( m.m34 ),
@@ -196,7 +196,7 @@ public:
     /**
      * Matrix addition operator
      */
-    TMatrix4<T> operator + ( const TMatrix4<T>& rhs ) const
+    constexpr TMatrix4<T> operator + ( const TMatrix4<T>& rhs ) const
     {
         return TMatrix4(
             m11 + rhs.m11, m12 + rhs.m12, m13 + rhs.m13, m14 + rhs.m14,
@@ -222,7 +222,7 @@ public:
     /**
      * Matrix subtraction operator
      */
-    TMatrix4<T> operator - ( const TMatrix4<T>& rhs ) const
+    constexpr TMatrix4<T> operator - ( const TMatrix4<T>& rhs ) const
     {
         return TMatrix4(
             m11 - rhs.m11, m12 - rhs.m12, m13 - rhs.m13, m14 - rhs.m14,
@@ -248,7 +248,7 @@ public:
     /**
      * Matrix scalar multiplication operator
      */
-    TMatrix4<T> operator * ( value_type rhs ) const
+    constexpr TMatrix4<T> operator * ( value_type rhs ) const
     {
         return TMatrix4(
             m11 * rhs, m12 * rhs, m13 * rhs, m14 * rhs,
@@ -274,7 +274,7 @@ public:
     /**
      * Matrix multiplcation operator
      */
-    TMatrix4<T> operator * ( const TMatrix4<T>& rhs ) const
+    constexpr TMatrix4<T> operator * ( const TMatrix4<T>& rhs ) const
     {
         return TMatrix4<T>(
             m11 * rhs.m11 + m12 * rhs.m21 + m13 * rhs.m31 + m14 * rhs.m41,
@@ -491,9 +491,9 @@ public:
 
     friend bool isZeroMatrix<>( const TMatrix4<T>& );
     friend bool isIdentityMatrix<>( const TMatrix4<T>& );
-    friend TMatrix4<T> transpose<>( const TMatrix4<T>& );
-    friend value_type trace<>( const TMatrix4<T>& );
-    friend value_type determinant<>( const TMatrix4<T>& );
+    friend constexpr TMatrix4<T> transpose<>( const TMatrix4<T>& );
+    friend constexpr value_type trace<>( const TMatrix4<T>& );
+    friend constexpr value_type determinant<>( const TMatrix4<T>& );
     friend TMatrix4<T> inverse<>( const TMatrix4<T>& );
     friend TMatrix4<T> tryInverse<>( const TMatrix4<T>&, bool* );
     friend TMatrix4<T> calculateInverse<>( const TMatrix4<T>&, value_type );
@@ -570,7 +570,7 @@ bool isIdentityMatrix( const TMatrix4<T>& m )
  * \return    The transposed matrix
  */
 template<typename T>
-TMatrix4<T> transpose( const TMatrix4<T>& m )
+constexpr TMatrix4<T> transpose( const TMatrix4<T>& m )
 {
     return TMatrix4<T>( m.m11, m.m21, m.m31, m.m41,
                         m.m12, m.m22, m.m32, m.m42,
@@ -585,7 +585,7 @@ TMatrix4<T> transpose( const TMatrix4<T>& m )
  * \return    Trace value of the matrix
  */
 template<typename T>
-T trace( const TMatrix4<T>& m )
+constexpr T trace( const TMatrix4<T>& m )
 {
     return m.m11 + m.m22 + m.m33 + m.m44;
 }
@@ -597,7 +597,7 @@ T trace( const TMatrix4<T>& m )
  * \return    Value of the determinant
  */
 template<typename T>
-T determinant( const TMatrix4<T>& m )
+constexpr T determinant( const TMatrix4<T>& m )
 {
     return 
         m.m14 * m.m23 * m.m32 * m.m41-m.m13 * m.m24 * m.m32 * m.m41-m.m14 * m.m22 * m.m33 * m.m41+m.m12 * m.m24 * m.m33 * m.m41
@@ -720,7 +720,7 @@ std::ostream& operator << ( std::ostream& os, const TMatrix4<T>& m )
 // Static definitions
 /////////////////////////////////////////////////////////////////////////////
 template<typename T>
-const TMatrix4<T> TMatrix4<T>::ZERO_MATRIX = TMatrix4(
+constexpr TMatrix4<T> TMatrix4<T>::ZERO_MATRIX = TMatrix4<T>(
     0, 0, 0, 0,
     0, 0, 0, 0,
     0, 0, 0, 0,
@@ -728,7 +728,7 @@ const TMatrix4<T> TMatrix4<T>::ZERO_MATRIX = TMatrix4(
 );
 
 template<typename T>
-const TMatrix4<T> TMatrix4<T>::IDENTITY = TMatrix4(
+constexpr TMatrix4<T> TMatrix4<T>::IDENTITY = TMatrix4<T>(
     1, 0, 0, 0,
     0, 1, 0, 0,
     0, 0, 1, 0,
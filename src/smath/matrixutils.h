@@ -18,6 +18,7 @@
 
 #include <smath/matrix.h>
 #include <smath/vector.h>
+#include <smath/fastmath.h>
 
 namespace Math
 {
@@ -27,8 +28,8 @@ namespace Math
     template<typename T>
     TMatrix4<T> createRotationAroundX( T angle )
     {
-        T s = sinf( angle );
-        T c = cosf( angle );
+        T s, c;
+        Math::fast::sincos( angle, s, c );
 
         return TMatrix4<T>( 1.0f, 0.0f, 0.0f, 0.0f,
                             0.0f, c,    -s,   0.0f,
@@ -42,8 +43,8 @@ namespace Math
     template<typename T>
     TMatrix4<T> createRotationAroundY( T angle )
     {
-        T s = sinf( angle );
-        T c = cosf( angle );
+        T s, c;
+        Math::fast::sincos( angle, s, c );
 
         return TMatrix4<T>( c,    0.0f, s,    0.0f,
                             0.0f, 1.0f, 0.0f, 0.0f,
@@ -57,8 +58,8 @@ namespace Math
     template<typename T>
     TMatrix4<T> createRotationAroundZ( T angle )
     {
-        T s = sinf( angle );
-        T c = cosf( angle );
+        T s, c;
+        Math::fast::sincos( angle, s, c );
 
         return TMatrix4<T>( c,    -s,   0.0f, 0.0f,
                             s,    c,    0.0f, 0.0f,
@@ -74,8 +75,8 @@ namespace Math
     template<typename T>
     TMatrix4<T> createRotationAroundAxis( const TVector3<T>& axis, T angle )
     {
-        T s  = sin( angle );
-        T c  = cos( angle );
+        T s, c;
+        Math::fast::sincos( angle, s, c );
         T ic = 1 - c;
 
         TVector3<T> p = normalized( axis );
@@ -123,49 +124,194 @@ namespace Math
         return TMatrix4<T>( k,    0.0f, 0.0f, 0.0f,
                             0.0f, k,    0.0f, 0.0f,
                             0.0f, 0.0f, k,    0.0f,
-                            1.0f, 1.0f, 1.0f, 1.0f );
+                            0.0f, 0.0f, 0.0f, 1.0f );
     }
 
     /**
      * Creates a view matrix that looks from a specified eye position to
-     * the center position and with the given up vector.
+     * the center position and with the given up vector. The resulting view
+     * space is right handed with the camera looking down the negative Z axis.
      *
      * Similiar to gluLookAt
+     *
+     * \param  eye     Position of the viewer
+     * \param  lookAt  Position that the viewer is looking at
+     * \param  up      Approximate up direction, must not be parallel to the
+     *                 view direction
+     * \return         View matrix
      */
     template<typename T>
-    TMatrix4<T> createLookAt( const TVector3<T>& /*eye*/,
-                              const TVector3<T>& /*lookAt*/,
-                              const TVector3<T>& /*up*/ )
+    TMatrix4<T> createLookAt( const TVector3<T>& eye,
+                              const TVector3<T>& lookAt,
+                              const TVector3<T>& up )
     {
-        return TMatrix4<T>::IDENTITY;
+        TVector3<T> f = normalized( lookAt - eye );
+        TVector3<T> s = normalized( cross( f, up ) );
+        TVector3<T> u = cross( s, f );
+
+        return TMatrix4<T>(  s.x(),  s.y(),  s.z(), -dot( s, eye ),
+                             u.x(),  u.y(),  u.z(), -dot( u, eye ),
+                            -f.x(), -f.y(), -f.z(),  dot( f, eye ),
+                             0,      0,      0,      1 );
     }
 
     /**
-     * Creates an OpenGL compatible perspective projection
+     * Creates an OpenGL compatible perspective projection. Points between the
+     * near and far planes are mapped to clip space depth values in [-1,1].
+     *
+     * Similiar to glFrustum
      */
     template<typename T>
-    TMatrix4<T> createFrustum( T /*left*/,
-                               T /*right*/,
-                               T /*bottom*/,
-                               T /*top*/,
-                               T /*zNear*/,
-                               T /*zFar*/ )
+    TMatrix4<T> createFrustum( T left,
+                               T right,
+                               T bottom,
+                               T top,
+                               T zNear,
+                               T zFar )
     {
-        return TMatrix4<T>::IDENTITY;
+        SMATH_ASSERT( right != left, "Frustum width cannot be zero" );
+        SMATH_ASSERT( top != bottom, "Frustum height cannot be zero" );
+        SMATH_ASSERT( zFar != zNear, "Frustum depth cannot be zero" );
+
+        T w = right - left;
+        T h = top - bottom;
+        T d = zFar - zNear;
+
+        return TMatrix4<T>( 2 * zNear / w, 0, ( right + left ) / w, 0,
+                            0, 2 * zNear / h, ( top + bottom ) / h, 0,
+                            0, 0, -( zFar + zNear ) / d, -2 * zFar * zNear / d,
+                            0, 0, -1, 0 );
     }
 
     /**
-     * Creates an OpenGL compatible orthographic projection matrix
+     * Creates an OpenGL compatible perspective projection from a vertical
+     * field of view. Points between the near and far planes are mapped to
+     * clip space depth values in [-1,1].
+     *
+     * Similiar to gluPerspective, except the field of view is in radians.
+     *
+     * \param  fovY    Vertical field of view, in radians
+     * \param  aspect  Aspect ratio of the viewport (width / height)
+     * \param  zNear   Distance to the near clipping plane (must be positive)
+     * \param  zFar    Distance to the far clipping plane
+     * \return         Perspective projection matrix
      */
     template<typename T>
-    TMatrix4<T> createOrtho( T /*left*/,
-                             T /*right*/,
-                             T /*bottom*/,
-                             T /*top*/,
-                             T /*zNear*/,
-                             T /*zFar*/ )
+    TMatrix4<T> createPerspective( T fovY, T aspect, T zNear, T zFar )
     {
-        return TMatrix4<T>::IDENTITY;
+        SMATH_ASSERT( aspect != 0, "Aspect ratio cannot be zero" );
+        SMATH_ASSERT( zFar != zNear, "Frustum depth cannot be zero" );
+
+        T f = 1 / std::tan( fovY / 2 );
+        T d = zNear - zFar;
+
+        return TMatrix4<T>( f / aspect, 0, 0, 0,
+                            0, f, 0, 0,
+                            0, 0, ( zFar + zNear ) / d, 2 * zFar * zNear / d,
+                            0, 0, -1, 0 );
+    }
+
+    /**
+     * Creates an OpenGL compatible perspective projection that does not have
+     * a far clipping plane. This is the limit of createPerspective as zFar
+     * approaches infinity.
+     *
+     * \param  fovY    Vertical field of view, in radians
+     * \param  aspect  Aspect ratio of the viewport (width / height)
+     * \param  zNear   Distance to the near clipping plane (must be positive)
+     * \return         Perspective projection matrix
+     */
+    template<typename T>
+    TMatrix4<T> createInfinitePerspective( T fovY, T aspect, T zNear )
+    {
+        SMATH_ASSERT( aspect != 0, "Aspect ratio cannot be zero" );
+
+        T f = 1 / std::tan( fovY / 2 );
+
+        return TMatrix4<T>( f / aspect, 0, 0, 0,
+                            0, f, 0, 0,
+                            0, 0, -1, -2 * zNear,
+                            0, 0, -1, 0 );
+    }
+
+    /**
+     * Creates a reversed-Z perspective projection. The near plane is mapped to
+     * a clip space depth of 1 and the far plane to 0, which spreads floating
+     * point depth precision evenly across the view distance. The depth range
+     * is [0,1] so it should be used with a [0,1] depth buffer (Direct3D,
+     * Vulkan or glClipControl) and a greater-than depth test.
+     *
+     * \param  fovY    Vertical field of view, in radians
+     * \param  aspect  Aspect ratio of the viewport (width / height)
+     * \param  zNear   Distance to the near clipping plane (must be positive)
+     * \param  zFar    Distance to the far clipping plane
+     * \return         Perspective projection matrix
+     */
+    template<typename T>
+    TMatrix4<T> createPerspectiveReversedZ( T fovY, T aspect, T zNear, T zFar )
+    {
+        SMATH_ASSERT( aspect != 0, "Aspect ratio cannot be zero" );
+        SMATH_ASSERT( zFar != zNear, "Frustum depth cannot be zero" );
+
+        T f = 1 / std::tan( fovY / 2 );
+        T d = zFar - zNear;
+
+        return TMatrix4<T>( f / aspect, 0, 0, 0,
+                            0, f, 0, 0,
+                            0, 0, zNear / d, zFar * zNear / d,
+                            0, 0, -1, 0 );
+    }
+
+    /**
+     * Creates a reversed-Z perspective projection with no far clipping plane.
+     * The near plane is mapped to a clip space depth of 1, and depth
+     * approaches 0 as distance approaches infinity.
+     *
+     * \param  fovY    Vertical field of view, in radians
+     * \param  aspect  Aspect ratio of the viewport (width / height)
+     * \param  zNear   Distance to the near clipping plane (must be positive)
+     * \return         Perspective projection matrix
+     */
+    template<typename T>
+    TMatrix4<T> createInfinitePerspectiveReversedZ( T fovY, T aspect, T zNear )
+    {
+        SMATH_ASSERT( aspect != 0, "Aspect ratio cannot be zero" );
+
+        T f = 1 / std::tan( fovY / 2 );
+
+        return TMatrix4<T>( f / aspect, 0, 0, 0,
+                            0, f, 0, 0,
+                            0, 0, 0, zNear,
+                            0, 0, -1, 0 );
+    }
+
+    /**
+     * Creates an OpenGL compatible orthographic projection matrix. Points
+     * between the near and far planes are mapped to clip space depth values
+     * in [-1,1].
+     *
+     * Similiar to glOrtho
+     */
+    template<typename T>
+    TMatrix4<T> createOrtho( T left,
+                             T right,
+                             T bottom,
+                             T top,
+                             T zNear,
+                             T zFar )
+    {
+        SMATH_ASSERT( right != left, "Ortho width cannot be zero" );
+        SMATH_ASSERT( top != bottom, "Ortho height cannot be zero" );
+        SMATH_ASSERT( zFar != zNear, "Ortho depth cannot be zero" );
+
+        T w = right - left;
+        T h = top - bottom;
+        T d = zFar - zNear;
+
+        return TMatrix4<T>( 2 / w, 0, 0, -( right + left ) / w,
+                            0, 2 / h, 0, -( top + bottom ) / h,
+                            0, 0, -2 / d, -( zFar + zNear ) / d,
+                            0, 0, 0, 1 );
     }
 
     /**
@@ -0,0 +1,387 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_MEMORY_H
+#define SCOTT_MATH_MEMORY_H
+
+#include <smath/config.h>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Math
+{
+    /// Alignment of a cache line, and the widest SIMD register (AVX-512)
+    const size_t CacheLineSize = 64;
+
+    /**
+     * Allocates memory aligned to the given power of two.
+     *
+     * \param  bytes      Number of bytes to allocate
+     * \param  alignment  Alignment of the returned address, a power of two
+     * \return            The memory, or NULL if it could not be allocated
+     */
+    void * alignedAlloc( size_t bytes, size_t alignment );
+
+    /**
+     * Frees memory returned by alignedAlloc. Null pointers are ignored.
+     *
+     * \param  pMemory  Memory to free
+     */
+    void alignedFree( void * pMemory );
+
+    /**
+     * Standard allocator that aligns every allocation to Alignment bytes,
+     * so containers of vectors and matrices can be read with aligned SIMD
+     * loads. Use 16 for SSE, 32 for AVX and 64 for AVX-512 or to keep
+     * arrays from sharing cache lines.
+     *
+     *   std::vector< Vec4, Math::AlignedAllocator<Vec4, 32> > points;
+     */
+    template<typename T, size_t Alignment = 32>
+    class AlignedAllocator
+    {
+        static_assert( Alignment != 0 && ( Alignment & ( Alignment - 1 ) ) == 0,
+                       "Alignment must be a power of two" );
+        static_assert( Alignment >= std::alignment_of<T>::value,
+                       "Alignment must not be less than the type's alignment" );
+
+    public:
+        typedef T value_type;
+        typedef T * pointer;
+        typedef const T * const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template<typename U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, Alignment> other;
+        };
+
+        AlignedAllocator()
+        {
+        }
+
+        template<typename U>
+        AlignedAllocator( const AlignedAllocator<U, Alignment>& )
+        {
+        }
+
+        /**
+         * Allocates storage for count objects, throws std::bad_alloc if it
+         * cannot.
+         */
+        pointer allocate( size_type count )
+        {
+            if ( count == 0 )
+            {
+                return NULL;
+            }
+
+            if ( count > max_size() )
+            {
+                throw std::bad_alloc();
+            }
+
+            void * pMemory = alignedAlloc( count * sizeof( T ), Alignment );
+
+            if ( pMemory == NULL )
+            {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<pointer>( pMemory );
+        }
+
+        void deallocate( pointer p, size_type /*count*/ )
+        {
+            alignedFree( p );
+        }
+
+        size_type max_size() const
+        {
+            return std::numeric_limits<size_type>::max() / sizeof( T );
+        }
+
+        template<typename U>
+        bool operator == ( const AlignedAllocator<U, Alignment>& ) const
+        {
+            return true;
+        }
+
+        template<typename U>
+        bool operator != ( const AlignedAllocator<U, Alignment>& ) const
+        {
+            return false;
+        }
+    };
+
+    /**
+     * std::vector whose storage is aligned to Alignment bytes.
+     */
+    template<typename T, size_t Alignment = 32>
+    using AlignedVector = std::vector< T, AlignedAllocator<T, Alignment> >;
+
+    /**
+     * Linear (frame) allocator. Allocations are carved sequentially out of
+     * large blocks and are never freed individually: reset() releases every
+     * allocation at once and keeps the blocks for reuse, so a pipeline that
+     * resets its arena every frame stops calling malloc once the arena has
+     * grown to the frame's high water mark.
+     *
+     * No constructors or destructors are run, so the arena only holds
+     * trivially destructible types such as vectors, matrices and scalars.
+     * An arena must not be used by two threads at once, use threadArena()
+     * to get one per thread.
+     */
+    class Arena
+    {
+    public:
+        /// Size of the blocks an arena grows by, unless constructed otherwise
+        static const size_t DefaultBlockSize = 256 * 1024;
+
+        /**
+         * Position in an arena, returned by mark() and restored by rewind().
+         */
+        struct Marker
+        {
+            size_t block;
+            size_t offset;
+            size_t used;
+        };
+
+        /**
+         * Creates an empty arena. No memory is allocated until the first
+         * allocation.
+         *
+         * \param  blockSize  Size of each block, larger requests get a block
+         *                    of their own size
+         */
+        explicit Arena( size_t blockSize = DefaultBlockSize );
+        ~Arena();
+
+        Arena( const Arena& ) = delete;
+        Arena& operator = ( const Arena& ) = delete;
+
+        /**
+         * Allocates bytes of memory aligned to the given power of two.
+         *
+         * \param  bytes      Number of bytes to allocate
+         * \param  alignment  Alignment of the returned address, at most
+         *                    CacheLineSize
+         * \return            The memory, or NULL if a new block was needed
+         *                    and could not be allocated
+         */
+        void * allocate( size_t bytes, size_t alignment = CacheLineSize );
+
+        /**
+         * Allocates uninitialized storage for count objects of type T,
+         * aligned to a cache line.
+         */
+        template<typename T>
+        T * allocateArray( size_t count )
+        {
+            static_assert( std::is_trivially_destructible<T>::value,
+                           "Arena storage is never destroyed" );
+            static_assert( std::alignment_of<T>::value <= CacheLineSize,
+                           "Type is over aligned for the arena" );
+
+            if ( count > std::numeric_limits<size_t>::max() / sizeof( T ) )
+            {
+                return NULL;
+            }
+
+            return static_cast<T *>( allocate( count * sizeof( T ), CacheLineSize ) );
+        }
+
+        /**
+         * Returns the current position, to later release everything
+         * allocated after it with rewind().
+         */
+        Marker mark() const;
+
+        /**
+         * Releases every allocation made since the marker was taken.
+         */
+        void rewind( const Marker& marker );
+
+        /**
+         * Releases every allocation, keeping the blocks for reuse.
+         */
+        void reset();
+
+        /**
+         * Releases every allocation and frees the blocks.
+         */
+        void release();
+
+        /**
+         * Returns the number of bytes allocated since the last reset,
+         * including alignment padding.
+         */
+        size_t bytesUsed() const;
+
+        /**
+         * Returns the total size of the blocks owned by the arena.
+         */
+        size_t capacity() const;
+
+    private:
+        struct Block
+        {
+            char * pData;
+            size_t size;
+        };
+
+        bool nextBlock( size_t bytes );
+
+    private:
+        std::vector<Block> mBlocks;
+        size_t mBlockSize;
+        size_t mBlock;
+        size_t mOffset;
+        size_t mUsed;
+    };
+
+    /**
+     * Rewinds an arena to where it was when the scope was entered, for
+     * scratch buffers that only live for the duration of a call.
+     */
+    class ArenaScope
+    {
+    public:
+        explicit ArenaScope( Arena& arena )
+            : mArena( arena ),
+              mMarker( arena.mark() )
+        {
+        }
+
+        ~ArenaScope()
+        {
+            mArena.rewind( mMarker );
+        }
+
+        ArenaScope( const ArenaScope& ) = delete;
+        ArenaScope& operator = ( const ArenaScope& ) = delete;
+
+    private:
+        Arena& mArena;
+        Arena::Marker mMarker;
+    };
+
+    /**
+     * Standard allocator that takes its memory from an arena, so standard
+     * containers can be used for per-frame buffers. Deallocation does
+     * nothing, the memory is reclaimed when the arena is reset.
+     */
+    template<typename T>
+    class ArenaAllocator
+    {
+    public:
+        typedef T value_type;
+        typedef T * pointer;
+        typedef const T * const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template<typename U>
+        struct rebind
+        {
+            typedef ArenaAllocator<U> other;
+        };
+
+        explicit ArenaAllocator( Arena& arena )
+            : mpArena( &arena )
+        {
+        }
+
+        template<typename U>
+        ArenaAllocator( const ArenaAllocator<U>& other )
+            : mpArena( other.arena() )
+        {
+        }
+
+        /**
+         * Allocates storage for count objects, throws std::bad_alloc if it
+         * cannot.
+         */
+        pointer allocate( size_type count )
+        {
+            static_assert( std::alignment_of<T>::value <= CacheLineSize,
+                           "Type is over aligned for the arena" );
+
+            if ( count > max_size() )
+            {
+                throw std::bad_alloc();
+            }
+
+            void * pMemory = mpArena->allocate( count * sizeof( T ),
+                                                std::alignment_of<T>::value );
+
+            if ( pMemory == NULL )
+            {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<pointer>( pMemory );
+        }
+
+        void deallocate( pointer /*p*/, size_type /*count*/ )
+        {
+        }
+
+        size_type max_size() const
+        {
+            return std::numeric_limits<size_type>::max() / sizeof( T );
+        }
+
+        Arena * arena() const
+        {
+            return mpArena;
+        }
+
+        template<typename U>
+        bool operator == ( const ArenaAllocator<U>& rhs ) const
+        {
+            return mpArena == rhs.arena();
+        }
+
+        template<typename U>
+        bool operator != ( const ArenaAllocator<U>& rhs ) const
+        {
+            return mpArena != rhs.arena();
+        }
+
+    private:
+        Arena * mpArena;
+    };
+
+    /**
+     * Returns the calling thread's arena, created on first use and freed
+     * when the thread exits. Each thread owns its arena, so reset it from
+     * the thread that uses it, typically once per frame.
+     */
+    Arena& threadArena();
+}
+
+#endif
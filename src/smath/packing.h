@@ -0,0 +1,152 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_PACKING_H
+#define SCOTT_MATH_PACKING_H
+
+//
+// Compact storage formats for animation data, vertex streams and network
+// snapshots, which are usually limited by memory bandwidth rather than
+// arithmetic:
+//
+//   Format                  Size      Precision
+//   Half (IEEE binary16)    2 bytes   11 significant bits, range 65504
+//   Bfloat16                2 bytes   8 significant bits, float range
+//   Snorm16                 2 bytes   1/32767 of a chosen range
+//   Octahedral normal       4 bytes   about 0.004 degrees
+//   Smallest three quat     6 bytes   about 2e-5 per component
+//
+// Each format has scalar functions for single values and batch versions in
+// Math::batch for whole arrays. The batch versions use the runtime selected
+// instruction set like the kernels in batch.h. They pack to exactly the
+// same bits as the scalar functions, except for NaN payloads; unpacked
+// normals and quaternions may differ in the last bit on levels with fused
+// multiply-adds. See smath/half.h for scalar types stored in these formats.
+//
+#include <smath/config.h>
+#include <smath/quaternion.h>
+#include <smath/vector.h>
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace Math
+{
+    /**
+     * Unit normal in octahedral encoding: the sphere is projected onto an
+     * octahedron, which is unfolded into a square, and the two square
+     * coordinates are stored as snorm16.
+     */
+    struct PackedNormal
+    {
+        uint16_t bits[2];
+    };
+
+    /**
+     * Unit quaternion in 48 bits with smallest three compression. The
+     * largest magnitude component is dropped and recomputed from the unit
+     * length when unpacking; the other three are stored as 15 bit
+     * fractions of [-1/sqrt(2), 1/sqrt(2)], with the index of the dropped
+     * component in the two remaining bits. The quaternion may come back
+     * negated, which is the same rotation.
+     */
+    struct PackedQuaternion
+    {
+        uint16_t bits[3];
+    };
+
+    /**
+     * Converts a float to IEEE half precision, rounding to nearest even.
+     * Values beyond the half range become infinity.
+     */
+    uint16_t packHalf( float value );
+    float unpackHalf( uint16_t bits );
+
+    /**
+     * Converts a float to bfloat16, the upper 16 bits of the float, rounding
+     * to nearest even.
+     */
+    uint16_t packBFloat16( float value );
+    float unpackBFloat16( uint16_t bits );
+
+    /**
+     * Converts a float in [-1,1] to a 16 bit signed normalized integer,
+     * rounding to nearest and clamping values outside the range.
+     */
+    int16_t packSnorm16( float value );
+    float unpackSnorm16( int16_t bits );
+
+    /**
+     * Packs a unit length normal. The vector need not be exactly unit
+     * length but must not be zero; unpacked normals are normalized.
+     */
+    PackedNormal packOctahedral( const TVector3<float>& normal );
+    TVector3<float> unpackOctahedral( const PackedNormal& packed );
+
+    /**
+     * Packs a unit quaternion.
+     */
+    PackedQuaternion packQuaternion( const TQuaternion<float>& q );
+    TQuaternion<float> unpackQuaternion( const PackedQuaternion& packed );
+
+namespace batch
+{
+    /**
+     * Converts count floats, or the components of count vectors, to half
+     * precision and back. Vector overloads write three or four halves per
+     * vector.
+     */
+    void packHalf( const float * pIn, uint16_t * pOut, size_t count );
+    void packHalf( const TVector3<float> * pIn, uint16_t * pOut, size_t count );
+    void packHalf( const TVector4<float> * pIn, uint16_t * pOut, size_t count );
+
+    void unpackHalf( const uint16_t * pIn, float * pOut, size_t count );
+    void unpackHalf( const uint16_t * pIn, TVector3<float> * pOut, size_t count );
+    void unpackHalf( const uint16_t * pIn, TVector4<float> * pOut, size_t count );
+
+    /**
+     * Converts count floats to bfloat16 and back.
+     */
+    void packBFloat16( const float * pIn, uint16_t * pOut, size_t count );
+    void unpackBFloat16( const uint16_t * pIn, float * pOut, size_t count );
+
+    /**
+     * Converts count floats, or the components of count vectors, in
+     * [-range, range] to snorm16 and back. Use the extent of an animation
+     * clip or a mesh as the range to quantize positions.
+     */
+    void packSnorm16( const float * pIn, int16_t * pOut, size_t count, float range = 1.0f );
+    void packSnorm16( const TVector3<float> * pIn, int16_t * pOut, size_t count, float range = 1.0f );
+    void packSnorm16( const TVector4<float> * pIn, int16_t * pOut, size_t count, float range = 1.0f );
+
+    void unpackSnorm16( const int16_t * pIn, float * pOut, size_t count, float range = 1.0f );
+    void unpackSnorm16( const int16_t * pIn, TVector3<float> * pOut, size_t count, float range = 1.0f );
+    void unpackSnorm16( const int16_t * pIn, TVector4<float> * pOut, size_t count, float range = 1.0f );
+
+    /**
+     * Packs and unpacks count normals, see Math::packOctahedral.
+     */
+    void packOctahedral( const TVector3<float> * pIn, PackedNormal * pOut, size_t count );
+    void unpackOctahedral( const PackedNormal * pIn, TVector3<float> * pOut, size_t count );
+
+    /**
+     * Packs and unpacks count quaternions, see Math::packQuaternion.
+     */
+    void packQuaternion( const TQuaternion<float> * pIn, PackedQuaternion * pOut, size_t count );
+    void unpackQuaternion( const PackedQuaternion * pIn, TQuaternion<float> * pOut, size_t count );
+}
+}
+
+#endif
@@ -18,7 +18,7 @@
 
 #include <stdlib>
 
-class Random;
+#include <smath/random.h>
 
 /**
  * Random number generator using the mersenne twister algorithm for
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_POISSON_DISK_H
+#define SCOTT_MATH_POISSON_DISK_H
+
+//
+// Poisson-disk (blue noise) point sets: random points that are never
+// closer than a minimum distance to each other, yet leave no gaps where
+// another point would fit. Use them to scatter vegetation, rocks and decals
+// without the clumps and holes of uniform random points.
+//
+// poissonDisk() implements Bridson's "Fast Poisson Disk Sampling in
+// Arbitrary Dimensions" (2007): a background grid with cells small enough
+// to hold at most one point means each candidate is checked against a
+// constant number of neighbours, so generation is O(n) in the number of
+// points rather than the O(n^2) of plain dart throwing.
+//
+// For very large areas, generate a BlueNoiseTile once and scatter() copies
+// of it instead. The tile wraps around at its edges, so neighbouring copies
+// keep the minimum distance across the seams and placing a point costs no
+// more than copying it.
+//
+#include <smath/config.h>
+#include <smath/random.h>
+#include <smath/rect.h>
+#include <smath/vector.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace Math
+{
+    /// Candidates tried around each point before it is retired, Bridson's k
+    const int PoissonDiskAttempts = 30;
+
+    /**
+     * Fills a rectangle with Poisson-disk distributed points.
+     *
+     * \param  bounds    Area to fill
+     * \param  radius    Minimum distance between any two points
+     * \param  random    Random number generator
+     * \param  points    Receives the points, replacing its contents
+     * \param  attempts  Candidates tried around each point; more gives a
+     *                   slightly denser set at a higher cost
+     */
+    template<typename Engine>
+    void poissonDisk( const RectF& bounds,
+                      float radius,
+                      TRandom<Engine>& random,
+                      std::vector< TVector2<float> >& points,
+                      int attempts = PoissonDiskAttempts );
+
+    /**
+     * Fills an axis aligned box with Poisson-disk distributed points.
+     *
+     * \param  minCorner  Corner of the box with the smallest coordinates
+     * \param  maxCorner  Corner of the box with the largest coordinates
+     * \param  radius     Minimum distance between any two points
+     * \param  random     Random number generator
+     * \param  points     Receives the points, replacing its contents
+     * \param  attempts   Candidates tried around each point
+     */
+    template<typename Engine>
+    void poissonDisk( const TVector3<float>& minCorner,
+                      const TVector3<float>& maxCorner,
+                      float radius,
+                      TRandom<Engine>& random,
+                      std::vector< TVector3<float> >& points,
+                      int attempts = PoissonDiskAttempts );
+
+    /**
+     * Tileable square of Poisson-disk points. The points lie in [0,1)^2 and
+     * keep their minimum distance when measured across the edges of the
+     * square, so copies of the tile placed side by side form one seamless
+     * blue noise pattern.
+     *
+     *   Math::BlueNoiseTile tile;
+     *   tile.generate( 0.02f, random );          // once, at load time
+     *   tile.scatter( level.bounds(), 64.0f, grassPositions );
+     *
+     * Repeating a tile repeats its pattern; vary per instance attributes
+     * (rotation, scale, which mesh) from a hash of the position to hide it.
+     */
+    class BlueNoiseTile
+    {
+    public:
+        BlueNoiseTile();
+
+        /**
+         * Regenerates the tile's points.
+         *
+         * \param  radius    Minimum distance between points, as a fraction
+         *                   of the tile size in (0, 0.5)
+         * \param  random    Random number generator
+         * \param  attempts  Candidates tried around each point
+         */
+        template<typename Engine>
+        void generate( float radius, TRandom<Engine>& random, int attempts = PoissonDiskAttempts );
+
+        /**
+         * Appends the points of every copy of the tile that fall inside a
+         * region. Copies are tileSize wide and anchored at the origin, so
+         * regions scattered with the same tile and size line up seamlessly.
+         * The points are radius * tileSize apart.
+         *
+         * \param  region    Area to fill
+         * \param  tileSize  Width and height of one copy of the tile
+         * \param  points    Points are appended to this
+         */
+        void scatter( const RectF& region, float tileSize,
+                      std::vector< TVector2<float> >& points ) const;
+
+        /**
+         * Returns the points of the tile, in [0,1)^2.
+         */
+        const std::vector< TVector2<float> >& points() const
+        {
+            return mPoints;
+        }
+
+        /**
+         * Returns the minimum distance between points, relative to the tile
+         * size.
+         */
+        float radius() const
+        {
+            return mRadius;
+        }
+
+        size_t size() const
+        {
+            return mPoints.size();
+        }
+
+    private:
+        std::vector< TVector2<float> > mPoints;
+        float mRadius;
+    };
+}
+
+#endif
@@ -23,12 +23,12 @@
 template<typename T> class TQuaternion;
 
 template<typename T> T normal( const TQuaternion<T>& q );
-template<typename T> TQuaternion<T> conjugate( const TQuaternion<T>& q );
-template<typename T> TQuaternion<T> inverse( const TQuaternion<T>& q );
+template<typename T> constexpr TQuaternion<T> conjugate( const TQuaternion<T>& q );
+template<typename T> constexpr TQuaternion<T> inverse( const TQuaternion<T>& q );
 template<typename T> TQuaternion<T> normalize( const TQuaternion<T>& q );
-template<typename T> TQuaternion<T> lerp( const TQuaternion<T>& a,
-                                          const TQuaternion<T>& b,
-                                          T t );
+template<typename T> constexpr TQuaternion<T> lerp( const TQuaternion<T>& a,
+                                                    const TQuaternion<T>& b,
+                                                    T t );
 
 /**
  * Quaternions are used to represent rotations in the game engine. Quaternions
@@ -70,7 +70,7 @@ public:
     /**
      * Quaternion constructor
      */
-    TQuaternion( value_type w, value_type x, value_type y, value_type z )
+    constexpr TQuaternion( value_type w, value_type x, value_type y, value_type z )
         : mW( w ),
           mX( x ),
           mY( y ),
@@ -81,7 +81,7 @@ public:
     /**
      * Copy constructor
      */
-    TQuaternion( const TQuaternion<T>& q )
+    constexpr TQuaternion( const TQuaternion<T>& q )
         : mW( q.mW ),
           mX( q.mX ),
           mY( q.mY ),
@@ -142,7 +142,7 @@ public:
     /**
      * Addition operator
      */
-    TQuaternion<T> operator + ( const TQuaternion<T>& rhs ) const
+    constexpr TQuaternion<T> operator + ( const TQuaternion<T>& rhs ) const
     {
         return TQuaternion<T>(
                 mW + rhs.mW,
@@ -168,7 +168,7 @@ public:
     /**
      * Subtraction operator
      */
-    TQuaternion<T> operator - ( const TQuaternion<T>& rhs ) const
+    constexpr TQuaternion<T> operator - ( const TQuaternion<T>& rhs ) const
     {
         return TQuaternion<T>(
                 mW - rhs.mW,
@@ -194,7 +194,7 @@ public:
     /**
      * Multiplication operator
      */
-    TQuaternion<T> operator * ( const TQuaternion<T>& rhs ) const
+    constexpr TQuaternion<T> operator * ( const TQuaternion<T>& rhs ) const
     {
         return TQuaternion<T>(
                 mW * rhs.mW - mX * rhs.mX - mY * rhs.mY - mZ * rhs.mZ,
@@ -234,7 +234,7 @@ public:
     /**
      * X component
      */
-    value_type x() const
+    constexpr value_type x() const
     {
         return mX;
     }
@@ -242,7 +242,7 @@ public:
     /**
      * Y component
      */
-    value_type y() const
+    constexpr value_type y() const
     {
         return mY;
     }
@@ -250,7 +250,7 @@ public:
     /**
      * Z component
      */
-    value_type z() const
+    constexpr value_type z() const
     {
         return mZ;
     }
@@ -258,7 +258,7 @@ public:
     /**
      * W component
      */
-    value_type w() const
+    constexpr value_type w() const
     {
         return mW;
     }
@@ -267,16 +267,16 @@ public:
     friend value_type normal<>( const TQuaternion<T>& q );
 
     // Calculate the conjugate of a quaternion
-    friend TQuaternion<T> conjugate<>( const TQuaternion<T>& q );
+    friend constexpr TQuaternion<T> conjugate<>( const TQuaternion<T>& q );
 
     // Calculate the inverse of a quaternion
-    friend TQuaternion<T> inverse<>( const TQuaternion<T>& q );
+    friend constexpr TQuaternion<T> inverse<>( const TQuaternion<T>& q );
 
     // Normalize a quaternion
     friend TQuaternion<T> normalize<>( const TQuaternion<T>& q );
 
     // Linearly interpolate a quarternion.
-    friend TQuaternion<T> lerp<>( const TQuaternion<T>& a, const TQuaternion<T>& b, T t );
+    friend constexpr TQuaternion<T> lerp<>( const TQuaternion<T>& a, const TQuaternion<T>& b, T t );
 
 public:
     static const TQuaternion<T> ZERO;
@@ -314,7 +314,7 @@ T normal( const TQuaternion<T>& q )
  * Calculates and returns the quaternion's conjugate
  */
 template<typename T>
-TQuaternion<T> conjugate( const TQuaternion<T>& q )
+constexpr TQuaternion<T> conjugate( const TQuaternion<T>& q )
 {
     return TQuaternion<T>( q.mW, -q.mX, -q.mY, -q.mZ );
 }
@@ -323,7 +323,7 @@ TQuaternion<T> conjugate( const TQuaternion<T>& q )
  * Calculates and returns the quaternion's inverse
  */
 template<typename T>
-TQuaternion<T> inverse( const TQuaternion<T>& q )
+constexpr TQuaternion<T> inverse( const TQuaternion<T>& q )
 {
     return conjugate( q );
 }
@@ -342,7 +342,7 @@ TQuaternion<T> normalize( const TQuaternion<T>& q )
  * Linearly interpolate two quaternions based on a third value ranging from 0.0 to 1.0
  */
 template<typename T>
-TQuaternion<T> lerp( const TQuaternion<T>& a, const TQuaternion<T>& b, T t )
+constexpr TQuaternion<T> lerp( const TQuaternion<T>& a, const TQuaternion<T>& b, T t )
 {
     return TQuaternion<T>(
         a.mW + t * ( b.mW - a.mW ),
@@ -372,13 +372,13 @@ std::ostream& operator << ( std::ostream& os, const TQuaternion<T>& q )
  * Zero quaternion (all components are zero)
  */
 template<typename T>
-const TQuaternion<T> TQuaternion<T>::ZERO = TQuaternion<T>( 0, 0, 0, 0 );
+constexpr TQuaternion<T> TQuaternion<T>::ZERO = TQuaternion<T>( 0, 0, 0, 0 );
 
 /**
  * Identity quaternion
  */
 template<typename T>
-const TQuaternion<T> TQuaternion<T>::IDENTITY = TQuaternion<T>( 1, 0, 0, 0 );
+constexpr TQuaternion<T> TQuaternion<T>::IDENTITY = TQuaternion<T>( 1, 0, 0, 0 );
 
 #ifdef MATH_TYPEDEFS
 typedef TQuaternion<scalar_t> Quat;
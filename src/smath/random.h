@@ -16,32 +16,82 @@
 #ifndef SCOTT_MATH_RANDOM_H
 #define SCOTT_MATH_RANDOM_H
 
+#include <smath/randomstate.h>
+
 #include <stdint.h>
 #include <cstdlib>
 #include <algorithm>
-
-struct random_state_t;
+#include <vector>
 
 /**
- * Random number generator.
- * [NEEDS MORE DESCRIPTION]
+ * Random number generator, producing integers, floating point values,
+ * bytes and gaussian values from the raw 32 bit output of an engine (see
+ * randomstate.h).
+ *
+ * The engine state is held inline, so generators are plain values that are
+ * cheap to create, copy and move and can be stored contiguously in arrays,
+ * one per entity. Random uses the MT19937 engine whose state is a 2.5 KB
+ * table; AlignedRandom keeps each table on its own cache lines, and must be
+ * stored in a Math::AlignedVector<AlignedRandom, 64> rather than a
+ * std::vector. FastRandom (xoshiro256**) is the better choice for most
+ * uses, and SmallRandom (SplitMix64) when there are many generators.
+ * TRandom<Math::Pcg32> is also available.
  */
-class Random
+template<typename Engine>
+class TRandom
 {
 public:
-    Random();
-    Random( uint32_t seed );
-    Random( const Random& r );
-    ~Random();
+    typedef Engine engine_type;
+
+    TRandom();
+    explicit TRandom( uint32_t seed );
 
-    Random& operator = ( const Random& rhs );
+    TRandom( const TRandom& ) = default;
+    TRandom( TRandom&& ) = default;
+
+    TRandom& operator = ( const TRandom& ) = default;
+    TRandom& operator = ( TRandom&& ) = default;
     
     int nextInt();
+
+    /**
+     * Returns a uniformly distributed value in [0, max].
+     */
     int nextInt( int max );
+
+    /**
+     * Returns a uniformly distributed value in [min, max]. Either bound may
+     * be negative.
+     */
     int nextInt( int min, int max );
 
-    unsigned int nextUInt();
+    /**
+     * Fills out with count uniformly distributed values in [min, max].
+     * Cheaper per value than calling nextInt( min, max ) in a loop.
+     *
+     * \param  pOut   Array to write the values to
+     * \param  count  Number of values to write
+     * \param  min    Smallest value to generate
+     * \param  max    Largest value to generate
+     */
+    void nextInts( int * pOut, size_t count, int min, int max );
+
+    /**
+     * Returns the next raw 32 bit value from the engine.
+     */
+    unsigned int nextUInt()
+    {
+        return mEngine.next();
+    }
+
+    /**
+     * Returns a uniformly distributed value in [0, max].
+     */
     unsigned int nextUInt( unsigned int max );
+
+    /**
+     * Returns a uniformly distributed value in [min, max].
+     */
     unsigned int nextUInt( unsigned int min, unsigned int max );
 
     float nextFloat();
@@ -59,18 +109,99 @@ public:
     float nextGaussian( float standardDeviation, float mean );
     float nextGaussian( float standardDeviation, float mean, float min, float max );
 
+    /**
+     * Returns the engine producing the raw values.
+     */
+    Engine& engine()
+    {
+        return mEngine;
+    }
+
 public:
     static unsigned int getRandomSeed();
 
 private:
-    void init( random_state_t * pState, uint32_t seed );
-    void initByArray( random_state_t * pState, uint32_t key[], size_t length );
+    uint32_t nextBounded( uint32_t range );
 
 private:
-    random_state_t * mpState;
+    Engine mEngine;
     bool mHasNextGaussian;
     float mNextGaussian;
 };
 
-#endif
+//
+// Bounded integers use Lemire's multiply-shift method ("Fast Random Integer
+// Generation in an Interval", 2019). The 32 bit value is scaled into the
+// range with a 32x32 -> 64 bit multiply; the few values that would make the
+// result biased are rejected, and the divide that finds them only runs when
+// the low half of the product lands in the first `range` values, which for
+// small ranges almost never happens. They are inline as shuffle and sampling
+// loops call them in bulk.
+//
+
+/**
+ * Returns a value in [0, range), range must not be zero.
+ */
+template<typename Engine>
+inline uint32_t TRandom<Engine>::nextBounded( uint32_t range )
+{
+    uint64_t product = static_cast<uint64_t>( mEngine.next() ) * range;
+    uint32_t low = static_cast<uint32_t>( product );
 
+    if ( low < range )
+    {
+        // 2^32 mod range, the number of values to reject
+        const uint32_t threshold = static_cast<uint32_t>( -range ) % range;
+
+        while ( low < threshold )
+        {
+            product = static_cast<uint64_t>( mEngine.next() ) * range;
+            low = static_cast<uint32_t>( product );
+        }
+    }
+
+    return static_cast<uint32_t>( product >> 32 );
+}
+
+template<typename Engine>
+inline unsigned int TRandom<Engine>::nextUInt( unsigned int min, unsigned int max )
+{
+    const uint32_t range = static_cast<uint32_t>( max - min ) + 1u;
+
+    // The full 32 bit range wraps to zero
+    return range == 0 ? nextUInt() : min + nextBounded( range );
+}
+
+template<typename Engine>
+inline unsigned int TRandom<Engine>::nextUInt( unsigned int max )
+{
+    return nextUInt( 0u, max );
+}
+
+template<typename Engine>
+inline int TRandom<Engine>::nextInt( int min, int max )
+{
+    // Work in unsigned arithmetic so ranges wider than INT_MAX don't overflow
+    return static_cast<int>( nextUInt( static_cast<uint32_t>( min ),
+                                       static_cast<uint32_t>( max ) ) );
+}
+
+template<typename Engine>
+inline int TRandom<Engine>::nextInt( int max )
+{
+    return nextInt( 0, max );
+}
+
+// Instantiated in random.cpp
+extern template class TRandom<Math::MersenneTwister>;
+extern template class TRandom<Math::AlignedMersenneTwister>;
+extern template class TRandom<Math::SplitMix64>;
+extern template class TRandom<Math::Xoshiro256>;
+extern template class TRandom<Math::Pcg32>;
+
+typedef TRandom<Math::MersenneTwister> Random;
+typedef TRandom<Math::AlignedMersenneTwister> AlignedRandom;
+typedef TRandom<Math::SplitMix64> SmallRandom;
+typedef TRandom<Math::Xoshiro256> FastRandom;
+
+#endif
@@ -16,44 +16,282 @@
 #ifndef SCOTT_RANDOM_STATE_H
 #define SCOTT_RANDOM_STATE_H
 
-//#define MATH_USE_STD_RANDOM
-
-#ifdef MATH_USE_STD_RANDOM
-#include <random>
-
-struct random_state_t
-{
-    std::mt19937 rng;
-};
-
-#else
+//
+// Engines that produce the raw 32 bit values consumed by TRandom. An engine
+// is a small value type with a next() method returning the next uint32_t in
+// its sequence and a seed() method that restarts it. Engines hold their
+// state inline, so generators can be copied, moved and stored in arrays
+// without any heap allocation.
+//
+//   Engine           State    Notes
+//   MersenneTwister  2.5 KB   Reference quality, slow to seed and copy
+//   Xoshiro256       32 B     Fast and high quality, supports jump()
+//   Pcg32            16 B     Good quality, independent streams
+//   SplitMix64       8 B      Fastest and smallest, modest quality
+//
+// AlignedMersenneTwister is a MersenneTwister aligned to a cache line.
+//
 #include <cstddef>
 #include <stdint.h>
 
 namespace RandomConstants
 {
     const uint32_t N = 624;
-    const uint32_t M = 396;
+    const uint32_t M = 397;
     const uint32_t MATRIX_A = 0x9908B0DFU;
     const uint32_t UPPER_MASK = 0x80000000U;
     const uint32_t LOWER_MASK = 0x7fffffffU;
     const uint32_t INITIAL_SEED = 5489U;
 }
 
+/**
+ * MT19937 state.
+ */
 struct random_state_t
 {
-    random_state_t();
-    random_state_t( const random_state_t& rhs );
-    random_state_t( const random_state_t *rhs );
-
-    ~random_state_t();
-
-    random_state_t& operator = ( const random_state_t& rhs );
-
     uint32_t vals[RandomConstants::N];
     uint32_t seed;
     size_t index;
 };
-#endif
+
+namespace Math
+{
+    /**
+     * MT19937 Mersenne twister engine. High quality with a very long period,
+     * but it carries 2.5 KB of state and regenerates all 624 words of it at
+     * once every 624 outputs.
+     */
+    class MersenneTwister
+    {
+    public:
+        explicit MersenneTwister( uint32_t seed = RandomConstants::INITIAL_SEED );
+
+        /**
+         * Restarts the sequence from the given seed.
+         */
+        void seed( uint32_t seed );
+
+        /**
+         * Restarts the sequence from an array of seed values, for seeds
+         * wider than 32 bits.
+         *
+         * \param  pKey    Seed values
+         * \param  length  Number of values in pKey
+         */
+        void seed( const uint32_t * pKey, size_t length );
+
+        /**
+         * Returns the next value in the sequence.
+         */
+        uint32_t next()
+        {
+            if ( mState.index >= RandomConstants::N )
+            {
+                regenerate();
+            }
+
+            uint32_t y = mState.vals[ mState.index++ ];
+
+            // Tempering
+            y ^= ( y >> 11 );
+            y ^= ( y << 7 )  & 0x9d2c5680U;
+            y ^= ( y << 15 ) & 0xefc60000U;
+            y ^= ( y >> 18 );
+
+            return y;
+        }
+
+    private:
+        void regenerate();
+
+    private:
+        random_state_t mState;
+    };
+
+    /**
+     * MT19937 engine aligned to a cache line, so that the 2.5 KB table of
+     * one generator never shares a line with its neighbours in an array.
+     * Over-aligned types need an aligned allocator before C++17, so store
+     * these in a Math::AlignedVector rather than a std::vector or plain new.
+     */
+    class alignas(64) AlignedMersenneTwister : public MersenneTwister
+    {
+    public:
+        explicit AlignedMersenneTwister( uint32_t seed = RandomConstants::INITIAL_SEED )
+            : MersenneTwister( seed )
+        {
+        }
+    };
+
+    /**
+     * SplitMix64 engine. Eight bytes of state and a handful of instructions
+     * per value, for the many per-entity generators where state size and
+     * speed matter more than statistical quality.
+     */
+    class SplitMix64
+    {
+    public:
+        explicit SplitMix64( uint64_t seed = RandomConstants::INITIAL_SEED )
+            : mState( seed )
+        {
+        }
+
+        /**
+         * Restarts the sequence from the given seed.
+         */
+        void seed( uint64_t seed )
+        {
+            mState = seed;
+        }
+
+        /**
+         * Returns the next 64 bit value in the sequence.
+         */
+        uint64_t next64()
+        {
+            uint64_t z = ( mState += 0x9e3779b97f4a7c15ull );
+            z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+            z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebull;
+            return z ^ ( z >> 31 );
+        }
+
+        /**
+         * Returns the next value in the sequence, the high half of next64().
+         */
+        uint32_t next()
+        {
+            return static_cast<uint32_t>( next64() >> 32 );
+        }
+
+    private:
+        uint64_t mState;
+    };
+
+    /**
+     * xoshiro256** engine by Blackman and Vigna. 32 bytes of state, a period
+     * of 2^256 - 1 and excellent statistical quality at a few cycles per
+     * value; the best general purpose choice.
+     */
+    class Xoshiro256
+    {
+    public:
+        explicit Xoshiro256( uint64_t seed = RandomConstants::INITIAL_SEED )
+        {
+            this->seed( seed );
+        }
+
+        /**
+         * Restarts the sequence from the given seed. The seed is expanded
+         * into the full state with SplitMix64, as the authors recommend.
+         */
+        void seed( uint64_t seed )
+        {
+            SplitMix64 expander( seed );
+
+            for ( int i = 0; i < 4; ++i )
+            {
+                mState[i] = expander.next64();
+            }
+        }
+
+        /**
+         * Sets the full state. At least one word must be non-zero.
+         */
+        void seed( uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3 )
+        {
+            mState[0] = s0;
+            mState[1] = s1;
+            mState[2] = s2;
+            mState[3] = s3;
+        }
+
+        /**
+         * Returns the next 64 bit value in the sequence.
+         */
+        uint64_t next64()
+        {
+            const uint64_t result = rotl( mState[1] * 5, 7 ) * 9;
+            const uint64_t t = mState[1] << 17;
+
+            mState[2] ^= mState[0];
+            mState[3] ^= mState[1];
+            mState[1] ^= mState[2];
+            mState[0] ^= mState[3];
+            mState[2] ^= t;
+            mState[3] = rotl( mState[3], 45 );
+
+            return result;
+        }
+
+        /**
+         * Returns the next value in the sequence, the high half of next64().
+         */
+        uint32_t next()
+        {
+            return static_cast<uint32_t>( next64() >> 32 );
+        }
+
+        /**
+         * Advances the sequence by 2^128 values. Seed one engine and jump
+         * copies of it to get up to 2^128 non-overlapping streams, one per
+         * thread or job.
+         */
+        void jump();
+
+    private:
+        static uint64_t rotl( uint64_t x, int k )
+        {
+            return ( x << k ) | ( x >> ( 64 - k ) );
+        }
+
+    private:
+        uint64_t mState[4];
+    };
+
+    /**
+     * PCG32 (XSH RR) engine by O'Neill. 16 bytes of state and good quality,
+     * with selectable streams: engines with the same seed and different
+     * streams produce independent sequences.
+     */
+    class Pcg32
+    {
+    public:
+        explicit Pcg32( uint64_t seed = RandomConstants::INITIAL_SEED, uint64_t stream = 0 )
+        {
+            this->seed( seed, stream );
+        }
+
+        /**
+         * Restarts the sequence from the given seed and stream.
+         */
+        void seed( uint64_t seed, uint64_t stream = 0 )
+        {
+            mState     = 0u;
+            mIncrement = ( stream << 1 ) | 1u;
+
+            next();
+            mState += seed;
+            next();
+        }
+
+        /**
+         * Returns the next value in the sequence.
+         */
+        uint32_t next()
+        {
+            const uint64_t old = mState;
+            mState = old * 6364136223846793005ull + mIncrement;
+
+            const uint32_t xorShifted = static_cast<uint32_t>( ( ( old >> 18 ) ^ old ) >> 27 );
+            const uint32_t rotation   = static_cast<uint32_t>( old >> 59 );
+
+            return ( xorShifted >> rotation ) | ( xorShifted << ( ( 32 - rotation ) & 31 ) );
+        }
+
+    private:
+        uint64_t mState;
+        uint64_t mIncrement;
+    };
+}
 
 #endif
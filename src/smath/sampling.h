@@ -0,0 +1,345 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_SAMPLING_H
+#define SCOTT_MATH_SAMPLING_H
+
+//
+// Random sampling: shuffling, choosing elements without replacement,
+// reservoir sampling over streams and weighted choice with alias tables.
+//
+// Every function takes the generator as a template parameter, so any
+// TRandom<Engine> (Random, FastRandom, SmallRandom...) can be used and its
+// bounded integer generation is inlined into the sampling loop.
+//
+#include <smath/config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <stdint.h>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace Math
+{
+    /**
+     * Shuffles the range in place with the Fisher-Yates algorithm; every
+     * permutation is equally likely.
+     *
+     * \param  first   Start of the range
+     * \param  last    End of the range
+     * \param  random  Random number generator
+     */
+    template<typename RandomIt, typename Generator>
+    void shuffle( RandomIt first, RandomIt last, Generator& random )
+    {
+        typedef typename std::iterator_traits<RandomIt>::difference_type difference_type;
+        const difference_type count = last - first;
+
+        for ( difference_type i = count - 1; i > 0; --i )
+        {
+            difference_type j = static_cast<difference_type>(
+                random.nextUInt( static_cast<unsigned int>( i ) ) );
+
+            using std::swap;
+            swap( first[i], first[j] );
+        }
+    }
+
+    /**
+     * Moves a uniformly chosen subset of count elements to the front of the
+     * range, in random order, without shuffling the rest. This is sampling
+     * without replacement in O(count) time.
+     *
+     * \param  first   Start of the range
+     * \param  last    End of the range
+     * \param  count   Number of elements to choose, clamped to the range size
+     * \param  random  Random number generator
+     * \return         End of the chosen elements
+     */
+    template<typename RandomIt, typename Generator>
+    RandomIt partialShuffle( RandomIt first, RandomIt last, size_t count, Generator& random )
+    {
+        typedef typename std::iterator_traits<RandomIt>::difference_type difference_type;
+        const difference_type size = last - first;
+        const difference_type chosen =
+            static_cast<difference_type>( count ) < size ? static_cast<difference_type>( count )
+                                                         : size;
+
+        for ( difference_type i = 0; i < chosen; ++i )
+        {
+            difference_type j = static_cast<difference_type>(
+                random.nextUInt( static_cast<unsigned int>( i ),
+                                 static_cast<unsigned int>( size - 1 ) ) );
+
+            using std::swap;
+            swap( first[i], first[j] );
+        }
+
+        return first + chosen;
+    }
+
+    /**
+     * Chooses count distinct indices from [0, size) uniformly at random,
+     * without touching the data they index. Small selections use Floyd's
+     * algorithm, which draws exactly count values and needs memory in
+     * proportion to count only; larger ones partially shuffle all indices.
+     *
+     * \param  size     Number of indices to choose from
+     * \param  count    Number of indices to choose, clamped to size
+     * \param  random   Random number generator
+     * \param  indices  Receives the chosen indices, in no particular order
+     */
+    template<typename Generator>
+    void sampleIndices( uint32_t size, uint32_t count, Generator& random,
+                        std::vector<uint32_t>& indices )
+    {
+        count = std::min( count, size );
+
+        indices.clear();
+        indices.reserve( count );
+
+        // Dense selections are cheaper to shuffle than to hash
+        if ( count > size / 4 )
+        {
+            indices.resize( size );
+
+            for ( uint32_t i = 0; i < size; ++i )
+            {
+                indices[i] = i;
+            }
+
+            partialShuffle( indices.begin(), indices.end(), count, random );
+            indices.resize( count );
+
+            return;
+        }
+
+        std::unordered_set<uint32_t> chosen( count * 2 );
+
+        for ( uint32_t j = size - count; j < size; ++j )
+        {
+            uint32_t t = random.nextUInt( j );
+
+            if ( chosen.insert( t ).second )
+            {
+                indices.push_back( t );
+            }
+            else
+            {
+                chosen.insert( j );
+                indices.push_back( j );
+            }
+        }
+    }
+
+    /**
+     * Keeps a uniform random sample of up to capacity values from a stream of
+     * unknown length, using Li's "Algorithm L": after the reservoir fills,
+     * the number of values to skip before the next replacement is drawn
+     * directly, so long streams cost a few random numbers per replacement
+     * rather than one per value.
+     *
+     *   Math::ReservoirSampler<Enemy> sampler( 8 );
+     *   for ( ... ) sampler.add( enemy, random );
+     *   const std::vector<Enemy>& targets = sampler.samples();
+     */
+    template<typename T>
+    class ReservoirSampler
+    {
+    public:
+        /**
+         * \param  capacity  Number of values to keep, must be at least one
+         */
+        explicit ReservoirSampler( size_t capacity )
+            : mSamples(),
+              mCapacity( capacity ),
+              mSeen( 0 ),
+              mNext( 0 ),
+              mLogW( 0.0 )
+        {
+            SMATH_ASSERT( capacity > 0, "Reservoir must hold at least one value" );
+            mSamples.reserve( capacity );
+        }
+
+        /**
+         * Offers the next value in the stream to the sample.
+         */
+        template<typename Generator>
+        void add( const T& value, Generator& random )
+        {
+            ++mSeen;
+
+            if ( mSamples.size() < mCapacity )
+            {
+                mSamples.push_back( value );
+
+                if ( mSamples.size() == mCapacity )
+                {
+                    mLogW = std::log( random.nextFloat3() ) / mCapacity;
+                    skip( random );
+                }
+            }
+            else if ( mSeen == mNext )
+            {
+                mSamples[ random.nextUInt( static_cast<unsigned int>( mCapacity - 1 ) ) ] = value;
+
+                mLogW += std::log( random.nextFloat3() ) / mCapacity;
+                skip( random );
+            }
+        }
+
+        /**
+         * Returns the sample, all values seen if fewer than the capacity.
+         */
+        const std::vector<T>& samples() const
+        {
+            return mSamples;
+        }
+
+        /**
+         * Returns the number of values offered so far.
+         */
+        size_t seen() const
+        {
+            return mSeen;
+        }
+
+        /**
+         * Empties the sample to start over with a new stream.
+         */
+        void reset()
+        {
+            mSamples.clear();
+            mSeen = 0;
+            mNext = 0;
+            mLogW = 0.0;
+        }
+
+    private:
+        /**
+         * Draws the position of the next value to replace a sample.
+         */
+        template<typename Generator>
+        void skip( Generator& random )
+        {
+            const double w = std::exp( mLogW );
+            const double gap = std::floor( std::log( random.nextFloat3() ) / std::log1p( -w ) );
+
+            // Only reachable for astronomically long streams, keeps the cast defined
+            const double MaxGap = 1e15;
+
+            mNext = mSeen + 1 + static_cast<size_t>( gap < MaxGap ? gap : MaxGap );
+        }
+
+    private:
+        std::vector<T> mSamples;
+        size_t mCapacity;
+        size_t mSeen;
+        size_t mNext;
+        double mLogW;
+    };
+
+    /**
+     * Weighted discrete distribution with O(1) sampling, built with Vose's
+     * alias method in O(n). Each column of the table holds one outcome, the
+     * probability of keeping it and the outcome to return otherwise (its
+     * alias); sampling picks a column uniformly and then makes one
+     * comparison. Use it for loot and spawn tables that are sampled far more
+     * often than they change.
+     */
+    class AliasTable
+    {
+    public:
+        AliasTable();
+
+        /**
+         * Builds the table from non-negative weights, see build().
+         */
+        explicit AliasTable( const std::vector<float>& weights );
+
+        /**
+         * Rebuilds the table from count non-negative weights. Each index is
+         * sampled with probability weight / sum of weights; if every weight
+         * is zero all indices are equally likely.
+         *
+         * \param  pWeights  Weight of each outcome
+         * \param  count     Number of outcomes
+         */
+        void build( const float * pWeights, size_t count );
+
+        /**
+         * Returns a random outcome index in [0, size()). The table must not
+         * be empty.
+         */
+        template<typename Generator>
+        uint32_t sample( Generator& random ) const
+        {
+            SMATH_ASSERT( !mEntries.empty(), "Cannot sample an empty alias table" );
+
+            const uint32_t column = random.nextUInt( static_cast<unsigned int>( mEntries.size() - 1 ) );
+            const Entry& entry    = mEntries[column];
+
+            // Select without a branch, the comparison is unpredictable
+            const uint32_t keep = 0u - static_cast<uint32_t>( random.nextUInt() < entry.threshold );
+            return ( column & keep ) | ( entry.alias & ~keep );
+        }
+
+        /**
+         * Fills pOut with count outcome indices.
+         */
+        template<typename Generator>
+        void sample( Generator& random, uint32_t * pOut, size_t count ) const
+        {
+            for ( size_t i = 0; i < count; ++i )
+            {
+                pOut[i] = sample( random );
+            }
+        }
+
+        /**
+         * Returns the probability of sampling an outcome, as stored in the
+         * table.
+         */
+        double probability( uint32_t index ) const;
+
+        /**
+         * Returns the number of outcomes.
+         */
+        size_t size() const
+        {
+            return mEntries.size();
+        }
+
+        bool empty() const
+        {
+            return mEntries.empty();
+        }
+
+    private:
+        struct Entry
+        {
+            uint32_t threshold;     // keep the column if a 32 bit draw is below this
+            uint32_t alias;         // outcome otherwise, the column itself if full
+        };
+
+        std::vector<Entry> mEntries;
+    };
+}
+
+#endif
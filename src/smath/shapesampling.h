@@ -0,0 +1,379 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_SHAPE_SAMPLING_H
+#define SCOTT_MATH_SHAPE_SAMPLING_H
+
+//
+// Uniformly distributed points in and on geometric shapes.
+//
+// Every sampler is a direct mapping from uniform values in [0,1) to the
+// shape, with no rejection loop, so the cost per point is fixed and the
+// code has no data dependent branches. The mapX() functions take the
+// uniform values explicitly and so also accept stratified or
+// low-discrepancy input; the randomX() functions draw them from a
+// generator, and their array versions fill structure of arrays buffers in
+// blocks with the runtime dispatched kernels from batch.h.
+//
+#include <smath/config.h>
+#include <smath/batch.h>
+#include <smath/constants.h>
+#include <smath/fastmath.h>
+#include <smath/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+
+namespace Math
+{
+namespace detail
+{
+    /// Number of points generated per block by the array samplers
+    const size_t ShapeSampleBlock = 64;
+
+    /**
+     * Converts a 32 bit random value into a float in [0,1), using the top
+     * 24 bits so every result is exactly representable.
+     */
+    inline float unitFloat( uint32_t bits )
+    {
+        return static_cast<float>( bits >> 8 ) * ( 1.0f / 16777216.0f );
+    }
+
+    /**
+     * Fills pOut with count uniform values in [0,1), the same values as
+     * unitFloat().
+     */
+    template<typename Generator>
+    inline void unitFloats( Generator& random, float * pOut, size_t count )
+    {
+        uint32_t bits[ShapeSampleBlock];
+
+        for ( size_t base = 0; base < count; base += ShapeSampleBlock )
+        {
+            const size_t n = std::min( count - base, ShapeSampleBlock );
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                bits[i] = random.nextUInt();
+            }
+
+            Math::batch::unitFloats( bits, pOut + base, n );
+        }
+    }
+
+    template<typename T>
+    inline T sqrtClamped( T x )
+    {
+        return std::sqrt( x > T(0) ? x : T(0) );
+    }
+}
+
+    /////////////////////////////////////////////////////////////////////////
+    // Mappings from uniform values
+    /////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Maps two uniform values in [0,1) to a point on the unit sphere
+     * (Archimedes' hat box theorem: z is uniform).
+     */
+    template<typename T>
+    inline TVector3<T> mapToSphere( T u1, T u2 )
+    {
+        const T z = T(1) - T(2) * u1;
+        const T r = detail::sqrtClamped( T(1) - z * z );
+
+        T s, c;
+        Math::fast::sincos( static_cast<T>( TwoPi ) * u2, s, c );
+
+        return TVector3<T>( r * c, r * s, z );
+    }
+
+    /**
+     * Maps three uniform values in [0,1) to a point inside the unit sphere.
+     */
+    template<typename T>
+    inline TVector3<T> mapToBall( T u1, T u2, T u3 )
+    {
+        // Cube root of u3, with 1 - u3 in (0,1] keeping the log finite
+        const T radius = Math::fast::exp( Math::fast::log( T(1) - u3 ) / T(3) );
+        return mapToSphere( u1, u2 ) * radius;
+    }
+
+    /**
+     * Maps two uniform values in [0,1) to a point inside the unit disk with
+     * Shirley and Chiu's concentric mapping, which keeps nearby inputs
+     * nearby and so preserves the stratification of the input.
+     */
+    template<typename T>
+    inline TVector2<T> mapToDisk( T u1, T u2 )
+    {
+        const T a = T(2) * u1 - T(1);
+        const T b = T(2) * u2 - T(1);
+
+        // Map each square wedge to a disk wedge, the wedge is picked by
+        // selects rather than branches
+        const bool horizontal = a * a > b * b;
+        const T r     = horizontal ? a : b;
+        const T ratio = ( horizontal ? b : a ) / ( r != T(0) ? r : T(1) );
+        const T phi   = horizontal ? static_cast<T>( QuarterPi ) * ratio
+                                   : static_cast<T>( HalfPi ) - static_cast<T>( QuarterPi ) * ratio;
+
+        T s, c;
+        Math::fast::sincos( phi, s, c );
+
+        return TVector2<T>( r * c, r * s );
+    }
+
+    /**
+     * Maps two uniform values in [0,1) to a direction on the hemisphere
+     * around +Z with density proportional to the cosine of the angle to +Z
+     * (Malley's method: a concentric disk sample lifted to the hemisphere).
+     */
+    template<typename T>
+    inline TVector3<T> mapToCosineHemisphere( T u1, T u2 )
+    {
+        const TVector2<T> d = mapToDisk( u1, u2 );
+        const T z = detail::sqrtClamped( T(1) - d.x() * d.x() - d.y() * d.y() );
+
+        return TVector3<T>( d.x(), d.y(), z );
+    }
+
+    /**
+     * Maps two uniform values in [0,1) to a point on the triangle abc.
+     * Points that land in the far half of the parallelogram spanned by the
+     * edges are reflected back into the triangle.
+     */
+    template<typename T>
+    inline TVector3<T> mapToTriangle( const TVector3<T>& a,
+                                      const TVector3<T>& b,
+                                      const TVector3<T>& c,
+                                      T u1,
+                                      T u2 )
+    {
+        const bool outside = u1 + u2 > T(1);
+
+        const T s = outside ? T(1) - u1 : u1;
+        const T t = outside ? T(1) - u2 : u2;
+
+        return a + ( b - a ) * s + ( c - a ) * t;
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Random points
+    /////////////////////////////////////////////////////////////////////////
+
+    /**
+     * Returns a random point on the unit sphere, a uniform random direction.
+     */
+    template<typename Generator>
+    inline TVector3<float> randomOnSphere( Generator& random )
+    {
+        const float u1 = detail::unitFloat( random.nextUInt() );
+        const float u2 = detail::unitFloat( random.nextUInt() );
+
+        return mapToSphere( u1, u2 );
+    }
+
+    /**
+     * Returns a random point inside the unit sphere.
+     */
+    template<typename Generator>
+    inline TVector3<float> randomInSphere( Generator& random )
+    {
+        const float u1 = detail::unitFloat( random.nextUInt() );
+        const float u2 = detail::unitFloat( random.nextUInt() );
+        const float u3 = detail::unitFloat( random.nextUInt() );
+
+        return mapToBall( u1, u2, u3 );
+    }
+
+    /**
+     * Returns a random point inside the unit disk.
+     */
+    template<typename Generator>
+    inline TVector2<float> randomInDisk( Generator& random )
+    {
+        const float u1 = detail::unitFloat( random.nextUInt() );
+        const float u2 = detail::unitFloat( random.nextUInt() );
+
+        return mapToDisk( u1, u2 );
+    }
+
+    /**
+     * Returns a random cosine weighted direction on the hemisphere around +Z.
+     */
+    template<typename Generator>
+    inline TVector3<float> randomCosineHemisphere( Generator& random )
+    {
+        const float u1 = detail::unitFloat( random.nextUInt() );
+        const float u2 = detail::unitFloat( random.nextUInt() );
+
+        return mapToCosineHemisphere( u1, u2 );
+    }
+
+    /**
+     * Returns a random point on the triangle abc.
+     */
+    template<typename Generator>
+    inline TVector3<float> randomOnTriangle( Generator& random,
+                                             const TVector3<float>& a,
+                                             const TVector3<float>& b,
+                                             const TVector3<float>& c )
+    {
+        const float u1 = detail::unitFloat( random.nextUInt() );
+        const float u2 = detail::unitFloat( random.nextUInt() );
+
+        return mapToTriangle( a, b, c, u1, u2 );
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // Arrays of random points
+    //
+    // Each fills separate x, y (and z) arrays with count points. A block of
+    // uniform values is generated first, then mapped by the batch kernels
+    // and branch free loops the compiler vectorizes.
+    /////////////////////////////////////////////////////////////////////////
+
+    template<typename Generator>
+    void randomOnSphere( Generator& random, float * pX, float * pY, float * pZ, size_t count )
+    {
+        const size_t Block = detail::ShapeSampleBlock;
+        float u1[Block], u2[Block];
+
+        for ( size_t base = 0; base < count; base += Block )
+        {
+            const size_t n = std::min( count - base, Block );
+
+            detail::unitFloats( random, u1, n );
+            detail::unitFloats( random, u2, n );
+
+            Math::batch::mapToSphere( u1, u2, pX + base, pY + base, pZ + base, n );
+        }
+    }
+
+    template<typename Generator>
+    void randomInSphere( Generator& random, float * pX, float * pY, float * pZ, size_t count )
+    {
+        const size_t Block = detail::ShapeSampleBlock;
+        float u[Block], scale[Block];
+
+        randomOnSphere( random, pX, pY, pZ, count );
+
+        // Scale each direction by the cube root of a uniform value in (0,1]
+        for ( size_t base = 0; base < count; base += Block )
+        {
+            const size_t n = std::min( count - base, Block );
+
+            detail::unitFloats( random, u, n );
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                u[i] = 1.0f - u[i];
+            }
+
+            Math::batch::log( scale, u, n );
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                scale[i] *= ( 1.0f / 3.0f );
+            }
+
+            Math::batch::exp( scale, scale, n );
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                pX[base + i] *= scale[i];
+                pY[base + i] *= scale[i];
+                pZ[base + i] *= scale[i];
+            }
+        }
+    }
+
+    template<typename Generator>
+    void randomInDisk( Generator& random, float * pX, float * pY, size_t count )
+    {
+        const size_t Block = detail::ShapeSampleBlock;
+        float u1[Block], u2[Block];
+
+        for ( size_t base = 0; base < count; base += Block )
+        {
+            const size_t n = std::min( count - base, Block );
+
+            detail::unitFloats( random, u1, n );
+            detail::unitFloats( random, u2, n );
+
+            Math::batch::mapToDisk( u1, u2, pX + base, pY + base, n );
+        }
+    }
+
+    template<typename Generator>
+    void randomCosineHemisphere( Generator& random,
+                                 float * pX,
+                                 float * pY,
+                                 float * pZ,
+                                 size_t count )
+    {
+        randomInDisk( random, pX, pY, count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            pZ[i] = std::max( 1.0f - pX[i] * pX[i] - pY[i] * pY[i], 0.0f );
+        }
+
+        Math::batch::sqrt( pZ, pZ, count );
+    }
+
+    template<typename Generator>
+    void randomOnTriangle( Generator& random,
+                           const TVector3<float>& a,
+                           const TVector3<float>& b,
+                           const TVector3<float>& c,
+                           float * pX,
+                           float * pY,
+                           float * pZ,
+                           size_t count )
+    {
+        const size_t Block = detail::ShapeSampleBlock;
+        float u1[Block], u2[Block];
+
+        const TVector3<float> ab = b - a;
+        const TVector3<float> ac = c - a;
+
+        for ( size_t base = 0; base < count; base += Block )
+        {
+            const size_t n = std::min( count - base, Block );
+
+            detail::unitFloats( random, u1, n );
+            detail::unitFloats( random, u2, n );
+
+            for ( size_t i = 0; i < n; ++i )
+            {
+                const bool outside = u1[i] + u2[i] > 1.0f;
+
+                const float s = outside ? 1.0f - u1[i] : u1[i];
+                const float t = outside ? 1.0f - u2[i] : u2[i];
+
+                pX[base + i] = a.x() + ab.x() * s + ac.x() * t;
+                pY[base + i] = a.y() + ab.y() * s + ac.y() * t;
+                pZ[base + i] = a.z() + ab.z() * s + ac.z() * t;
+            }
+        }
+    }
+}
+
+#endif
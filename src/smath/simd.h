@@ -0,0 +1,1070 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_SIMD_H
+#define SCOTT_MATH_SIMD_H
+
+//
+// Thin lane abstraction used to write math kernels once and instantiate them
+// for scalar floats, 4-wide SSE registers and 8-wide AVX2 registers. Every
+// operation is overloaded on the lane type, so a kernel written as a template
+// over V compiles to straight line scalar code or to packed instructions
+// without any branches on the lane type.
+//
+// MATH_SSE2 and MATH_AVX2 are defined when the compiler is targeting an ISA
+// that provides the 4-wide and 8-wide lane types respectively, and
+// MATH_AVX512 when it provides the 16-wide lane type. MATH_SSE41 enables
+// blend instructions for the 4-wide lanes.
+//
+// Everything in Math::simd and Math::fast lives in an inline namespace named
+// after the target ISA (see MATH_ISA_NAMESPACE). Code is unchanged, but the
+// inline functions of translation units built with different instruction
+// set flags get distinct symbols, so the linker can never substitute an
+// AVX2 copy of a function for the baseline copy. The runtime dispatched
+// kernels in batch.h rely on this.
+//
+#include <smath/config.h>
+
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#   define MATH_SSE2
+#   include <emmintrin.h>
+#endif
+
+#if defined(__SSE4_1__) || ( defined(_MSC_VER) && defined(__AVX__) )
+#   define MATH_SSE41
+#   include <smmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#   define MATH_AVX2
+#   include <immintrin.h>
+#endif
+
+#if defined(__AVX512F__)
+#   define MATH_AVX512
+#endif
+
+#if defined(__FMA__) || ( defined(_MSC_VER) && defined(__AVX2__) )
+#   define MATH_FMA
+#endif
+
+#if defined(__F16C__) || ( defined(_MSC_VER) && defined(__AVX2__) )
+#   define MATH_F16C
+#   include <immintrin.h>
+#endif
+
+#if defined(MATH_AVX512)
+#   define MATH_ISA_NAMESPACE isa_avx512
+#elif defined(MATH_AVX2) && defined(MATH_FMA)
+#   define MATH_ISA_NAMESPACE isa_avx2_fma
+#elif defined(MATH_AVX2)
+#   define MATH_ISA_NAMESPACE isa_avx2
+#elif defined(__AVX__)
+#   define MATH_ISA_NAMESPACE isa_avx
+#elif defined(MATH_SSE41)
+#   define MATH_ISA_NAMESPACE isa_sse41
+#elif defined(MATH_SSE2)
+#   define MATH_ISA_NAMESPACE isa_sse2
+#else
+#   define MATH_ISA_NAMESPACE isa_scalar
+#endif
+
+// __m128 and friends carry alignment attributes that GCC warns are dropped
+// when the types are used as template arguments, which is harmless here
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+
+namespace Math
+{
+namespace simd
+{
+inline namespace MATH_ISA_NAMESPACE
+{
+    /**
+     * Maps a floating point lane type to the integer lane type of the same
+     * width.
+     */
+    template<typename V> struct IntLanes;
+
+    /**
+     * Number of floats held by a lane type.
+     */
+    template<typename V> struct LaneCount;
+
+    /**
+     * Returns a lane value with every lane set to v.
+     */
+    template<typename V> V splat( float v );
+
+    /**
+     * Returns an integer lane value with every lane set to v.
+     */
+    template<typename I> I splatInt( int32_t v );
+
+    /**
+     * Loads a lane value from (possibly unaligned) memory.
+     */
+    template<typename V> V load( const float * p );
+
+    /**
+     * Loads one 16 bit value per integer lane, zero extended.
+     */
+    template<typename I> I loadUInt16( const uint16_t * p );
+
+    /**
+     * Loads one 32 bit value per integer lane.
+     */
+    template<typename I> I loadUInt32( const uint32_t * p );
+
+    /**
+     * Loads four floats and repeats them in every group of four lanes. Only
+     * defined for the SIMD lane types.
+     */
+    template<typename V> V loadGroup4( const float * p );
+
+    /**
+     * Maps a float lane type to the double lane type of the same register
+     * width, which holds half as many values.
+     */
+    template<typename V> struct DoubleLanes;
+
+    /**
+     * Returns a double lane value with every lane set to v.
+     */
+    template<typename D> D splatDouble( double v );
+
+    /**
+     * Loads a double lane value from (possibly unaligned) memory.
+     */
+    template<typename D> D load( const double * p );
+
+    /////////////////////////////////////////////////////////////////////////
+    // Scalar lanes
+    /////////////////////////////////////////////////////////////////////////
+    template<> struct IntLanes<float> { typedef int32_t type; };
+    template<> struct LaneCount<float> { enum { value = 1 }; };
+    template<> struct LaneCount<int32_t> { enum { value = 1 }; };
+
+    template<> inline float splat<float>( float v ) { return v; }
+    template<> inline int32_t splatInt<int32_t>( int32_t v ) { return v; }
+
+    inline float add( float a, float b ) { return a + b; }
+    inline float sub( float a, float b ) { return a - b; }
+    inline float mul( float a, float b ) { return a * b; }
+    inline float div( float a, float b ) { return a / b; }
+    inline float madd( float a, float b, float c ) { return a * b + c; }
+    inline float minimum( float a, float b ) { return ( b < a ? b : a ); }
+    inline float maximum( float a, float b ) { return ( a < b ? b : a ); }
+
+    inline bool lessThan( float a, float b ) { return a < b; }
+    inline bool greaterThan( float a, float b ) { return a > b; }
+    inline bool equal( float a, float b ) { return a == b; }
+    inline float select( bool m, float a, float b ) { return ( m ? a : b ); }
+
+    inline int32_t asInt( float a )
+    {
+        int32_t i;
+        std::memcpy( &i, &a, sizeof( i ) );
+        return i;
+    }
+
+    inline float asFloat( int32_t a )
+    {
+        float f;
+        std::memcpy( &f, &a, sizeof( f ) );
+        return f;
+    }
+
+    inline float abs( float a ) { return asFloat( asInt( a ) & 0x7fffffff ); }
+
+    /**
+     * Converts to an integer, rounding to the nearest value.
+     */
+    inline int32_t roundToInt( float a )
+    {
+#ifdef MATH_SSE2
+        return _mm_cvtss_si32( _mm_set_ss( a ) );
+#else
+        return static_cast<int32_t>( std::floor( a + 0.5f ) );
+#endif
+    }
+
+    inline float toFloat( int32_t a ) { return static_cast<float>( a ); }
+
+    inline float sqrt( float a )
+    {
+#ifdef MATH_SSE2
+        return _mm_cvtss_f32( _mm_sqrt_ss( _mm_set_ss( a ) ) );
+#else
+        return std::sqrt( a );
+#endif
+    }
+
+    /**
+     * Approximates 1/sqrt(a) with a relative error of at most 1.5 * 2^-12
+     * (hardware) or 3.5e-3 (integer fallback).
+     */
+    inline float rsqrtEstimate( float a )
+    {
+#ifdef MATH_SSE2
+        return _mm_cvtss_f32( _mm_rsqrt_ss( _mm_set_ss( a ) ) );
+#else
+        int32_t i = 0x5f375a86 - ( asInt( a ) >> 1 );
+        return asFloat( i );
+#endif
+    }
+
+    // Wraps like the vector lanes instead of overflowing
+    inline int32_t iadd( int32_t a, int32_t b )
+    {
+        return static_cast<int32_t>( static_cast<uint32_t>( a ) + static_cast<uint32_t>( b ) );
+    }
+
+    inline int32_t isub( int32_t a, int32_t b )
+    {
+        return static_cast<int32_t>( static_cast<uint32_t>( a ) - static_cast<uint32_t>( b ) );
+    }
+
+    inline int32_t imul( int32_t a, int32_t b )
+    {
+        return static_cast<int32_t>( static_cast<uint32_t>( a ) * static_cast<uint32_t>( b ) );
+    }
+
+    inline int32_t iand( int32_t a, int32_t b ) { return a & b; }
+    inline int32_t ior( int32_t a, int32_t b ) { return a | b; }
+    inline int32_t ixor( int32_t a, int32_t b ) { return a ^ b; }
+    inline bool iequal( int32_t a, int32_t b ) { return a == b; }
+
+    template<int N> inline int32_t shiftLeft( int32_t a )
+    {
+        return static_cast<int32_t>( static_cast<uint32_t>( a ) << N );
+    }
+
+    template<int N> inline int32_t shiftRight( int32_t a )
+    {
+        return static_cast<int32_t>( static_cast<uint32_t>( a ) >> N );
+    }
+
+    template<> inline float load<float>( const float * p ) { return *p; }
+    inline void store( float * p, float v ) { *p = v; }
+
+    template<> inline int32_t loadUInt16<int32_t>( const uint16_t * p ) { return *p; }
+    template<> inline int32_t loadUInt32<int32_t>( const uint32_t * p ) { return static_cast<int32_t>( *p ); }
+
+    /**
+     * Stores the low 16 bits of each integer lane.
+     */
+    inline void storeUInt16( uint16_t * p, int32_t v ) { *p = static_cast<uint16_t>( v ); }
+
+    /**
+     * Loads xyz triples from interleaved memory, one triple per lane.
+     */
+    inline void load3( const float * p, float& x, float& y, float& z )
+    {
+        x = p[0];
+        y = p[1];
+        z = p[2];
+    }
+
+    /**
+     * Stores one xyz triple per lane to interleaved memory.
+     */
+    inline void store3( float * p, float x, float y, float z )
+    {
+        p[0] = x;
+        p[1] = y;
+        p[2] = z;
+    }
+
+    /**
+     * Integer versions of store, load3 and store3, for integer vectors.
+     */
+    inline void store( int32_t * p, int32_t v ) { *p = v; }
+
+    inline void load3( const int32_t * p, int32_t& x, int32_t& y, int32_t& z )
+    {
+        x = p[0];
+        y = p[1];
+        z = p[2];
+    }
+
+    inline void store3( int32_t * p, int32_t x, int32_t y, int32_t z )
+    {
+        p[0] = x;
+        p[1] = y;
+        p[2] = z;
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    // 4-wide SSE lanes
+    /////////////////////////////////////////////////////////////////////////
+#ifdef MATH_SSE2
+    template<> struct IntLanes<__m128> { typedef __m128i type; };
+    template<> struct LaneCount<__m128> { enum { value = 4 }; };
+    template<> struct LaneCount<__m128i> { enum { value = 4 }; };
+
+    template<> inline __m128 splat<__m128>( float v ) { return _mm_set1_ps( v ); }
+    template<> inline __m128i splatInt<__m128i>( int32_t v ) { return _mm_set1_epi32( v ); }
+
+    inline __m128 add( __m128 a, __m128 b ) { return _mm_add_ps( a, b ); }
+    inline __m128 sub( __m128 a, __m128 b ) { return _mm_sub_ps( a, b ); }
+    inline __m128 mul( __m128 a, __m128 b ) { return _mm_mul_ps( a, b ); }
+    inline __m128 div( __m128 a, __m128 b ) { return _mm_div_ps( a, b ); }
+    inline __m128 minimum( __m128 a, __m128 b ) { return _mm_min_ps( a, b ); }
+    inline __m128 maximum( __m128 a, __m128 b ) { return _mm_max_ps( a, b ); }
+    inline __m128 sqrt( __m128 a ) { return _mm_sqrt_ps( a ); }
+    inline __m128 rsqrtEstimate( __m128 a ) { return _mm_rsqrt_ps( a ); }
+
+    inline __m128 madd( __m128 a, __m128 b, __m128 c )
+    {
+#ifdef MATH_FMA
+        return _mm_fmadd_ps( a, b, c );
+#else
+        return _mm_add_ps( _mm_mul_ps( a, b ), c );
+#endif
+    }
+
+    inline __m128 abs( __m128 a )
+    {
+        return _mm_andnot_ps( _mm_set1_ps( -0.0f ), a );
+    }
+
+    inline __m128 lessThan( __m128 a, __m128 b ) { return _mm_cmplt_ps( a, b ); }
+    inline __m128 greaterThan( __m128 a, __m128 b ) { return _mm_cmpgt_ps( a, b ); }
+    inline __m128 equal( __m128 a, __m128 b ) { return _mm_cmpeq_ps( a, b ); }
+
+    inline __m128 select( __m128 m, __m128 a, __m128 b )
+    {
+#ifdef MATH_SSE41
+        return _mm_blendv_ps( b, a, m );
+#else
+        return _mm_or_ps( _mm_and_ps( m, a ), _mm_andnot_ps( m, b ) );
+#endif
+    }
+
+    inline __m128i asInt( __m128 a ) { return _mm_castps_si128( a ); }
+    inline __m128 asFloat( __m128i a ) { return _mm_castsi128_ps( a ); }
+    inline __m128i roundToInt( __m128 a ) { return _mm_cvtps_epi32( a ); }
+    inline __m128 toFloat( __m128i a ) { return _mm_cvtepi32_ps( a ); }
+
+    inline __m128i iadd( __m128i a, __m128i b ) { return _mm_add_epi32( a, b ); }
+    inline __m128i isub( __m128i a, __m128i b ) { return _mm_sub_epi32( a, b ); }
+
+    inline __m128i imul( __m128i a, __m128i b )
+    {
+#ifdef MATH_SSE41
+        return _mm_mullo_epi32( a, b );
+#else
+        // SSE2 only multiplies the even lanes, do the odd ones shifted down
+        __m128i even = _mm_mul_epu32( a, b );
+        __m128i odd  = _mm_mul_epu32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) );
+
+        return _mm_unpacklo_epi32( _mm_shuffle_epi32( even, _MM_SHUFFLE( 0, 0, 2, 0 ) ),
+                                   _mm_shuffle_epi32( odd, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+#endif
+    }
+
+    inline __m128i iand( __m128i a, __m128i b ) { return _mm_and_si128( a, b ); }
+    inline __m128i ior( __m128i a, __m128i b ) { return _mm_or_si128( a, b ); }
+    inline __m128i ixor( __m128i a, __m128i b ) { return _mm_xor_si128( a, b ); }
+
+    inline __m128 iequal( __m128i a, __m128i b )
+    {
+        return _mm_castsi128_ps( _mm_cmpeq_epi32( a, b ) );
+    }
+
+    template<int N> inline __m128i shiftLeft( __m128i a )
+    {
+        return _mm_slli_epi32( a, N );
+    }
+
+    template<int N> inline __m128i shiftRight( __m128i a )
+    {
+        return _mm_srli_epi32( a, N );
+    }
+
+    template<> inline __m128 load<__m128>( const float * p ) { return _mm_loadu_ps( p ); }
+    template<> inline __m128 loadGroup4<__m128>( const float * p ) { return _mm_loadu_ps( p ); }
+    inline void store( float * p, __m128 v ) { _mm_storeu_ps( p, v ); }
+
+    template<> inline __m128i loadUInt16<__m128i>( const uint16_t * p )
+    {
+        return _mm_unpacklo_epi16( _mm_loadl_epi64( reinterpret_cast<const __m128i *>( p ) ),
+                                   _mm_setzero_si128() );
+    }
+
+    template<> inline __m128i loadUInt32<__m128i>( const uint32_t * p )
+    {
+        return _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) );
+    }
+
+    inline void storeUInt16( uint16_t * p, __m128i v )
+    {
+        // Sign extend the low halves so the saturating pack keeps them as is
+        v = _mm_srai_epi32( _mm_slli_epi32( v, 16 ), 16 );
+        _mm_storel_epi64( reinterpret_cast<__m128i *>( p ), _mm_packs_epi32( v, v ) );
+    }
+
+    /**
+     * Broadcasts lane K of every group of four lanes to the whole group.
+     */
+    template<int K> inline __m128 permute4( __m128 a )
+    {
+        return _mm_shuffle_ps( a, a, _MM_SHUFFLE( K, K, K, K ) );
+    }
+
+    /**
+     * Loads four xyz triples (twelve floats) and transposes them to x, y and
+     * z lanes.
+     */
+    inline void load3( const float * p, __m128& x, __m128& y, __m128& z )
+    {
+        __m128 a = _mm_loadu_ps( p );           // x0 y0 z0 x1
+        __m128 b = _mm_loadu_ps( p + 4 );       // y1 z1 x2 y2
+        __m128 c = _mm_loadu_ps( p + 8 );       // z2 x3 y3 z3
+
+        __m128 t0 = _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 1, 3, 2 ) );  // x2 y2 x3 y3
+        __m128 t1 = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 0, 2, 1 ) );  // y0 z0 y1 z1
+
+        x = _mm_shuffle_ps( a,  t0, _MM_SHUFFLE( 2, 0, 3, 0 ) );
+        y = _mm_shuffle_ps( t1, t0, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+        z = _mm_shuffle_ps( t1, c,  _MM_SHUFFLE( 3, 0, 3, 1 ) );
+    }
+
+    /**
+     * Transposes x, y and z lanes back to four xyz triples and stores them.
+     */
+    inline void store3( float * p, __m128 x, __m128 y, __m128 z )
+    {
+        __m128 xy = _mm_unpacklo_ps( x, y );                            // x0 y0 x1 y1
+        __m128 zx = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) );  // z0 z0 x1 x1
+        __m128 yz = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 1, 1, 1, 1 ) );  // y1 y1 z1 z1
+        __m128 xy2 = _mm_shuffle_ps( x, y, _MM_SHUFFLE( 2, 2, 2, 2 ) ); // x2 x2 y2 y2
+        __m128 zx3 = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 3, 2, 2 ) ); // z2 z2 x3 x3
+        __m128 yz3 = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 3, 3, 3 ) ); // y3 y3 z3 z3
+
+        _mm_storeu_ps( p,     _mm_shuffle_ps( xy, zx, _MM_SHUFFLE( 2, 0, 1, 0 ) ) );
+        _mm_storeu_ps( p + 4, _mm_shuffle_ps( yz, xy2, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+        _mm_storeu_ps( p + 8, _mm_shuffle_ps( zx3, yz3, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+    }
+
+    /**
+     * Integer versions of store, load3 and store3. The triples go through
+     * the float shuffles, which move the bits unchanged.
+     */
+    inline void store( int32_t * p, __m128i v )
+    {
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( p ), v );
+    }
+
+    inline void load3( const int32_t * p, __m128i& x, __m128i& y, __m128i& z )
+    {
+        __m128 fx, fy, fz;
+        load3( reinterpret_cast<const float *>( p ), fx, fy, fz );
+
+        x = asInt( fx );
+        y = asInt( fy );
+        z = asInt( fz );
+    }
+
+    inline void store3( int32_t * p, __m128i x, __m128i y, __m128i z )
+    {
+        store3( reinterpret_cast<float *>( p ), asFloat( x ), asFloat( y ), asFloat( z ) );
+    }
+#endif
+
+    /////////////////////////////////////////////////////////////////////////
+    // 8-wide AVX2 lanes
+    /////////////////////////////////////////////////////////////////////////
+#ifdef MATH_AVX2
+    template<> struct IntLanes<__m256> { typedef __m256i type; };
+    template<> struct LaneCount<__m256> { enum { value = 8 }; };
+    template<> struct LaneCount<__m256i> { enum { value = 8 }; };
+
+    template<> inline __m256 splat<__m256>( float v ) { return _mm256_set1_ps( v ); }
+    template<> inline __m256i splatInt<__m256i>( int32_t v ) { return _mm256_set1_epi32( v ); }
+
+    inline __m256 add( __m256 a, __m256 b ) { return _mm256_add_ps( a, b ); }
+    inline __m256 sub( __m256 a, __m256 b ) { return _mm256_sub_ps( a, b ); }
+    inline __m256 mul( __m256 a, __m256 b ) { return _mm256_mul_ps( a, b ); }
+    inline __m256 div( __m256 a, __m256 b ) { return _mm256_div_ps( a, b ); }
+    inline __m256 minimum( __m256 a, __m256 b ) { return _mm256_min_ps( a, b ); }
+    inline __m256 maximum( __m256 a, __m256 b ) { return _mm256_max_ps( a, b ); }
+    inline __m256 sqrt( __m256 a ) { return _mm256_sqrt_ps( a ); }
+    inline __m256 rsqrtEstimate( __m256 a ) { return _mm256_rsqrt_ps( a ); }
+
+    inline __m256 madd( __m256 a, __m256 b, __m256 c )
+    {
+#ifdef MATH_FMA
+        return _mm256_fmadd_ps( a, b, c );
+#else
+        return _mm256_add_ps( _mm256_mul_ps( a, b ), c );
+#endif
+    }
+
+    inline __m256 abs( __m256 a )
+    {
+        return _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), a );
+    }
+
+    inline __m256 lessThan( __m256 a, __m256 b ) { return _mm256_cmp_ps( a, b, _CMP_LT_OQ ); }
+    inline __m256 greaterThan( __m256 a, __m256 b ) { return _mm256_cmp_ps( a, b, _CMP_GT_OQ ); }
+    inline __m256 equal( __m256 a, __m256 b ) { return _mm256_cmp_ps( a, b, _CMP_EQ_OQ ); }
+
+    inline __m256 select( __m256 m, __m256 a, __m256 b )
+    {
+        return _mm256_blendv_ps( b, a, m );
+    }
+
+    inline __m256i asInt( __m256 a ) { return _mm256_castps_si256( a ); }
+    inline __m256 asFloat( __m256i a ) { return _mm256_castsi256_ps( a ); }
+    inline __m256i roundToInt( __m256 a ) { return _mm256_cvtps_epi32( a ); }
+    inline __m256 toFloat( __m256i a ) { return _mm256_cvtepi32_ps( a ); }
+
+    inline __m256i iadd( __m256i a, __m256i b ) { return _mm256_add_epi32( a, b ); }
+    inline __m256i isub( __m256i a, __m256i b ) { return _mm256_sub_epi32( a, b ); }
+    inline __m256i imul( __m256i a, __m256i b ) { return _mm256_mullo_epi32( a, b ); }
+    inline __m256i iand( __m256i a, __m256i b ) { return _mm256_and_si256( a, b ); }
+    inline __m256i ior( __m256i a, __m256i b ) { return _mm256_or_si256( a, b ); }
+    inline __m256i ixor( __m256i a, __m256i b ) { return _mm256_xor_si256( a, b ); }
+
+    inline __m256 iequal( __m256i a, __m256i b )
+    {
+        return _mm256_castsi256_ps( _mm256_cmpeq_epi32( a, b ) );
+    }
+
+    template<int N> inline __m256i shiftLeft( __m256i a )
+    {
+        return _mm256_slli_epi32( a, N );
+    }
+
+    template<int N> inline __m256i shiftRight( __m256i a )
+    {
+        return _mm256_srli_epi32( a, N );
+    }
+
+    template<> inline __m256 load<__m256>( const float * p ) { return _mm256_loadu_ps( p ); }
+    inline void store( float * p, __m256 v ) { _mm256_storeu_ps( p, v ); }
+
+    template<> inline __m256i loadUInt16<__m256i>( const uint16_t * p )
+    {
+        return _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) ) );
+    }
+
+    template<> inline __m256i loadUInt32<__m256i>( const uint32_t * p )
+    {
+        return _mm256_loadu_si256( reinterpret_cast<const __m256i *>( p ) );
+    }
+
+    inline void storeUInt16( uint16_t * p, __m256i v )
+    {
+        // The pack works within 128 bit halves, gather both results low
+        v = _mm256_srai_epi32( _mm256_slli_epi32( v, 16 ), 16 );
+        v = _mm256_permute4x64_epi64( _mm256_packs_epi32( v, v ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i *>( p ), _mm256_castsi256_si128( v ) );
+    }
+
+    template<> inline __m256 loadGroup4<__m256>( const float * p )
+    {
+        return _mm256_broadcast_ps( reinterpret_cast<const __m128 *>( p ) );
+    }
+
+    template<int K> inline __m256 permute4( __m256 a )
+    {
+        return _mm256_permute_ps( a, K * 0x55 );
+    }
+
+    inline void load3( const float * p, __m256& x, __m256& y, __m256& z )
+    {
+        __m128 x0, y0, z0, x1, y1, z1;
+        load3( p,      x0, y0, z0 );
+        load3( p + 12, x1, y1, z1 );
+
+        x = _mm256_insertf128_ps( _mm256_castps128_ps256( x0 ), x1, 1 );
+        y = _mm256_insertf128_ps( _mm256_castps128_ps256( y0 ), y1, 1 );
+        z = _mm256_insertf128_ps( _mm256_castps128_ps256( z0 ), z1, 1 );
+    }
+
+    inline void store3( float * p, __m256 x, __m256 y, __m256 z )
+    {
+        store3( p,      _mm256_castps256_ps128( x ),
+                        _mm256_castps256_ps128( y ),
+                        _mm256_castps256_ps128( z ) );
+        store3( p + 12, _mm256_extractf128_ps( x, 1 ),
+                        _mm256_extractf128_ps( y, 1 ),
+                        _mm256_extractf128_ps( z, 1 ) );
+    }
+
+    inline void store( int32_t * p, __m256i v )
+    {
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( p ), v );
+    }
+
+    inline void load3( const int32_t * p, __m256i& x, __m256i& y, __m256i& z )
+    {
+        __m256 fx, fy, fz;
+        load3( reinterpret_cast<const float *>( p ), fx, fy, fz );
+
+        x = asInt( fx );
+        y = asInt( fy );
+        z = asInt( fz );
+    }
+
+    inline void store3( int32_t * p, __m256i x, __m256i y, __m256i z )
+    {
+        store3( reinterpret_cast<float *>( p ), asFloat( x ), asFloat( y ), asFloat( z ) );
+    }
+#endif
+
+    /////////////////////////////////////////////////////////////////////////
+    // 16-wide AVX-512 lanes. Comparisons return __mmask16 bit masks rather
+    // than lane masks, kernels should hold them in auto variables.
+    /////////////////////////////////////////////////////////////////////////
+#ifdef MATH_AVX512
+    template<> struct IntLanes<__m512> { typedef __m512i type; };
+    template<> struct LaneCount<__m512> { enum { value = 16 }; };
+    template<> struct LaneCount<__m512i> { enum { value = 16 }; };
+
+    template<> inline __m512 splat<__m512>( float v ) { return _mm512_set1_ps( v ); }
+    template<> inline __m512i splatInt<__m512i>( int32_t v ) { return _mm512_set1_epi32( v ); }
+
+    inline __m512 add( __m512 a, __m512 b ) { return _mm512_add_ps( a, b ); }
+    inline __m512 sub( __m512 a, __m512 b ) { return _mm512_sub_ps( a, b ); }
+    inline __m512 mul( __m512 a, __m512 b ) { return _mm512_mul_ps( a, b ); }
+    inline __m512 div( __m512 a, __m512 b ) { return _mm512_div_ps( a, b ); }
+    inline __m512 madd( __m512 a, __m512 b, __m512 c ) { return _mm512_fmadd_ps( a, b, c ); }
+    inline __m512 minimum( __m512 a, __m512 b ) { return _mm512_min_ps( a, b ); }
+    inline __m512 maximum( __m512 a, __m512 b ) { return _mm512_max_ps( a, b ); }
+    inline __m512 sqrt( __m512 a ) { return _mm512_sqrt_ps( a ); }
+    inline __m512 rsqrtEstimate( __m512 a ) { return _mm512_rsqrt14_ps( a ); }
+
+    inline __m512 abs( __m512 a )
+    {
+        return _mm512_castsi512_ps( _mm512_and_epi32( _mm512_castps_si512( a ),
+                                                      _mm512_set1_epi32( 0x7fffffff ) ) );
+    }
+
+    inline __mmask16 lessThan( __m512 a, __m512 b ) { return _mm512_cmp_ps_mask( a, b, _CMP_LT_OQ ); }
+    inline __mmask16 greaterThan( __m512 a, __m512 b ) { return _mm512_cmp_ps_mask( a, b, _CMP_GT_OQ ); }
+    inline __mmask16 equal( __m512 a, __m512 b ) { return _mm512_cmp_ps_mask( a, b, _CMP_EQ_OQ ); }
+
+    inline __m512 select( __mmask16 m, __m512 a, __m512 b )
+    {
+        return _mm512_mask_blend_ps( m, b, a );
+    }
+
+    inline __m512i asInt( __m512 a ) { return _mm512_castps_si512( a ); }
+    inline __m512 asFloat( __m512i a ) { return _mm512_castsi512_ps( a ); }
+    inline __m512i roundToInt( __m512 a ) { return _mm512_cvtps_epi32( a ); }
+    inline __m512 toFloat( __m512i a ) { return _mm512_cvtepi32_ps( a ); }
+
+    inline __m512i iadd( __m512i a, __m512i b ) { return _mm512_add_epi32( a, b ); }
+    inline __m512i isub( __m512i a, __m512i b ) { return _mm512_sub_epi32( a, b ); }
+    inline __m512i imul( __m512i a, __m512i b ) { return _mm512_mullo_epi32( a, b ); }
+    inline __m512i iand( __m512i a, __m512i b ) { return _mm512_and_si512( a, b ); }
+    inline __m512i ior( __m512i a, __m512i b ) { return _mm512_or_si512( a, b ); }
+    inline __m512i ixor( __m512i a, __m512i b ) { return _mm512_xor_si512( a, b ); }
+    inline __mmask16 iequal( __m512i a, __m512i b ) { return _mm512_cmpeq_epi32_mask( a, b ); }
+
+    template<int N> inline __m512i shiftLeft( __m512i a )
+    {
+        return _mm512_slli_epi32( a, N );
+    }
+
+    template<int N> inline __m512i shiftRight( __m512i a )
+    {
+        return _mm512_srli_epi32( a, N );
+    }
+
+    template<> inline __m512 load<__m512>( const float * p ) { return _mm512_loadu_ps( p ); }
+    inline void store( float * p, __m512 v ) { _mm512_storeu_ps( p, v ); }
+
+    template<> inline __m512i loadUInt16<__m512i>( const uint16_t * p )
+    {
+        return _mm512_cvtepu16_epi32( _mm256_loadu_si256( reinterpret_cast<const __m256i *>( p ) ) );
+    }
+
+    template<> inline __m512i loadUInt32<__m512i>( const uint32_t * p )
+    {
+        return _mm512_loadu_si512( p );
+    }
+
+    inline void storeUInt16( uint16_t * p, __m512i v )
+    {
+        _mm256_storeu_si256( reinterpret_cast<__m256i *>( p ), _mm512_cvtepi32_epi16( v ) );
+    }
+
+    template<> inline __m512 loadGroup4<__m512>( const float * p )
+    {
+        return _mm512_broadcast_f32x4( _mm_loadu_ps( p ) );
+    }
+
+    template<int K> inline __m512 permute4( __m512 a )
+    {
+        return _mm512_permute_ps( a, K * 0x55 );
+    }
+
+    /**
+     * Deinterleaves 16 xyz triples with two cross-register permutes per
+     * component: the first gathers what the first two registers hold, the
+     * second fills the remaining lanes from the third.
+     */
+    inline void load3( const float * p, __m512& x, __m512& y, __m512& z )
+    {
+        const __m512i X0 = _mm512_setr_epi32( 0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 0, 0, 0, 0, 0 );
+        const __m512i X1 = _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 17, 20, 23, 26, 29 );
+        const __m512i Y0 = _mm512_setr_epi32( 1, 4, 7, 10, 13, 16, 19, 22, 25, 28, 31, 0, 0, 0, 0, 0 );
+        const __m512i Y1 = _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 18, 21, 24, 27, 30 );
+        const __m512i Z0 = _mm512_setr_epi32( 2, 5, 8, 11, 14, 17, 20, 23, 26, 29, 0, 0, 0, 0, 0, 0 );
+        const __m512i Z1 = _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 16, 19, 22, 25, 28, 31 );
+
+        __m512 a = _mm512_loadu_ps( p );
+        __m512 b = _mm512_loadu_ps( p + 16 );
+        __m512 c = _mm512_loadu_ps( p + 32 );
+
+        x = _mm512_permutex2var_ps( _mm512_permutex2var_ps( a, X0, b ), X1, c );
+        y = _mm512_permutex2var_ps( _mm512_permutex2var_ps( a, Y0, b ), Y1, c );
+        z = _mm512_permutex2var_ps( _mm512_permutex2var_ps( a, Z0, b ), Z1, c );
+    }
+
+    /**
+     * Interleaves 16 xyz triples, the inverse of load3: x and y are merged
+     * first and then z is slotted into every third lane.
+     */
+    inline void store3( float * p, __m512 x, __m512 y, __m512 z )
+    {
+        const __m512i A0 = _mm512_setr_epi32( 0, 16, 0, 1, 17, 0, 2, 18, 0, 3, 19, 0, 4, 20, 0, 5 );
+        const __m512i A1 = _mm512_setr_epi32( 0, 1, 16, 3, 4, 17, 6, 7, 18, 9, 10, 19, 12, 13, 20, 15 );
+        const __m512i B0 = _mm512_setr_epi32( 21, 0, 6, 22, 0, 7, 23, 0, 8, 24, 0, 9, 25, 0, 10, 26 );
+        const __m512i B1 = _mm512_setr_epi32( 0, 21, 2, 3, 22, 5, 6, 23, 8, 9, 24, 11, 12, 25, 14, 15 );
+        const __m512i C0 = _mm512_setr_epi32( 0, 11, 27, 0, 12, 28, 0, 13, 29, 0, 14, 30, 0, 15, 31, 0 );
+        const __m512i C1 = _mm512_setr_epi32( 26, 1, 2, 27, 4, 5, 28, 7, 8, 29, 10, 11, 30, 13, 14, 31 );
+
+        _mm512_storeu_ps( p,      _mm512_permutex2var_ps( _mm512_permutex2var_ps( x, A0, y ), A1, z ) );
+        _mm512_storeu_ps( p + 16, _mm512_permutex2var_ps( _mm512_permutex2var_ps( x, B0, y ), B1, z ) );
+        _mm512_storeu_ps( p + 32, _mm512_permutex2var_ps( _mm512_permutex2var_ps( x, C0, y ), C1, z ) );
+    }
+
+    inline void store( int32_t * p, __m512i v ) { _mm512_storeu_si512( p, v ); }
+
+    inline void load3( const int32_t * p, __m512i& x, __m512i& y, __m512i& z )
+    {
+        __m512 fx, fy, fz;
+        load3( reinterpret_cast<const float *>( p ), fx, fy, fz );
+
+        x = asInt( fx );
+        y = asInt( fy );
+        z = asInt( fz );
+    }
+
+    inline void store3( int32_t * p, __m512i x, __m512i y, __m512i z )
+    {
+        store3( reinterpret_cast<float *>( p ), asFloat( x ), asFloat( y ), asFloat( z ) );
+    }
+#endif
+
+    /////////////////////////////////////////////////////////////////////////
+    // Double lanes. Only the arithmetic that the double precision vector
+    // kernels need, with the same names as the float lanes.
+    /////////////////////////////////////////////////////////////////////////
+    template<> struct DoubleLanes<float> { typedef double type; };
+    template<> struct LaneCount<double> { enum { value = 1 }; };
+
+    template<> inline double splatDouble<double>( double v ) { return v; }
+
+    inline double add( double a, double b ) { return a + b; }
+    inline double sub( double a, double b ) { return a - b; }
+    inline double mul( double a, double b ) { return a * b; }
+    inline double div( double a, double b ) { return a / b; }
+    inline double madd( double a, double b, double c ) { return a * b + c; }
+
+    inline double sqrt( double a )
+    {
+#ifdef MATH_SSE2
+        return _mm_cvtsd_f64( _mm_sqrt_sd( _mm_setzero_pd(), _mm_set_sd( a ) ) );
+#else
+        return std::sqrt( a );
+#endif
+    }
+
+    template<> inline double load<double>( const double * p ) { return *p; }
+    inline void store( double * p, double v ) { *p = v; }
+
+    inline void load3( const double * p, double& x, double& y, double& z )
+    {
+        x = p[0];
+        y = p[1];
+        z = p[2];
+    }
+
+    inline void store3( double * p, double x, double y, double z )
+    {
+        p[0] = x;
+        p[1] = y;
+        p[2] = z;
+    }
+
+    /**
+     * Rounds double lanes to the nearest float, keeping them in double
+     * lanes.
+     */
+    inline double roundToFloat( double a ) { return static_cast<float>( a ); }
+
+    /**
+     * Rounds double lanes to float and stores them, for kernels that compute
+     * in double and write float results.
+     */
+    inline void storeFloat( float * p, double v ) { *p = static_cast<float>( v ); }
+
+#ifdef MATH_SSE2
+    template<> struct DoubleLanes<__m128> { typedef __m128d type; };
+    template<> struct LaneCount<__m128d> { enum { value = 2 }; };
+
+    template<> inline __m128d splatDouble<__m128d>( double v ) { return _mm_set1_pd( v ); }
+
+    inline __m128d add( __m128d a, __m128d b ) { return _mm_add_pd( a, b ); }
+    inline __m128d sub( __m128d a, __m128d b ) { return _mm_sub_pd( a, b ); }
+    inline __m128d mul( __m128d a, __m128d b ) { return _mm_mul_pd( a, b ); }
+    inline __m128d div( __m128d a, __m128d b ) { return _mm_div_pd( a, b ); }
+    inline __m128d sqrt( __m128d a ) { return _mm_sqrt_pd( a ); }
+
+    inline __m128d madd( __m128d a, __m128d b, __m128d c )
+    {
+#ifdef MATH_FMA
+        return _mm_fmadd_pd( a, b, c );
+#else
+        return _mm_add_pd( _mm_mul_pd( a, b ), c );
+#endif
+    }
+
+    template<> inline __m128d load<__m128d>( const double * p ) { return _mm_loadu_pd( p ); }
+    inline void store( double * p, __m128d v ) { _mm_storeu_pd( p, v ); }
+
+    /**
+     * Loads two xyz triples (six doubles) and transposes them to x, y and z
+     * lanes.
+     */
+    inline void load3( const double * p, __m128d& x, __m128d& y, __m128d& z )
+    {
+        __m128d a = _mm_loadu_pd( p );          // x0 y0
+        __m128d b = _mm_loadu_pd( p + 2 );      // z0 x1
+        __m128d c = _mm_loadu_pd( p + 4 );      // y1 z1
+
+        x = _mm_shuffle_pd( a, b, 2 );
+        y = _mm_shuffle_pd( a, c, 1 );
+        z = _mm_shuffle_pd( b, c, 2 );
+    }
+
+    inline void store3( double * p, __m128d x, __m128d y, __m128d z )
+    {
+        _mm_storeu_pd( p,     _mm_shuffle_pd( x, y, 0 ) );
+        _mm_storeu_pd( p + 2, _mm_shuffle_pd( z, x, 2 ) );
+        _mm_storeu_pd( p + 4, _mm_shuffle_pd( y, z, 3 ) );
+    }
+
+    inline __m128d roundToFloat( __m128d a ) { return _mm_cvtps_pd( _mm_cvtpd_ps( a ) ); }
+
+    inline void storeFloat( float * p, __m128d v )
+    {
+        _mm_storel_pi( reinterpret_cast<__m64 *>( p ), _mm_cvtpd_ps( v ) );
+    }
+#endif
+
+#ifdef MATH_AVX2
+    template<> struct DoubleLanes<__m256> { typedef __m256d type; };
+    template<> struct LaneCount<__m256d> { enum { value = 4 }; };
+
+    template<> inline __m256d splatDouble<__m256d>( double v ) { return _mm256_set1_pd( v ); }
+
+    inline __m256d add( __m256d a, __m256d b ) { return _mm256_add_pd( a, b ); }
+    inline __m256d sub( __m256d a, __m256d b ) { return _mm256_sub_pd( a, b ); }
+    inline __m256d mul( __m256d a, __m256d b ) { return _mm256_mul_pd( a, b ); }
+    inline __m256d div( __m256d a, __m256d b ) { return _mm256_div_pd( a, b ); }
+    inline __m256d sqrt( __m256d a ) { return _mm256_sqrt_pd( a ); }
+
+    inline __m256d madd( __m256d a, __m256d b, __m256d c )
+    {
+#ifdef MATH_FMA
+        return _mm256_fmadd_pd( a, b, c );
+#else
+        return _mm256_add_pd( _mm256_mul_pd( a, b ), c );
+#endif
+    }
+
+    template<> inline __m256d load<__m256d>( const double * p ) { return _mm256_loadu_pd( p ); }
+    inline void store( double * p, __m256d v ) { _mm256_storeu_pd( p, v ); }
+
+    /**
+     * Loads four xyz triples (twelve doubles) and transposes them with
+     * blends, after swapping the middle halves of the first and last load.
+     */
+    inline void load3( const double * p, __m256d& x, __m256d& y, __m256d& z )
+    {
+        __m256d a = _mm256_loadu_pd( p );       // x0 y0 z0 x1
+        __m256d b = _mm256_loadu_pd( p + 4 );   // y1 z1 x2 y2
+        __m256d c = _mm256_loadu_pd( p + 8 );   // z2 x3 y3 z3
+
+        __m256d t0 = _mm256_blend_pd( a, c, 0xc );              // x0 y0 y3 z3
+        __m256d t1 = _mm256_permute2f128_pd( a, c, 0x21 );      // z0 x1 z2 x3
+
+        x = _mm256_blend_pd( _mm256_blend_pd( t1, t0, 0x1 ), b, 0x4 );
+        y = _mm256_permute_pd( _mm256_blend_pd( t0, b, 0x9 ), 0x5 );
+        z = _mm256_blend_pd( _mm256_blend_pd( t1, t0, 0x8 ), b, 0x2 );
+    }
+
+    inline void store3( double * p, __m256d x, __m256d y, __m256d z )
+    {
+        __m256d ys = _mm256_permute_pd( y, 0x5 );                                   // y1 y0 y3 y2
+        __m256d t0 = _mm256_blend_pd( _mm256_blend_pd( x, ys, 0x6 ), z, 0x8 );      // x0 y0 y3 z3
+        __m256d t1 = _mm256_blend_pd( z, x, 0xa );                                  // z0 x1 z2 x3
+        __m256d t2 = _mm256_blend_pd( _mm256_blend_pd( ys, z, 0x2 ), x, 0x4 );      // y1 z1 x2 y2
+
+        _mm256_storeu_pd( p,     _mm256_permute2f128_pd( t0, t1, 0x20 ) );
+        _mm256_storeu_pd( p + 4, t2 );
+        _mm256_storeu_pd( p + 8, _mm256_permute2f128_pd( t1, t0, 0x31 ) );
+    }
+
+    inline __m256d roundToFloat( __m256d a ) { return _mm256_cvtps_pd( _mm256_cvtpd_ps( a ) ); }
+
+    inline void storeFloat( float * p, __m256d v ) { _mm_storeu_ps( p, _mm256_cvtpd_ps( v ) ); }
+#endif
+
+#ifdef MATH_AVX512
+    template<> struct DoubleLanes<__m512> { typedef __m512d type; };
+    template<> struct LaneCount<__m512d> { enum { value = 8 }; };
+
+    template<> inline __m512d splatDouble<__m512d>( double v ) { return _mm512_set1_pd( v ); }
+
+    inline __m512d add( __m512d a, __m512d b ) { return _mm512_add_pd( a, b ); }
+    inline __m512d sub( __m512d a, __m512d b ) { return _mm512_sub_pd( a, b ); }
+    inline __m512d mul( __m512d a, __m512d b ) { return _mm512_mul_pd( a, b ); }
+    inline __m512d div( __m512d a, __m512d b ) { return _mm512_div_pd( a, b ); }
+    inline __m512d madd( __m512d a, __m512d b, __m512d c ) { return _mm512_fmadd_pd( a, b, c ); }
+    inline __m512d sqrt( __m512d a ) { return _mm512_sqrt_pd( a ); }
+
+    template<> inline __m512d load<__m512d>( const double * p ) { return _mm512_loadu_pd( p ); }
+    inline void store( double * p, __m512d v ) { _mm512_storeu_pd( p, v ); }
+
+    /**
+     * Loads eight xyz triples like the float version: two permutes per
+     * component, the first from the low sixteen doubles and the second
+     * filling in the rest from the last load.
+     */
+    inline void load3( const double * p, __m512d& x, __m512d& y, __m512d& z )
+    {
+        const __m512i X0 = _mm512_setr_epi64( 0, 3, 6, 9, 12, 15, 0, 0 );
+        const __m512i X1 = _mm512_setr_epi64( 0, 1, 2, 3, 4, 5, 10, 13 );
+        const __m512i Y0 = _mm512_setr_epi64( 1, 4, 7, 10, 13, 0, 0, 0 );
+        const __m512i Y1 = _mm512_setr_epi64( 0, 1, 2, 3, 4, 8, 11, 14 );
+        const __m512i Z0 = _mm512_setr_epi64( 2, 5, 8, 11, 14, 0, 0, 0 );
+        const __m512i Z1 = _mm512_setr_epi64( 0, 1, 2, 3, 4, 9, 12, 15 );
+
+        __m512d a = _mm512_loadu_pd( p );
+        __m512d b = _mm512_loadu_pd( p + 8 );
+        __m512d c = _mm512_loadu_pd( p + 16 );
+
+        x = _mm512_permutex2var_pd( _mm512_permutex2var_pd( a, X0, b ), X1, c );
+        y = _mm512_permutex2var_pd( _mm512_permutex2var_pd( a, Y0, b ), Y1, c );
+        z = _mm512_permutex2var_pd( _mm512_permutex2var_pd( a, Z0, b ), Z1, c );
+    }
+
+    inline void store3( double * p, __m512d x, __m512d y, __m512d z )
+    {
+        const __m512i A0 = _mm512_setr_epi64( 0, 8, 0, 1, 9, 0, 2, 10 );
+        const __m512i A1 = _mm512_setr_epi64( 0, 1, 8, 3, 4, 9, 6, 7 );
+        const __m512i B0 = _mm512_setr_epi64( 0, 3, 11, 0, 4, 12, 0, 5 );
+        const __m512i B1 = _mm512_setr_epi64( 10, 1, 2, 11, 4, 5, 12, 7 );
+        const __m512i C0 = _mm512_setr_epi64( 13, 0, 6, 14, 0, 7, 15, 0 );
+        const __m512i C1 = _mm512_setr_epi64( 0, 13, 2, 3, 14, 5, 6, 15 );
+
+        _mm512_storeu_pd( p,      _mm512_permutex2var_pd( _mm512_permutex2var_pd( x, A0, y ), A1, z ) );
+        _mm512_storeu_pd( p + 8,  _mm512_permutex2var_pd( _mm512_permutex2var_pd( x, B0, y ), B1, z ) );
+        _mm512_storeu_pd( p + 16, _mm512_permutex2var_pd( _mm512_permutex2var_pd( x, C0, y ), C1, z ) );
+    }
+
+    inline __m512d roundToFloat( __m512d a ) { return _mm512_cvtps_pd( _mm512_cvtpd_ps( a ) ); }
+
+    inline void storeFloat( float * p, __m512d v ) { _mm256_storeu_ps( p, _mm512_cvtpd_ps( v ) ); }
+#endif
+
+    /////////////////////////////////////////////////////////////////////////
+    // Polynomial evaluation (Horner's method, lowest order coefficient first)
+    /////////////////////////////////////////////////////////////////////////
+    template<typename V>
+    inline V horner( V /*x*/, float c0 )
+    {
+        return splat<V>( c0 );
+    }
+
+    template<typename V>
+    inline V horner( V x, float c0, float c1 )
+    {
+        return madd( x, splat<V>( c1 ), splat<V>( c0 ) );
+    }
+
+    template<typename V>
+    inline V horner( V x, float c0, float c1, float c2 )
+    {
+        return madd( x, horner( x, c1, c2 ), splat<V>( c0 ) );
+    }
+
+    template<typename V>
+    inline V horner( V x, float c0, float c1, float c2, float c3 )
+    {
+        return madd( x, horner( x, c1, c2, c3 ), splat<V>( c0 ) );
+    }
+
+    template<typename V>
+    inline V horner( V x, float c0, float c1, float c2, float c3, float c4 )
+    {
+        return madd( x, horner( x, c1, c2, c3, c4 ), splat<V>( c0 ) );
+    }
+
+    template<typename V>
+    inline V horner( V x, float c0, float c1, float c2, float c3, float c4,
+                     float c5 )
+    {
+        return madd( x, horner( x, c1, c2, c3, c4, c5 ), splat<V>( c0 ) );
+    }
+
+    template<typename V>
+    inline V horner( V x, float c0, float c1, float c2, float c3, float c4,
+                     float c5, float c6 )
+    {
+        return madd( x, horner( x, c1, c2, c3, c4, c5, c6 ), splat<V>( c0 ) );
+    }
+
+    template<typename V>
+    inline V horner( V x, float c0, float c1, float c2, float c3, float c4,
+                     float c5, float c6, float c7 )
+    {
+        return madd( x, horner( x, c1, c2, c3, c4, c5, c6, c7 ), splat<V>( c0 ) );
+    }
+}
+}
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#   pragma GCC diagnostic pop
+#endif
+
+#endif
@@ -0,0 +1,665 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_SPLINE_H
+#define SCOTT_MATH_SPLINE_H
+
+//
+// Piecewise cubic curves over TVector2, TVector3, TVector4 and TQuaternion
+// control values: Catmull-Rom, Bezier, uniform B-spline and Hermite.
+//
+//   std::vector<Vec3> rail = ...;
+//   Math::Spline<Vec3> spline = Math::createCatmullRom( &rail[0], rail.size() );
+//
+//   Vec3 p = spline.evaluate( 0.25f );                 // by parameter
+//
+//   spline.computeArcLength();                         // once
+//   Vec3 q = spline.evaluateAtDistance( metres );      // constant speed
+//
+// Whatever the curve type, every segment is converted to power basis when
+// the spline is built, so evaluating a point costs three multiply-adds per
+// component after finding the segment. The parameter t runs from 0 at the
+// start of the first segment to 1 at the end of the last, with every
+// segment covering an equal share.
+//
+// Evaluating by parameter does not move along the curve at constant speed.
+// computeArcLength() tabulates the length of the curve at evenly spaced
+// parameters; distances are then mapped back to parameters by binary search
+// in the table, optionally refined with Newton's method.
+//
+// Quaternion splines interpolate the components and normalize the result,
+// with each control rotation first moved into the same hemisphere as the
+// one before it. This is not a true spherical spline, but it is smooth and
+// far cheaper to evaluate.
+//
+#include <smath/config.h>
+#include <smath/quaternion.h>
+#include <smath/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Math
+{
+namespace detail
+{
+    /**
+     * Adapts a control value type to the spline code, which works on arrays
+     * of its components.
+     */
+    template<typename V> struct SplineTraits;
+
+    template<typename T> struct SplineTraits< TVector2<T> >
+    {
+        typedef T Scalar;
+        static const int Components = 2;
+
+        static TVector2<T> fromComponents( const T * pC ) { return TVector2<T>( pC ); }
+        static TVector2<T> finish( const TVector2<T>& v ) { return v; }
+    };
+
+    template<typename T> struct SplineTraits< TVector3<T> >
+    {
+        typedef T Scalar;
+        static const int Components = 3;
+
+        static TVector3<T> fromComponents( const T * pC ) { return TVector3<T>( pC ); }
+        static TVector3<T> finish( const TVector3<T>& v ) { return v; }
+    };
+
+    template<typename T> struct SplineTraits< TVector4<T> >
+    {
+        typedef T Scalar;
+        static const int Components = 4;
+
+        static TVector4<T> fromComponents( const T * pC ) { return TVector4<T>( pC ); }
+        static TVector4<T> finish( const TVector4<T>& v ) { return v; }
+    };
+
+    template<typename T> struct SplineTraits< TQuaternion<T> >
+    {
+        typedef T Scalar;
+        static const int Components = 4;
+
+        static TQuaternion<T> fromComponents( const T * pC )
+        {
+            return TQuaternion<T>( pC[0], pC[1], pC[2], pC[3] );
+        }
+
+        static TQuaternion<T> finish( const TQuaternion<T>& q ) { return normalize( q ); }
+    };
+
+    /**
+     * Control values flattened into arrays of components. Quaternions are
+     * flipped where needed so each is in the same hemisphere as the one
+     * before it, which makes the curve take the shorter way around.
+     */
+    template<typename V>
+    std::vector<typename SplineTraits<V>::Scalar> splineComponents( const V * pValues,
+                                                                    size_t count,
+                                                                    bool alignHemispheres )
+    {
+        typedef typename SplineTraits<V>::Scalar T;
+        const int C = SplineTraits<V>::Components;
+
+        std::vector<T> components( count * C );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            T * pC = &components[ i * C ];
+            T dot = 0;
+
+            for ( int c = 0; c < C; ++c )
+            {
+                pC[c] = pValues[i][c];
+            }
+
+            if ( alignHemispheres && i > 0 )
+            {
+                for ( int c = 0; c < C; ++c )
+                {
+                    dot += pC[c] * pC[ c - C ];
+                }
+
+                if ( dot < 0 )
+                {
+                    for ( int c = 0; c < C; ++c )
+                    {
+                        pC[c] = -pC[c];
+                    }
+                }
+            }
+        }
+
+        return components;
+    }
+
+    /**
+     * Returns true if the control values are quaternions.
+     */
+    template<typename V> struct IsQuaternion { static const bool value = false; };
+    template<typename T> struct IsQuaternion< TQuaternion<T> > { static const bool value = true; };
+}
+
+    /**
+     * Piecewise cubic curve, built with one of the create functions below.
+     * Each segment is stored as the power basis coefficients of
+     * p(u) = c0 + c1 u + c2 u^2 + c3 u^3 for u in [0,1].
+     */
+    template<typename V>
+    class Spline
+    {
+    public:
+        typedef typename detail::SplineTraits<V>::Scalar Scalar;
+        static const int Components = detail::SplineTraits<V>::Components;
+
+        /**
+         * Creates an empty spline.
+         */
+        Spline()
+            : mSegments( 0 ),
+              mCoefficients(),
+              mLengths()
+        {
+        }
+
+        /**
+         * Returns the number of cubic segments.
+         */
+        size_t segmentCount() const
+        {
+            return mSegments;
+        }
+
+        bool empty() const
+        {
+            return mSegments == 0;
+        }
+
+        /**
+         * Returns the point at parameter t, clamped to [0,1].
+         */
+        V evaluate( Scalar t ) const
+        {
+            Scalar u;
+            const Scalar * pC = locate( t, u );
+            Scalar out[Components];
+
+            for ( int c = 0; c < Components; ++c )
+            {
+                out[c] = ( ( pC[ 3 * Components + c ] * u + pC[ 2 * Components + c ] ) * u +
+                           pC[ Components + c ] ) * u + pC[c];
+            }
+
+            return detail::SplineTraits<V>::finish( detail::SplineTraits<V>::fromComponents( out ) );
+        }
+
+        /**
+         * Evaluates the spline at count parameters.
+         */
+        void evaluate( const Scalar * pT, V * pOut, size_t count ) const
+        {
+            for ( size_t i = 0; i < count; ++i )
+            {
+                pOut[i] = evaluate( pT[i] );
+            }
+        }
+
+        /**
+         * Returns the derivative of the curve with respect to t, its
+         * velocity when t is time over the whole curve. For quaternion
+         * splines this is the derivative of the components before they are
+         * normalized.
+         */
+        V derivative( Scalar t ) const
+        {
+            Scalar out[Components];
+            derivative( t, out );
+
+            return detail::SplineTraits<V>::fromComponents( out );
+        }
+
+        /**
+         * Tabulates the length of the curve, which is needed by the distance
+         * functions below. The length between neighbouring entries is found
+         * with five point Gauss-Legendre quadrature, so a few entries per
+         * segment are enough unless segments are tightly curved.
+         *
+         * \param  samplesPerSegment  Table entries per segment
+         */
+        void computeArcLength( size_t samplesPerSegment = 8 )
+        {
+            SMATH_ASSERT( samplesPerSegment > 0, "Arc length table needs samples" );
+
+            const size_t intervals = mSegments * samplesPerSegment;
+            const Scalar step = Scalar(1) / intervals;
+
+            mLengths.resize( intervals + 1 );
+            mLengths[0] = 0;
+
+            for ( size_t i = 0; i < intervals; ++i )
+            {
+                mLengths[ i + 1 ] = mLengths[i] + integrateSpeed( i * step, ( i + 1 ) * step );
+            }
+        }
+
+        /**
+         * Returns the length of the curve, computeArcLength() must have been
+         * called.
+         */
+        Scalar length() const
+        {
+            SMATH_ASSERT( !mLengths.empty(), "Arc length table not computed" );
+            return mLengths.back();
+        }
+
+        /**
+         * Returns the parameter of the point a distance along the curve.
+         * The table is searched by bisection and interpolated linearly
+         * between its entries; each Newton step then roughly squares the
+         * remaining relative error.
+         *
+         * \param  distance     Distance from the start, clamped to the length
+         * \param  newtonSteps  Refinement steps
+         */
+        Scalar parameterAtDistance( Scalar distance, int newtonSteps = 0 ) const
+        {
+            SMATH_ASSERT( !mLengths.empty(), "Arc length table not computed" );
+
+            const size_t intervals = mLengths.size() - 1;
+            distance = std::min( std::max( distance, Scalar(0) ), mLengths.back() );
+
+            // Last entry not past the distance, by a bisection whose
+            // comparisons compile to conditional moves rather than branches
+            const Scalar * pBase = &mLengths[0];
+
+            for ( size_t n = mLengths.size(); n > 1; )
+            {
+                const size_t half = n / 2;
+
+                pBase = pBase[half] <= distance ? pBase + half : pBase;
+                n -= half;
+            }
+
+            const size_t i = std::min( static_cast<size_t>( pBase - &mLengths[0] ), intervals - 1 );
+
+            const Scalar step  = Scalar(1) / intervals;
+            const Scalar start = i * step;
+            const Scalar span  = mLengths[ i + 1 ] - mLengths[i];
+            const Scalar part  = span > 0 ? ( distance - mLengths[i] ) / span : Scalar(0);
+
+            Scalar t = start + part * step;
+
+            for ( int n = 0; n < newtonSteps; ++n )
+            {
+                const Scalar error = mLengths[i] + integrateSpeed( start, t ) - distance;
+                const Scalar speed = this->speed( t );
+
+                if ( speed <= 0 )
+                {
+                    break;
+                }
+
+                t = std::min( std::max( t - error / speed, start ), start + step );
+            }
+
+            return t;
+        }
+
+        /**
+         * Returns the point a distance along the curve.
+         */
+        V evaluateAtDistance( Scalar distance, int newtonSteps = 0 ) const
+        {
+            return evaluate( parameterAtDistance( distance, newtonSteps ) );
+        }
+
+        /**
+         * Evaluates the spline at count distances along it.
+         */
+        void evaluateAtDistance( const Scalar * pDistances,
+                                 V * pOut,
+                                 size_t count,
+                                 int newtonSteps = 0 ) const
+        {
+            for ( size_t i = 0; i < count; ++i )
+            {
+                pOut[i] = evaluate( parameterAtDistance( pDistances[i], newtonSteps ) );
+            }
+        }
+
+        /**
+         * Replaces the spline with segments given in power basis, see the
+         * create functions. Discards the arc length table.
+         */
+        void assign( size_t segments, std::vector<Scalar> coefficients )
+        {
+            SMATH_ASSERT( coefficients.size() == segments * 4 * Components,
+                          "Wrong number of spline coefficients" );
+
+            mSegments = segments;
+            mCoefficients.swap( coefficients );
+            mLengths.clear();
+        }
+
+    private:
+        /**
+         * Finds the coefficients of the segment containing parameter t and
+         * the local parameter u within it.
+         */
+        const Scalar * locate( Scalar t, Scalar& u ) const
+        {
+            SMATH_ASSERT( mSegments > 0, "Cannot evaluate an empty spline" );
+
+            const Scalar scaled = std::min( std::max( t, Scalar(0) ), Scalar(1) ) * mSegments;
+            const size_t segment = std::min( static_cast<size_t>( scaled ), mSegments - 1 );
+
+            u = scaled - segment;
+            return &mCoefficients[ segment * 4 * Components ];
+        }
+
+        void derivative( Scalar t, Scalar * pOut ) const
+        {
+            Scalar u;
+            const Scalar * pC = locate( t, u );
+
+            // Chain rule, each segment spans 1 / mSegments of t
+            const Scalar scale = static_cast<Scalar>( mSegments );
+
+            for ( int c = 0; c < Components; ++c )
+            {
+                pOut[c] = ( ( 3 * pC[ 3 * Components + c ] * u + 2 * pC[ 2 * Components + c ] ) * u +
+                            pC[ Components + c ] ) * scale;
+            }
+        }
+
+        /**
+         * Length of the derivative at t.
+         */
+        Scalar speed( Scalar t ) const
+        {
+            Scalar d[Components];
+            Scalar sum = 0;
+
+            derivative( t, d );
+
+            for ( int c = 0; c < Components; ++c )
+            {
+                sum += d[c] * d[c];
+            }
+
+            return std::sqrt( sum );
+        }
+
+        /**
+         * Length of the curve between two parameters in the same segment.
+         */
+        Scalar integrateSpeed( Scalar from, Scalar to ) const
+        {
+            // Five point Gauss-Legendre nodes and weights on [-1,1]
+            static const Scalar Nodes[5] = { Scalar(0), Scalar(-0.5384693101056831),
+                                             Scalar(0.5384693101056831), Scalar(-0.9061798459386640),
+                                             Scalar(0.9061798459386640) };
+            static const Scalar Weights[5] = { Scalar(0.5688888888888889), Scalar(0.4786286704993665),
+                                               Scalar(0.4786286704993665), Scalar(0.2369268850561891),
+                                               Scalar(0.2369268850561891) };
+
+            const Scalar half   = ( to - from ) / 2;
+            const Scalar middle = ( to + from ) / 2;
+            Scalar sum = 0;
+
+            for ( int i = 0; i < 5; ++i )
+            {
+                sum += Weights[i] * speed( middle + half * Nodes[i] );
+            }
+
+            return sum * half;
+        }
+
+    private:
+        size_t mSegments;
+        std::vector<Scalar> mCoefficients;
+        std::vector<Scalar> mLengths;
+    };
+
+namespace detail
+{
+    /**
+     * Appends one Hermite segment in power basis: from p0 with tangent m0 to
+     * p1 with tangent m1.
+     */
+    template<typename T>
+    void appendHermite( std::vector<T>& out, const T * p0, const T * p1,
+                        const T * m0, const T * m1, int components )
+    {
+        const size_t base = out.size();
+        out.resize( base + 4 * components );
+
+        for ( int c = 0; c < components; ++c )
+        {
+            out[ base + c ]                  = p0[c];
+            out[ base + components + c ]     = m0[c];
+            out[ base + 2 * components + c ] = 3 * ( p1[c] - p0[c] ) - 2 * m0[c] - m1[c];
+            out[ base + 3 * components + c ] = 2 * ( p0[c] - p1[c] ) + m0[c] + m1[c];
+        }
+    }
+
+    /**
+     * Distance between two control values raised to alpha, the knot spacing
+     * of a Catmull-Rom spline. Never zero, so repeated points are safe.
+     */
+    template<typename T>
+    T knotInterval( const T * pA, const T * pB, int components, T alpha )
+    {
+        T sum = 0;
+
+        for ( int c = 0; c < components; ++c )
+        {
+            sum += ( pB[c] - pA[c] ) * ( pB[c] - pA[c] );
+        }
+
+        const T interval = std::pow( sum, alpha / 2 );
+        return interval > T(1e-6) ? interval : T(1);
+    }
+}
+
+    /**
+     * Creates a Catmull-Rom spline passing through every point, with
+     * count - 1 segments. The tangents follow from the neighbouring points;
+     * the curve is extended past both ends by reflecting the second and
+     * second last points.
+     *
+     * \param  pPoints  Points to pass through, at least two
+     * \param  count    Number of points
+     * \param  alpha    Knot parameterization: 0 is the uniform spline, the
+     *                  default 0.5 the centripetal spline, which never forms
+     *                  cusps or loops within a segment, and 1 the chordal
+     */
+    template<typename V>
+    Spline<V> createCatmullRom( const V * pPoints, size_t count, float alpha = 0.5f )
+    {
+        typedef typename Spline<V>::Scalar T;
+        const int C = Spline<V>::Components;
+
+        SMATH_ASSERT( count >= 2, "Catmull-Rom spline needs two points" );
+
+        std::vector<T> points = detail::splineComponents( pPoints, count, detail::IsQuaternion<V>::value );
+        std::vector<T> coefficients;
+        coefficients.reserve( ( count - 1 ) * 4 * C );
+
+        T before[C], after[C];
+
+        for ( int c = 0; c < C; ++c )
+        {
+            before[c] = 2 * points[c] - points[ C + c ];
+            after[c]  = 2 * points[ ( count - 1 ) * C + c ] - points[ ( count - 2 ) * C + c ];
+        }
+
+        for ( size_t i = 0; i + 1 < count; ++i )
+        {
+            const T * p0 = i > 0 ? &points[ ( i - 1 ) * C ] : before;
+            const T * p1 = &points[ i * C ];
+            const T * p2 = &points[ ( i + 1 ) * C ];
+            const T * p3 = i + 2 < count ? &points[ ( i + 2 ) * C ] : after;
+
+            const T d01 = detail::knotInterval( p0, p1, C, T(alpha) );
+            const T d12 = detail::knotInterval( p1, p2, C, T(alpha) );
+            const T d23 = detail::knotInterval( p2, p3, C, T(alpha) );
+
+            // Tangents of the non-uniform spline, scaled to the segment
+            T m1[C], m2[C];
+
+            for ( int c = 0; c < C; ++c )
+            {
+                m1[c] = d12 * ( ( p1[c] - p0[c] ) / d01 - ( p2[c] - p0[c] ) / ( d01 + d12 ) ) +
+                        ( p2[c] - p1[c] );
+                m2[c] = d12 * ( ( p3[c] - p2[c] ) / d23 - ( p3[c] - p1[c] ) / ( d12 + d23 ) ) +
+                        ( p2[c] - p1[c] );
+            }
+
+            detail::appendHermite( coefficients, p1, p2, m1, m2, C );
+        }
+
+        Spline<V> spline;
+        spline.assign( count - 1, std::move( coefficients ) );
+
+        return spline;
+    }
+
+    /**
+     * Creates a piecewise cubic Bezier curve. Segments share their end
+     * points, so n segments take 3n + 1 control points: each segment starts
+     * at the end of the one before, is pulled towards the next two points
+     * and ends at the third.
+     *
+     * \param  pPoints  Control points
+     * \param  count    Number of control points, 3n + 1 for n segments
+     */
+    template<typename V>
+    Spline<V> createBezier( const V * pPoints, size_t count )
+    {
+        typedef typename Spline<V>::Scalar T;
+        const int C = Spline<V>::Components;
+
+        SMATH_ASSERT( count >= 4 && ( count - 1 ) % 3 == 0, "Bezier spline needs 3n + 1 points" );
+
+        const size_t segments = ( count - 1 ) / 3;
+        std::vector<T> points = detail::splineComponents( pPoints, count, detail::IsQuaternion<V>::value );
+        std::vector<T> coefficients( segments * 4 * C );
+
+        for ( size_t s = 0; s < segments; ++s )
+        {
+            const T * b = &points[ 3 * s * C ];
+            T * pOut = &coefficients[ s * 4 * C ];
+
+            for ( int c = 0; c < C; ++c )
+            {
+                const T b0 = b[c], b1 = b[ C + c ], b2 = b[ 2 * C + c ], b3 = b[ 3 * C + c ];
+
+                pOut[c]           = b0;
+                pOut[ C + c ]     = 3 * ( b1 - b0 );
+                pOut[ 2 * C + c ] = 3 * ( b0 - 2 * b1 + b2 );
+                pOut[ 3 * C + c ] = b3 - b0 + 3 * ( b1 - b2 );
+            }
+        }
+
+        Spline<V> spline;
+        spline.assign( segments, std::move( coefficients ) );
+
+        return spline;
+    }
+
+    /**
+     * Creates a uniform cubic B-spline, with count - 3 segments. The curve
+     * is twice continuously differentiable but only approaches its control
+     * points; repeat the first and last points three times to make it
+     * reach them.
+     *
+     * \param  pPoints  Control points, at least four
+     * \param  count    Number of control points
+     */
+    template<typename V>
+    Spline<V> createBSpline( const V * pPoints, size_t count )
+    {
+        typedef typename Spline<V>::Scalar T;
+        const int C = Spline<V>::Components;
+
+        SMATH_ASSERT( count >= 4, "B-spline needs four points" );
+
+        const size_t segments = count - 3;
+        std::vector<T> points = detail::splineComponents( pPoints, count, detail::IsQuaternion<V>::value );
+        std::vector<T> coefficients( segments * 4 * C );
+
+        for ( size_t s = 0; s < segments; ++s )
+        {
+            const T * p = &points[ s * C ];
+            T * pOut = &coefficients[ s * 4 * C ];
+
+            for ( int c = 0; c < C; ++c )
+            {
+                const T p0 = p[c], p1 = p[ C + c ], p2 = p[ 2 * C + c ], p3 = p[ 3 * C + c ];
+
+                pOut[c]           = ( p0 + 4 * p1 + p2 ) / 6;
+                pOut[ C + c ]     = ( p2 - p0 ) / 2;
+                pOut[ 2 * C + c ] = ( p0 - 2 * p1 + p2 ) / 2;
+                pOut[ 3 * C + c ] = ( p3 - p0 + 3 * ( p1 - p2 ) ) / 6;
+            }
+        }
+
+        Spline<V> spline;
+        spline.assign( segments, std::move( coefficients ) );
+
+        return spline;
+    }
+
+    /**
+     * Creates a cubic Hermite spline through every point with the given
+     * tangents, with count - 1 segments. Tangents are derivatives with
+     * respect to the parameter of one segment.
+     *
+     * \param  pPoints    Points to pass through, at least two
+     * \param  pTangents  Tangent at each point
+     * \param  count      Number of points and tangents
+     */
+    template<typename V>
+    Spline<V> createHermite( const V * pPoints, const V * pTangents, size_t count )
+    {
+        typedef typename Spline<V>::Scalar T;
+        const int C = Spline<V>::Components;
+
+        SMATH_ASSERT( count >= 2, "Hermite spline needs two points" );
+
+        std::vector<T> points   = detail::splineComponents( pPoints, count, detail::IsQuaternion<V>::value );
+        std::vector<T> tangents = detail::splineComponents( pTangents, count, false );
+        std::vector<T> coefficients;
+        coefficients.reserve( ( count - 1 ) * 4 * C );
+
+        for ( size_t i = 0; i + 1 < count; ++i )
+        {
+            detail::appendHermite( coefficients, &points[ i * C ], &points[ ( i + 1 ) * C ],
+                                   &tangents[ i * C ], &tangents[ ( i + 1 ) * C ], C );
+        }
+
+        Spline<V> spline;
+        spline.assign( count - 1, std::move( coefficients ) );
+
+        return spline;
+    }
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_SWIZZLE_H
+#define SCOTT_MATH_SWIZZLE_H
+
+//
+// Shader style swizzle accessors for TVector2, TVector3 and TVector4. The
+// vector classes expand the lists below in their class bodies, producing
+//
+//   v.zxy()             - read swizzles, for every combination of two to
+//                         four of the vector's components (repeats allowed)
+//   v.zx( TVector2<T> ) - write swizzles, for every combination without a
+//                         repeated component
+//
+// Reads are constexpr and return a new vector built from the component
+// accessors, so they compile to the same loads as writing the vector out by
+// hand. Writes copy the source before storing, so v.yx( v.xy() ) and
+// v.zyx( v ) swap components as expected.
+//
+namespace Math
+{
+    namespace detail
+    {
+        /**
+         * Component offsets, named after the swizzle letters so the
+         * accessor macros can paste them together.
+         */
+        enum SwizzleComponent
+        {
+            SWIZZLE_x = 0,
+            SWIZZLE_y = 1,
+            SWIZZLE_z = 2,
+            SWIZZLE_w = 3
+        };
+    }
+}
+
+#define SMATH_SWIZZLE_READ2( A, B )                                           \
+    constexpr TVector2<T> A##B() const                                        \
+    {                                                                         \
+        return TVector2<T>( A(), B() );                                       \
+    }
+
+#define SMATH_SWIZZLE_READ3( A, B, C )                                        \
+    constexpr TVector3<T> A##B##C() const                                     \
+    {                                                                         \
+        return TVector3<T>( A(), B(), C() );                                  \
+    }
+
+#define SMATH_SWIZZLE_READ4( A, B, C, D )                                     \
+    constexpr TVector4<T> A##B##C##D() const                                  \
+    {                                                                         \
+        return TVector4<T>( A(), B(), C(), D() );                             \
+    }
+
+#define SMATH_SWIZZLE_WRITE2( A, B )                                          \
+    void A##B( const TVector2<T>& s )                                         \
+    {                                                                         \
+        const T s0 = s.x(), s1 = s.y();                                       \
+        v[Math::detail::SWIZZLE_##A] = s0;                                    \
+        v[Math::detail::SWIZZLE_##B] = s1;                                    \
+    }
+
+#define SMATH_SWIZZLE_WRITE3( A, B, C )                                       \
+    void A##B##C( const TVector3<T>& s )                                      \
+    {                                                                         \
+        const T s0 = s.x(), s1 = s.y(), s2 = s.z();                           \
+        v[Math::detail::SWIZZLE_##A] = s0;                                    \
+        v[Math::detail::SWIZZLE_##B] = s1;                                    \
+        v[Math::detail::SWIZZLE_##C] = s2;                                    \
+    }
+
+#define SMATH_SWIZZLE_WRITE4( A, B, C, D )                                    \
+    void A##B##C##D( const TVector4<T>& s )                                   \
+    {                                                                         \
+        const T s0 = s.x(), s1 = s.y(), s2 = s.z(), s3 = s.w();               \
+        v[Math::detail::SWIZZLE_##A] = s0;                                    \
+        v[Math::detail::SWIZZLE_##B] = s1;                                    \
+        v[Math::detail::SWIZZLE_##C] = s2;                                    \
+        v[Math::detail::SWIZZLE_##D] = s3;                                    \
+    }
+
+/**
+ * Expands to every swizzle accessor of a vector with the given components.
+ */
+#define SMATH_SWIZZLE_ACCESSORS( LIST )                                       \
+    LIST( SMATH_SWIZZLE_READ2, SMATH_SWIZZLE_READ3, SMATH_SWIZZLE_READ4,      \
+          SMATH_SWIZZLE_WRITE2, SMATH_SWIZZLE_WRITE3, SMATH_SWIZZLE_WRITE4 )
+
+//
+// Swizzle lists. R2..R4 name the read accessors and W2..W4 the writable
+// ones, the vector classes pass SMATH_SWIZZLE_ACCESSORS one of these lists.
+//
+#define SMATH_SWIZZLES_XY( R2, R3, R4, W2, W3, W4 ) \
+    R2(x,x) R2(x,y) R2(y,x) R2(y,y) \
+    R3(x,x,x) R3(x,x,y) R3(x,y,x) R3(x,y,y) R3(y,x,x) R3(y,x,y) R3(y,y,x) R3(y,y,y) \
+    R4(x,x,x,x) R4(x,x,x,y) R4(x,x,y,x) R4(x,x,y,y) R4(x,y,x,x) R4(x,y,x,y) R4(x,y,y,x) R4(x,y,y,y) \
+    R4(y,x,x,x) R4(y,x,x,y) R4(y,x,y,x) R4(y,x,y,y) R4(y,y,x,x) R4(y,y,x,y) R4(y,y,y,x) R4(y,y,y,y) \
+    W2(x,y) W2(y,x)
+
+#define SMATH_SWIZZLES_XYZ( R2, R3, R4, W2, W3, W4 ) \
+    R2(x,x) R2(x,y) R2(x,z) R2(y,x) R2(y,y) R2(y,z) R2(z,x) R2(z,y) \
+    R2(z,z) \
+    R3(x,x,x) R3(x,x,y) R3(x,x,z) R3(x,y,x) R3(x,y,y) R3(x,y,z) R3(x,z,x) R3(x,z,y) \
+    R3(x,z,z) R3(y,x,x) R3(y,x,y) R3(y,x,z) R3(y,y,x) R3(y,y,y) R3(y,y,z) R3(y,z,x) \
+    R3(y,z,y) R3(y,z,z) R3(z,x,x) R3(z,x,y) R3(z,x,z) R3(z,y,x) R3(z,y,y) R3(z,y,z) \
+    R3(z,z,x) R3(z,z,y) R3(z,z,z) \
+    R4(x,x,x,x) R4(x,x,x,y) R4(x,x,x,z) R4(x,x,y,x) R4(x,x,y,y) R4(x,x,y,z) R4(x,x,z,x) R4(x,x,z,y) \
+    R4(x,x,z,z) R4(x,y,x,x) R4(x,y,x,y) R4(x,y,x,z) R4(x,y,y,x) R4(x,y,y,y) R4(x,y,y,z) R4(x,y,z,x) \
+    R4(x,y,z,y) R4(x,y,z,z) R4(x,z,x,x) R4(x,z,x,y) R4(x,z,x,z) R4(x,z,y,x) R4(x,z,y,y) R4(x,z,y,z) \
+    R4(x,z,z,x) R4(x,z,z,y) R4(x,z,z,z) R4(y,x,x,x) R4(y,x,x,y) R4(y,x,x,z) R4(y,x,y,x) R4(y,x,y,y) \
+    R4(y,x,y,z) R4(y,x,z,x) R4(y,x,z,y) R4(y,x,z,z) R4(y,y,x,x) R4(y,y,x,y) R4(y,y,x,z) R4(y,y,y,x) \
+    R4(y,y,y,y) R4(y,y,y,z) R4(y,y,z,x) R4(y,y,z,y) R4(y,y,z,z) R4(y,z,x,x) R4(y,z,x,y) R4(y,z,x,z) \
+    R4(y,z,y,x) R4(y,z,y,y) R4(y,z,y,z) R4(y,z,z,x) R4(y,z,z,y) R4(y,z,z,z) R4(z,x,x,x) R4(z,x,x,y) \
+    R4(z,x,x,z) R4(z,x,y,x) R4(z,x,y,y) R4(z,x,y,z) R4(z,x,z,x) R4(z,x,z,y) R4(z,x,z,z) R4(z,y,x,x) \
+    R4(z,y,x,y) R4(z,y,x,z) R4(z,y,y,x) R4(z,y,y,y) R4(z,y,y,z) R4(z,y,z,x) R4(z,y,z,y) R4(z,y,z,z) \
+    R4(z,z,x,x) R4(z,z,x,y) R4(z,z,x,z) R4(z,z,y,x) R4(z,z,y,y) R4(z,z,y,z) R4(z,z,z,x) R4(z,z,z,y) \
+    R4(z,z,z,z) \
+    W2(x,y) W2(x,z) W2(y,x) W2(y,z) W2(z,x) W2(z,y) \
+    W3(x,y,z) W3(x,z,y) W3(y,x,z) W3(y,z,x) W3(z,x,y) W3(z,y,x)
+
+#define SMATH_SWIZZLES_XYZW( R2, R3, R4, W2, W3, W4 ) \
+    R2(x,x) R2(x,y) R2(x,z) R2(x,w) R2(y,x) R2(y,y) R2(y,z) R2(y,w) \
+    R2(z,x) R2(z,y) R2(z,z) R2(z,w) R2(w,x) R2(w,y) R2(w,z) R2(w,w) \
+    R3(x,x,x) R3(x,x,y) R3(x,x,z) R3(x,x,w) R3(x,y,x) R3(x,y,y) R3(x,y,z) R3(x,y,w) \
+    R3(x,z,x) R3(x,z,y) R3(x,z,z) R3(x,z,w) R3(x,w,x) R3(x,w,y) R3(x,w,z) R3(x,w,w) \
+    R3(y,x,x) R3(y,x,y) R3(y,x,z) R3(y,x,w) R3(y,y,x) R3(y,y,y) R3(y,y,z) R3(y,y,w) \
+    R3(y,z,x) R3(y,z,y) R3(y,z,z) R3(y,z,w) R3(y,w,x) R3(y,w,y) R3(y,w,z) R3(y,w,w) \
+    R3(z,x,x) R3(z,x,y) R3(z,x,z) R3(z,x,w) R3(z,y,x) R3(z,y,y) R3(z,y,z) R3(z,y,w) \
+    R3(z,z,x) R3(z,z,y) R3(z,z,z) R3(z,z,w) R3(z,w,x) R3(z,w,y) R3(z,w,z) R3(z,w,w) \
+    R3(w,x,x) R3(w,x,y) R3(w,x,z) R3(w,x,w) R3(w,y,x) R3(w,y,y) R3(w,y,z) R3(w,y,w) \
+    R3(w,z,x) R3(w,z,y) R3(w,z,z) R3(w,z,w) R3(w,w,x) R3(w,w,y) R3(w,w,z) R3(w,w,w) \
+    R4(x,x,x,x) R4(x,x,x,y) R4(x,x,x,z) R4(x,x,x,w) R4(x,x,y,x) R4(x,x,y,y) R4(x,x,y,z) R4(x,x,y,w) \
+    R4(x,x,z,x) R4(x,x,z,y) R4(x,x,z,z) R4(x,x,z,w) R4(x,x,w,x) R4(x,x,w,y) R4(x,x,w,z) R4(x,x,w,w) \
+    R4(x,y,x,x) R4(x,y,x,y) R4(x,y,x,z) R4(x,y,x,w) R4(x,y,y,x) R4(x,y,y,y) R4(x,y,y,z) R4(x,y,y,w) \
+    R4(x,y,z,x) R4(x,y,z,y) R4(x,y,z,z) R4(x,y,z,w) R4(x,y,w,x) R4(x,y,w,y) R4(x,y,w,z) R4(x,y,w,w) \
+    R4(x,z,x,x) R4(x,z,x,y) R4(x,z,x,z) R4(x,z,x,w) R4(x,z,y,x) R4(x,z,y,y) R4(x,z,y,z) R4(x,z,y,w) \
+    R4(x,z,z,x) R4(x,z,z,y) R4(x,z,z,z) R4(x,z,z,w) R4(x,z,w,x) R4(x,z,w,y) R4(x,z,w,z) R4(x,z,w,w) \
+    R4(x,w,x,x) R4(x,w,x,y) R4(x,w,x,z) R4(x,w,x,w) R4(x,w,y,x) R4(x,w,y,y) R4(x,w,y,z) R4(x,w,y,w) \
+    R4(x,w,z,x) R4(x,w,z,y) R4(x,w,z,z) R4(x,w,z,w) R4(x,w,w,x) R4(x,w,w,y) R4(x,w,w,z) R4(x,w,w,w) \
+    R4(y,x,x,x) R4(y,x,x,y) R4(y,x,x,z) R4(y,x,x,w) R4(y,x,y,x) R4(y,x,y,y) R4(y,x,y,z) R4(y,x,y,w) \
+    R4(y,x,z,x) R4(y,x,z,y) R4(y,x,z,z) R4(y,x,z,w) R4(y,x,w,x) R4(y,x,w,y) R4(y,x,w,z) R4(y,x,w,w) \
+    R4(y,y,x,x) R4(y,y,x,y) R4(y,y,x,z) R4(y,y,x,w) R4(y,y,y,x) R4(y,y,y,y) R4(y,y,y,z) R4(y,y,y,w) \
+    R4(y,y,z,x) R4(y,y,z,y) R4(y,y,z,z) R4(y,y,z,w) R4(y,y,w,x) R4(y,y,w,y) R4(y,y,w,z) R4(y,y,w,w) \
+    R4(y,z,x,x) R4(y,z,x,y) R4(y,z,x,z) R4(y,z,x,w) R4(y,z,y,x) R4(y,z,y,y) R4(y,z,y,z) R4(y,z,y,w) \
+    R4(y,z,z,x) R4(y,z,z,y) R4(y,z,z,z) R4(y,z,z,w) R4(y,z,w,x) R4(y,z,w,y) R4(y,z,w,z) R4(y,z,w,w) \
+    R4(y,w,x,x) R4(y,w,x,y) R4(y,w,x,z) R4(y,w,x,w) R4(y,w,y,x) R4(y,w,y,y) R4(y,w,y,z) R4(y,w,y,w) \
+    R4(y,w,z,x) R4(y,w,z,y) R4(y,w,z,z) R4(y,w,z,w) R4(y,w,w,x) R4(y,w,w,y) R4(y,w,w,z) R4(y,w,w,w) \
+    R4(z,x,x,x) R4(z,x,x,y) R4(z,x,x,z) R4(z,x,x,w) R4(z,x,y,x) R4(z,x,y,y) R4(z,x,y,z) R4(z,x,y,w) \
+    R4(z,x,z,x) R4(z,x,z,y) R4(z,x,z,z) R4(z,x,z,w) R4(z,x,w,x) R4(z,x,w,y) R4(z,x,w,z) R4(z,x,w,w) \
+    R4(z,y,x,x) R4(z,y,x,y) R4(z,y,x,z) R4(z,y,x,w) R4(z,y,y,x) R4(z,y,y,y) R4(z,y,y,z) R4(z,y,y,w) \
+    R4(z,y,z,x) R4(z,y,z,y) R4(z,y,z,z) R4(z,y,z,w) R4(z,y,w,x) R4(z,y,w,y) R4(z,y,w,z) R4(z,y,w,w) \
+    R4(z,z,x,x) R4(z,z,x,y) R4(z,z,x,z) R4(z,z,x,w) R4(z,z,y,x) R4(z,z,y,y) R4(z,z,y,z) R4(z,z,y,w) \
+    R4(z,z,z,x) R4(z,z,z,y) R4(z,z,z,z) R4(z,z,z,w) R4(z,z,w,x) R4(z,z,w,y) R4(z,z,w,z) R4(z,z,w,w) \
+    R4(z,w,x,x) R4(z,w,x,y) R4(z,w,x,z) R4(z,w,x,w) R4(z,w,y,x) R4(z,w,y,y) R4(z,w,y,z) R4(z,w,y,w) \
+    R4(z,w,z,x) R4(z,w,z,y) R4(z,w,z,z) R4(z,w,z,w) R4(z,w,w,x) R4(z,w,w,y) R4(z,w,w,z) R4(z,w,w,w) \
+    R4(w,x,x,x) R4(w,x,x,y) R4(w,x,x,z) R4(w,x,x,w) R4(w,x,y,x) R4(w,x,y,y) R4(w,x,y,z) R4(w,x,y,w) \
+    R4(w,x,z,x) R4(w,x,z,y) R4(w,x,z,z) R4(w,x,z,w) R4(w,x,w,x) R4(w,x,w,y) R4(w,x,w,z) R4(w,x,w,w) \
+    R4(w,y,x,x) R4(w,y,x,y) R4(w,y,x,z) R4(w,y,x,w) R4(w,y,y,x) R4(w,y,y,y) R4(w,y,y,z) R4(w,y,y,w) \
+    R4(w,y,z,x) R4(w,y,z,y) R4(w,y,z,z) R4(w,y,z,w) R4(w,y,w,x) R4(w,y,w,y) R4(w,y,w,z) R4(w,y,w,w) \
+    R4(w,z,x,x) R4(w,z,x,y) R4(w,z,x,z) R4(w,z,x,w) R4(w,z,y,x) R4(w,z,y,y) R4(w,z,y,z) R4(w,z,y,w) \
+    R4(w,z,z,x) R4(w,z,z,y) R4(w,z,z,z) R4(w,z,z,w) R4(w,z,w,x) R4(w,z,w,y) R4(w,z,w,z) R4(w,z,w,w) \
+    R4(w,w,x,x) R4(w,w,x,y) R4(w,w,x,z) R4(w,w,x,w) R4(w,w,y,x) R4(w,w,y,y) R4(w,w,y,z) R4(w,w,y,w) \
+    R4(w,w,z,x) R4(w,w,z,y) R4(w,w,z,z) R4(w,w,z,w) R4(w,w,w,x) R4(w,w,w,y) R4(w,w,w,z) R4(w,w,w,w) \
+    W2(x,y) W2(x,z) W2(x,w) W2(y,x) W2(y,z) W2(y,w) W2(z,x) W2(z,y) \
+    W2(z,w) W2(w,x) W2(w,y) W2(w,z) \
+    W3(x,y,z) W3(x,y,w) W3(x,z,y) W3(x,z,w) W3(x,w,y) W3(x,w,z) W3(y,x,z) W3(y,x,w) \
+    W3(y,z,x) W3(y,z,w) W3(y,w,x) W3(y,w,z) W3(z,x,y) W3(z,x,w) W3(z,y,x) W3(z,y,w) \
+    W3(z,w,x) W3(z,w,y) W3(w,x,y) W3(w,x,z) W3(w,y,x) W3(w,y,z) W3(w,z,x) W3(w,z,y) \
+    W4(x,y,z,w) W4(x,y,w,z) W4(x,z,y,w) W4(x,z,w,y) W4(x,w,y,z) W4(x,w,z,y) W4(y,x,z,w) W4(y,x,w,z) \
+    W4(y,z,x,w) W4(y,z,w,x) W4(y,w,x,z) W4(y,w,z,x) W4(z,x,y,w) W4(z,x,w,y) W4(z,y,x,w) W4(z,y,w,x) \
+    W4(z,w,x,y) W4(z,w,y,x) W4(w,x,y,z) W4(w,x,z,y) W4(w,y,x,z) W4(w,y,z,x) W4(w,z,x,y) W4(w,z,y,x)
+
+#endif
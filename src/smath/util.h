@@ -34,7 +34,7 @@ namespace Math
      * \return    True if they are of similiar value (within error tolerance)
      */
     template<typename T>
-    inline bool equalsClose( T a, T b )
+    constexpr bool equalsClose( T a, T b )
     {
         return a == b;
     }
@@ -48,9 +48,10 @@ namespace Math
      * \return    True if they are of similiar value (within error tolerance)
      */
     template<>
-    inline bool equalsClose<float>( float a, float b )
+    constexpr bool equalsClose<float>( float a, float b )
     {
-        return ( std::fabs( a - b ) < ZeroEpsilonF );
+        // Both differences rather than std::fabs, which is not constexpr
+        return ( a - b < ZeroEpsilonF && b - a < ZeroEpsilonF );
     }
 
     /**
@@ -62,9 +63,9 @@ namespace Math
      * \return    True if they are of similiar value (within error tolerance)
      */
     template<>
-    inline bool equalsClose<double>( double a, double b )
+    constexpr bool equalsClose<double>( double a, double b )
     {
-        return ( std::fabs( a - b ) < ZeroEpsilonD );
+        return ( a - b < ZeroEpsilonD && b - a < ZeroEpsilonD );
     }
 
     /**
@@ -381,30 +382,29 @@ namespace Math
     }
 
     /**
-     * Computes a 32 bit hash from a floating point value. This is used to
-     * quickly cache floats into a hashmap, but care must be taken since two
-     * seemingly identical floating point values can have different memory values
-     * and hence different hash values
+     * Computes a 32 bit hash from a floating point value. -0 and +0 hash to
+     * the same value, as do all NaNs. See smath/hash.h for 64 bit hashes of
+     * vectors and matrices.
      *
      * \param  value  Floating point value to hash
      * \return        Numeric hash code
      */
-    inline unsigned int hashfloat( float value );
+    unsigned int hashfloat( float value );
 
     /**
-     * Computes a 32 bit hash from a floating point value. This is used to
-     * quickly cache floats into a hashmap, but care must be taken since two
-     * seemingly identical floating point values can have different memory values
-     * and hence different hash values
+     * Computes a 32 bit hash from an array of floating point values. The
+     * hash depends on the order of the values.
      *
      * \param  pArray     Pointer to an array of floating point values
      * \param  arraySize  Number of floating point values in array
      * \return            Numeric hash code
      */
-    inline unsigned int hashfloat( const float * pArray, size_t arraySize );
+    unsigned int hashfloat( const float * pArray, size_t arraySize );
 
     /**
-     * Quickly computes the approximate square root of the input value
+     * Quickly computes the approximate square root of the input value. This
+     * is Math::fast::sqrt at the default precision, see fastmath.h for the
+     * inline and batch versions.
      */
     float fastSqrt( float f );
 }
@@ -20,6 +20,8 @@
 #include <smath/util.h>
 #include <smath/interpolation.h>
 #include <smath/constants.h>
+#include <smath/fastmath.h>
+#include <smath/swizzle.h>
 #include <ostream>
 
 /////////////////////////////////////////////////////////////////////////////
@@ -34,14 +36,14 @@ template<typename T> class TVector2;
 
 namespace boost { namespace serialization { class access; } }
 
-template<typename T> T dot( const TVector3<T>& lhs, const TVector3<T>& rhs );
-template<typename T> TVector3<T> cross( const TVector3<T>& lhs, const TVector3<T>& rhs );
+template<typename T> constexpr T dot( const TVector3<T>& lhs, const TVector3<T>& rhs );
+template<typename T> constexpr TVector3<T> cross( const TVector3<T>& lhs, const TVector3<T>& rhs );
 template<typename T> T length( const TVector4<T>& v );
 template<typename T> T length( const TVector3<T>& v );
 template<typename T> T length( const TVector2<T>& v );
-template<typename T> T lengthSquared( const TVector4<T>& v );
-template<typename T> T lengthSquared( const TVector3<T>& v );
-template<typename T> T lengthSquared( const TVector2<T>& v );
+template<typename T> constexpr T lengthSquared( const TVector4<T>& v );
+template<typename T> constexpr T lengthSquared( const TVector3<T>& v );
+template<typename T> constexpr T lengthSquared( const TVector2<T>& v );
 template<typename T> TVector4<T> normalized( const TVector4<T>& v );
 template<typename T> TVector3<T> normalized( const TVector3<T>& v );
 template<typename T> TVector2<T> normalized( const TVector2<T>& v );
@@ -118,7 +120,7 @@ public:
      * This constructor expects that the passed array contains at 
      * least four values, but there is nothing to check this constraint
      */
-    explicit TVector4( const_pointer pVals )
+    explicit constexpr TVector4( const_pointer pVals )
         : mX( pVals[0] ), mY( pVals[1] ), mZ( pVals[2] ), mW( pVals[3] )
     {
     }
@@ -127,7 +129,7 @@ public:
      * Vector x/y/z constructor. Takes the provided x/y/z values and
      * assigns it to the newly constructed vector.
      */
-    TVector4( value_type x, value_type y, value_type z, value_type w )
+    constexpr TVector4( value_type x, value_type y, value_type z, value_type w )
         : mX( x ), mY( y ), mZ( z ), mW( w )
     {
     }
@@ -135,7 +137,7 @@ public:
     /**
      * Copy constructor
      */
-    TVector4( const TVector4<T>& v )
+    constexpr TVector4( const TVector4<T>& v )
         : mX( v.mX ), mY( v.mY ), mZ( v.mZ ), mW( v.mW )
     {
     }
@@ -210,7 +212,7 @@ public:
     /**
      * Equality operator
      */
-    bool operator == ( const TVector4<T>& rhs ) const
+    constexpr bool operator == ( const TVector4<T>& rhs ) const
     {
 #ifdef MATH_FUZZY_EQUALS
     return ( Math::equalsClose( mX, rhs.mX ) &&
@@ -225,7 +227,7 @@ public:
     /**
      * Inequality operator
      */
-    bool operator != ( const TVector4<T>& rhs ) const
+    constexpr bool operator != ( const TVector4<T>& rhs ) const
     {
         return !( *this == rhs );
     }
@@ -234,7 +236,7 @@ public:
      * Unary negation operator. Negates all components of the value, which is
      * the same as multiplying all components by -1.0.
      */
-    friend TVector4<T> operator - ( const TVector4<T>& rhs )
+    friend constexpr TVector4<T> operator - ( const TVector4<T>& rhs )
     {
         return TVector4( -rhs.mX, -rhs.mY, -rhs.mZ, -rhs.mW );
     }
@@ -242,7 +244,7 @@ public:
     /**
      * Component wise addition operator
      */
-    friend TVector4<T> operator + ( const TVector4<T>& lhs,
+    friend constexpr TVector4<T> operator + ( const TVector4<T>& lhs,
                                     const TVector4<T>& rhs )
     {
         return TVector4( lhs.mX + rhs.mX,
@@ -254,7 +256,7 @@ public:
     /**
      * Component wise subtraction operator
      */
-    friend TVector4<T> operator - ( const TVector4<T>& lhs,
+    friend constexpr TVector4<T> operator - ( const TVector4<T>& lhs,
                                     const TVector4<T>& rhs )
     {
         return TVector4<T>( lhs.mX - rhs.mX,
@@ -268,7 +270,7 @@ public:
      * which is identical to multiplying all of the vector's components by the
      * scalar.
      */
-    friend TVector4<T> operator * ( const TVector4<T>& lhs, 
+    friend constexpr TVector4<T> operator * ( const TVector4<T>& lhs, 
                                     value_type scalar )
     {
         return TVector4( lhs.mX * scalar, 
@@ -282,7 +284,7 @@ public:
      * scalar, which is identical to dividing all of the vector's components by
      * the scalar.
      */
-    friend TVector4<T> operator / ( const TVector4<T>& lhs,
+    friend constexpr TVector4<T> operator / ( const TVector4<T>& lhs,
                                     value_type scalar )
 
     {
@@ -348,7 +350,7 @@ public:
     /**
      * Return the value of the vector's X component
      */
-    inline value_type x() const
+    constexpr value_type x() const
     {
         return mX;
     }
@@ -356,7 +358,7 @@ public:
     /**
      * Return the value of the vector's Y component
      */
-    inline value_type y() const
+    constexpr value_type y() const
     {
         return mY;
     }
@@ -364,7 +366,7 @@ public:
     /**
      * Return the value of the vector's Z component
      */
-    inline value_type z() const
+    constexpr value_type z() const
     {
         return mZ;
     }
@@ -372,16 +374,22 @@ public:
     /**
      * Return the value of the vector's W component
      */
-    inline value_type w() const
+    constexpr value_type w() const
     {
         return mW;
     }
 
+    /**
+     * Swizzle accessors, v.wzyx() reads and v.wzyx( u ) writes. See
+     * smath/swizzle.h for the generated set.
+     */
+    SMATH_SWIZZLE_ACCESSORS( SMATH_SWIZZLES_XYZW )
+
     // Returns the length (magnitude) of this vector
     friend value_type length<>( const TVector4<T>& v );
 
     // Returns the length squared of this vector
-    friend value_type lengthSquared<>( const TVector4<T>& v );
+    friend constexpr value_type lengthSquared<>( const TVector4<T>& v );
 
     // Returns normalized version of this vector
     friend TVector4<T> normalized<>( const TVector4<T>& v );
@@ -474,7 +482,7 @@ public:
      * This constructor expects that the passed array contains at 
      * least four values, but there is nothing to check this constraint
      */
-    explicit TVector3( const_pointer pVals )
+    explicit constexpr TVector3( const_pointer pVals )
         : mX( pVals[0] ), mY( pVals[1] ), mZ( pVals[2] )
     {
     }
@@ -483,7 +491,7 @@ public:
      * Vector x/y/z constructor. Takes the provided x/y/z values and
      * assigns it to the newly constructed vector.
      */
-    TVector3( value_type x, value_type y, value_type z )
+    constexpr TVector3( value_type x, value_type y, value_type z )
         : mX( x ), mY( y ), mZ( z )
     {
     }
@@ -491,7 +499,7 @@ public:
     /**
      * Copy constructor
      */
-    TVector3( const TVector3<T>& v )
+    constexpr TVector3( const TVector3<T>& v )
         : mX( v.mX ), mY( v.mY ), mZ( v.mZ )
     {
     }
@@ -564,7 +572,7 @@ public:
     /**
      * Equality operator
      */
-    bool operator == ( const TVector3<T>& rhs ) const
+    constexpr bool operator == ( const TVector3<T>& rhs ) const
     {
 #ifdef MATH_FUZZY_EQUALS
     return ( Math::equalsClose( mX, rhs.mX ) &&
@@ -578,7 +586,7 @@ public:
     /**
      * Inequality operator
      */
-    bool operator != ( const TVector3<T>& rhs ) const
+    constexpr bool operator != ( const TVector3<T>& rhs ) const
     {
         return !( *this == rhs );
     }
@@ -587,7 +595,7 @@ public:
      * Unary negation operator. Negates all components of the value, which is
      * the same as multiplying all components by -1.0.
      */
-    friend TVector3<T> operator - ( const TVector3<T>& rhs )
+    friend constexpr TVector3<T> operator - ( const TVector3<T>& rhs )
     {
         return TVector3( -rhs.mX, -rhs.mY, -rhs.mZ );
     }
@@ -595,7 +603,7 @@ public:
     /**
      * Component wise addition operator
      */
-    friend TVector3<T> operator + ( const TVector3<T>& lhs,
+    friend constexpr TVector3<T> operator + ( const TVector3<T>& lhs,
                                     const TVector3<T>& rhs )
     {
         return TVector3( lhs.mX + rhs.mX,
@@ -606,7 +614,7 @@ public:
     /**
      * Component wise subtraction operator
      */
-    friend TVector3<T> operator - ( const TVector3<T>& lhs,
+    friend constexpr TVector3<T> operator - ( const TVector3<T>& lhs,
                                     const TVector3<T>& rhs )
     {
         return TVector3<T>( lhs.mX - rhs.mX,
@@ -619,7 +627,7 @@ public:
      * which is identical to multiplying all of the vector's components by the
      * scalar value.
      */
-    friend TVector3<T> operator * ( const TVector3<T>& lhs, 
+    friend constexpr TVector3<T> operator * ( const TVector3<T>& lhs, 
                                     value_type scalar )
     {
         return TVector3( lhs.mX * scalar, 
@@ -632,7 +640,7 @@ public:
      * scalar, which is identical to dividing all of the vector's components by
      * the scalar value.
      */
-    friend TVector3<T> operator / ( const TVector3<T>& lhs,
+    friend constexpr TVector3<T> operator / ( const TVector3<T>& lhs,
                                     value_type scalar )
 
     {
@@ -692,7 +700,7 @@ public:
     /**
      * Return the value of the vector's X component
      */
-    inline value_type x() const
+    constexpr value_type x() const
     {
         return mX;
     }
@@ -700,7 +708,7 @@ public:
     /**
      * Return the value of the vector's Y component
      */
-    inline value_type y() const
+    constexpr value_type y() const
     {
         return mY;
     }
@@ -708,11 +716,17 @@ public:
     /**
      * Return the value of the vector's Z component
      */
-    inline value_type z() const
+    constexpr value_type z() const
     {
         return mZ;
     }
 
+    /**
+     * Swizzle accessors, v.zyx() reads and v.zyx( u ) writes. See
+     * smath/swizzle.h for the generated set.
+     */
+    SMATH_SWIZZLE_ACCESSORS( SMATH_SWIZZLES_XYZ )
+
     /**
      * Rotates the vector around the X axis, and returns the result
      * of this rotation
@@ -747,14 +761,14 @@ public:
      * Cross product. Returns the result of crossing the lhs vector with
      * the rhs vector
      */
-    friend TVector3<T> cross<>( const TVector3<T>& lhs,
+    friend constexpr TVector3<T> cross<>( const TVector3<T>& lhs,
                                 const TVector3<T>& rhs );
 
     /**
      * Dot product. Returns the result of dotting the lhs vector with the 
      * rhs vector
      */
-    friend value_type dot<>( const TVector3<T>& lhs, const TVector3<T>& rhs );
+    friend constexpr value_type dot<>( const TVector3<T>& lhs, const TVector3<T>& rhs );
 
     /**
      * Returns the angle between the lhs vector and the rhs vector
@@ -770,7 +784,7 @@ public:
     /**
      * Returns the length squared of the vector (no sqrt)
      */
-    friend value_type lengthSquared<>( const TVector3<T>& v );
+    friend constexpr value_type lengthSquared<>( const TVector3<T>& v );
 
     /**
      * Returns a normalized verison of this vector
@@ -863,7 +877,7 @@ public:
      * This constructor expects that the passed array contains at 
      * least four values, but there is nothing to check this constraint
      */
-    explicit TVector2( const_pointer pVals )
+    explicit constexpr TVector2( const_pointer pVals )
         : mX( pVals[0] ), mY( pVals[1] )
     {
     }
@@ -872,7 +886,7 @@ public:
      * Vector x/y constructor. Takes the provided x/y values and
      * assigns it to the newly constructed vector.
      */
-    TVector2( value_type x, value_type y )
+    constexpr TVector2( value_type x, value_type y )
         : mX( x ), mY( y )
     {
     }
@@ -880,7 +894,7 @@ public:
     /**
      * Copy constructor
      */
-    TVector2( const TVector2<T>& v )
+    constexpr TVector2( const TVector2<T>& v )
         : mX( v.mX ), mY( v.mY )
     {
     }
@@ -953,7 +967,7 @@ public:
     /**
      * Equality operator
      */
-    bool operator == ( const TVector2<T>& rhs ) const
+    constexpr bool operator == ( const TVector2<T>& rhs ) const
     {
 #ifdef MATH_FUZZY_EQUALS
     return ( Math::equalsClose( mX, rhs.mX ) &&
@@ -966,7 +980,7 @@ public:
     /**
      * Inequality operator
      */
-    bool operator != ( const TVector2<T>& rhs ) const
+    constexpr bool operator != ( const TVector2<T>& rhs ) const
     {
         return !( *this == rhs );
     }
@@ -975,7 +989,7 @@ public:
      * Unary negation operator. Negates all components of the value, which is
      * the same as multiplying all components by -1.0.
      */
-    friend TVector2<T> operator - ( const TVector2<T>& rhs )
+    friend constexpr TVector2<T> operator - ( const TVector2<T>& rhs )
     {
         return TVector2( -rhs.mX, -rhs.mY );
     }
@@ -983,7 +997,7 @@ public:
     /**
      * Component wise addition operator
      */
-    friend TVector2<T> operator + ( const TVector2<T>& lhs,
+    friend constexpr TVector2<T> operator + ( const TVector2<T>& lhs,
                                     const TVector2<T>& rhs )
     {
         return TVector2( lhs.mX + rhs.mX,
@@ -993,7 +1007,7 @@ public:
     /**
      * Component wise subtraction operator
      */
-    friend TVector2<T> operator - ( const TVector2<T>& lhs,
+    friend constexpr TVector2<T> operator - ( const TVector2<T>& lhs,
                                     const TVector2<T>& rhs )
     {
         return TVector2<T>( lhs.mX - rhs.mX,
@@ -1005,7 +1019,7 @@ public:
      * which is identical to multiplying all of the vector's components by the
      * scalar.
      */
-    friend TVector2<T> operator * ( const TVector2<T>& lhs, 
+    friend constexpr TVector2<T> operator * ( const TVector2<T>& lhs, 
                                     value_type scalar )
     {
         return TVector2( lhs.mX * scalar, 
@@ -1017,7 +1031,7 @@ public:
      * scalar, which is identical to dividing all of the vector's components by
      * the scalar.
      */
-    friend TVector2<T> operator / ( const TVector2<T>& lhs,
+    friend constexpr TVector2<T> operator / ( const TVector2<T>& lhs,
                                     value_type scalar )
 
     {
@@ -1073,7 +1087,7 @@ public:
     /**
      * Return the value of the vector's X component
      */
-    inline value_type x() const
+    constexpr value_type x() const
     {
         return mX;
     }
@@ -1081,11 +1095,17 @@ public:
     /**
      * Return the value of the vector's Y component
      */
-    inline value_type y() const
+    constexpr value_type y() const
     {
         return mY;
     }
 
+    /**
+     * Swizzle accessors, v.yx() reads and v.yx( u ) writes. See
+     * smath/swizzle.h for the generated set.
+     */
+    SMATH_SWIZZLE_ACCESSORS( SMATH_SWIZZLES_XY )
+
     /**
      * Returns the length (magnitude) of this vector.
      */
@@ -1094,7 +1114,7 @@ public:
     /**
      * Returns the length squared of the vector (no sqrt)
      */
-    friend value_type lengthSquared<>( const TVector2<T>& v );
+    friend constexpr value_type lengthSquared<>( const TVector2<T>& v );
 
     /**
      * Returns a normalized version of this vector
@@ -1142,19 +1162,19 @@ private:
 // Vector static definitions
 /////////////////////////////////////////////////////////////////////////////
 template<typename T>
-const TVector4<T> TVector4<T>::ZERO = TVector4<T>( 0, 0, 0, 0 );
+constexpr TVector4<T> TVector4<T>::ZERO = TVector4<T>( 0, 0, 0, 0 );
 
 template<typename T>
-const TVector3<T> TVector3<T>::ZERO = TVector3<T>( 0, 0, 0 );
+constexpr TVector3<T> TVector3<T>::ZERO = TVector3<T>( 0, 0, 0 );
 
 template<typename T>
-const TVector2<T> TVector2<T>::ZERO = TVector2<T>( 0, 0 );
+constexpr TVector2<T> TVector2<T>::ZERO = TVector2<T>( 0, 0 );
 
 /////////////////////////////////////////////////////////////////////////////
 // Templated vector method definitions
 /////////////////////////////////////////////////////////////////////////////
 template<typename T>
-TVector3<T> cross ( const TVector3<T>& lhs,
+constexpr TVector3<T> cross ( const TVector3<T>& lhs,
                     const TVector3<T>& rhs )
 {
     return TVector3<T>( lhs.mY * rhs.mZ - lhs.mZ * rhs.mY,
@@ -1163,62 +1183,230 @@ TVector3<T> cross ( const TVector3<T>& lhs,
 }
 
 template<typename T>
-T dot ( const TVector3<T>& lhs, const TVector3<T>& rhs )
+constexpr T dot ( const TVector3<T>& lhs, const TVector3<T>& rhs )
 {
     return lhs.mX * rhs.mX + lhs.mY * rhs.mY + lhs.mZ * rhs.mZ;
 }
 
-template<typename T> T angleBetween( const TVector3<T>& lhs, const TVector3<T>& rhs );
-template<> float angleBetween( const TVector3<float>& lhs, const TVector3<float>& rhs );
+/////////////////////////////////////////////////////////////////////////////
+// Length, normalization and rotation. The templates serve double and the 16
+// bit types in half.h; float is specialized in vector.cpp to use the
+// Math::fast approximations. Integer vectors have no length, only
+// lengthSquared.
+/////////////////////////////////////////////////////////////////////////////
+template<typename T>
+T length( const TVector4<T>& v )
+{
+    static_assert( !std::numeric_limits<T>::is_integer, "Integer vectors have no length" );
+    return static_cast<T>( std::sqrt( lengthSquared( v ) ) );
+}
 
-template<typename T> T length( const TVector4<T>& v );  // must specialize
-template<> float length( const TVector4<float>& v );
+template<typename T>
+T length( const TVector3<T>& v )
+{
+    static_assert( !std::numeric_limits<T>::is_integer, "Integer vectors have no length" );
+    return static_cast<T>( std::sqrt( lengthSquared( v ) ) );
+}
 
-template<typename T> T length( const TVector3<T>& v ); // must specialize
-template<> float length( const TVector3<float>& v );
+template<typename T>
+T length( const TVector2<T>& v )
+{
+    static_assert( !std::numeric_limits<T>::is_integer, "Integer vectors have no length" );
+    return static_cast<T>( std::sqrt( lengthSquared( v ) ) );
+}
 
-template<typename T> T length( const TVector2<T>& v );  // must specialize
+template<> float length( const TVector4<float>& v );
+template<> float length( const TVector3<float>& v );
 template<> float length( const TVector2<float>& v );
 
+/**
+ * Returns the angle between two vectors in degrees.
+ */
+template<typename T>
+T angleBetween( const TVector3<T>& lhs, const TVector3<T>& rhs )
+{
+    const T c = dot( lhs, rhs ) / ( length( lhs ) * length( rhs ) );
+    return static_cast<T>( std::acos( Math::clamp<T>( c, -1, 1 ) ) * Math::Rad2DegD );
+}
+
+template<> float angleBetween( const TVector3<float>& lhs, const TVector3<float>& rhs );
+
 template<typename T>
-T lengthSquared( const TVector4<T>& v )
+constexpr T lengthSquared( const TVector4<T>& v )
 {
     return v.mX * v.mX + v.mY * v.mY + v.mZ * v.mZ + v.mW * v.mW;
 }
 
 template<typename T>
-T lengthSquared( const TVector3<T>& v )
+constexpr T lengthSquared( const TVector3<T>& v )
 {
     return v.mX * v.mX + v.mY * v.mY + v.mZ * v.mZ;
 }
 
 template<typename T>
-T lengthSquared( const TVector2<T>& v )
+constexpr T lengthSquared( const TVector2<T>& v )
 {
     return v.mX * v.mX + v.mY * v.mY;
 }
 
-template<typename T> TVector4<T> normalized( const TVector4<T>& v );
-template<> TVector4<float> normalized( const TVector4<float>& v );
+template<typename T>
+TVector4<T> normalized( const TVector4<T>& v )
+{
+    T len = length( v );
+    SMATH_ASSERT( len > 0, "Cannot normalize vector of length zero" );
 
-template<typename T> TVector3<T> normalized( const TVector3<T>& v );
-template<> TVector3<float> normalized( const TVector3<float>& v );
+    // Vectors that are already unit length are returned as is
+    if ( Math::equalsClose<T>( len, 1 ) )
+    {
+        return v;
+    }
 
-template<typename T> TVector2<T> normalized( const TVector2<T>& v );
+    return TVector4<T>( v.mX / len, v.mY / len, v.mZ / len, v.mW / len );
+}
+
+template<typename T>
+TVector3<T> normalized( const TVector3<T>& v )
+{
+    T len = length( v );
+    SMATH_ASSERT( len > 0, "Cannot normalize vector of length zero" );
+
+    if ( Math::equalsClose<T>( len, 1 ) )
+    {
+        return v;
+    }
+
+    return TVector3<T>( v.mX / len, v.mY / len, v.mZ / len );
+}
+
+template<typename T>
+TVector2<T> normalized( const TVector2<T>& v )
+{
+    T len = length( v );
+    SMATH_ASSERT( len > 0, "Cannot normalize vector of length zero" );
+
+    if ( Math::equalsClose<T>( len, 1 ) )
+    {
+        return v;
+    }
+
+    return TVector2<T>( v.mX / len, v.mY / len );
+}
+
+template<> TVector4<float> normalized( const TVector4<float>& v );
+template<> TVector3<float> normalized( const TVector3<float>& v );
 template<> TVector2<float> normalized( const TVector2<float>& v );
 
-template<typename T> TVector3<T> rotateAroundX( const TVector3<T>& v, T angle );
-template<> TVector3<float> rotateAroundX( const TVector3<float>& v, float angle );
+/**
+ * Returns a normalized version of the vector using the fast reciprocal
+ * square root, with a relative error of about 1e-7 at full precision. Unlike
+ * normalized() there is no early out for vectors that are already unit
+ * length.
+ */
+template<typename T>
+TVector4<T> normalizedFast( const TVector4<T>& v )
+{
+    T lenSq = lengthSquared( v );
+    SMATH_ASSERT( lenSq > 0, "Cannot normalize vector of length zero" );
 
-template<typename T> TVector3<T> rotateAroundY( const TVector3<T>& v, T angle );
-template<> TVector3<float> rotateAroundY( const TVector3<float>& v, float angle );
+    T s = Math::fast::rsqrt( lenSq );
+    return TVector4<T>( v.x() * s, v.y() * s, v.z() * s, v.w() * s );
+}
 
-template<typename T> TVector3<T> rotateAroundZ( const TVector3<T>& v, T angle );
-template<> TVector3<float> rotateAroundZ( const TVector3<float>& v, float angle );
+template<typename T>
+TVector3<T> normalizedFast( const TVector3<T>& v )
+{
+    T lenSq = lengthSquared( v );
+    SMATH_ASSERT( lenSq > 0, "Cannot normalize vector of length zero" );
 
-template<typename T> TVector3<T> rotateAround( const TVector3<T>& v,
-                                               const TVector3<T>& axis,
-                                               T angle );
+    T s = Math::fast::rsqrt( lenSq );
+    return TVector3<T>( v.x() * s, v.y() * s, v.z() * s );
+}
+
+template<typename T>
+TVector2<T> normalizedFast( const TVector2<T>& v )
+{
+    T lenSq = lengthSquared( v );
+    SMATH_ASSERT( lenSq > 0, "Cannot normalize vector of length zero" );
+
+    T s = Math::fast::rsqrt( lenSq );
+    return TVector2<T>( v.x() * s, v.y() * s );
+}
+
+/**
+ * Rotates a vector about the x, y or z axis, or an arbitrary axis, by an
+ * angle in degrees.
+ */
+template<typename T>
+TVector3<T> rotateAroundX( const TVector3<T>& v, T angle )
+{
+    if ( !Math::notZero( angle ) )
+    {
+        return v;
+    }
+
+    const T s = static_cast<T>( std::sin( angle * Math::Deg2RadD ) );
+    const T c = static_cast<T>( std::cos( angle * Math::Deg2RadD ) );
+
+    return TVector3<T>( v.mX, v.mY * c - v.mZ * s, v.mY * s + v.mZ * c );
+}
+
+template<typename T>
+TVector3<T> rotateAroundY( const TVector3<T>& v, T angle )
+{
+    if ( !Math::notZero( angle ) )
+    {
+        return v;
+    }
+
+    const T s = static_cast<T>( std::sin( angle * Math::Deg2RadD ) );
+    const T c = static_cast<T>( std::cos( angle * Math::Deg2RadD ) );
+
+    return TVector3<T>( v.mX * c + v.mZ * s, v.mY, -v.mX * s + v.mZ * c );
+}
+
+template<typename T>
+TVector3<T> rotateAroundZ( const TVector3<T>& v, T angle )
+{
+    if ( !Math::notZero( angle ) )
+    {
+        return v;
+    }
+
+    const T s = static_cast<T>( std::sin( angle * Math::Deg2RadD ) );
+    const T c = static_cast<T>( std::cos( angle * Math::Deg2RadD ) );
+
+    return TVector3<T>( v.mX * c - v.mY * s, v.mX * s + v.mY * c, v.mZ );
+}
+
+template<typename T>
+TVector3<T> rotateAround( const TVector3<T>& v, const TVector3<T>& axis, T angle )
+{
+    if ( !Math::notZero( angle ) )
+    {
+        return v;
+    }
+
+    const T s = static_cast<T>( std::sin( angle * Math::Deg2RadD ) );
+    const T c = static_cast<T>( std::cos( angle * Math::Deg2RadD ) );
+    const T t = 1 - c;      // "1 minus cos angle"
+
+    const TVector3<T> u = normalized( axis );
+    const TVector3<T> r1( u.mX * u.mX * t + c,
+                          u.mX * u.mY * t - s * u.mZ,
+                          u.mX * u.mZ * t + s * u.mY );
+    const TVector3<T> r2( u.mX * u.mY * t + s * u.mZ,
+                          u.mY * u.mY * t + c,
+                          u.mY * u.mZ * t - s * u.mX );
+    const TVector3<T> r3( u.mX * u.mZ * t - s * u.mY,
+                          u.mY * u.mZ * t + s * u.mX,
+                          u.mZ * u.mZ * t + c );
+
+    return TVector3<T>( dot( v, r1 ), dot( v, r2 ), dot( v, r3 ) );
+}
+
+template<> TVector3<float> rotateAroundX( const TVector3<float>& v, float angle );
+template<> TVector3<float> rotateAroundY( const TVector3<float>& v, float angle );
+template<> TVector3<float> rotateAroundZ( const TVector3<float>& v, float angle );
 template<> TVector3<float> rotateAround( const TVector3<float>& v,
                                          const TVector3<float>& axis,
                                          float angle );
@@ -1375,17 +1563,20 @@ std::ostream& operator << ( std::ostream& os, const TVector2<T>& v )
 // Vector typedefs - typedef common vector types
 /////////////////////////////////////////////////////////////////////////////
 #ifdef MATH_TYPEDEFS
-typedef TVector4<float> Vec4;
+typedef TVector4<scalar_t> Vec4;
 typedef TVector4<float> Vec4f;
 typedef TVector4<double> Vec4d;
+typedef TVector4<int> Vec4i;
 
-typedef TVector3<float> Vec3;
+typedef TVector3<scalar_t> Vec3;
 typedef TVector3<float> Vec3f;
 typedef TVector3<double> Vec3d;
+typedef TVector3<int> Vec3i;
 
-typedef TVector2<float> Vec2;
+typedef TVector2<scalar_t> Vec2;
 typedef TVector2<float> Vec2f;
 typedef TVector2<double> Vec2d;
+typedef TVector2<int> Vec2i;
 #endif
 
 #endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_WELD_H
+#define SCOTT_MATH_WELD_H
+
+#include <smath/config.h>
+#include <smath/constants.h>
+#include <smath/vector.h>
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace Math
+{
+    /**
+     * Welds (deduplicates) vertices that lie within epsilon of each other.
+     *
+     * Two vertices are close when every component differs by less than
+     * epsilon, the same test TVector3::operator== uses with
+     * Math::ZeroEpsilonF. Exact duplicates are always welded, so an epsilon
+     * of zero removes only exact duplicates.
+     *
+     * Each vertex is welded to the lowest indexed vertex that is close to it,
+     * and welds are followed transitively. The output contains one vertex for
+     * each group, at the position of the group's lowest indexed vertex, and
+     * in order of first appearance. The result is deterministic and does not
+     * depend on the thread count.
+     *
+     * Neighbours are found through a hash grid with cells 4 * epsilon wide,
+     * so each vertex only examines the (at most eight) cells that overlap its
+     * epsilon box. The grid is built and queried in parallel over chunks of
+     * the input. Only the final numbering pass is serial.
+     *
+     * \param  pVertices    Vertices to weld
+     * \param  count        Number of vertices
+     * \param  remap        Receives the output index of every input vertex
+     * \param  welded       Receives the deduplicated vertices
+     * \param  epsilon      Weld distance
+     * \param  threadCount  Worker threads to use, 0 for one per hardware thread
+     * \return              Number of vertices after welding
+     */
+    size_t weldVertices( const TVector3<float> * pVertices,
+                         size_t count,
+                         std::vector<uint32_t>& remap,
+                         std::vector< TVector3<float> >& welded,
+                         float epsilon = ZeroEpsilonF,
+                         unsigned int threadCount = 0 );
+
+    /**
+     * Welds the vertices of an indexed mesh in place. The vertex buffer is
+     * replaced with the deduplicated vertices and every index is remapped.
+     *
+     * \param  vertices     Vertex buffer to weld
+     * \param  indices      Index buffer referring to vertices
+     * \param  epsilon      Weld distance
+     * \param  threadCount  Worker threads to use, 0 for one per hardware thread
+     * \return              Number of vertices after welding
+     */
+    size_t weldMesh( std::vector< TVector3<float> >& vertices,
+                     std::vector<uint32_t>& indices,
+                     float epsilon = ZeroEpsilonF,
+                     unsigned int threadCount = 0 );
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SCOTT_MATH_WORLDPOSITION_H
+#define SCOTT_MATH_WORLDPOSITION_H
+
+//
+// Positions in worlds too large for float. A float has 24 significant bits,
+// which is about 6 cm at 1000 km from the origin; objects there jitter as
+// they move. Doubles are precise enough but halve the SIMD width of every
+// vector kernel, and GPUs want floats anyway.
+//
+// The usual fix is camera relative rendering: keep world positions in high
+// precision, and subtract the camera position before converting to float.
+// The result is precise near the camera, where precision is visible, and
+// only loses it with distance.
+//
+// WorldPosition stores a position as two floats per component, a high part
+// and the remainder that the high part could not represent (the
+// "double-single" or df64 representation). That is 48 significant bits,
+// about 4 nm at 1000 km, while rebasing stays in float lanes:
+//
+//   relative = ( high - origin.high ) + ( low - origin.low )
+//
+// The batch functions rebase whole arrays, either from high and low arrays,
+// which can also be uploaded as two vertex attributes and rebased on the
+// GPU, or from TVector3<double> arrays. Both read 24 bytes per position and
+// are usually limited by memory bandwidth rather than SIMD width.
+//
+#include <smath/config.h>
+#include <smath/matrix.h>
+#include <smath/vector.h>
+
+#include <cstddef>
+
+namespace Math
+{
+    /**
+     * World position as the sum of a float high part and a float low part.
+     */
+    class WorldPosition
+    {
+    public:
+        /**
+         * Leaves the position uninitialized, like a vector.
+         */
+        WorldPosition()
+        {
+        }
+
+        /**
+         * Splits a double position into its high and low parts.
+         */
+        explicit WorldPosition( const TVector3<double>& position );
+
+        /**
+         * Creates a position from parts split by Math::batch::split. The
+         * low part should be smaller than half a float ulp of the high part.
+         */
+        WorldPosition( const TVector3<float>& high, const TVector3<float>& low )
+            : mHigh( high ),
+              mLow( low )
+        {
+        }
+
+        /**
+         * Returns the high part, the position rounded to float.
+         */
+        const TVector3<float>& high() const
+        {
+            return mHigh;
+        }
+
+        /**
+         * Returns the low part, what the high part is off by.
+         */
+        const TVector3<float>& low() const
+        {
+            return mLow;
+        }
+
+        /**
+         * Returns the position in double precision.
+         */
+        TVector3<double> toDouble() const;
+
+        /**
+         * Returns the position relative to an origin, usually the camera,
+         * in float.
+         */
+        TVector3<float> relativeTo( const WorldPosition& origin ) const
+        {
+            return ( mHigh - origin.mHigh ) + ( mLow - origin.mLow );
+        }
+
+        /**
+         * Moves the position by a float offset, without losing the
+         * precision of the position. Objects can integrate float velocities
+         * every frame without drifting.
+         */
+        WorldPosition& operator += ( const TVector3<float>& offset );
+
+    private:
+        TVector3<float> mHigh;
+        TVector3<float> mLow;
+    };
+
+    /**
+     * Converts an object to world transform to a float transform relative
+     * to an origin, by subtracting the origin from its translation in
+     * double. Use with a camera relative view.
+     */
+    TMatrix4<float> rebase( const TMatrix4<double>& transform, const WorldPosition& origin );
+
+    /**
+     * Converts a view matrix to float without its translation, so that it
+     * transforms positions that are already relative to the camera.
+     */
+    TMatrix4<float> cameraRelativeView( const TMatrix4<double>& view );
+
+namespace batch
+{
+    /**
+     * Splits count double positions into high and low parts.
+     */
+    void split( const TVector3<double> * pIn,
+                TVector3<float> * pHigh,
+                TVector3<float> * pLow,
+                size_t count );
+
+    /**
+     * Computes count positions relative to an origin from their high and
+     * low parts, exactly like WorldPosition::relativeTo.
+     */
+    void rebase( const TVector3<float> * pHigh,
+                 const TVector3<float> * pLow,
+                 const WorldPosition& origin,
+                 TVector3<float> * pOut,
+                 size_t count );
+
+    /**
+     * Computes count double positions relative to an origin, rounded to
+     * float. Runs at double SIMD width but needs no split, which suits
+     * positions that change every frame.
+     */
+    void rebase( const TVector3<double> * pIn,
+                 const TVector3<double>& origin,
+                 TVector3<float> * pOut,
+                 size_t count );
+}
+}
+
+#endif
@@ -15,6 +15,7 @@
  */
 #include <smath/vector.h>
 #include <smath/util.h>
+#include <smath/fastmath.h>
 #include <cmath>
 
 template<>
@@ -39,7 +40,7 @@ template<>
 float angleBetween( const TVector3<float>& lhs,
                     const TVector3<float>& rhs )
 {
-    float a = acos( dot( lhs, rhs ) / ( length( lhs ) * length( rhs ) ) );
+    float a = Math::fast::acos( dot( lhs, rhs ) / ( length( lhs ) * length( rhs ) ) );
     return a * 180.0f / Math::Pi;
 }
 
@@ -102,8 +103,8 @@ TVector3<float> rotateAroundX( const TVector3<float>& v, float angle )
 {
     if ( Math::notZero( angle ) )
     {
-        float sangle = sin( Math::Pi * angle / 180.0f );
-        float cangle = cos( Math::Pi * angle / 180.0f );
+        float sangle, cangle;
+        Math::fast::sincos( Math::Pi * angle / 180.0f, sangle, cangle );
 
         return TVector3<float>( v.mX,
                                    v.mY * cangle - v.mZ * sangle,
@@ -120,8 +121,8 @@ TVector3<float> rotateAroundY( const TVector3<float>& v, float angle )
 {
     if ( Math::notZero( angle ) )
     {
-        float sangle = sin( Math::Pi * angle / 180.0f );
-        float cangle = cos( Math::Pi * angle / 180.0f );
+        float sangle, cangle;
+        Math::fast::sincos( Math::Pi * angle / 180.0f, sangle, cangle );
 
         return TVector3<float>( v.mX * cangle + v.mZ * sangle,
                                    v.mY,
@@ -138,11 +139,11 @@ TVector3<float> rotateAroundZ( const TVector3<float>& v, float angle )
 {
     if ( Math::notZero( angle ) )
     {
-        float sangle = sinf( Math::Pi * angle / 180.0f );
-        float cangle = cosf( Math::Pi * angle / 180.0f );
+        float sangle, cangle;
+        Math::fast::sincos( Math::Pi * angle / 180.0f, sangle, cangle );
 
         return TVector3<float>( v.mX * cangle - v.mY * sangle,
-                                   v.mY * sangle + v.mY * cangle,
+                                   v.mX * sangle + v.mY * cangle,
                                    v.mZ );
     }
     else
@@ -160,14 +161,14 @@ TVector3<float> rotateAround( const TVector3<float>& v,
 
     if ( Math::notZero( angle ) )
     {
-        float sangle = sin( Math::Pi * angle / 180.0f );
-        float cangle = cos( Math::Pi * angle / 180.0f );
+        float sangle, cangle;
+        Math::fast::sincos( Math::Pi * angle / 180.0f, sangle, cangle );
         float xangle = one - cangle;    // "1 minus cos angle"
 
         TVector3<float> u  = normalized( axis );
         TVector3<float> r1( u.mX * u.mX + cangle * ( one - u.mX * u.mX ),
                                u.mX * u.mY * xangle - sangle * u.mZ,
-                               u.mY * u.mZ * xangle + sangle * u.mY );
+                               u.mX * u.mZ * xangle + sangle * u.mY );
         TVector3<float> r2( u.mX * u.mY * xangle + sangle * u.mZ,
                                u.mY * u.mY + cangle * ( one - u.mY * u.mY ),
                                u.mY * u.mZ * xangle - sangle * u.mX );
@@ -0,0 +1,405 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/weld.h>
+#include <smath/hash.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    typedef TVector3<float> Vec3;
+
+    // Number of partitions used to split the grid build between threads
+    const unsigned int PartitionBits = 8;
+    const unsigned int PartitionCount = 1u << PartitionBits;
+
+    // Smallest number of vertices worth handing to a worker thread
+    const size_t MinVerticesPerThread = 16384;
+
+    /**
+     * Runs fn(task) for every task in [0, taskCount), one thread per task.
+     * The calling thread runs task zero.
+     */
+    template<typename Fn>
+    void parallelFor( unsigned int taskCount, Fn fn )
+    {
+        std::vector<std::thread> workers;
+
+        for ( unsigned int task = 1; task < taskCount; ++task )
+        {
+            workers.push_back( std::thread( fn, task ) );
+        }
+
+        fn( 0u );
+
+        for ( size_t i = 0; i < workers.size(); ++i )
+        {
+            workers[i].join();
+        }
+    }
+
+    /**
+     * Hash grid over the input vertices. Vertex indices are stored grouped
+     * by bucket, in ascending order within each bucket.
+     */
+    struct WeldGrid
+    {
+        float cellScale;        // 1 / cell width
+        float queryRadius;      // half width of the box searched per vertex
+        unsigned int bucketBits;
+        std::vector<uint32_t> bucketStart;
+        std::vector<uint32_t> entries;
+
+        /**
+         * Returns the cell coordinate of a position along one axis. Cells
+         * are offset by half their width so that points on round
+         * coordinates, which are common in meshes, sit in the middle of a
+         * cell rather than on a boundary.
+         */
+        float cellOf( float x ) const
+        {
+            return std::floor( x * cellScale + 0.5f );
+        }
+
+        uint32_t bucketOf( float cx, float cy, float cz ) const
+        {
+            uint64_t h = Math::hash( Vec3( cx, cy, cz ) );
+            return static_cast<uint32_t>( h >> ( 64 - bucketBits ) );
+        }
+
+        uint32_t bucketOf( const Vec3& p ) const
+        {
+            return bucketOf( cellOf( p.x() ), cellOf( p.y() ), cellOf( p.z() ) );
+        }
+    };
+
+    bool isClose( float a, float b, float epsilon )
+    {
+        return ( a == b || std::fabs( a - b ) < epsilon );
+    }
+
+    bool isClose( const Vec3& a, const Vec3& b, float epsilon )
+    {
+        return isClose( a.x(), b.x(), epsilon ) &&
+               isClose( a.y(), b.y(), epsilon ) &&
+               isClose( a.z(), b.z(), epsilon );
+    }
+
+    /**
+     * Returns the lowest index in a bucket that is close to p and lower
+     * than best, or best if there is none.
+     */
+    uint32_t findInBucket( const WeldGrid& grid,
+                           const Vec3 * pVertices,
+                           uint32_t bucket,
+                           const Vec3& p,
+                           float epsilon,
+                           uint32_t best )
+    {
+        for ( uint32_t e = grid.bucketStart[bucket]; e < grid.bucketStart[bucket + 1]; ++e )
+        {
+            uint32_t j = grid.entries[e];
+
+            if ( j >= best )
+            {
+                break;
+            }
+            else if ( isClose( pVertices[j], p, epsilon ) )
+            {
+                return j;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * Returns the lowest index of a vertex close to vertex i, which may be i
+     * itself. Only the cells overlapping the query box around the vertex are
+     * examined, at most two per axis.
+     */
+    uint32_t findLowestNeighbour( const WeldGrid& grid,
+                                  const Vec3 * pVertices,
+                                  uint32_t i,
+                                  float epsilon )
+    {
+        const Vec3& p = pVertices[i];
+        const float r = grid.queryRadius;
+
+        float lo[3], hi[3];
+
+        for ( int a = 0; a < 3; ++a )
+        {
+            lo[a] = grid.cellOf( p[a] - r );
+            hi[a] = grid.cellOf( p[a] + r );
+        }
+
+        uint32_t best = i;
+
+        // Walk the cells by index rather than by incrementing the float cell
+        // coordinate, which stops changing beyond 2^24
+        int nx = ( hi[0] > lo[0] ? 2 : 1 );
+        int ny = ( hi[1] > lo[1] ? 2 : 1 );
+        int nz = ( hi[2] > lo[2] ? 2 : 1 );
+
+        for ( int x = 0; x < nx; ++x )
+        {
+            for ( int y = 0; y < ny; ++y )
+            {
+                for ( int z = 0; z < nz; ++z )
+                {
+                    uint32_t bucket = grid.bucketOf( ( x ? hi[0] : lo[0] ),
+                                                     ( y ? hi[1] : lo[1] ),
+                                                     ( z ? hi[2] : lo[2] ) );
+
+                    best = findInBucket( grid, pVertices, bucket, p, epsilon, best );
+                }
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * Builds the hash grid in three parallel passes: bucket every vertex and
+     * count partition sizes per chunk, scatter vertices into partitions in
+     * index order, and finally counting sort each partition by bucket.
+     */
+    void buildGrid( WeldGrid& grid,
+                    const Vec3 * pVertices,
+                    size_t count,
+                    unsigned int chunkCount )
+    {
+        const size_t bucketCount = size_t( 1 ) << grid.bucketBits;
+        const unsigned int partitionShift = grid.bucketBits - PartitionBits;
+
+        std::vector<uint32_t> buckets( count );
+        std::vector<uint32_t> partitioned( count );
+        std::vector<uint32_t> offsets( chunkCount * PartitionCount, 0 );
+
+        grid.bucketStart.assign( bucketCount + 1, 0 );
+        grid.entries.resize( count );
+
+        // Bucket every vertex and count how many land in each partition
+        parallelFor( chunkCount, [&]( unsigned int chunk )
+        {
+            size_t begin = count * chunk / chunkCount;
+            size_t end   = count * ( chunk + 1 ) / chunkCount;
+            uint32_t * pCounts = &offsets[chunk * PartitionCount];
+
+            for ( size_t i = begin; i < end; ++i )
+            {
+                buckets[i] = grid.bucketOf( pVertices[i] );
+                pCounts[ buckets[i] >> partitionShift ]++;
+            }
+        } );
+
+        // Turn the counts into the first output slot of each (chunk,
+        // partition) pair. Chunks are laid out in order within a partition
+        // so that indices remain sorted.
+        std::vector<uint32_t> partitionStart( PartitionCount + 1, 0 );
+        uint32_t total = 0;
+
+        for ( unsigned int p = 0; p < PartitionCount; ++p )
+        {
+            partitionStart[p] = total;
+
+            for ( unsigned int c = 0; c < chunkCount; ++c )
+            {
+                uint32_t n = offsets[c * PartitionCount + p];
+                offsets[c * PartitionCount + p] = total;
+                total += n;
+            }
+        }
+
+        partitionStart[PartitionCount] = total;
+
+        // Scatter vertex indices into their partitions
+        parallelFor( chunkCount, [&]( unsigned int chunk )
+        {
+            size_t begin = count * chunk / chunkCount;
+            size_t end   = count * ( chunk + 1 ) / chunkCount;
+            uint32_t * pOffsets = &offsets[chunk * PartitionCount];
+
+            for ( size_t i = begin; i < end; ++i )
+            {
+                partitioned[ pOffsets[ buckets[i] >> partitionShift ]++ ] =
+                    static_cast<uint32_t>( i );
+            }
+        } );
+
+        // Counting sort each partition by bucket. Partitions own disjoint
+        // bucket ranges, so they can be sorted independently.
+        parallelFor( chunkCount, [&]( unsigned int chunk )
+        {
+            const size_t bucketsPerPartition = bucketCount / PartitionCount;
+
+            for ( unsigned int p = chunk; p < PartitionCount; p += chunkCount )
+            {
+                size_t firstBucket = p * bucketsPerPartition;
+                uint32_t * pStart  = &grid.bucketStart[firstBucket];
+
+                for ( uint32_t e = partitionStart[p]; e < partitionStart[p + 1]; ++e )
+                {
+                    pStart[ buckets[ partitioned[e] ] - firstBucket ]++;
+                }
+
+                uint32_t offset = partitionStart[p];
+
+                for ( size_t b = 0; b < bucketsPerPartition; ++b )
+                {
+                    uint32_t n = pStart[b];
+                    pStart[b]  = offset;
+                    offset    += n;
+                }
+
+                for ( uint32_t e = partitionStart[p]; e < partitionStart[p + 1]; ++e )
+                {
+                    uint32_t i = partitioned[e];
+                    grid.entries[ pStart[ buckets[i] - firstBucket ]++ ] = i;
+                }
+
+                // Writing advanced every start to the start of the next
+                // bucket, shift them back
+                for ( size_t b = bucketsPerPartition; b > 0; --b )
+                {
+                    pStart[b - 1] = ( b > 1 ? pStart[b - 2] : partitionStart[p] );
+                }
+            }
+        } );
+
+        grid.bucketStart[bucketCount] = static_cast<uint32_t>( count );
+    }
+}
+
+size_t Math::weldVertices( const TVector3<float> * pVertices,
+                           size_t count,
+                           std::vector<uint32_t>& remap,
+                           std::vector< TVector3<float> >& welded,
+                           float epsilon,
+                           unsigned int threadCount )
+{
+    SMATH_ASSERT( count < 0xffffffffu, "Too many vertices to weld" );
+    SMATH_ASSERT( epsilon >= 0.0f, "Weld epsilon cannot be negative" );
+
+    remap.resize( count );
+    welded.clear();
+
+    if ( count == 0 )
+    {
+        return 0;
+    }
+
+    // Pick the number of chunks to split the work into
+    if ( threadCount == 0 )
+    {
+        threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+    }
+
+    size_t maxChunks = std::max( size_t( 1 ), count / MinVerticesPerThread );
+    unsigned int chunkCount =
+        static_cast<unsigned int>( std::min( size_t( threadCount ), maxChunks ) );
+
+    // Cells are four times the weld distance wide, so the box searched
+    // around a vertex overlaps at most two cells per axis and usually just
+    // one. An epsilon of zero only welds exact duplicates, which always share
+    // a cell.
+    WeldGrid grid;
+
+    if ( epsilon > 0.0f )
+    {
+        grid.cellScale   = 0.25f / epsilon;
+        grid.queryRadius = epsilon * 1.0625f;   // slack for rounding of p +/- r
+    }
+    else
+    {
+        grid.cellScale   = 1.0f;
+        grid.queryRadius = 0.0f;
+    }
+
+    grid.bucketBits = PartitionBits;
+
+    while ( ( size_t( 1 ) << grid.bucketBits ) < count && grid.bucketBits < 31 )
+    {
+        grid.bucketBits++;
+    }
+
+    buildGrid( grid, pVertices, count, chunkCount );
+
+    // Find the lowest indexed neighbour of every vertex
+    std::vector<uint32_t> lowest( count );
+
+    parallelFor( chunkCount, [&]( unsigned int chunk )
+    {
+        size_t begin = count * chunk / chunkCount;
+        size_t end   = count * ( chunk + 1 ) / chunkCount;
+
+        for ( size_t i = begin; i < end; ++i )
+        {
+            lowest[i] = findLowestNeighbour( grid,
+                                             pVertices,
+                                             static_cast<uint32_t>( i ),
+                                             epsilon );
+        }
+    } );
+
+    // Number the groups in order of first appearance. A vertex's lowest
+    // neighbour always precedes it, so its output index is already known.
+    for ( size_t i = 0; i < count; ++i )
+    {
+        if ( lowest[i] == i )
+        {
+            remap[i] = static_cast<uint32_t>( welded.size() );
+            welded.push_back( pVertices[i] );
+        }
+        else
+        {
+            remap[i] = remap[ lowest[i] ];
+        }
+    }
+
+    return welded.size();
+}
+
+size_t Math::weldMesh( std::vector< TVector3<float> >& vertices,
+                       std::vector<uint32_t>& indices,
+                       float epsilon,
+                       unsigned int threadCount )
+{
+    std::vector<uint32_t> remap;
+    std::vector< TVector3<float> > welded;
+
+    if (! vertices.empty() )
+    {
+        weldVertices( &vertices[0],
+                      vertices.size(),
+                      remap,
+                      welded,
+                      epsilon,
+                      threadCount );
+    }
+
+    for ( size_t i = 0; i < indices.size(); ++i )
+    {
+        SMATH_ASSERT( indices[i] < remap.size(), "Index out of range" );
+        indices[i] = remap[ indices[i] ];
+    }
+
+    vertices.swap( welded );
+    return vertices.size();
+}
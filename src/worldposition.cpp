@@ -0,0 +1,170 @@
+/*
+ * Copyright 2010-2014 Scott MacDonald
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <smath/worldposition.h>
+#include "dispatch.h"
+
+// The kernels treat positions as packed float and double arrays
+static_assert( sizeof( TVector3<float> ) == 3 * sizeof( float ),
+               "TVector3<float> must be three packed floats" );
+static_assert( sizeof( TVector3<double> ) == 3 * sizeof( double ),
+               "TVector3<double> must be three packed doubles" );
+
+using namespace Math::detail;
+
+namespace
+{
+    const float * floats( const TVector3<float> * p )
+    {
+        return reinterpret_cast<const float *>( p );
+    }
+
+    float * floats( TVector3<float> * p )
+    {
+        return reinterpret_cast<float *>( p );
+    }
+
+    const double * doubles( const TVector3<double> * p )
+    {
+        return reinterpret_cast<const double *>( p );
+    }
+
+    /**
+     * Splits a double into the nearest float and the float remainder. The
+     * high part is read back from a volatile float: at -O2 and above, GCC 12
+     * vectorizes the three components of the constructor together and loses
+     * the remainder of y and z. One component at a time through memory is
+     * what the batch kernels compute.
+     */
+    void splitDouble( double value, float& high, float& low )
+    {
+        volatile float rounded = static_cast<float>( value );
+
+        high = rounded;
+        low  = static_cast<float>( value - static_cast<double>( high ) );
+    }
+
+    /**
+     * Adds a float to a high and low pair. The two-sum gives the rounding
+     * error of high + offset exactly, which is added to the low part before
+     * the pair is renormalized.
+     */
+    void addSplit( float& high, float& low, float offset )
+    {
+        const float sum = high + offset;
+        const float rounded = sum - high;
+        const float error = ( high - ( sum - rounded ) ) + ( offset - rounded );
+        const float rest = low + error;
+
+        high = sum + rest;
+        low  = rest - ( high - sum );
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// World positions
+/////////////////////////////////////////////////////////////////////////////
+Math::WorldPosition::WorldPosition( const TVector3<double>& position )
+{
+    splitDouble( position[0], mHigh[0], mLow[0] );
+    splitDouble( position[1], mHigh[1], mLow[1] );
+    splitDouble( position[2], mHigh[2], mLow[2] );
+}
+
+TVector3<double> Math::WorldPosition::toDouble() const
+{
+    return TVector3<double>( static_cast<double>( mHigh[0] ) + mLow[0],
+                             static_cast<double>( mHigh[1] ) + mLow[1],
+                             static_cast<double>( mHigh[2] ) + mLow[2] );
+}
+
+Math::WorldPosition& Math::WorldPosition::operator += ( const TVector3<float>& offset )
+{
+    for ( int i = 0; i < 3; ++i )
+    {
+        addSplit( mHigh[i], mLow[i], offset[i] );
+    }
+
+    return *this;
+}
+
+TMatrix4<float> Math::rebase( const TMatrix4<double>& transform, const WorldPosition& origin )
+{
+    const TVector3<double> o = origin.toDouble();
+    TMatrix4<float> result;
+
+    for ( unsigned int r = 0; r < 4; ++r )
+    {
+        for ( unsigned int c = 0; c < 4; ++c )
+        {
+            result.set( r, c, static_cast<float>( transform.at( r, c ) ) );
+        }
+    }
+
+    for ( unsigned int r = 0; r < 3; ++r )
+    {
+        result.set( r, 3, static_cast<float>( transform.at( r, 3 ) - o[r] ) );
+    }
+
+    return result;
+}
+
+TMatrix4<float> Math::cameraRelativeView( const TMatrix4<double>& view )
+{
+    TMatrix4<float> result;
+
+    for ( unsigned int r = 0; r < 4; ++r )
+    {
+        for ( unsigned int c = 0; c < 4; ++c )
+        {
+            result.set( r, c, c == 3 && r < 3 ? 0.0f : static_cast<float>( view.at( r, c ) ) );
+        }
+    }
+
+    return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Batch entry points
+/////////////////////////////////////////////////////////////////////////////
+void Math::batch::split( const TVector3<double> * pIn,
+                         TVector3<float> * pHigh,
+                         TVector3<float> * pLow,
+                         size_t count )
+{
+    activeBatchKernels().splitDouble( doubles( pIn ), floats( pHigh ), floats( pLow ), count );
+}
+
+void Math::batch::rebase( const TVector3<float> * pHigh,
+                          const TVector3<float> * pLow,
+                          const WorldPosition& origin,
+                          TVector3<float> * pOut,
+                          size_t count )
+{
+    const float o[6] = { origin.high()[0], origin.high()[1], origin.high()[2],
+                         origin.low()[0],  origin.low()[1],  origin.low()[2] };
+
+    activeBatchKernels().rebase( floats( pHigh ), floats( pLow ), o, floats( pOut ), count );
+}
+
+void Math::batch::rebase( const TVector3<double> * pIn,
+                          const TVector3<double>& origin,
+                          TVector3<float> * pOut,
+                          size_t count )
+{
+    const double o[3] = { origin[0], origin[1], origin[2] };
+
+    activeBatchKernels().rebaseDouble( doubles( pIn ), o, floats( pOut ), count );
+}
@@ -4,6 +4,9 @@
 #include <gtest/gtest.h>
 #include <smath/angle.h>
 
+#include <cmath>
+#include <limits>
+
 using namespace Math;
 
 TEST(Math, Angle_Degrees_Default_Constructor)
@@ -16,3 +19,40 @@ TEST(Math, Angle_Degrees_Init)
 {
     Degrees<float> a( 48.0f );
 }
+
+TEST(Math, Angle_ConstantExpressions)
+{
+    constexpr Degrees<float> a( 450.0f );
+    constexpr Degrees<float> b( -90.0f );
+    constexpr Radians<float> c( a );
+
+    static_assert( a.as<float>() == 90.0f, "degrees must wrap in constant expressions" );
+    static_assert( b.as<float>() == 270.0f, "negative degrees must wrap to positive" );
+    static_assert( c.as<float>() > 1.5707f && c.as<float>() < 1.5709f, "" );
+
+    EXPECT_FLOAT_EQ( HalfPi, c.as<float>() );
+    EXPECT_FLOAT_EQ( 0.5f, Radians<float>( TwoPi + 0.5f ).as<float>() );
+}
+
+TEST(Math, Angle_WrapsLargeAndNonFinite)
+{
+    // Past the integer truncation range the angle is wrapped with fmod
+    const double huge = 1.0e20;
+    EXPECT_DOUBLE_EQ( std::fmod( huge, 360.0 ), Degrees<double>( huge ).as<double>() );
+    EXPECT_DOUBLE_EQ( 360.0 - std::fmod( huge, 360.0 ), Degrees<double>( -huge ).as<double>() );
+    EXPECT_FLOAT_EQ( std::fmod( 3.0e9f, 360.0f ), Degrees<float>( 3.0e9f ).as<float>() );
+
+    const float turns = 123456.0f;
+    const float r = Radians<float>( turns * TwoPi + 1.0f ).as<float>();
+    EXPECT_GE( r, 0.0f );
+    EXPECT_LT( r, TwoPi );
+
+    EXPECT_TRUE( std::isnan( Degrees<float>( std::numeric_limits<float>::quiet_NaN() ).as<float>() ) );
+    EXPECT_TRUE( std::isnan( Degrees<float>( std::numeric_limits<float>::infinity() ).as<float>() ) );
+    EXPECT_TRUE( std::isnan( Radians<double>( -std::numeric_limits<double>::infinity() ).as<double>() ) );
+
+    // Quotients that round up to the next turn still land in [0,360)
+    const float below = std::nextafter( 720.0f, 0.0f );
+    EXPECT_GE( Degrees<float>( below ).as<float>(), 0.0f );
+    EXPECT_LT( Degrees<float>( below ).as<float>(), 360.0f );
+}
@@ -0,0 +1,417 @@
+/**
+ * Unit tests for the runtime dispatched batch kernels
+ */
+#include <gtest/gtest.h>
+#include <smath/batch.h>
+#include <smath/cpu.h>
+#include <smath/matrixutils.h>
+#include <smath/shapesampling.h>
+#include "unittesthelpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector3<float> Vec3f;
+typedef TVector4<float> Vec4f;
+typedef TMatrix4<float> Mat4f;
+#endif
+
+namespace
+{
+    float nextValue( unsigned int& state )
+    {
+        return nextTestFloat( state ) * 10.0f;
+    }
+
+    std::vector<Vec3f> makeVec3s( unsigned int seed )
+    {
+        std::vector<Vec3f> v;
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            float x = nextValue( seed );
+            float y = nextValue( seed );
+            float z = nextValue( seed );
+            v.push_back( Vec3f( x, y, z ) );
+        }
+
+        return v;
+    }
+
+    Mat4f makeMatrix()
+    {
+        return Mat4f(  0.5f, -1.25f, 2.0f,  3.0f,
+                      1.5f,  0.75f, -0.5f, -4.0f,
+                     -2.0f,  0.25f, 1.0f,  5.0f,
+                      0.1f,  0.2f,  0.3f,  1.0f );
+    }
+
+    std::vector< TVector3<double> > makeVec3ds( unsigned int seed )
+    {
+        std::vector< TVector3<double> > v;
+
+        // Doubles with more significant bits than a float can hold
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            double x = nextValue( seed ) + nextValue( seed ) * 1.0e-9;
+            double y = nextValue( seed ) + nextValue( seed ) * 1.0e-9;
+            double z = nextValue( seed ) + nextValue( seed ) * 1.0e-9;
+            v.push_back( TVector3<double>( x, y, z ) );
+        }
+
+        return v;
+    }
+
+    std::vector< TVector3<int> > makeVec3is( unsigned int seed )
+    {
+        std::vector< TVector3<int> > v;
+
+        // Small enough that the scalar products cannot overflow
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            int x = static_cast<int>( nextValue( seed ) * 100.0f );
+            int y = static_cast<int>( nextValue( seed ) * 100.0f );
+            int z = static_cast<int>( nextValue( seed ) * 100.0f );
+            v.push_back( TVector3<int>( x, y, z ) );
+        }
+
+        return v;
+    }
+
+    void expectNear( const Vec3f& expected, const Vec3f& actual, float tolerance )
+    {
+        EXPECT_NEAR( expected[0], actual[0], tolerance );
+        EXPECT_NEAR( expected[1], actual[1], tolerance );
+        EXPECT_NEAR( expected[2], actual[2], tolerance );
+    }
+
+    /**
+     * Runs every kernel at the active level and checks it against a plain
+     * scalar implementation.
+     */
+    void checkKernels()
+    {
+        const Mat4f m = makeMatrix();
+        const float * pM = m.ptr();
+        std::vector<Vec3f> a = makeVec3s( 1 );
+        std::vector<Vec3f> b = makeVec3s( 2 );
+        std::vector<Vec3f> out( LevelTestCount );
+        std::vector<float> scalars( LevelTestCount );
+
+        Math::batch::transformPoints( m, &a[0], &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            Vec3f expected( pM[0] * a[i][0] + pM[1] * a[i][1] + pM[2]  * a[i][2] + pM[3],
+                           pM[4] * a[i][0] + pM[5] * a[i][1] + pM[6]  * a[i][2] + pM[7],
+                           pM[8] * a[i][0] + pM[9] * a[i][1] + pM[10] * a[i][2] + pM[11] );
+            expectNear( expected, out[i], 1e-4f );
+        }
+
+        Math::batch::transformDirections( m, &a[0], &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            Vec3f expected( pM[0] * a[i][0] + pM[1] * a[i][1] + pM[2]  * a[i][2],
+                           pM[4] * a[i][0] + pM[5] * a[i][1] + pM[6]  * a[i][2],
+                           pM[8] * a[i][0] + pM[9] * a[i][1] + pM[10] * a[i][2] );
+            expectNear( expected, out[i], 1e-4f );
+        }
+
+        std::vector<Vec4f> v4( LevelTestCount ), out4( LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            v4[i] = Vec4f( a[i][0], a[i][1], a[i][2], b[i][0] );
+        }
+
+        Math::batch::transform( m, &v4[0], &out4[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            for ( int r = 0; r < 4; ++r )
+            {
+                float expected = pM[4 * r]     * v4[i][0] + pM[4 * r + 1] * v4[i][1] +
+                                 pM[4 * r + 2] * v4[i][2] + pM[4 * r + 3] * v4[i][3];
+                EXPECT_NEAR( expected, out4[i][r], 1e-4f );
+            }
+        }
+
+        Math::batch::dot( &a[0], &b[0], &scalars[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_NEAR( dot( a[i], b[i] ), scalars[i], 1e-4f );
+        }
+
+        Math::batch::cross( &a[0], &b[0], &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            expectNear( cross( a[i], b[i] ), out[i], 1e-4f );
+        }
+
+        Math::batch::length( &a[0], &scalars[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_NEAR( length( a[i] ), scalars[i], 1e-5f );
+        }
+
+        Math::batch::normalize( &a[0], &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            expectNear( normalized( a[i] ), out[i], 1e-6f );
+        }
+
+        Math::batch::scaleAdd( &a[0], &b[0], 0.5f, &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            expectNear( a[i] + b[i] * 0.5f, out[i], 1e-5f );
+        }
+
+        std::vector<float> xs( LevelTestCount ), ys( LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            xs[i] = 0.25f + static_cast<float>( i );
+        }
+
+        Math::batch::sin( &ys[0], &xs[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_NEAR( std::sin( xs[i] ), ys[i], 1e-3f );
+        }
+
+        Math::batch::log( &ys[0], &xs[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_NEAR( std::log( xs[i] ), ys[i], 1e-3f );
+        }
+
+        Math::batch::sqrt( &ys[0], &xs[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_NEAR( std::sqrt( xs[i] ), ys[i], 1e-3f );
+        }
+
+        std::vector<uint32_t> bits( LevelTestCount );
+        unsigned int state = 7;
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            state = state * 1664525u + 1013904223u;
+            bits[i] = state;
+        }
+
+        bits[0] = 0u;
+        bits[1] = 0xffffffffu;
+
+        Math::batch::unitFloats( &bits[0], &xs[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_EQ( static_cast<float>( bits[i] >> 8 ) / 16777216.0f, xs[i] );
+        }
+
+        std::vector<float> zs( LevelTestCount ), us( xs );
+        std::reverse( us.begin(), us.end() );
+
+        Math::batch::mapToSphere( &xs[0], &us[0], &scalars[0], &ys[0], &zs[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            expectNear( Math::mapToSphere( xs[i], us[i] ), Vec3f( scalars[i], ys[i], zs[i] ), 1e-5f );
+        }
+
+        Math::batch::mapToDisk( &xs[0], &us[0], &scalars[0], &ys[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            const TVector2<float> expected = Math::mapToDisk( xs[i], us[i] );
+
+            EXPECT_NEAR( expected[0], scalars[i], 1e-5f );
+            EXPECT_NEAR( expected[1], ys[i], 1e-5f );
+        }
+    }
+
+    /**
+     * Runs the double precision kernels at the active level and checks them
+     * against the scalar double vector functions.
+     */
+    void checkDoubleKernels()
+    {
+        std::vector< TVector3<double> > a = makeVec3ds( 4 );
+        std::vector< TVector3<double> > b = makeVec3ds( 5 );
+        std::vector< TVector3<double> > out( LevelTestCount );
+        std::vector<double> scalars( LevelTestCount );
+
+        Math::batch::dot( &a[0], &b[0], &scalars[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_NEAR( dot( a[i], b[i] ), scalars[i], 1e-13 );
+        }
+
+        Math::batch::cross( &a[0], &b[0], &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            for ( int c = 0; c < 3; ++c )
+            {
+                EXPECT_NEAR( cross( a[i], b[i] )[c], out[i][c], 1e-13 );
+            }
+        }
+
+        Math::batch::length( &a[0], &scalars[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_NEAR( length( a[i] ), scalars[i], 1e-14 );
+        }
+
+        Math::batch::normalize( &a[0], &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            for ( int c = 0; c < 3; ++c )
+            {
+                EXPECT_NEAR( normalized( a[i] )[c], out[i][c], 1e-15 );
+            }
+        }
+
+        Math::batch::scaleAdd( &a[0], &b[0], 0.5, &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            for ( int c = 0; c < 3; ++c )
+            {
+                EXPECT_NEAR( a[i][c] + b[i][c] * 0.5, out[i][c], 1e-14 );
+            }
+        }
+    }
+
+    /**
+     * Runs the integer kernels at the active level and checks them against
+     * the scalar int vector functions, which they must match exactly.
+     */
+    void checkIntKernels()
+    {
+        std::vector< TVector3<int> > a = makeVec3is( 6 );
+        std::vector< TVector3<int> > b = makeVec3is( 7 );
+        std::vector< TVector3<int> > out( LevelTestCount );
+        std::vector<int> scalars( LevelTestCount );
+
+        Math::batch::dot( &a[0], &b[0], &scalars[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_EQ( dot( a[i], b[i] ), scalars[i] );
+        }
+
+        Math::batch::cross( &a[0], &b[0], &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_EQ( cross( a[i], b[i] ), out[i] );
+        }
+
+        Math::batch::scaleAdd( &a[0], &b[0], -3, &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_EQ( a[i] + b[i] * -3, out[i] );
+        }
+
+        // Products wrap instead of saturating, 2^16 * 2^16 is 0 mod 2^32
+        std::vector< TVector3<int> > big( LevelTestCount, TVector3<int>( 65536, 3, 0 ) );
+        Math::batch::dot( &big[0], &big[0], &scalars[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            EXPECT_EQ( 9, scalars[i] );
+        }
+    }
+}
+
+TEST(Math,Batch_InstructionSetNames)
+{
+    Math::InstructionSet isa = Math::ISA_SCALAR;
+
+    for ( int level = Math::ISA_SCALAR; level <= Math::ISA_AVX512; ++level )
+    {
+        const char * pName = Math::instructionSetName( static_cast<Math::InstructionSet>( level ) );
+
+        EXPECT_TRUE( Math::parseInstructionSet( pName, isa ) );
+        EXPECT_EQ( level, isa );
+    }
+
+    EXPECT_TRUE( Math::parseInstructionSet( "SSE41", isa ) );
+    EXPECT_EQ( Math::ISA_SSE41, isa );
+
+    EXPECT_TRUE( Math::parseInstructionSet( "AVX2", isa ) );
+    EXPECT_EQ( Math::ISA_AVX2, isa );
+
+    EXPECT_FALSE( Math::parseInstructionSet( "neon", isa ) );
+    EXPECT_FALSE( Math::parseInstructionSet( "", isa ) );
+    EXPECT_FALSE( Math::parseInstructionSet( NULL, isa ) );
+}
+
+TEST(Math,Batch_SetInstructionSetClamps)
+{
+    Math::InstructionSet best = Math::detectInstructionSet();
+
+    if ( Math::compiledInstructionSet() < best )
+    {
+        best = Math::compiledInstructionSet();
+    }
+
+    EXPECT_EQ( Math::ISA_SCALAR, Math::setInstructionSet( Math::ISA_SCALAR ) );
+    EXPECT_EQ( Math::ISA_SCALAR, Math::activeInstructionSet() );
+
+    EXPECT_GE( best, Math::setInstructionSet( Math::ISA_AVX512 ) );
+    EXPECT_EQ( Math::activeInstructionSet(), Math::setInstructionSet( Math::ISA_AVX512 ) );
+
+    Math::resetInstructionSet();
+    EXPECT_GE( best, Math::activeInstructionSet() );
+}
+
+TEST(Math,Batch_EveryLevelMatchesReference)
+{
+    forEachInstructionSet( [&]()
+    {
+        checkKernels();
+        checkDoubleKernels();
+        checkIntKernels();
+    } );
+}
+
+TEST(Math,Batch_InPlaceAndEmpty)
+{
+    const Mat4f m = Math::createTranslation( 1.0f, 2.0f, 3.0f );
+    std::vector<Vec3f> a = makeVec3s( 3 );
+    std::vector<Vec3f> expected = a;
+
+    for ( size_t i = 0; i < LevelTestCount; ++i )
+    {
+        expected[i] += Vec3f( 1.0f, 2.0f, 3.0f );
+    }
+
+    Math::batch::transformPoints( m, &a[0], &a[0], LevelTestCount );
+
+    for ( size_t i = 0; i < LevelTestCount; ++i )
+    {
+        expectNear( expected[i], a[i], 1e-5f );
+    }
+
+    Math::batch::transformPoints( m, NULL, NULL, 0 );
+    Math::batch::sin( NULL, NULL, 0 );
+}
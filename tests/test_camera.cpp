@@ -0,0 +1,122 @@
+/**
+ * Unit tests for the camera matrix cache
+ * (template type=float)
+ */
+#include <gtest/gtest.h>
+#include <smath/camera.h>
+
+#include "unittesthelpers.h"
+
+#ifndef MATH_TYPEDEFS
+typedef TCamera<float> Camera;
+typedef TMatrix4<float> Mat4f;
+typedef TVector3<float> Vec3f;
+#endif
+
+TEST(Math,Camera_DefaultView)
+{
+    Camera c;
+    EXPECT_TRUE( MatrixEquals( Mat4f::IDENTITY, c.view() ) );
+    EXPECT_TRUE( MatrixEquals( Mat4f::IDENTITY, c.inverseView() ) );
+}
+
+TEST(Math,Camera_ViewMatchesLookAt)
+{
+    Camera c;
+    c.setView( Vec3f( 1.0f, 2.0f, 3.0f ),
+               Vec3f( -4.0f, 0.0f, 1.0f ),
+               Vec3f( 0.0f, 1.0f, 0.0f ) );
+
+    EXPECT_EQ( Math::createLookAt( Vec3f( 1.0f, 2.0f, 3.0f ),
+                                   Vec3f( -4.0f, 0.0f, 1.0f ),
+                                   Vec3f( 0.0f, 1.0f, 0.0f ) ),
+               c.view() );
+}
+
+TEST(Math,Camera_ProjectionMatchesPerspective)
+{
+    Camera c;
+    c.setPerspective( 1.0f, 1.5f, 0.5f, 200.0f );
+
+    EXPECT_EQ( Math::createPerspective( 1.0f, 1.5f, 0.5f, 200.0f ),
+               c.projection() );
+
+    c.setReversedZ( true );
+
+    EXPECT_EQ( Math::createPerspectiveReversedZ( 1.0f, 1.5f, 0.5f, 200.0f ),
+               c.projection() );
+
+    c.setInfinitePerspective( 1.0f, 1.5f, 0.5f );
+
+    EXPECT_EQ( Math::createInfinitePerspectiveReversedZ( 1.0f, 1.5f, 0.5f ),
+               c.projection() );
+}
+
+TEST(Math,Camera_ProjectionMatchesOrtho)
+{
+    Camera c;
+    c.setOrtho( 0.0f, 640.0f, 480.0f, 0.0f, 1.0f, 100.0f );
+
+    EXPECT_EQ( Camera::ORTHOGRAPHIC, c.projectionType() );
+    EXPECT_EQ( Math::createOrtho( 0.0f, 640.0f, 480.0f, 0.0f, 1.0f, 100.0f ),
+               c.projection() );
+}
+
+TEST(Math,Camera_ViewProjection)
+{
+    Camera c;
+    c.setView( Vec3f( 1.0f, 2.0f, 3.0f ),
+               Vec3f( 0.0f, 0.0f, 0.0f ),
+               Vec3f( 0.0f, 1.0f, 0.0f ) );
+    c.setPerspective( 1.0f, 1.5f, 0.5f, 200.0f );
+
+    EXPECT_TRUE( MatrixEquals( c.projection() * c.view(), c.viewProjection() ) );
+}
+
+TEST(Math,Camera_InverseMatrices)
+{
+    Camera c;
+    c.setView( Vec3f( 1.0f, 2.0f, 3.0f ),
+               Vec3f( 0.0f, 0.0f, 0.0f ),
+               Vec3f( 0.0f, 1.0f, 0.0f ) );
+    c.setPerspective( 1.0f, 1.5f, 0.5f, 200.0f );
+
+    EXPECT_TRUE( MatrixEquals( Mat4f::IDENTITY, c.view() * c.inverseView() ) );
+    EXPECT_TRUE( MatrixEquals( Mat4f::IDENTITY, c.projection() * c.inverseProjection() ) );
+    EXPECT_TRUE( MatrixEquals( Mat4f::IDENTITY, c.viewProjection() * c.inverseViewProjection() ) );
+}
+
+TEST(Math,Camera_CachedMatrixIsStable)
+{
+    Camera c;
+    c.setPerspective( 1.0f, 1.5f, 0.5f, 200.0f );
+
+    // Repeated requests return the same cached instance
+    const Mat4f * pFirst = &c.viewProjection();
+    EXPECT_EQ( pFirst, &c.viewProjection() );
+}
+
+TEST(Math,Camera_MovingInvalidatesView)
+{
+    Camera c;
+    c.setPerspective( 1.0f, 1.5f, 0.5f, 200.0f );
+
+    Mat4f before = c.viewProjection();
+    c.setPosition( Vec3f( 0.0f, 0.0f, 5.0f ) );
+
+    EXPECT_NE( before, c.viewProjection() );
+    EXPECT_TRUE( MatrixEquals( Math::createTranslation( 0.0f, 0.0f, -5.0f ), c.view() ) );
+    EXPECT_TRUE( MatrixEquals( c.projection() * c.view(), c.viewProjection() ) );
+}
+
+TEST(Math,Camera_ResizeInvalidatesProjection)
+{
+    Camera c;
+    c.setPerspective( 1.0f, 1.0f, 0.5f, 200.0f );
+
+    Mat4f before = c.inverseProjection();
+    c.setAspectRatio( 2.0f );
+
+    EXPECT_NE( before, c.inverseProjection() );
+    EXPECT_TRUE( MatrixEquals( Mat4f::IDENTITY, c.projection() * c.inverseProjection() ) );
+}
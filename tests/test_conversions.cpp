@@ -25,3 +25,14 @@ TEST(Math,Conversion_Deg2Rad_Values)
     EXPECT_FLOAT_EQ( 6.28318531f, deg2rad( 360.0f ) );
     EXPECT_FLOAT_EQ( 7.33038286f, deg2rad( 420.0f ) );
 }
+
+TEST(Math,Conversion_ConstantExpressions)
+{
+    constexpr float Angles[] = { deg2rad( 0.0f ), deg2rad( 90.0f ), deg2rad( 180.0f ) };
+
+    static_assert( rad2deg( Pi ) == 180.0f, "rad2deg must be a constant expression" );
+    static_assert( Deg2Rad * 180.0f == Pi, "" );
+
+    EXPECT_FLOAT_EQ( HalfPi, Angles[1] );
+    EXPECT_FLOAT_EQ( Pi, Angles[2] );
+}
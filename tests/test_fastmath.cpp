@@ -0,0 +1,314 @@
+/**
+ * Unit tests for the fast transcendental approximations
+ */
+#include <gtest/gtest.h>
+#include <smath/fastmath.h>
+#include <smath/constants.h>
+#include <smath/util.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Samples n evenly spaced values on [lo,hi]
+    std::vector<float> range( float lo, float hi, size_t n )
+    {
+        std::vector<float> v( n );
+
+        for ( size_t i = 0; i < n; ++i )
+        {
+            v[i] = lo + ( hi - lo ) * static_cast<float>( i ) / ( n - 1 );
+        }
+
+        return v;
+    }
+
+    float relativeError( float actual, double expected )
+    {
+        return static_cast<float>( std::abs( actual - expected ) /
+                                   std::abs( expected ) );
+    }
+
+    // Largest error of one tier of a function over the inputs, absolute
+    // except for exp
+    template<int P>
+    double maxError( const char * name, const std::vector<float>& xs )
+    {
+        const std::string fn( name );
+        double worst = 0.0;
+
+        for ( size_t i = 0; i < xs.size(); ++i )
+        {
+            const double x = xs[i];
+            double error = 0.0;
+
+            if ( fn == "sin" )
+            {
+                error = std::abs( Math::fast::sin<P>( xs[i] ) - std::sin( x ) );
+            }
+            else if ( fn == "cos" )
+            {
+                error = std::abs( Math::fast::cos<P>( xs[i] ) - std::cos( x ) );
+            }
+            else if ( fn == "atan" )
+            {
+                error = std::abs( Math::fast::atan2<P>( xs[i], 1.0f ) - std::atan2( x, 1.0 ) );
+            }
+            else if ( fn == "acos" )
+            {
+                error = std::abs( Math::fast::acos<P>( xs[i] ) - std::acos( x ) );
+            }
+            else if ( fn == "exp" )
+            {
+                error = relativeError( Math::fast::exp<P>( xs[i] ), std::exp( x ) );
+            }
+            else if ( fn == "log" )
+            {
+                error = std::abs( Math::fast::log<P>( xs[i] ) - std::log( x ) );
+            }
+
+            worst = std::max( worst, error );
+        }
+
+        return worst;
+    }
+}
+
+TEST(Math,Fast_SinCosAccuracy)
+{
+    std::vector<float> xs = range( -100.0f, 100.0f, 20001 );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        float x = xs[i];
+        EXPECT_NEAR( std::sin( x ), Math::fast::sin<Math::fast::Full>( x ), 2e-6f );
+        EXPECT_NEAR( std::cos( x ), Math::fast::cos<Math::fast::Full>( x ), 2e-6f );
+        EXPECT_NEAR( std::sin( x ), Math::fast::sin<Math::fast::Medium>( x ), 1e-5f );
+        EXPECT_NEAR( std::cos( x ), Math::fast::cos<Math::fast::Medium>( x ), 1e-5f );
+        EXPECT_NEAR( std::sin( x ), Math::fast::sin<Math::fast::Low>( x ), 1e-3f );
+        EXPECT_NEAR( std::cos( x ), Math::fast::cos<Math::fast::Low>( x ), 1e-3f );
+    }
+}
+
+TEST(Math,Fast_SinCosQuadrants)
+{
+    float s, c;
+
+    Math::fast::sincos( 0.0f, s, c );
+    EXPECT_FLOAT_EQ( 0.0f, s );
+    EXPECT_FLOAT_EQ( 1.0f, c );
+
+    Math::fast::sincos( Math::HalfPi, s, c );
+    EXPECT_NEAR( 1.0f, s, 1e-6f );
+    EXPECT_NEAR( 0.0f, c, 1e-6f );
+
+    Math::fast::sincos( Math::Pi, s, c );
+    EXPECT_NEAR( 0.0f, s, 1e-6f );
+    EXPECT_NEAR( -1.0f, c, 1e-6f );
+
+    Math::fast::sincos( -Math::HalfPi, s, c );
+    EXPECT_NEAR( -1.0f, s, 1e-6f );
+    EXPECT_NEAR( 0.0f, c, 1e-6f );
+}
+
+TEST(Math,Fast_Atan2Accuracy)
+{
+    std::vector<float> angles = range( -Math::Pi + 1e-3f, Math::Pi - 1e-3f, 2001 );
+    const float radii[] = { 1e-3f, 1.0f, 250.0f };
+
+    for ( size_t r = 0; r < 3; ++r )
+    {
+        for ( size_t i = 0; i < angles.size(); ++i )
+        {
+            float y = radii[r] * std::sin( angles[i] );
+            float x = radii[r] * std::cos( angles[i] );
+
+            EXPECT_NEAR( std::atan2( y, x ), Math::fast::atan2<Math::fast::Full>( y, x ), 2e-6f );
+            EXPECT_NEAR( std::atan2( y, x ), Math::fast::atan2<Math::fast::Medium>( y, x ), 1e-5f );
+            EXPECT_NEAR( std::atan2( y, x ), Math::fast::atan2<Math::fast::Low>( y, x ), 1e-3f );
+        }
+    }
+
+    EXPECT_EQ( 0.0f, Math::fast::atan2( 0.0f, 0.0f ) );
+    EXPECT_NEAR( Math::HalfPi, Math::fast::atan2( 1.0f, 0.0f ), 1e-6f );
+    EXPECT_NEAR( -Math::HalfPi, Math::fast::atan2( -1.0f, 0.0f ), 1e-6f );
+}
+
+TEST(Math,Fast_AcosAccuracy)
+{
+    std::vector<float> xs = range( -1.0f, 1.0f, 4001 );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        float x = xs[i];
+        EXPECT_NEAR( std::acos( x ), Math::fast::acos<Math::fast::Full>( x ), 2e-6f );
+        EXPECT_NEAR( std::acos( x ), Math::fast::acos<Math::fast::Medium>( x ), 1e-5f );
+        EXPECT_NEAR( std::acos( x ), Math::fast::acos<Math::fast::Low>( x ), 1e-3f );
+    }
+}
+
+TEST(Math,Fast_ExpAccuracy)
+{
+    std::vector<float> xs = range( -80.0f, 80.0f, 16001 );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        double expected = std::exp( static_cast<double>( xs[i] ) );
+
+        EXPECT_GT( 1e-6f, relativeError( Math::fast::exp<Math::fast::Full>( xs[i] ), expected ) );
+        EXPECT_GT( 1e-5f, relativeError( Math::fast::exp<Math::fast::Medium>( xs[i] ), expected ) );
+        EXPECT_GT( 1e-3f, relativeError( Math::fast::exp<Math::fast::Low>( xs[i] ), expected ) );
+    }
+}
+
+TEST(Math,Fast_LogAccuracy)
+{
+    std::vector<float> xs = range( 1e-3f, 1000.0f, 16001 );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        float expected = std::log( xs[i] );
+
+        EXPECT_NEAR( expected, Math::fast::log<Math::fast::Full>( xs[i] ), 2e-6f );
+        EXPECT_NEAR( expected, Math::fast::log<Math::fast::Medium>( xs[i] ), 1e-5f );
+        EXPECT_NEAR( expected, Math::fast::log<Math::fast::Low>( xs[i] ), 1e-3f );
+    }
+}
+
+TEST(Math,Fast_TiersAreOrdered)
+{
+    // Each tier stays within its documented bound, and is more accurate
+    // than the tier below it, so no tier can share the polynomial of another
+    const char * names[] = { "sin", "cos", "atan", "acos", "exp", "log" };
+    const float lo[] = { -4.0f, -4.0f, -8.0f, -1.0f, -20.0f, 0.5f };
+    const float hi[] = {  4.0f,  4.0f,  8.0f,  1.0f,  20.0f, 2.0f };
+
+    for ( size_t f = 0; f < 6; ++f )
+    {
+        SCOPED_TRACE( names[f] );
+
+        std::vector<float> xs = range( lo[f], hi[f], 20001 );
+        const double low    = maxError<Math::fast::Low>( names[f], xs );
+        const double medium = maxError<Math::fast::Medium>( names[f], xs );
+        const double full   = maxError<Math::fast::Full>( names[f], xs );
+
+        EXPECT_GT( 1e-3, low );
+        EXPECT_GT( 1e-5, medium );
+        EXPECT_GT( 2e-6, full );
+        EXPECT_GT( low, medium );
+        EXPECT_GE( medium, full );
+    }
+}
+
+TEST(Math,Fast_Pow)
+{
+    EXPECT_NEAR( 8.0f, Math::fast::pow( 2.0f, 3.0f ), 1e-4f );
+    EXPECT_NEAR( 3.0f, Math::fast::pow( 9.0f, 0.5f ), 1e-5f );
+    EXPECT_GT( 1e-5f, relativeError( Math::fast::pow( 0.35f, 2.2f ),
+                                     std::pow( 0.35, 2.2 ) ) );
+}
+
+TEST(Math,Fast_RsqrtAccuracy)
+{
+    std::vector<float> xs = range( 1e-4f, 1e4f, 20001 );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        double expected = 1.0 / std::sqrt( static_cast<double>( xs[i] ) );
+
+        EXPECT_GT( 5e-7f, relativeError( Math::fast::rsqrt<Math::fast::Full>( xs[i] ), expected ) );
+        EXPECT_GT( 4e-3f, relativeError( Math::fast::rsqrt<Math::fast::Low>( xs[i] ), expected ) );
+        EXPECT_GT( 5e-7f, relativeError( Math::fast::sqrt( xs[i] ),
+                                         std::sqrt( static_cast<double>( xs[i] ) ) ) );
+    }
+}
+
+TEST(Math,Fast_SqrtZero)
+{
+    EXPECT_EQ( 0.0f, Math::fast::sqrt( 0.0f ) );
+    EXPECT_EQ( 0.0f, Math::fastSqrt( 0.0f ) );
+    EXPECT_NEAR( 3.0f, Math::fastSqrt( 9.0f ), 1e-6f );
+}
+
+TEST(Math,Fast_RsqrtArray)
+{
+    std::vector<float> xs = range( 0.5f, 50.0f, 29 );
+    std::vector<float> out( xs.size() );
+
+    Math::fast::rsqrt( &out[0], &xs[0], xs.size() );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        EXPECT_EQ( Math::fast::rsqrt( xs[i] ), out[i] );
+    }
+}
+
+TEST(Math,Fast_DoubleForwardsToStd)
+{
+    EXPECT_EQ( std::sin( 0.25 ), Math::fast::sin( 0.25 ) );
+    EXPECT_EQ( std::atan2( 0.5, -2.0 ), Math::fast::atan2( 0.5, -2.0 ) );
+    EXPECT_EQ( std::exp( 3.5 ), Math::fast::exp( 3.5 ) );
+}
+
+TEST(Math,Fast_ArraysMatchScalar)
+{
+    // Odd length so the vector loops and scalar tail both run
+    std::vector<float> xs = range( -10.0f, 10.0f, 37 );
+    std::vector<float> ys = range( 0.1f, 5.0f, 37 );
+    std::vector<float> out( xs.size() );
+
+    Math::fast::sin( &out[0], &xs[0], xs.size() );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        EXPECT_EQ( Math::fast::sin( xs[i] ), out[i] );
+    }
+
+    Math::fast::atan2( &out[0], &xs[0], &ys[0], xs.size() );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        EXPECT_EQ( Math::fast::atan2( xs[i], ys[i] ), out[i] );
+    }
+
+    Math::fast::log( &out[0], &ys[0], ys.size() );
+
+    for ( size_t i = 0; i < ys.size(); ++i )
+    {
+        EXPECT_EQ( Math::fast::log( ys[i] ), out[i] );
+    }
+
+    std::vector<float> cosines( xs.size() );
+    Math::fast::sincos( &out[0], &cosines[0], &xs[0], xs.size() );
+
+    for ( size_t i = 0; i < xs.size(); ++i )
+    {
+        EXPECT_EQ( Math::fast::sin( xs[i] ), out[i] );
+        EXPECT_EQ( Math::fast::cos( xs[i] ), cosines[i] );
+    }
+}
+
+#ifdef MATH_SSE2
+TEST(Math,Fast_SseMatchesScalar)
+{
+    float in[4] = { -3.0f, 0.5f, 1.25f, 7.0f };
+    float out[4];
+
+    Math::simd::store( out, Math::fast::cos( Math::simd::load<__m128>( in ) ) );
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        EXPECT_EQ( Math::fast::cos( in[i] ), out[i] );
+    }
+
+    Math::simd::store( out, Math::fast::exp( Math::simd::load<__m128>( in ) ) );
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        EXPECT_EQ( Math::fast::exp( in[i] ), out[i] );
+    }
+}
+#endif
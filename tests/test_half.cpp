@@ -0,0 +1,173 @@
+/**
+ * Unit tests for the half and bfloat16 scalar types
+ */
+#include <gtest/gtest.h>
+#include <smath/half.h>
+#include <smath/matrix.h>
+#include <smath/cpu.h>
+#include "unittesthelpers.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using Math::half;
+using Math::bfloat16;
+
+#ifndef MATH_TYPEDEFS
+typedef TVector3<float> Vec3f;
+typedef TVector4<float> Vec4f;
+#endif
+
+TEST(Math,Half_Conversions)
+{
+    EXPECT_EQ( 0x3c00, half( 1.0f ).bits() );
+    EXPECT_EQ( 0xc000, half( -2.0f ).bits() );
+    EXPECT_EQ( 0x7bff, half( 65504.0f ).bits() );
+    EXPECT_EQ( 0x7c00, half( 1.0e6f ).bits() );
+    EXPECT_EQ( 0.5f, static_cast<float>( half( 0.5f ) ) );
+
+    // The type converts exactly like the packing functions
+    for ( uint32_t h = 0; h < 0x10000; ++h )
+    {
+        const half value = half::fromBits( static_cast<uint16_t>( h ) );
+        const float f = value;
+
+        ASSERT_EQ( bitsOf( Math::unpackHalf( value.bits() ) ), bitsOf( f ) ) << std::hex << h;
+
+        if ( f == f )
+        {
+            ASSERT_EQ( h, half( f ).bits() ) << std::hex << h;
+        }
+    }
+
+    unsigned int state = 1;
+
+    for ( int i = 0; i < 10000; ++i )
+    {
+        const float f = nextTestFloat( state ) * 1000.0f;
+        ASSERT_EQ( Math::packHalf( f ), half( f ).bits() ) << f;
+    }
+
+    EXPECT_EQ( 65504.0f, static_cast<float>( std::numeric_limits<half>::max() ) );
+    EXPECT_EQ( 1.0f / 1024.0f, static_cast<float>( std::numeric_limits<half>::epsilon() ) );
+    EXPECT_EQ( std::numeric_limits<float>::infinity(),
+               static_cast<float>( std::numeric_limits<half>::infinity() ) );
+    EXPECT_TRUE( std::isnan( static_cast<float>( std::numeric_limits<half>::quiet_NaN() ) ) );
+}
+
+TEST(Math,BFloat16_Conversions)
+{
+    EXPECT_EQ( 0x3f80, bfloat16( 1.0f ).bits() );
+    EXPECT_EQ( 0xc000, bfloat16( -2.0f ).bits() );
+    EXPECT_EQ( 0x3eab, bfloat16( 1.0f / 3.0f ).bits() );
+    EXPECT_NEAR( 1.0e30f, static_cast<float>( bfloat16( 1.0e30f ) ), 1.0e30f / 256.0f );
+
+    // Ties round to even
+    EXPECT_EQ( 0x3f80, bfloat16( 1.0f + 1.0f / 256.0f ).bits() );
+    EXPECT_EQ( 0x3f82, bfloat16( 1.0f + 3.0f / 256.0f ).bits() );
+
+    // The largest floats round up to infinity, NaNs stay NaN
+    EXPECT_EQ( 0x7f80, bfloat16( std::numeric_limits<float>::max() ).bits() );
+    EXPECT_EQ( 0xff80, bfloat16( -std::numeric_limits<float>::infinity() ).bits() );
+    EXPECT_TRUE( std::isnan( static_cast<float>( bfloat16( std::numeric_limits<float>::quiet_NaN() ) ) ) );
+
+    unsigned int state = 2;
+
+    for ( int i = 0; i < 10000; ++i )
+    {
+        const float f = nextTestFloat( state ) * 1.0e20f;
+        EXPECT_NEAR( f, static_cast<float>( bfloat16( f ) ), std::fabs( f ) / 256.0f );
+    }
+
+    EXPECT_EQ( std::numeric_limits<float>::min(),
+               static_cast<float>( std::numeric_limits<bfloat16>::min() ) );
+    EXPECT_EQ( 1.0f / 128.0f, static_cast<float>( std::numeric_limits<bfloat16>::epsilon() ) );
+}
+
+TEST(Math,Half_Vectors)
+{
+    EXPECT_EQ( 6u, sizeof( TVector3<half> ) );
+    EXPECT_EQ( 8u, sizeof( TVector4<bfloat16> ) );
+
+    const TVector3<half> a( 1.0f, 2.0f, -3.0f );
+    const TVector3<half> b( 0.5f, 0.25f, 4.0f );
+
+    EXPECT_EQ( TVector3<half>( 1.5f, 2.25f, 1.0f ), a + b );
+    EXPECT_EQ( TVector3<half>( 0.5f, 1.75f, -7.0f ), a - b );
+    EXPECT_EQ( TVector3<half>( 2.0f, 4.0f, -6.0f ), a * 2.0f );
+    EXPECT_EQ( 14.0f, lengthSquared( a ) );
+    EXPECT_EQ( -11.0f, dot( a, b ) );
+    EXPECT_EQ( TVector3<half>( 8.75f, -5.5f, -0.75f ), cross( a, b ) );
+    EXPECT_EQ( TVector3<half>( 0.5f, 0.25f, -3.0f ), min( a, b ) );
+
+    TVector4<bfloat16> c( 1.0f, 2.0f, 3.0f, 4.0f );
+    c += TVector4<bfloat16>( 1.0f, 1.0f, 1.0f, 1.0f );
+    c *= 0.5f;
+
+    EXPECT_EQ( TVector4<bfloat16>( 1.0f, 1.5f, 2.0f, 2.5f ), c );
+
+    // Results are rounded to the storage type
+    EXPECT_EQ( half( 1.0f / 3.0f ).bits(), ( TVector2<half>( 1.0f, 1.0f ) / 3.0f ).x().bits() );
+
+    TMatrix4<half> m( 1, 0, 0, 5,
+                      0, 1, 0, 6,
+                      0, 0, 1, 7,
+                      0, 0, 0, 1 );
+
+    EXPECT_EQ( 6.0f, m.at( 1, 3 ) );
+}
+
+TEST(Math,Half_BatchEveryLevel)
+{
+    unsigned int state = 11;
+
+    std::vector<float> values( LevelTestCount );
+    std::vector<Vec3f> vectors( LevelTestCount );
+
+    for ( size_t i = 0; i < LevelTestCount; ++i )
+    {
+        values[i]  = nextTestFloat( state ) * 70000.0f * std::pow( 2.0f, -30.0f * std::abs( nextTestFloat( state ) ) );
+        vectors[i] = Vec3f( nextTestFloat( state ), nextTestFloat( state ), nextTestFloat( state ) ) * 100.0f;
+    }
+
+    forEachInstructionSet( [&]()
+    {
+        std::vector<half> halves( LevelTestCount );
+        std::vector<bfloat16> brains( LevelTestCount );
+        std::vector<float> floats( LevelTestCount );
+
+        Math::batch::convert( &values[0], &halves[0], LevelTestCount );
+        Math::batch::convert( &halves[0], &floats[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            ASSERT_EQ( Math::packHalf( values[i] ), halves[i].bits() ) << values[i];
+            ASSERT_EQ( bitsOf( Math::unpackHalf( halves[i].bits() ) ), bitsOf( floats[i] ) );
+        }
+
+        Math::batch::convert( &values[0], &brains[0], LevelTestCount );
+        Math::batch::convert( &brains[0], &floats[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            ASSERT_EQ( Math::packBFloat16( values[i] ), brains[i].bits() ) << values[i];
+            ASSERT_EQ( bitsOf( Math::unpackBFloat16( brains[i].bits() ) ), bitsOf( floats[i] ) );
+        }
+
+        std::vector< TVector3<half> > packed( LevelTestCount );
+        std::vector<Vec3f> unpacked( LevelTestCount );
+
+        Math::batch::convert( &vectors[0], &packed[0], LevelTestCount );
+        Math::batch::convert( &packed[0], &unpacked[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            for ( int c = 0; c < 3; ++c )
+            {
+                ASSERT_EQ( half( vectors[i][c] ).bits(), packed[i][c].bits() );
+                ASSERT_EQ( static_cast<float>( packed[i][c] ), unpacked[i][c] );
+            }
+        }
+    } );
+}
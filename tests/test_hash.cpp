@@ -0,0 +1,221 @@
+/**
+ * Unit tests for float, vector and matrix hashing
+ */
+#include <gtest/gtest.h>
+#include <smath/hash.h>
+#include <smath/util.h>
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector2<float> Vec2f;
+typedef TVector3<float> Vec3f;
+typedef TVector4<float> Vec4f;
+typedef TVector3<double> Vec3d;
+typedef TMatrix4<float> Mat4f;
+typedef TQuaternion<float> Quatf;
+typedef TVector2<int> Vec2i;
+typedef TVector3<int> Vec3i;
+#endif
+
+TEST(Math,Hash_SignedZero)
+{
+    EXPECT_EQ( Math::hash( 0.0f ), Math::hash( -0.0f ) );
+    EXPECT_EQ( Math::hash( 0.0 ), Math::hash( -0.0 ) );
+    EXPECT_EQ( Math::hash( Vec3f( 0.0f, 1.0f, 0.0f ) ),
+               Math::hash( Vec3f( -0.0f, 1.0f, -0.0f ) ) );
+    EXPECT_EQ( Math::hashfloat( 0.0f ), Math::hashfloat( -0.0f ) );
+}
+
+TEST(Math,Hash_NaN)
+{
+    float quiet = std::numeric_limits<float>::quiet_NaN();
+    float other = -std::numeric_limits<float>::quiet_NaN();
+
+    EXPECT_EQ( Math::hash( quiet ), Math::hash( other ) );
+    EXPECT_EQ( Math::hash( std::numeric_limits<double>::quiet_NaN() ),
+               Math::hash( -std::numeric_limits<double>::quiet_NaN() ) );
+    EXPECT_NE( Math::hash( quiet ), Math::hash( 0.0f ) );
+}
+
+TEST(Math,Hash_OrderSensitive)
+{
+    EXPECT_NE( Math::hash( Vec3f( 1.0f, 2.0f, 3.0f ) ),
+               Math::hash( Vec3f( 3.0f, 2.0f, 1.0f ) ) );
+    EXPECT_NE( Math::hash( Vec2f( 1.0f, 2.0f ) ),
+               Math::hash( Vec2f( 2.0f, 1.0f ) ) );
+
+    const float a[] = { 1.0f, 2.0f };
+    const float b[] = { 2.0f, 1.0f };
+    EXPECT_NE( Math::hashfloat( a, 2 ), Math::hashfloat( b, 2 ) );
+}
+
+TEST(Math,Hash_LengthSensitive)
+{
+    const float zeros[16] = { 0 };
+    std::set<uint64_t> seen;
+
+    for ( size_t i = 0; i <= 16; ++i )
+    {
+        EXPECT_TRUE( seen.insert( Math::hash( zeros, i ) ).second );
+    }
+}
+
+TEST(Math,Hash_Seed)
+{
+    EXPECT_NE( Math::hash( Vec4f( 1.0f, 2.0f, 3.0f, 4.0f ), 1 ),
+               Math::hash( Vec4f( 1.0f, 2.0f, 3.0f, 4.0f ), 2 ) );
+}
+
+TEST(Math,Hash_SingleValueMatchesArray)
+{
+    float f = 3.25f;
+    double d = -7.5;
+
+    EXPECT_EQ( Math::hash( f ), Math::hash( &f, 1 ) );
+    EXPECT_EQ( Math::hash( d ), Math::hash( &d, 1 ) );
+}
+
+TEST(Math,Hash_BulkCanonicalization)
+{
+    // Lengths cover the vectorized blocks and every tail size
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    for ( size_t n = 1; n < 40; ++n )
+    {
+        std::vector<float> raw( n ), canonical( n );
+
+        for ( size_t i = 0; i < n; ++i )
+        {
+            switch ( i % 3 )
+            {
+                case 0: raw[i] = -0.0f; canonical[i] = 0.0f; break;
+                case 1: raw[i] = -nan;  canonical[i] = nan;  break;
+                default: raw[i] = canonical[i] = static_cast<float>( i ); break;
+            }
+        }
+
+        EXPECT_EQ( Math::hash( &canonical[0], n ), Math::hash( &raw[0], n ) );
+    }
+}
+
+TEST(Math,Hash_Matrix)
+{
+    Mat4f a = Mat4f::IDENTITY;
+    Mat4f b = Mat4f::IDENTITY;
+    b.set( 2, 3, 5.0f );
+
+    EXPECT_EQ( Math::hash( a ), Math::hash( Mat4f::IDENTITY ) );
+    EXPECT_NE( Math::hash( a ), Math::hash( b ) );
+}
+
+TEST(Math,Hash_Quaternion)
+{
+    EXPECT_EQ( Math::hash( Quatf( 1.0f, 0.0f, 0.0f, 0.0f ) ),
+               Math::hash( Quatf( 1.0f, -0.0f, 0.0f, 0.0f ) ) );
+    EXPECT_NE( Math::hash( Quatf( 1.0f, 0.0f, 0.0f, 0.0f ) ),
+               Math::hash( Quatf( 0.0f, 1.0f, 0.0f, 0.0f ) ) );
+}
+
+TEST(Math,Hash_DoubleVector)
+{
+    EXPECT_EQ( Math::hash( Vec3d( 1.0, -0.0, 2.0 ) ),
+               Math::hash( Vec3d( 1.0, 0.0, 2.0 ) ) );
+    EXPECT_NE( Math::hash( Vec3d( 1.0, 0.0, 2.0 ) ),
+               Math::hash( Vec3d( 2.0, 0.0, 1.0 ) ) );
+}
+
+TEST(Math,Hash_GridHasFewCollisions)
+{
+    // A vertex welding style workload: points on a regular grid
+    std::set<uint32_t> seen;
+    size_t count = 0;
+
+    for ( int x = 0; x < 64; ++x )
+    {
+        for ( int y = 0; y < 64; ++y )
+        {
+            for ( int z = 0; z < 16; ++z, ++count )
+            {
+                Vec3f p( x * 0.125f, y * 0.125f, z * 0.125f );
+                seen.insert( Math::hash32( Math::hash( p ) ) );
+            }
+        }
+    }
+
+    // 65536 keys into 2^32 buckets should be essentially collision free
+    EXPECT_LE( count - seen.size(), 2u );
+}
+
+TEST(Math,Hash_IntegerVectors)
+{
+    // Grid cells as keys, including negative coordinates
+    std::unordered_map<Vec3i, int, Math::Hasher, Math::ExactEqual> cells;
+    std::set<uint32_t> seen;
+
+    for ( int x = -16; x < 16; ++x )
+    {
+        for ( int y = -16; y < 16; ++y )
+        {
+            for ( int z = -8; z < 8; ++z )
+            {
+                cells[ Vec3i( x, y, z ) ] = x * 10000 + y * 100 + z;
+                seen.insert( Math::hash32( Math::hash( Vec3i( x, y, z ) ) ) );
+            }
+        }
+    }
+
+    EXPECT_EQ( 16384u, cells.size() );
+    EXPECT_LE( 16384u - seen.size(), 2u );
+    EXPECT_EQ( -30507, cells[ Vec3i( -3, -5, -7 ) ] );
+
+    EXPECT_NE( Math::hash( Vec2i( 1, 2 ) ), Math::hash( Vec2i( 2, 1 ) ) );
+    EXPECT_EQ( Math::hash( 7 ), Math::hash( Vec2i( 7, 0 ).ptr(), 1 ) );
+    EXPECT_TRUE( Math::ExactEqual()( Vec2i( -1, 4 ), Vec2i( -1, 4 ) ) );
+    EXPECT_FALSE( Math::ExactEqual()( Vec2i( -1, 4 ), Vec2i( 1, 4 ) ) );
+
+    // Arrays longer than a block are order sensitive too
+    int values[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    const uint64_t before = Math::hash( values, 9 );
+
+    std::swap( values[0], values[8] );
+    EXPECT_NE( before, Math::hash( values, 9 ) );
+    EXPECT_NE( Math::hash( values, 8 ), Math::hash( values, 9 ) );
+}
+
+TEST(Math,Hash_Hasher)
+{
+    std::unordered_map<Vec3f, int, Math::Hasher, Math::ExactEqual> map;
+
+    map[ Vec3f( 1.0f, 2.0f, 3.0f ) ] = 1;
+    map[ Vec3f( -0.0f, 0.0f, 0.0f ) ] = 2;
+
+    EXPECT_EQ( 1, map[ Vec3f( 1.0f, 2.0f, 3.0f ) ] );
+    EXPECT_EQ( 2, map[ Vec3f( 0.0f, 0.0f, 0.0f ) ] );
+
+    // Keys that are only close are distinct keys, whatever operator== says
+    map[ Vec3f( 1.0f, 2.0f, 3.0000002f ) ] = 3;
+
+    EXPECT_EQ( 3u, map.size() );
+    EXPECT_EQ( 1, map[ Vec3f( 1.0f, 2.0f, 3.0f ) ] );
+}
+
+TEST(Math,Hash_ExactEqual)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const Math::ExactEqual equal;
+
+    EXPECT_TRUE( equal( Vec3f( -0.0f, 1.0f, nan ), Vec3f( 0.0f, 1.0f, -nan ) ) );
+    EXPECT_FALSE( equal( Vec3f( 1.0f, 2.0f, 3.0f ), Vec3f( 1.0f, 2.0f, 3.0000002f ) ) );
+    EXPECT_TRUE( equal( 0.0, -0.0 ) );
+    EXPECT_TRUE( equal( Quatf( 1, 0, 0, 0 ), Quatf( 1, 0, 0, 0 ) ) );
+    EXPECT_FALSE( equal( Quatf( 1, 0, 0, 0 ), Quatf( -1, 0, 0, 0 ) ) );
+
+    // Whatever compares equal hashes equal
+    EXPECT_EQ( Math::hash( Vec3f( -0.0f, 1.0f, nan ) ), Math::hash( Vec3f( 0.0f, 1.0f, -nan ) ) );
+}
@@ -1,3 +1,100 @@
+/**
+ * Unit tests for the interpolation (easing) curves
+ */
 #include <gtest/gtest.h>
 #include <smath/interpolation.h>
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    std::vector<float> ramp( size_t count, float first, float last )
+    {
+        std::vector<float> values( count );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            values[i] = first + ( last - first ) * i / ( count - 1 );
+        }
+
+        return values;
+    }
+}
+
+TEST(Math,Interpolation_CurveEndpoints)
+{
+    EXPECT_FLOAT_EQ( 2.0f, Math::smoothstep( 2.0f, 6.0f, 0.0f ) );
+    EXPECT_FLOAT_EQ( 4.0f, Math::smoothstep( 2.0f, 6.0f, 0.5f ) );
+    EXPECT_FLOAT_EQ( 6.0f, Math::smoothstep( 2.0f, 6.0f, 1.0f ) );
+    EXPECT_FLOAT_EQ( 6.0f, Math::smoothstep( 2.0f, 6.0f, 3.0f ) );
+
+    EXPECT_NEAR( 2.0f, Math::sinerp( 2.0f, 6.0f, 0.0f ), 1e-5f );
+    EXPECT_NEAR( 6.0f, Math::sinerp( 2.0f, 6.0f, 1.0f ), 1e-5f );
+
+    // Eases in from the starting value
+    EXPECT_NEAR( 2.0f, Math::coserp( 2.0f, 6.0f, 0.0f ), 1e-5f );
+    EXPECT_NEAR( 6.0f, Math::coserp( 2.0f, 6.0f, 1.0f ), 1e-5f );
+    EXPECT_LT( Math::coserp( 2.0f, 6.0f, 0.5f ), 4.0f );
+
+    EXPECT_NEAR( 2.0f, Math::berp( 2.0f, 6.0f, 0.0f ), 1e-5f );
+    EXPECT_NEAR( 6.0f, Math::berp( 2.0f, 6.0f, 1.0f ), 1e-5f );
+}
+
+TEST(Math,Interpolation_BerpOvershoots)
+{
+    std::vector<float> s = ramp( 101, 0.0f, 1.0f );
+    float highest = 0.0f;
+
+    for ( size_t i = 0; i < s.size(); ++i )
+    {
+        highest = std::max( highest, Math::berp( 0.0f, 1.0f, s[i] ) );
+    }
+
+    EXPECT_GT( highest, 1.05f );
+
+    // Clamped outside [0,1]
+    EXPECT_NEAR( 0.0f, Math::berp( 0.0f, 1.0f, -0.5f ), 1e-5f );
+    EXPECT_NEAR( 1.0f, Math::berp( 0.0f, 1.0f, 1.5f ), 1e-5f );
+}
+
+TEST(Math,Interpolation_ArraysMatchScalar)
+{
+    // Odd count so the scalar remainder loop runs too
+    const size_t Count = 103;
+    std::vector<float> s = ramp( Count, -0.25f, 1.25f );
+    std::vector<float> a = ramp( Count, -3.0f, 2.0f );
+    std::vector<float> b = ramp( Count, 7.0f, -1.0f );
+    std::vector<float> constant( Count ), arrays( Count );
+
+#define SMATH_CHECK_CURVE( name )                                                   \
+    Math::name( &constant[0], -2.0f, 5.0f, &s[0], Count );                          \
+    Math::name( &arrays[0], &a[0], &b[0], &s[0], Count );                           \
+                                                                                    \
+    for ( size_t i = 0; i < Count; ++i )                                            \
+    {                                                                               \
+        EXPECT_NEAR( Math::name( -2.0f, 5.0f, s[i] ), constant[i], 2e-5f ) << #name; \
+        EXPECT_NEAR( Math::name( a[i], b[i], s[i] ), arrays[i], 2e-5f ) << #name;   \
+    }
+
+    SMATH_CHECK_CURVE( lerp )
+    SMATH_CHECK_CURVE( smoothstep )
+    SMATH_CHECK_CURVE( hermite )
+    SMATH_CHECK_CURVE( sinerp )
+    SMATH_CHECK_CURVE( coserp )
+    SMATH_CHECK_CURVE( berp )
+    SMATH_CHECK_CURVE( bounce )
+
+#undef SMATH_CHECK_CURVE
+}
+
+TEST(Math,Interpolation_ArraysInPlace)
+{
+    std::vector<float> s = ramp( 20, 0.0f, 1.0f );
+    std::vector<float> expected( s.size() );
+
+    Math::smoothstep( &expected[0], 1.0f, 3.0f, &s[0], s.size() );
+    Math::smoothstep( &s[0], 1.0f, 3.0f, &s[0], s.size() );
+
+    EXPECT_EQ( expected, s );
+}
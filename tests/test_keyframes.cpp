@@ -0,0 +1,237 @@
+/**
+ * Unit tests for keyframe tracks and cursor lookups
+ */
+#include <gtest/gtest.h>
+#include <smath/keyframes.h>
+#include "unittesthelpers.h"
+
+#include <cmath>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector3<float> Vec3f;
+typedef TQuaternion<float> Quatf;
+#endif
+
+namespace
+{
+    Math::KeyframeTrack<float> makeTrack( Math::KeyframeMode mode )
+    {
+        const float times[]  = { 0.0f, 0.5f, 2.0f, 2.5f, 4.0f };
+        const float values[] = { 1.0f, 3.0f, -1.0f, 0.0f, 2.0f };
+
+        Math::KeyframeTrack<float> track( mode );
+        track.setKeys( times, values, 5 );
+
+        return track;
+    }
+}
+
+TEST(Math,Keyframes_Linear)
+{
+    Math::KeyframeTrack<float> track = makeTrack( Math::KeyframeLinear );
+
+    ASSERT_EQ( 5u, track.size() );
+    EXPECT_EQ( 0.0f, track.startTime() );
+    EXPECT_EQ( 4.0f, track.endTime() );
+
+    EXPECT_FLOAT_EQ( 1.0f, track.sample( 0.0f ) );
+    EXPECT_FLOAT_EQ( 3.0f, track.sample( 0.5f ) );
+    EXPECT_FLOAT_EQ( 2.0f, track.sample( 0.25f ) );
+    EXPECT_FLOAT_EQ( 1.0f, track.sample( 1.25f ) );
+    EXPECT_FLOAT_EQ( 1.0f, track.sample( 3.25f ) );
+    EXPECT_FLOAT_EQ( 2.0f, track.sample( 4.0f ) );
+
+    // Held outside the keys
+    EXPECT_FLOAT_EQ( 1.0f, track.sample( -3.0f ) );
+    EXPECT_FLOAT_EQ( 2.0f, track.sample( 10.0f ) );
+}
+
+TEST(Math,Keyframes_Step)
+{
+    Math::KeyframeTrack<float> track = makeTrack( Math::KeyframeStep );
+
+    EXPECT_EQ( 1.0f, track.sample( -1.0f ) );
+    EXPECT_EQ( 1.0f, track.sample( 0.49f ) );
+    EXPECT_EQ( 3.0f, track.sample( 0.5f ) );
+    EXPECT_EQ( 3.0f, track.sample( 1.99f ) );
+    EXPECT_EQ( -1.0f, track.sample( 2.0f ) );
+    EXPECT_EQ( 0.0f, track.sample( 3.99f ) );
+    EXPECT_EQ( 2.0f, track.sample( 4.0f ) );
+    EXPECT_EQ( 2.0f, track.sample( 5.0f ) );
+}
+
+TEST(Math,Keyframes_Cubic)
+{
+    Math::KeyframeTrack<float> track = makeTrack( Math::KeyframeCubic );
+
+    // Passes through every key
+    const float times[]  = { 0.0f, 0.5f, 2.0f, 2.5f, 4.0f };
+    const float values[] = { 1.0f, 3.0f, -1.0f, 0.0f, 2.0f };
+
+    for ( int i = 0; i < 5; ++i )
+    {
+        EXPECT_NEAR( values[i], track.sample( times[i] ), 1e-5f );
+    }
+
+    // Continuous slope across keys
+    const float h = 1e-3f;
+
+    for ( int i = 1; i < 4; ++i )
+    {
+        const float before = ( track.sample( times[i] ) - track.sample( times[i] - h ) ) / h;
+        const float after  = ( track.sample( times[i] + h ) - track.sample( times[i] ) ) / h;
+
+        EXPECT_NEAR( before, after, 0.05f );
+    }
+
+    // Explicit tangents along a straight line reproduce it
+    const Vec3f points[]   = { Vec3f( 0, 0, 0 ), Vec3f( 2, 4, -2 ), Vec3f( 3, 6, -3 ) };
+    const Vec3f tangents[] = { Vec3f( 1, 2, -1 ), Vec3f( 1, 2, -1 ), Vec3f( 1, 2, -1 ) };
+    const float lineTimes[] = { 0.0f, 2.0f, 3.0f };
+
+    Math::KeyframeTrack<Vec3f> line( Math::KeyframeCubic );
+    line.setKeys( lineTimes, points, tangents, 3 );
+
+    for ( int i = 0; i <= 30; ++i )
+    {
+        const float t = 0.1f * i;
+        EXPECT_TRUE( VectorNear( Vec3f( t, 2.0f * t, -t ), line.sample( t ), 1e-5f ) );
+    }
+}
+
+TEST(Math,Keyframes_CursorMatchesSearch)
+{
+    const Math::KeyframeMode Modes[] = { Math::KeyframeStep, Math::KeyframeLinear, Math::KeyframeCubic };
+
+    std::vector<float> times;
+    std::vector<Vec3f> values;
+
+    for ( int i = 0; i < 40; ++i )
+    {
+        times.push_back( i * 0.25f + ( i % 3 ) * 0.05f );
+        values.push_back( Vec3f( std::sin( i * 0.7f ), std::cos( i * 1.3f ), 0.1f * i ) );
+    }
+
+    for ( int m = 0; m < 3; ++m )
+    {
+        Math::KeyframeTrack<Vec3f> track( Modes[m] );
+        track.setKeys( &times[0], &values[0], times.size() );
+
+        Math::KeyframeCursor cursor;
+
+        // Forward in small and large steps, then backward, then jumping around
+        for ( float t = -1.0f; t < 12.0f; t += 0.01f )
+        {
+            ASSERT_TRUE( VectorNear( track.sample( t ), track.sample( t, cursor ), 0.0f ) ) << t;
+        }
+
+        for ( float t = 11.0f; t > -1.0f; t -= 0.37f )
+        {
+            ASSERT_TRUE( VectorNear( track.sample( t ), track.sample( t, cursor ), 0.0f ) ) << t;
+        }
+
+        for ( int i = 0; i < 200; ++i )
+        {
+            const float t = std::fmod( i * 7.31f, 11.0f ) - 0.5f;
+            ASSERT_TRUE( VectorNear( track.sample( t ), track.sample( t, cursor ), 0.0f ) ) << t;
+        }
+
+        // Exactly on every key
+        for ( size_t i = 0; i < times.size(); ++i )
+        {
+            ASSERT_TRUE( VectorNear( values[i], track.sample( times[i], cursor ), 1e-5f ) );
+        }
+    }
+
+    // A single key is constant
+    Math::KeyframeTrack<Vec3f> single;
+    Math::KeyframeCursor cursor;
+    cursor.segment = 17;
+
+    single.setKeys( &times[0], &values[0], 1 );
+    EXPECT_TRUE( VectorNear( values[0], single.sample( 5.0f, cursor ), 0.0f ) );
+}
+
+TEST(Math,Keyframes_Quaternion)
+{
+    const float half = std::sqrt( 0.5f );
+
+    // The last key is the negation of a rotation close to the second, and
+    // must not send the interpolation the long way around
+    const Quatf keys[] = { Quatf( 1.0f, 0.0f, 0.0f, 0.0f ),
+                          Quatf( half, 0.0f, 0.0f, half ),
+                          Quatf( -half, 0.0f, 0.0f, -half ) };
+    const float times[] = { 0.0f, 1.0f, 2.0f };
+
+    const Math::KeyframeMode Modes[] = { Math::KeyframeLinear, Math::KeyframeCubic };
+
+    for ( int m = 0; m < 2; ++m )
+    {
+        Math::KeyframeTrack<Quatf> track( Modes[m] );
+        track.setKeys( times, keys, 3 );
+
+        Math::KeyframeCursor cursor;
+
+        for ( float t = 0.0f; t <= 2.0f; t += 0.05f )
+        {
+            const Quatf q = track.sample( t, cursor );
+            EXPECT_NEAR( 1.0f, normal( q ), 1e-5f );
+
+            // Same rotation as the second key for the whole second segment
+            if ( t >= 1.0f && Modes[m] == Math::KeyframeLinear )
+            {
+                EXPECT_NEAR( half, q[0], 1e-5f );
+                EXPECT_NEAR( half, q[3], 1e-5f );
+            }
+        }
+
+        // Part way to a quarter turn about z, exactly halfway when linear
+        const Quatf mid = track.sample( 0.5f );
+        const float angle = 2.0f * std::atan2( mid[3], mid[0] );
+
+        EXPECT_GT( angle, 0.0f );
+        EXPECT_LT( angle, Math::Pi * 0.5f );
+
+        if ( Modes[m] == Math::KeyframeLinear )
+        {
+            EXPECT_NEAR( Math::Pi * 0.25f, angle, 1e-5f );
+        }
+    }
+}
+
+TEST(Math,Keyframes_SampleTracks)
+{
+    std::vector< Math::KeyframeTrack<float> > tracks;
+
+    for ( int i = 0; i < 16; ++i )
+    {
+        const float times[]  = { 0.0f, 1.0f + i * 0.1f, 3.0f };
+        const float values[] = { static_cast<float>( i ), 2.0f * i, -1.0f };
+
+        tracks.push_back( Math::KeyframeTrack<float>( i % 2 ? Math::KeyframeLinear : Math::KeyframeCubic ) );
+        tracks.back().setKeys( times, values, 3 );
+    }
+
+    std::vector<Math::KeyframeCursor> cursors( tracks.size() );
+    std::vector<float> out( tracks.size() );
+    std::vector<float> clocks( tracks.size() );
+
+    for ( float t = 0.0f; t < 3.5f; t += 0.1f )
+    {
+        Math::sampleTracks( &tracks[0], &cursors[0], t, &out[0], tracks.size() );
+
+        for ( size_t i = 0; i < tracks.size(); ++i )
+        {
+            EXPECT_EQ( tracks[i].sample( t ), out[i] );
+            clocks[i] = t * ( 1.0f + 0.05f * i );
+        }
+
+        Math::sampleTracks( &tracks[0], &cursors[0], &clocks[0], &out[0], tracks.size() );
+
+        for ( size_t i = 0; i < tracks.size(); ++i )
+        {
+            EXPECT_EQ( tracks[i].sample( clocks[i] ), out[i] );
+        }
+    }
+}
@@ -0,0 +1,215 @@
+/**
+ * Unit tests for the Halton, Sobol and Kronecker sequences
+ */
+#include <gtest/gtest.h>
+#include <smath/lowdiscrepancy.h>
+
+#include <set>
+#include <stdint.h>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector2<float> Vec2f;
+typedef TVector3<float> Vec3f;
+#endif
+
+namespace
+{
+    /**
+     * Returns true if count points fall one per cell of a columns by rows
+     * grid over the unit square.
+     */
+    bool onePerCell( const std::vector<Vec2f>& points, int columns, int rows )
+    {
+        std::set<int> cells;
+
+        for ( size_t i = 0; i < points.size(); ++i )
+        {
+            if ( points[i].x() < 0.0f || points[i].x() >= 1.0f ||
+                 points[i].y() < 0.0f || points[i].y() >= 1.0f )
+            {
+                return false;
+            }
+
+            int column = static_cast<int>( points[i].x() * columns );
+            int row    = static_cast<int>( points[i].y() * rows );
+
+            cells.insert( row * columns + column );
+        }
+
+        return static_cast<int>( cells.size() ) == columns * rows &&
+               static_cast<int>( points.size() ) == columns * rows;
+    }
+}
+
+TEST(Math,LowDiscrepancy_RadicalInverse)
+{
+    EXPECT_EQ( 0.0f, Math::radicalInverse2( 0 ) );
+    EXPECT_EQ( 0.5f, Math::radicalInverse2( 1 ) );
+    EXPECT_EQ( 0.25f, Math::radicalInverse2( 2 ) );
+    EXPECT_EQ( 0.75f, Math::radicalInverse2( 3 ) );
+
+    EXPECT_FLOAT_EQ( 1.0f / 3.0f, Math::radicalInverse( 1, 3 ) );
+    EXPECT_FLOAT_EQ( 2.0f / 3.0f, Math::radicalInverse( 2, 3 ) );
+    EXPECT_FLOAT_EQ( 1.0f / 9.0f, Math::radicalInverse( 3, 3 ) );
+    EXPECT_FLOAT_EQ( 0.2f, Math::radicalInverse( 1, 5 ) );
+    EXPECT_EQ( 0.25f, Math::radicalInverse( 2, 2 ) );
+
+    EXPECT_LT( Math::radicalInverse( 0xffffffffu, 3 ), 1.0f );
+}
+
+TEST(Math,LowDiscrepancy_HaltonStratified)
+{
+    const uint32_t Seeds[] = { 0, 1, 1234 };
+
+    for ( size_t s = 0; s < 3; ++s )
+    {
+        Math::HaltonSequence halton( Seeds[s] );
+        std::vector<Vec2f> points( 72 );
+
+        halton.generate( 0, &points[0], points.size() );
+
+        // 72 = 2^3 * 3^2
+        EXPECT_TRUE( onePerCell( points, 8, 9 ) ) << "seed " << Seeds[s];
+    }
+
+    Math::HaltonSequence plain;
+    EXPECT_EQ( Vec2f( 0.5f, 1.0f / 3.0f ), plain.point2( 1 ) );
+    EXPECT_FLOAT_EQ( 0.4f, plain.point3( 2 ).z() );
+
+    // Scrambling changes the points
+    Math::HaltonSequence scrambled( 99 );
+    EXPECT_NE( plain.point2( 5 ), scrambled.point2( 5 ) );
+}
+
+TEST(Math,LowDiscrepancy_SobolStratified)
+{
+    const uint32_t Seeds[] = { 0, 1, 1234 };
+
+    for ( size_t s = 0; s < 3; ++s )
+    {
+        Math::SobolSequence sobol( Seeds[s] );
+        std::vector<Vec2f> points( 256 );
+
+        // Both the first block and a later aligned block
+        sobol.generate( 0, &points[0], points.size() );
+        EXPECT_TRUE( onePerCell( points, 16, 16 ) ) << "seed " << Seeds[s];
+
+        sobol.generate( 1024, &points[0], points.size() );
+        EXPECT_TRUE( onePerCell( points, 16, 16 ) ) << "seed " << Seeds[s];
+
+        // Elementary intervals of other shapes
+        points.resize( 64 );
+        sobol.generate( 0, &points[0], points.size() );
+
+        EXPECT_TRUE( onePerCell( points, 64, 1 ) );
+        EXPECT_TRUE( onePerCell( points, 2, 32 ) );
+    }
+}
+
+TEST(Math,LowDiscrepancy_SobolThirdDimension)
+{
+    Math::SobolSequence sobol;
+    std::vector<Vec3f> points( 64 );
+    std::vector<Vec2f> xz( 64 ), yz( 64 );
+
+    sobol.generate( 0, &points[0], points.size() );
+
+    for ( size_t i = 0; i < points.size(); ++i )
+    {
+        xz[i] = Vec2f( points[i].x(), points[i].z() );
+        yz[i] = Vec2f( points[i].y(), points[i].z() );
+    }
+
+    EXPECT_TRUE( onePerCell( xz, 8, 8 ) );
+    EXPECT_TRUE( onePerCell( yz, 8, 8 ) );
+}
+
+TEST(Math,LowDiscrepancy_GenerateMatchesIndex)
+{
+    const uint32_t First = 1000;
+    const size_t Count = 100;
+
+    Math::HaltonSequence halton( 5 );
+    Math::SobolSequence sobol( 5 );
+    Math::KroneckerSequence kronecker( Vec3f( 0.1f, 0.2f, 0.3f ) );
+
+    std::vector<Vec2f> points2( Count );
+    std::vector<Vec3f> points3( Count );
+
+    halton.generate( First, &points2[0], Count );
+    halton.generate( First, &points3[0], Count );
+
+    for ( uint32_t i = 0; i < Count; ++i )
+    {
+        EXPECT_EQ( halton.point2( First + i ), points2[i] );
+        EXPECT_EQ( halton.point3( First + i ), points3[i] );
+    }
+
+    sobol.generate( First, &points2[0], Count );
+    sobol.generate( First, &points3[0], Count );
+
+    for ( uint32_t i = 0; i < Count; ++i )
+    {
+        EXPECT_EQ( sobol.point2( First + i ), points2[i] );
+        EXPECT_EQ( sobol.point3( First + i ), points3[i] );
+    }
+
+    kronecker.generate( First, &points2[0], Count );
+    kronecker.generate( First, &points3[0], Count );
+
+    for ( uint32_t i = 0; i < Count; ++i )
+    {
+        EXPECT_EQ( kronecker.point2( First + i ), points2[i] );
+        EXPECT_EQ( kronecker.point3( First + i ), points3[i] );
+    }
+}
+
+TEST(Math,LowDiscrepancy_Kronecker)
+{
+    Math::KroneckerSequence r2;
+
+    EXPECT_EQ( Vec2f( 0.5f, 0.5f ), r2.point2( 0 ) );
+    EXPECT_NEAR( 0.25487766f, r2.point2( 1 ).x(), 1e-6f );
+    EXPECT_NEAR( 0.06984029f, r2.point2( 1 ).y(), 1e-6f );
+
+    // Close to even coverage at any count, not only powers of two
+    std::vector<Vec2f> points( 100 );
+    r2.generate( 0, &points[0], points.size() );
+
+    int counts[4] = { 0, 0, 0, 0 };
+
+    for ( size_t i = 0; i < points.size(); ++i )
+    {
+        EXPECT_TRUE( points[i].x() >= 0.0f && points[i].x() < 1.0f );
+        EXPECT_TRUE( points[i].y() >= 0.0f && points[i].y() < 1.0f );
+
+        counts[ ( points[i].x() < 0.5f ? 0 : 1 ) + ( points[i].y() < 0.5f ? 0 : 2 ) ]++;
+    }
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        EXPECT_NEAR( 25, counts[i], 3 );
+    }
+
+    // Large indices stay exact
+    EXPECT_LT( r2.point3( 0xffffffffu ).z(), 1.0f );
+}
+
+TEST(Math,LowDiscrepancy_IntegratesFasterThanRandom)
+{
+    // Estimate the area of the quarter disk, pi / 4, from 1024 points
+    Math::SobolSequence sobol( 7 );
+    Math::KroneckerSequence r2;
+    int sobolInside = 0, r2Inside = 0;
+
+    for ( uint32_t i = 0; i < 1024; ++i )
+    {
+        sobolInside += lengthSquared( sobol.point2( i ) ) < 1.0f ? 1 : 0;
+        r2Inside += lengthSquared( r2.point2( i ) ) < 1.0f ? 1 : 0;
+    }
+
+    // Random points would be off by about 0.013 (one standard deviation)
+    EXPECT_NEAR( 0.785398, sobolInside / 1024.0, 0.006 );
+    EXPECT_NEAR( 0.785398, r2Inside / 1024.0, 0.006 );
+}
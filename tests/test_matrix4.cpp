@@ -8,20 +8,20 @@
 #include "unittesthelpers.h"
 
 #ifndef MATH_TYPEDEFS
-typedef TMatrix4<float> Mat4;
+typedef TMatrix4<float> Mat4f;
 #endif
 
 const float DELTA = 0.00001f;
 
 TEST(Math,Matrix4_NoValueCtor)
 {
-    Mat4 m();
+    Mat4f m();
     EXPECT_TRUE( true );   // no checks, just here to make sure compile
 }
 
 TEST(Math,Matrix4_ValueCtor)
 {
-    Mat4 m( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f m( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
@@ -58,7 +58,7 @@ TEST(Math,Matrix4_ValuePtrCtor)
                      6.0f, 5.0f, 1.0f, 6.6f,
                      9.0f, 7.0f, 0.0f, 8.8f };
 
-    Mat4 m( (float*) va );
+    Mat4f m( (float*) va );
 
     // first row
     EXPECT_FLOAT_EQ( 2.0f, m.at(0,0) );
@@ -87,23 +87,23 @@ TEST(Math,Matrix4_ValuePtrCtor)
 
 TEST(Math,Matrix4_CopyCtor)
 {
-    Mat4 m( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f m( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
 
-    Mat4 r( m );
+    Mat4f r( m );
 
     EXPECT_EQ( m, r );
 }
 
 TEST(Math,Matrix4_Assignment)
 {
-    Mat4 m( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f m( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
-    Mat4 r;
+    Mat4f r;
     
     // Make sure empty matrix != value constructed matrix
     EXPECT_NE( m, r );
@@ -117,41 +117,41 @@ TEST(Math,Matrix4_Addition)
 {
     // Verified by mathmatica
     // {{3.2f, -0.0f, 4.0f, 2.0f}, {-1.0f,  2.0f, 1.2f, 0.0f}, {3.0f,  1.0f, 7.0f, 2.5f}, {-2.0f,  4.0f, 5.0f, 6.0f}}
-    Mat4 a(  3.2f, -0.0f, 4.0f, 2.0f,
+    Mat4f a(  3.2f, -0.0f, 4.0f, 2.0f,
             -1.0f,  2.0f, 1.2f, 0.0f,
              3.0f,  1.0f, 7.0f, 2.5f,
             -2.0f,  4.0f, 5.0f, 6.0f );
 
     // {{1.1f, -2.0f, 1.5f, 3.0f}, {1.0f,  1.2f, 2.2f,-2.2f}, {4.0f,  0.0f, 1.5f, 0.2f}, {1.9f, -4.0f, 2.5f,-1.0f}}
-    Mat4 b(  1.1f, -2.0f, 1.5f, 3.0f,
+    Mat4f b(  1.1f, -2.0f, 1.5f, 3.0f,
              1.0f,  1.2f, 2.2f,-2.2f,
              4.0f,  0.0f, 1.5f, 0.2f,
              1.9f, -4.0f, 2.5f,-1.0f );
 
     // {{4.3f, -2., 5.5f, 5.}, {0., 3.2f, 3.4f, -2.2f}, {7., 1., 8.5f, 2.7f}, {-0.1f, 0., 7.5f, 5.}}
-    Mat4 v(  4.3f, -2.0f, 5.5f, 5.0f,
+    Mat4f v(  4.3f, -2.0f, 5.5f, 5.0f,
              0.0f,  3.2f, 3.4f,-2.2f,
              7.0f,  1.0f, 8.5f, 2.7f,
             -0.1f,  0.0f, 7.5f, 5.0f );
 
-    Mat4 r( a + b );
+    Mat4f r( a + b );
 
     EXPECT_TRUE( MatrixEquals( v, r ) );
 }
 
 TEST(Math,Matrix4_SelfAddition)
 {
-    Mat4 a(  3.2f, -0.0f, 4.0f, 2.0f,
+    Mat4f a(  3.2f, -0.0f, 4.0f, 2.0f,
             -1.0f,  2.0f, 1.2f, 0.0f,
              3.0f,  1.0f, 7.0f, 2.5f,
             -2.0f,  4.0f, 5.0f, 6.0f );
 
-    Mat4 b(  1.1f, -2.0f, 1.5f, 3.0f,
+    Mat4f b(  1.1f, -2.0f, 1.5f, 3.0f,
              1.0f,  1.2f, 2.2f,-2.2f,
              4.0f,  0.0f, 1.5f, 0.2f,
              1.9f, -4.0f, 2.5f,-1.0f );
 
-    Mat4 v(  4.3f, -2.0f, 5.5f, 5.0f,
+    Mat4f v(  4.3f, -2.0f, 5.5f, 5.0f,
              0.0f,  3.2f, 3.4f,-2.2f,
              7.0f,  1.0f, 8.5f, 2.7f,
             -0.1f,  0.0f, 7.5f, 5.0f );
@@ -165,39 +165,39 @@ TEST(Math,Matrix4_SelfAddition)
 
 TEST(Math,Matrix4_Subtraction)
 {
-    Mat4 a(  3.2f, -0.0f, 4.0f, 2.0f,
+    Mat4f a(  3.2f, -0.0f, 4.0f, 2.0f,
             -1.0f,  2.0f, 1.2f, 0.0f,
              3.0f,  1.0f, 7.0f, 2.5f,
             -2.0f,  4.0f, 5.0f, 6.0f );
 
-    Mat4 b(  1.1f, -2.0f, 1.5f, 3.0f,
+    Mat4f b(  1.1f, -2.0f, 1.5f, 3.0f,
              1.0f,  1.2f, 2.2f,-2.2f,
              4.0f,  0.0f, 1.5f, 0.2f,
              1.9f, -4.0f, 2.5f,-1.0f );
 
-    Mat4 v(  2.1f,  2.0f, 2.5f,-1.0f,
+    Mat4f v(  2.1f,  2.0f, 2.5f,-1.0f,
             -2.0f,  0.8f,-1.0f, 2.2f,
             -1.0f,  1.0f, 5.5f, 2.3f,
             -3.9f,  8.0f, 2.5f, 7.0f );
 
-    Mat4 r( a - b );
+    Mat4f r( a - b );
 
     EXPECT_TRUE( MatrixEquals( v, r ) );
 }
 
 TEST(Math,Matrix4_SelfSubtraction)
 {
-    Mat4 a(  3.2f, -0.0f, 4.0f, 2.0f,
+    Mat4f a(  3.2f, -0.0f, 4.0f, 2.0f,
             -1.0f,  2.0f, 1.2f, 0.0f,
              3.0f,  1.0f, 7.0f, 2.5f,
             -2.0f,  4.0f, 5.0f, 6.0f );
 
-    Mat4 b(  1.1f, -2.0f, 1.5f, 3.0f,
+    Mat4f b(  1.1f, -2.0f, 1.5f, 3.0f,
              1.0f,  1.2f, 2.2f,-2.2f,
              4.0f,  0.0f, 1.5f, 0.2f,
              1.9f, -4.0f, 2.5f,-1.0f );
 
-    Mat4 v(  2.1f,  2.0f, 2.5f,-1.0f,
+    Mat4f v(  2.1f,  2.0f, 2.5f,-1.0f,
             -2.0f,  0.8f,-1.0f, 2.2f,
             -1.0f,  1.0f, 5.5f, 2.3f,
             -3.9f,  8.0f, 2.5f, 7.0f );
@@ -210,17 +210,17 @@ TEST(Math,Matrix4_SelfSubtraction)
 
 TEST(Math,Matrix4_Multiplication)
 {
-    Mat4 a( 0.0f, 1.0f, 3.0f, 5.0f,
+    Mat4f a( 0.0f, 1.0f, 3.0f, 5.0f,
             2.0f, 3.0f, 8.0f, 9.0f,
             3.0f, 4.0f, 1.0f, 2.0f,
             7.0f, 0.0f, 6.0f, 6.0f );
 
-    Mat4 b( 2.0f, 1.0f, 4.0f, 8.0f,
+    Mat4f b( 2.0f, 1.0f, 4.0f, 8.0f,
             9.0f, 2.0f, 1.0f, 5.0f,
             7.0f, 6.0f, 6.0f, 7.0f,
             9.0f, 5.0f, 4.0f, 3.0f );
 
-    Mat4 v(  75.0f,  45.0f,  39.0f,  41.0f,
+    Mat4f v(  75.0f,  45.0f,  39.0f,  41.0f,
             168.0f, 101.0f,  95.0f, 114.0f,
              67.0f,  27.0f,  30.0f,  57.0f,
             110.0f,  73.0f,  88.0f, 116.0f );
@@ -230,17 +230,17 @@ TEST(Math,Matrix4_Multiplication)
 
 TEST(Math,Matrix4_Multiplication2)
 {
-        Mat4 a(  0.2f,  1.0f,  0.5f, -1.2f,
+        Mat4f a(  0.2f,  1.0f,  0.5f, -1.2f,
                  0.6f, -1.4f,  0.0f, -2.0f,
                 -0.1f, -1.1f,  0.3f, -0.0f,
                  1.0f,  0.5f,  0.2f,  0.8f );
 
-        Mat4 b(  0.4f,  0.5f,  0.6f, 1.0f,
+        Mat4f b(  0.4f,  0.5f,  0.6f, 1.0f,
                  0.2f,  1.0f,  1.5f, 1.2f,
                  0.8f,  1.4f,  0.1f, 0.1f,
                  0.6f,  1.8f,  0.9f, 1.1f );
 
-        Mat4 v(  -1.0f/25.0f,  -9.0f/25.0f,    59.0f/100.0f,   13.0f/100.0f,
+        Mat4f v(  -1.0f/25.0f,  -9.0f/25.0f,    59.0f/100.0f,   13.0f/100.0f,
                  -31.0f/25.0f, -47.0f/10.0f,  -177.0f/50.0f,  -82.0f/25.0f,
                  -1.0f/50.0f,  -73.0f/100.0f, -42.0f/25.0f,   -139.0f/100.0f,
                   57.0f/50.0f,  68.0f/25.0f,   209.0f/100.0f,  5.0f/2.0f );
@@ -250,12 +250,12 @@ TEST(Math,Matrix4_Multiplication2)
 
 TEST(Math,Matrix4_Transpose)
 {
-    Mat4 a(  1,  2,  3,  4,
+    Mat4f a(  1,  2,  3,  4,
              5,  6,  7,  8,
              9, 10, 11, 12,
             13, 14, 15, 16 );
 
-    Mat4 v(  1,  5,  9, 13,
+    Mat4f v(  1,  5,  9, 13,
              2,  6, 10, 14,
              3,  7, 11, 15,
              4,  8, 12, 16 );
@@ -267,7 +267,7 @@ TEST(Math,Matrix4_Determinant)
 {
     // verified by mathmatica
     // {{6, -7, 10, 2}, {0, 3, -1, 6}, {0, 5, -7, -1}, {3, 6, 1, 4}}
-    const Mat4 a( 6.0f, -7.0f, 10.0f,  2.0f,
+    const Mat4f a( 6.0f, -7.0f, 10.0f,  2.0f,
                   0.0f,  3.0f, -1.0f,  6.0f,
                   0.0f,  5.0f, -7.0f, -1.0f,
                   3.0f,  6.0f,  1.0f,  4.0f );
@@ -279,13 +279,13 @@ TEST(Math,Matrix4_Inverse)
 {
     // verified by mathmatica
     // {{6, -7, 10, 2}, {0, 3, -1, 6}, {0, 5, -7, -1}, {3, 6, 1, 4}}
-    const Mat4 a( 6.0f, -7.0f, 10.0f,  2.0f,
+    const Mat4f a( 6.0f, -7.0f, 10.0f,  2.0f,
                   0.0f,  3.0f, -1.0f,  6.0f,
                   0.0f,  5.0f, -7.0f, -1.0f,
                   3.0f,  6.0f,  1.0f,  4.0f );
    
     // N[Inverse[{{6, -7, 10, 2}, {0, 3, -1, 6}, {0, 5, -7, -1}, {3, 6, 1, 4}}]]
-    const Mat4 r(  0.165573f,  -0.0167761f, 0.239241f,   0.00218818f,
+    const Mat4f r(  0.165573f,  -0.0167761f, 0.239241f,   0.00218818f,
                   -0.0940919f, -0.109409f, -0.0919037f,  0.188184f,
                   -0.0722101f, -0.107221f, -0.210066f,   0.14442f,
                    0.0350109f,  0.203501f,  0.0109409f, -0.0700219f );
@@ -295,7 +295,7 @@ TEST(Math,Matrix4_Inverse)
 
 TEST(Math,Matrix4_SelfEquality)
 {
-    const Mat4 a( 6.0f, -7.0f, 10.0f,  2.0f,
+    const Mat4f a( 6.0f, -7.0f, 10.0f,  2.0f,
                   0.0f,  3.0f, -1.0f,  6.0f,
                   0.0f,  5.0f, -7.0f, -1.0f,
                   3.0f,  6.0f,  1.0f,  4.0f );
@@ -305,11 +305,11 @@ TEST(Math,Matrix4_SelfEquality)
 
 TEST(Math,Matrix4_Equality)
 {
-    Mat4 m( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f m( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
-    Mat4 n( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f n( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
@@ -327,7 +327,7 @@ TEST(Math,Matrix4_Equality)
 
 TEST(Math,Matrix4_SelfInequalityFalse)
 {
-    Mat4 m( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f m( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
@@ -337,11 +337,11 @@ TEST(Math,Matrix4_SelfInequalityFalse)
 
 TEST(Math,Matrix4_Inequality)
 {
-    Mat4 m( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f m( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
-    Mat4 n( 2.0f, 4.0f, 6.0f, 9.0f, 
+    Mat4f n( 2.0f, 4.0f, 6.0f, 9.0f, 
             1.2f, 3.0f, 5.0f, 7.0f,
             9.5f, 1.5f, 1.0f, 0.0f,
             2.8f, 9.8f, 6.6f, 8.8f );
@@ -357,12 +357,12 @@ TEST(Math,Matrix4_Inequality)
 
 TEST(Math,Matrix4_ZeroMatrix)
 {
-    Mat4 m( 0.0f, 0.0f, 0.0f, 0.0f,
+    Mat4f m( 0.0f, 0.0f, 0.0f, 0.0f,
             0.0f, 0.0f, 0.0f, 0.0f,
             0.0f, 0.0f, 0.0f, 0.0f,
             0.0f, 0.0f, 0.0f, 0.0f );
 
-    Mat4 n = Mat4::ZERO_MATRIX;
+    Mat4f n = Mat4f::ZERO_MATRIX;
 
     EXPECT_EQ( m, n );
 
@@ -372,11 +372,11 @@ TEST(Math,Matrix4_ZeroMatrix)
 
 TEST(Math,Matrix4_MakeIdentityMatrix)
 {
-    Mat4 a( 1.0f, 0.0f, 0.0f, 0.0f,
+    Mat4f a( 1.0f, 0.0f, 0.0f, 0.0f,
             0.0f, 1.0f, 0.0f, 0.0f,
             0.0f, 0.0f, 1.0f, 0.0f,
             0.0f, 0.0f, 0.0f, 1.0f );
-    Mat4 b = Mat4::IDENTITY;
+    Mat4f b = Mat4f::IDENTITY;
 
     EXPECT_EQ( a, b );
     EXPECT_TRUE( isIdentityMatrix( a ) );
@@ -384,11 +384,11 @@ TEST(Math,Matrix4_MakeIdentityMatrix)
 
 TEST(Math,Matrix4_IsIdentityMatrix)
 {
-    Mat4 a( 1.0f, 1.0f, 1.0f, 1.0f,
+    Mat4f a( 1.0f, 1.0f, 1.0f, 1.0f,
             1.0f, 1.0f, 1.0f, 1.0f,
             1.0f, 1.0f, 1.0f, 1.0f,
             1.0f, 1.0f, 1.0f, 0.0f );
-    Mat4 b( 1.0f, 0.0f, 0.0f, 0.0f,
+    Mat4f b( 1.0f, 0.0f, 0.0f, 0.0f,
             0.0f, 1.0f, 0.0f, 0.0f,
             0.0f, 0.0f, 1.0f, 0.0f,
             0.0f, 0.0f, 0.0f, 1.0f );
@@ -398,3 +398,23 @@ TEST(Math,Matrix4_IsIdentityMatrix)
 }
 
 
+
+TEST(Math,Matrix4_ConstantExpressions)
+{
+    constexpr Mat4f a(  1.0f,  2.0f,  3.0f,  4.0f,
+                       5.0f,  6.0f,  7.0f,  8.0f,
+                       9.0f, 10.0f, 11.0f, 12.0f,
+                      13.0f, 14.0f, 15.0f, 16.0f );
+    constexpr Mat4f b = transpose( a ) * Mat4f::IDENTITY + Mat4f::ZERO_MATRIX;
+    constexpr Mat4f c = a * b;
+
+    static_assert( trace( a ) == 34.0f, "trace must be a constant expression" );
+    static_assert( determinant( a ) == 0.0f, "determinant must be a constant expression" );
+    static_assert( determinant( Mat4f::IDENTITY * 2.0f ) == 16.0f, "" );
+
+    // a * transpose(a) holds the dot products of a's rows
+    EXPECT_EQ( 30.0f,  c.at( 0, 0 ) );
+    EXPECT_EQ( 70.0f,  c.at( 0, 1 ) );
+    EXPECT_EQ( 174.0f, c.at( 1, 1 ) );
+    EXPECT_EQ( 5.0f,   b.at( 0, 1 ) );
+}
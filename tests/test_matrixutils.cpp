@@ -6,32 +6,34 @@
 #include <smath/matrix.h>
 #include <smath/matrixutils.h>
 
+#include "unittesthelpers.h"
+
 #ifndef MATH_TYPEDEFS
-typedef TMatrix4<float> Mat4;
-typedef TVector3<float> Vec3;
+typedef TMatrix4<float> Mat4f;
+typedef TVector3<float> Vec3f;
 #endif
 
 TEST(Math,Math_RotationAroundX)
 {
-    Mat4 m = Math::createRotationAroundX<float>( 45.0f );
+    Mat4f m = Math::createRotationAroundX<float>( 45.0f );
     EXPECT_EQ( m, m );
 }
 
 TEST(Math,Math_RotationAroundY)
 {
-    Mat4 m = Math::createRotationAroundY<float>( 45.0f );
+    Mat4f m = Math::createRotationAroundY<float>( 45.0f );
     EXPECT_EQ( m, m );
 }
 
 TEST(Math,Math_RotationAroundZ)
 {
-    Mat4 m = Math::createRotationAroundZ<float>( 45.0f );
+    Mat4f m = Math::createRotationAroundZ<float>( 45.0f );
     EXPECT_EQ( m, m );
 }
 
 TEST(Math,Math_RotationAroundAxis)
 {
-    Mat4 m = Math::createRotationAroundAxis(
+    Mat4f m = Math::createRotationAroundAxis(
                     TVector3<float>( 1.0f, 0.0f, 0.0f ),
                     45.0f );
 
@@ -40,27 +42,27 @@ TEST(Math,Math_RotationAroundAxis)
 
 TEST(Math,Math_Translation)
 {
-    Mat4 m = Math::createTranslation( 45.0f, 5.0f, -6.0f );
+    Mat4f m = Math::createTranslation( 45.0f, 5.0f, -6.0f );
     EXPECT_EQ( m, m );
 }
 
 TEST(Math,Math_Scale)
 {
-    Mat4 m = Math::createScale( 4.0f );
+    Mat4f m = Math::createScale( 4.0f );
     EXPECT_EQ( m, m );
 }
 
 TEST(Math,Math_LookAt)
 {
-    Mat4 m = Math::createLookAt( Vec3( 2.0f, 5.0f, -8.0f ),
-                                 Vec3( 0.0f, 0.0f,  1.0f ),
-                                 Vec3( 0.0f, 1.0f,  0.0f ) );
+    Mat4f m = Math::createLookAt( Vec3f( 2.0f, 5.0f, -8.0f ),
+                                 Vec3f( 0.0f, 0.0f,  1.0f ),
+                                 Vec3f( 0.0f, 1.0f,  0.0f ) );
     EXPECT_EQ( m, m );
 }
 
 TEST(Math,Math_CreateFrustum)
 {
-    Mat4 m = Math::createFrustum( 30.0f,
+    Mat4f m = Math::createFrustum( 30.0f,
                                         55.0f,
                                         10.0f,
                                         75.0f,
@@ -71,7 +73,7 @@ TEST(Math,Math_CreateFrustum)
 
 TEST(Math,Math_CreateOrtho)
 {
-    Mat4 m = Math::createOrtho( 0.0f, 640.0f,
+    Mat4f m = Math::createOrtho( 0.0f, 640.0f,
                                       480.0f, 0.0f,
                                       0.01f,
                                       100.0f );
@@ -80,12 +82,123 @@ TEST(Math,Math_CreateOrtho)
 
 TEST(Math,Math_CreateRowOrder)
 {
-    Mat4 m = Math::createRowOrder<float>();
+    Mat4f m = Math::createRowOrder<float>();
     EXPECT_EQ( m, m );
 }
 
 TEST(Math,Math_CreateColOrder)
 {
-    Mat4 m = Math::createColOrder<float>();
+    Mat4f m = Math::createColOrder<float>();
     EXPECT_EQ( m, m );
 }
+
+namespace
+{
+    // Transforms a point (as a column vector) by the matrix and performs the
+    // perspective divide.
+    Vec3f project( const Mat4f& m, const Vec3f& p )
+    {
+        float v[4];
+
+        for ( unsigned int r = 0; r < 4; ++r )
+        {
+            v[r] = m.at(r,0) * p.x() + m.at(r,1) * p.y() +
+                   m.at(r,2) * p.z() + m.at(r,3);
+        }
+
+        return Vec3f( v[0] / v[3], v[1] / v[3], v[2] / v[3] );
+    }
+}
+
+TEST(Math,Math_ScaleValues)
+{
+    Mat4f m = Math::createScale( 4.0f );
+    Mat4f e( 4.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 4.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 4.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f );
+
+    EXPECT_TRUE( MatrixEquals( e, m ) );
+}
+
+TEST(Math,Math_LookAtValues)
+{
+    Vec3f eye( 2.0f, 5.0f, -8.0f );
+    Mat4f m = Math::createLookAt( eye,
+                                 Vec3f( 2.0f, 5.0f, -9.0f ),
+                                 Vec3f( 0.0f, 1.0f,  0.0f ) );
+
+    // Looking down -Z from the eye is a pure translation
+    EXPECT_TRUE( MatrixEquals( Math::createTranslation( -2.0f, -5.0f, 8.0f ), m ) );
+
+    // The eye itself always ends up at the view space origin
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f, 0.0f, 0.0f ), project( m, eye ) ) );
+}
+
+TEST(Math,Math_LookAtSideways)
+{
+    Mat4f m = Math::createLookAt( Vec3f( 0.0f, 0.0f, 0.0f ),
+                                 Vec3f( 1.0f, 0.0f, 0.0f ),
+                                 Vec3f( 0.0f, 1.0f, 0.0f ) );
+
+    // A point in front of the camera lies on the -Z axis in view space
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f, 0.0f, -3.0f ),
+                              project( m, Vec3f( 3.0f, 0.0f, 0.0f ) ) ) );
+
+    // Up is preserved
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f, 2.0f, 0.0f ),
+                              project( m, Vec3f( 0.0f, 2.0f, 0.0f ) ) ) );
+}
+
+TEST(Math,Math_FrustumValues)
+{
+    Mat4f m = Math::createFrustum( -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 10.0f );
+
+    EXPECT_TRUE( VectorEquals( Vec3f( -1.0f, -1.0f, -1.0f ),
+                              project( m, Vec3f( -1.0f, -1.0f, -1.0f ) ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f(  1.0f,  1.0f,  1.0f ),
+                              project( m, Vec3f( 10.0f, 10.0f, -10.0f ) ) ) );
+}
+
+TEST(Math,Math_PerspectiveMatchesFrustum)
+{
+    Mat4f a = Math::createPerspective( Math::HalfPi, 2.0f, 1.0f, 100.0f );
+    Mat4f b = Math::createFrustum( -2.0f, 2.0f, -1.0f, 1.0f, 1.0f, 100.0f );
+
+    EXPECT_TRUE( MatrixEquals( b, a ) );
+}
+
+TEST(Math,Math_PerspectiveReversedZ)
+{
+    Mat4f m = Math::createPerspectiveReversedZ( Math::HalfPi, 1.0f, 1.0f, 100.0f );
+
+    EXPECT_FLOAT_EQ( 1.0f, project( m, Vec3f( 0.0f, 0.0f, -1.0f ) ).z() );
+    EXPECT_NEAR( 0.0f, project( m, Vec3f( 0.0f, 0.0f, -100.0f ) ).z(), 1e-6f );
+}
+
+TEST(Math,Math_InfinitePerspective)
+{
+    Mat4f m = Math::createInfinitePerspective( Math::HalfPi, 1.0f, 1.0f );
+
+    EXPECT_FLOAT_EQ( -1.0f, project( m, Vec3f( 0.0f, 0.0f, -1.0f ) ).z() );
+    EXPECT_NEAR( 1.0f, project( m, Vec3f( 0.0f, 0.0f, -1e6f ) ).z(), 1e-5f );
+}
+
+TEST(Math,Math_InfinitePerspectiveReversedZ)
+{
+    Mat4f m = Math::createInfinitePerspectiveReversedZ( Math::HalfPi, 1.0f, 1.0f );
+
+    EXPECT_FLOAT_EQ( 1.0f, project( m, Vec3f( 0.0f, 0.0f, -1.0f ) ).z() );
+    EXPECT_FLOAT_EQ( 0.5f, project( m, Vec3f( 0.0f, 0.0f, -2.0f ) ).z() );
+    EXPECT_NEAR( 0.0f, project( m, Vec3f( 0.0f, 0.0f, -1e6f ) ).z(), 1e-5f );
+}
+
+TEST(Math,Math_OrthoValues)
+{
+    Mat4f m = Math::createOrtho( 0.0f, 640.0f, 480.0f, 0.0f, 1.0f, 100.0f );
+
+    EXPECT_TRUE( VectorEquals( Vec3f( -1.0f,  1.0f, -1.0f ),
+                              project( m, Vec3f( 0.0f, 0.0f, -1.0f ) ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f(  1.0f, -1.0f,  1.0f ),
+                              project( m, Vec3f( 640.0f, 480.0f, -100.0f ) ) ) );
+}
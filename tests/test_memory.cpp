@@ -0,0 +1,185 @@
+/**
+ * Unit tests for the aligned allocator and the arena allocator
+ */
+#include <gtest/gtest.h>
+#include <smath/memory.h>
+#include <smath/matrix.h>
+#include <smath/vector.h>
+
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector3<float> Vec3f;
+typedef TVector4<float> Vec4f;
+typedef TMatrix4<float> Mat4f;
+#endif
+
+namespace
+{
+    bool isAligned( const void * p, size_t alignment )
+    {
+        return ( reinterpret_cast<uintptr_t>( p ) & ( alignment - 1 ) ) == 0;
+    }
+}
+
+TEST(Math,Memory_AlignedAlloc)
+{
+    const size_t Alignments[] = { 1, 16, 32, 64, 4096 };
+
+    for ( size_t i = 0; i < sizeof( Alignments ) / sizeof( Alignments[0] ); ++i )
+    {
+        void * p = Math::alignedAlloc( 100, Alignments[i] );
+
+        ASSERT_TRUE( p != NULL );
+        EXPECT_TRUE( isAligned( p, Alignments[i] ) );
+
+        Math::alignedFree( p );
+    }
+
+    Math::alignedFree( NULL );
+}
+
+TEST(Math,Memory_AlignedVector)
+{
+    Math::AlignedVector<Vec4f, 16> a;
+    Math::AlignedVector<Mat4f, 64> b( 3, Mat4f::IDENTITY );
+    std::vector< Vec3f, Math::AlignedAllocator<Vec3f, 32> > c;
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        a.push_back( Vec4f( 1.0f, 2.0f, 3.0f, static_cast<float>( i ) ) );
+        c.push_back( Vec3f( 1.0f, 2.0f, static_cast<float>( i ) ) );
+
+        EXPECT_TRUE( isAligned( a.data(), 16 ) );
+        EXPECT_TRUE( isAligned( c.data(), 32 ) );
+    }
+
+    EXPECT_TRUE( isAligned( b.data(), 64 ) );
+    EXPECT_EQ( Mat4f::IDENTITY, b[2] );
+    EXPECT_EQ( 99.0f, a[99].w() );
+    EXPECT_EQ( 99.0f, c[99].z() );
+}
+
+TEST(Math,Memory_ArenaAlignmentAndReuse)
+{
+    Math::Arena arena( 1024 );
+
+    EXPECT_EQ( 0u, arena.capacity() );
+
+    char * p1 = static_cast<char *>( arena.allocate( 3, 1 ) );
+    Vec4f * p2 = arena.allocateArray<Vec4f>( 10 );
+    void * p3 = arena.allocate( 8, 16 );
+
+    ASSERT_TRUE( p1 != NULL && p2 != NULL && p3 != NULL );
+    EXPECT_TRUE( isAligned( p2, Math::CacheLineSize ) );
+    EXPECT_TRUE( isAligned( p3, 16 ) );
+    EXPECT_EQ( 1024u, arena.capacity() );
+
+    // Everything is released at once and the block is reused
+    arena.reset();
+
+    EXPECT_EQ( 0u, arena.bytesUsed() );
+    EXPECT_EQ( p1, arena.allocate( 3, 1 ) );
+    EXPECT_EQ( 1024u, arena.capacity() );
+}
+
+TEST(Math,Memory_ArenaGrowsAndKeepsBlocks)
+{
+    Math::Arena arena( 256 );
+
+    // Larger than a block, gets a block of its own
+    Vec3f * pLarge = arena.allocateArray<Vec3f>( 100 );
+    ASSERT_TRUE( pLarge != NULL );
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        pLarge[i] = Vec3f( 1.0f, 2.0f, 3.0f );
+    }
+
+    for ( int i = 0; i < 20; ++i )
+    {
+        ASSERT_TRUE( arena.allocate( 64 ) != NULL );
+    }
+
+    size_t capacity = arena.capacity();
+    EXPECT_GE( capacity, 100 * sizeof( Vec3f ) + 20 * 64 );
+
+    // A second frame of the same shape allocates no new blocks
+    arena.reset();
+
+    EXPECT_TRUE( arena.allocateArray<Vec3f>( 100 ) != NULL );
+
+    for ( int i = 0; i < 20; ++i )
+    {
+        ASSERT_TRUE( arena.allocate( 64 ) != NULL );
+    }
+
+    EXPECT_EQ( capacity, arena.capacity() );
+
+    arena.release();
+    EXPECT_EQ( 0u, arena.capacity() );
+}
+
+TEST(Math,Memory_ArenaMarkAndScope)
+{
+    Math::Arena arena( 512 );
+    arena.allocate( 32 );
+
+    size_t used = arena.bytesUsed();
+    Math::Arena::Marker marker = arena.mark();
+
+    void * p = arena.allocate( 100 );
+    arena.allocate( 1000 );
+    arena.rewind( marker );
+
+    EXPECT_EQ( used, arena.bytesUsed() );
+    EXPECT_EQ( p, arena.allocate( 100 ) );
+
+    used = arena.bytesUsed();
+
+    {
+        Math::ArenaScope scope( arena );
+        arena.allocate( 200 );
+        EXPECT_LT( used, arena.bytesUsed() );
+    }
+
+    EXPECT_EQ( used, arena.bytesUsed() );
+}
+
+TEST(Math,Memory_ArenaAllocator)
+{
+    Math::Arena arena( 4096 );
+
+    {
+        Math::ArenaAllocator<Vec3f> allocator( arena );
+        std::vector< Vec3f, Math::ArenaAllocator<Vec3f> > points( allocator );
+
+        for ( int i = 0; i < 50; ++i )
+        {
+            points.push_back( Vec3f( static_cast<float>( i ), 0.0f, 0.0f ) );
+        }
+
+        EXPECT_EQ( 49.0f, points[49].x() );
+        EXPECT_GE( arena.bytesUsed(), 50 * sizeof( Vec3f ) );
+    }
+
+    arena.reset();
+    EXPECT_EQ( 0u, arena.bytesUsed() );
+}
+
+TEST(Math,Memory_ThreadArenasAreDistinct)
+{
+    Math::Arena * pMain = &Math::threadArena();
+    Math::Arena * pOther = NULL;
+
+    std::thread worker( [&pOther]() {
+        pOther = &Math::threadArena();
+        pOther->allocate( 128 );
+    } );
+    worker.join();
+
+    EXPECT_EQ( pMain, &Math::threadArena() );
+    EXPECT_NE( pMain, pOther );
+}
@@ -0,0 +1,269 @@
+/**
+ * Unit tests for the packed half, snorm16, normal and quaternion formats
+ */
+#include <gtest/gtest.h>
+#include <smath/packing.h>
+#include <smath/cpu.h>
+#include "unittesthelpers.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector3<float> Vec3f;
+typedef TVector4<float> Vec4f;
+typedef TQuaternion<float> Quatf;
+#endif
+
+namespace
+{
+    Vec3f nextDirection( unsigned int& state )
+    {
+        Vec3f v;
+
+        do
+        {
+            v = Vec3f( nextTestFloat( state ), nextTestFloat( state ), nextTestFloat( state ) );
+        }
+        while ( lengthSquared( v ) < 0.01f || lengthSquared( v ) > 1.0f );
+
+        return v / std::sqrt( lengthSquared( v ) );
+    }
+
+    Quatf nextRotation( unsigned int& state )
+    {
+        Quatf q;
+        float n;
+
+        do
+        {
+            q = Quatf( nextTestFloat( state ), nextTestFloat( state ),
+                       nextTestFloat( state ), nextTestFloat( state ) );
+            n = normal( q );
+        }
+        while ( n < 0.1f || n > 1.0f );
+
+        return normalize( q );
+    }
+}
+
+TEST(Math,Packing_Half)
+{
+    EXPECT_EQ( 0x0000, Math::packHalf( 0.0f ) );
+    EXPECT_EQ( 0x8000, Math::packHalf( -0.0f ) );
+    EXPECT_EQ( 0x3c00, Math::packHalf( 1.0f ) );
+    EXPECT_EQ( 0xc000, Math::packHalf( -2.0f ) );
+    EXPECT_EQ( 0x3555, Math::packHalf( 1.0f / 3.0f ) );
+    EXPECT_EQ( 0x7bff, Math::packHalf( 65504.0f ) );
+    EXPECT_EQ( 0x0400, Math::packHalf( 6.103515625e-05f ) );
+    EXPECT_EQ( 0x0001, Math::packHalf( 5.9604645e-08f ) );
+    EXPECT_EQ( 0x0000, Math::packHalf( 2.0e-08f ) );
+
+    // Ties round to even
+    EXPECT_EQ( 0x3c00, Math::packHalf( 1.0f + 1.0f / 2048.0f ) );
+    EXPECT_EQ( 0x3c02, Math::packHalf( 1.0f + 3.0f / 2048.0f ) );
+
+    // Overflow, infinity and NaN
+    EXPECT_EQ( 0x7bff, Math::packHalf( 65519.0f ) );
+    EXPECT_EQ( 0x7c00, Math::packHalf( 65520.0f ) );
+    EXPECT_EQ( 0x7c00, Math::packHalf( 1.0e10f ) );
+    EXPECT_EQ( 0xfc00, Math::packHalf( -std::numeric_limits<float>::infinity() ) );
+    EXPECT_EQ( 0x7e00, Math::packHalf( std::numeric_limits<float>::quiet_NaN() ) & 0x7fff );
+
+    // Every half survives the round trip exactly
+    for ( uint32_t h = 0; h < 0x10000; ++h )
+    {
+        const float f = Math::unpackHalf( static_cast<uint16_t>( h ) );
+
+        if ( ( h & 0x7c00 ) == 0x7c00 && ( h & 0x03ff ) != 0 )
+        {
+            EXPECT_TRUE( f != f );
+            continue;
+        }
+
+        ASSERT_EQ( h, Math::packHalf( f ) ) << std::hex << h;
+    }
+
+    EXPECT_EQ( 1.0f, Math::unpackHalf( 0x3c00 ) );
+    EXPECT_EQ( 65504.0f, Math::unpackHalf( 0x7bff ) );
+    EXPECT_EQ( 5.9604645e-08f, Math::unpackHalf( 0x0001 ) );
+    EXPECT_EQ( 0x80000000u, bitsOf( Math::unpackHalf( 0x8000 ) ) );
+    EXPECT_EQ( std::numeric_limits<float>::infinity(), Math::unpackHalf( 0x7c00 ) );
+}
+
+TEST(Math,Packing_Snorm16)
+{
+    EXPECT_EQ( 0, Math::packSnorm16( 0.0f ) );
+    EXPECT_EQ( 32767, Math::packSnorm16( 1.0f ) );
+    EXPECT_EQ( -32767, Math::packSnorm16( -1.0f ) );
+    EXPECT_EQ( 32767, Math::packSnorm16( 4.0f ) );
+    EXPECT_EQ( -32767, Math::packSnorm16( -4.0f ) );
+    EXPECT_EQ( 16384, Math::packSnorm16( 0.5f ) );
+
+    EXPECT_EQ( 1.0f, Math::unpackSnorm16( 32767 ) );
+    EXPECT_EQ( -1.0f, Math::unpackSnorm16( -32767 ) );
+    EXPECT_EQ( -1.0f, Math::unpackSnorm16( -32768 ) );
+    EXPECT_EQ( 0.0f, Math::unpackSnorm16( 0 ) );
+
+    unsigned int state = 3;
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        const float v = nextTestFloat( state );
+        EXPECT_NEAR( v, Math::unpackSnorm16( Math::packSnorm16( v ) ), 0.5f / 32767.0f + 1e-7f );
+    }
+}
+
+TEST(Math,Packing_Octahedral)
+{
+    const Vec3f axes[] = { Vec3f( 1, 0, 0 ), Vec3f( -1, 0, 0 ), Vec3f( 0, 1, 0 ),
+                          Vec3f( 0, -1, 0 ), Vec3f( 0, 0, 1 ), Vec3f( 0, 0, -1 ) };
+
+    for ( int i = 0; i < 6; ++i )
+    {
+        const Vec3f n = Math::unpackOctahedral( Math::packOctahedral( axes[i] ) );
+        EXPECT_NEAR( 0.0f, std::sqrt( lengthSquared( axes[i] - n ) ), 1e-6f ) << i;
+    }
+
+    unsigned int state = 5;
+    float worst = 0.0f;
+
+    for ( int i = 0; i < 10000; ++i )
+    {
+        const Vec3f v = nextDirection( state );
+        const Vec3f n = Math::unpackOctahedral( Math::packOctahedral( v ) );
+
+        EXPECT_NEAR( 1.0f, lengthSquared( n ), 1e-5f );
+        worst = std::max( worst, std::sqrt( lengthSquared( v - n ) ) );
+    }
+
+    // About 0.004 degrees
+    EXPECT_LT( worst, 8e-5f );
+}
+
+TEST(Math,Packing_Quaternion)
+{
+    const float half = std::sqrt( 0.5f );
+    const Quatf exact[] = { Quatf( 1, 0, 0, 0 ), Quatf( 0, 0, 0, -1 ), Quatf( half, 0, -half, 0 ) };
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        const Quatf q = Math::unpackQuaternion( Math::packQuaternion( exact[i] ) );
+        const float sign = q[0] * exact[i][0] + q[1] * exact[i][1] + q[2] * exact[i][2] +
+                           q[3] * exact[i][3] < 0 ? -1.0f : 1.0f;
+
+        for ( int c = 0; c < 4; ++c )
+        {
+            EXPECT_NEAR( exact[i][c], sign * q[c], 5e-5f ) << i;
+        }
+    }
+
+    unsigned int state = 7;
+
+    for ( int i = 0; i < 10000; ++i )
+    {
+        const Quatf expected = nextRotation( state );
+        const Quatf q = Math::unpackQuaternion( Math::packQuaternion( expected ) );
+
+        float dot = 0.0f;
+
+        for ( int c = 0; c < 4; ++c )
+        {
+            dot += expected[c] * q[c];
+        }
+
+        // Same rotation, possibly negated, to about 2e-5 per component
+        const float sign = dot < 0.0f ? -1.0f : 1.0f;
+
+        for ( int c = 0; c < 4; ++c )
+        {
+            ASSERT_NEAR( expected[c], sign * q[c], 6e-5f ) << i;
+        }
+    }
+}
+
+TEST(Math,Packing_EveryLevelMatchesScalar)
+{
+    unsigned int state = 11;
+
+    std::vector<float> values( LevelTestCount );
+    std::vector<Vec3f> normals( LevelTestCount );
+    std::vector<Quatf> rotations( LevelTestCount );
+
+    for ( size_t i = 0; i < LevelTestCount; ++i )
+    {
+        values[i]    = nextTestFloat( state ) * 70000.0f * std::pow( 2.0f, -30.0f * std::abs( nextTestFloat( state ) ) );
+        normals[i]   = nextDirection( state );
+        rotations[i] = nextRotation( state );
+    }
+
+    forEachInstructionSet( [&]()
+    {
+        std::vector<uint16_t> halves( LevelTestCount );
+        std::vector<float> floats( LevelTestCount );
+
+        Math::batch::packHalf( &values[0], &halves[0], LevelTestCount );
+        Math::batch::unpackHalf( &halves[0], &floats[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            ASSERT_EQ( Math::packHalf( values[i] ), halves[i] ) << values[i];
+            ASSERT_EQ( bitsOf( Math::unpackHalf( halves[i] ) ), bitsOf( floats[i] ) );
+        }
+
+        std::vector<int16_t> snorms( 3 * LevelTestCount );
+        std::vector<Vec3f> vectors( LevelTestCount );
+
+        Math::batch::packSnorm16( &normals[0], &snorms[0], LevelTestCount, 0.5f );
+        Math::batch::unpackSnorm16( &snorms[0], &vectors[0], LevelTestCount, 0.5f );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            for ( int c = 0; c < 3; ++c )
+            {
+                ASSERT_EQ( Math::packSnorm16( normals[i][c] * 2.0f ), snorms[ 3 * i + c ] );
+                ASSERT_EQ( Math::unpackSnorm16( snorms[ 3 * i + c ] ) * 0.5f, vectors[i][c] );
+            }
+        }
+
+        std::vector<Math::PackedNormal> packedNormals( LevelTestCount );
+
+        Math::batch::packOctahedral( &normals[0], &packedNormals[0], LevelTestCount );
+        Math::batch::unpackOctahedral( &packedNormals[0], &vectors[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            const Math::PackedNormal expected = Math::packOctahedral( normals[i] );
+            const Vec3f n = Math::unpackOctahedral( expected );
+
+            ASSERT_EQ( expected.bits[0], packedNormals[i].bits[0] );
+            ASSERT_EQ( expected.bits[1], packedNormals[i].bits[1] );
+            EXPECT_NEAR( n[0], vectors[i][0], 1e-6f );
+            EXPECT_NEAR( n[1], vectors[i][1], 1e-6f );
+            EXPECT_NEAR( n[2], vectors[i][2], 1e-6f );
+        }
+
+        std::vector<Math::PackedQuaternion> packedRotations( LevelTestCount );
+        std::vector<Quatf> quats( LevelTestCount );
+
+        Math::batch::packQuaternion( &rotations[0], &packedRotations[0], LevelTestCount );
+        Math::batch::unpackQuaternion( &packedRotations[0], &quats[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            const Math::PackedQuaternion expected = Math::packQuaternion( rotations[i] );
+            const Quatf q = Math::unpackQuaternion( expected );
+
+            for ( int w = 0; w < 3; ++w )
+            {
+                ASSERT_EQ( expected.bits[w], packedRotations[i].bits[w] );
+            }
+
+            for ( int c = 0; c < 4; ++c )
+            {
+                EXPECT_NEAR( q[c], quats[i][c], 1e-6f );
+            }
+        }
+    } );
+}
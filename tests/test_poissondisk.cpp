@@ -0,0 +1,214 @@
+/**
+ * Unit tests for Poisson-disk sampling and blue noise tiles
+ */
+#include <gtest/gtest.h>
+#include <smath/poissondisk.h>
+
+#include <cmath>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector2<float> Vec2f;
+typedef TVector3<float> Vec3f;
+#endif
+
+namespace
+{
+    /**
+     * Returns the smallest distance between two points, comparing every
+     * pair. Distances are measured around a square of the given period if
+     * it is positive.
+     */
+    float minimumDistance( const std::vector<Vec2f>& points, float period = 0.0f )
+    {
+        float closest = HUGE_VALF;
+
+        for ( size_t i = 0; i < points.size(); ++i )
+        {
+            for ( size_t j = i + 1; j < points.size(); ++j )
+            {
+                float dx = std::fabs( points[i].x() - points[j].x() );
+                float dy = std::fabs( points[i].y() - points[j].y() );
+
+                if ( period > 0.0f )
+                {
+                    dx = std::min( dx, period - dx );
+                    dy = std::min( dy, period - dy );
+                }
+
+                closest = std::min( closest, std::sqrt( dx * dx + dy * dy ) );
+            }
+        }
+
+        return closest;
+    }
+
+    float minimumDistance( const std::vector<Vec3f>& points )
+    {
+        float closest = HUGE_VALF;
+
+        for ( size_t i = 0; i < points.size(); ++i )
+        {
+            for ( size_t j = i + 1; j < points.size(); ++j )
+            {
+                closest = std::min( closest, std::sqrt( lengthSquared( points[i] - points[j] ) ) );
+            }
+        }
+
+        return closest;
+    }
+
+    /**
+     * Returns true if every point of a grid over the area lies within
+     * maxGap of some point in the set.
+     */
+    bool coversArea( const std::vector<Vec2f>& points, const RectF& area, float maxGap )
+    {
+        for ( float y = area.top() + 0.5f * maxGap; y < area.bottom(); y += maxGap )
+        {
+            for ( float x = area.left() + 0.5f * maxGap; x < area.right(); x += maxGap )
+            {
+                bool covered = false;
+
+                for ( size_t i = 0; i < points.size() && !covered; ++i )
+                {
+                    covered = lengthSquared( points[i] - Vec2f( x, y ) ) < maxGap * maxGap;
+                }
+
+                if ( !covered )
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+TEST(Math,PoissonDisk_RespectsRadiusAndBounds)
+{
+    FastRandom random( 1 );
+    const RectF bounds( -10.0f, 5.0f, 30.0f, 20.0f );
+    std::vector<Vec2f> points;
+
+    Math::poissonDisk( bounds, 1.0f, random, points );
+
+    // Maximal packings hold between about 0.6 and 0.9 points per r^2
+    EXPECT_GT( points.size(), 300u );
+    EXPECT_LT( points.size(), 600u );
+    EXPECT_GE( minimumDistance( points ), 1.0f );
+
+    for ( size_t i = 0; i < points.size(); ++i )
+    {
+        EXPECT_TRUE( bounds.contains( points[i] ) );
+    }
+
+    // No gap is left where another point would fit
+    EXPECT_TRUE( coversArea( points, bounds, 2.0f ) );
+}
+
+TEST(Math,PoissonDisk_IsDeterministic)
+{
+    FastRandom a( 7 ), b( 7 ), c( 8 );
+    std::vector<Vec2f> first, second, third;
+    const RectF bounds( 0.0f, 0.0f, 10.0f, 10.0f );
+
+    Math::poissonDisk( bounds, 0.5f, a, first );
+    Math::poissonDisk( bounds, 0.5f, b, second );
+    Math::poissonDisk( bounds, 0.5f, c, third );
+
+    EXPECT_EQ( first, second );
+    EXPECT_NE( first, third );
+
+    // Replaces rather than appends
+    Math::poissonDisk( bounds, 20.0f, a, first );
+    EXPECT_EQ( 1u, first.size() );
+}
+
+TEST(Math,PoissonDisk_ThreeDimensions)
+{
+    Random random( 3 );
+    const Vec3f minCorner( -2.0f, 0.0f, 1.0f );
+    const Vec3f maxCorner( 3.0f, 4.0f, 4.0f );
+    std::vector<Vec3f> points;
+
+    Math::poissonDisk( minCorner, maxCorner, 0.5f, random, points );
+
+    EXPECT_GT( points.size(), 200u );
+    EXPECT_GE( minimumDistance( points ), 0.5f );
+
+    for ( size_t i = 0; i < points.size(); ++i )
+    {
+        EXPECT_TRUE( points[i].x() >= minCorner.x() && points[i].x() < maxCorner.x() );
+        EXPECT_TRUE( points[i].y() >= minCorner.y() && points[i].y() < maxCorner.y() );
+        EXPECT_TRUE( points[i].z() >= minCorner.z() && points[i].z() < maxCorner.z() );
+    }
+}
+
+TEST(Math,PoissonDisk_AlignedRandomMatchesRandom)
+{
+    // Same engine and sequence, only the alignment differs
+    Random random( 9 );
+    AlignedRandom aligned( 9 );
+    std::vector<Vec3f> expected, points;
+
+    Math::poissonDisk( Vec3f( 0.0f, 0.0f, 0.0f ), Vec3f( 2.0f, 2.0f, 2.0f ), 0.5f, random, expected );
+    Math::poissonDisk( Vec3f( 0.0f, 0.0f, 0.0f ), Vec3f( 2.0f, 2.0f, 2.0f ), 0.5f, aligned, points );
+    EXPECT_EQ( expected, points );
+
+    Math::BlueNoiseTile tile;
+    tile.generate( 0.1f, aligned );
+    EXPECT_GT( tile.points().size(), 10u );
+}
+
+TEST(Math,PoissonDisk_TileWrapsAround)
+{
+    FastRandom random( 11 );
+    Math::BlueNoiseTile tile;
+
+    EXPECT_EQ( 0u, tile.size() );
+
+    tile.generate( 0.05f, random );
+
+    EXPECT_EQ( 0.05f, tile.radius() );
+    EXPECT_GT( tile.size(), 200u );
+
+    for ( size_t i = 0; i < tile.size(); ++i )
+    {
+        EXPECT_TRUE( tile.points()[i].x() >= 0.0f && tile.points()[i].x() < 1.0f );
+        EXPECT_TRUE( tile.points()[i].y() >= 0.0f && tile.points()[i].y() < 1.0f );
+    }
+
+    // Distances across the edges count too
+    EXPECT_GE( minimumDistance( tile.points(), 1.0f ), 0.05f );
+}
+
+TEST(Math,PoissonDisk_ScatterIsSeamless)
+{
+    FastRandom random( 5 );
+    Math::BlueNoiseTile tile;
+    tile.generate( 0.1f, random );
+
+    // A region spanning several copies, including negative coordinates
+    const RectF region( -13.0f, -7.0f, 35.0f, 22.0f );
+    std::vector<Vec2f> points;
+
+    tile.scatter( region, 10.0f, points );
+
+    EXPECT_GE( minimumDistance( points ), 1.0f - 1e-4f );
+    EXPECT_TRUE( coversArea( points, region, 2.0f ) );
+
+    for ( size_t i = 0; i < points.size(); ++i )
+    {
+        EXPECT_TRUE( region.contains( points[i] ) );
+    }
+
+    // Regions sharing an edge divide the points between them
+    std::vector<Vec2f> halves;
+
+    tile.scatter( RectF( -13.0f, -7.0f, 15.0f, 22.0f ), 10.0f, halves );
+    tile.scatter( RectF( 2.0f, -7.0f, 20.0f, 22.0f ), 10.0f, halves );
+
+    EXPECT_EQ( points.size(), halves.size() );
+}
@@ -9,25 +9,25 @@
 #include "unittesthelpers.h"
 
 #ifndef MATH_TYPEDEFS
-typedef TQuaternion<float> Quat;
+typedef TQuaternion<float> Quatf;
 #endif
 
 TEST(Math, Quaternion_DefaultContructor)
 {
-    const Quat q;
+    const Quatf q;
     EXPECT_TRUE( true );      // test here just to make sure it compiles
 }
 
 TEST(Math, Quaternion_SizeTest)
 {
     // Verify that the quaternion is 16 bytes in size (4 * 4)
-    const Quat q( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf q( 1.0f, 2.0f, 3.0f, 4.0f );
     EXPECT_EQ( 16u, sizeof(q) );
 }
 
 TEST(Math, Quaternion_ValueConstructor)
 {
-    Quat q( 3.0f, 2.0f, -4.0f, 6.0f );
+    Quatf q( 3.0f, 2.0f, -4.0f, 6.0f );
 
     EXPECT_FLOAT_EQ(  3.0f, q.w() );
     EXPECT_FLOAT_EQ(  2.0f, q.x() );
@@ -37,8 +37,8 @@ TEST(Math, Quaternion_ValueConstructor)
 
 TEST(Math, Quaternion_CopyConstructor)
 {
-    const Quat a( 1.0f, -2.0f, 0.2f, 3.5f );
-    const Quat q( a );
+    const Quatf a( 1.0f, -2.0f, 0.2f, 3.5f );
+    const Quatf q( a );
 
     EXPECT_FLOAT_EQ(  1.0f, q.w() );
     EXPECT_FLOAT_EQ( -2.0f, q.x() );
@@ -48,7 +48,7 @@ TEST(Math, Quaternion_CopyConstructor)
 
 TEST(Math, Quaternion_ConstIndexOperatorRead)
 {
-    const Quat q( 1.0f, -2.0f, 0.2f, 3.5f );
+    const Quatf q( 1.0f, -2.0f, 0.2f, 3.5f );
 
     EXPECT_FLOAT_EQ(  1.0f, q[0] );
     EXPECT_FLOAT_EQ( -2.0f, q[1] );
@@ -58,7 +58,7 @@ TEST(Math, Quaternion_ConstIndexOperatorRead)
 
 TEST(Math, Quaternion_IndexOperatorWrite)
 {
-    Quat q( 1.0f, -2.0f, 0.2f, 3.5f );
+    Quatf q( 1.0f, -2.0f, 0.2f, 3.5f );
 
     q[0] =  2.0f;
     q[1] =  0.2f;
@@ -74,23 +74,23 @@ TEST(Math, Quaternion_IndexOperatorWrite)
 
 TEST(Math, Quaternion_Assignment)
 {
-    Quat a( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat b( 3.0f, 4.0f, 5.0f, 6.0f );
+    Quatf a( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf b( 3.0f, 4.0f, 5.0f, 6.0f );
     
     a = b;
 
-    EXPECT_NE( Quat( 1.0f, 2.0f, 3.0f, 4.0f ), a );
-    EXPECT_EQ( Quat( 3.0f, 4.0f, 5.0f, 6.0f ), a );
+    EXPECT_NE( Quatf( 1.0f, 2.0f, 3.0f, 4.0f ), a );
+    EXPECT_EQ( Quatf( 3.0f, 4.0f, 5.0f, 6.0f ), a );
 }
 
 TEST(Math, Quaternion_Equality)
 {
-    const Quat a( 1.5f, -0.2f, 0.0f, 1.0f );
-    const Quat b( 1.5f,  0.2f, 0.0f, 0.7f );
-    const Quat c( 1.5f, -0.2f, 0.1f, 1.0f );
-    const Quat d( 1.5f,  0.0f,-0.2f, 0.2f );
-    const Quat e( 0.0f,  1.5f,-0.2f, 0.2f );
-    const Quat f( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Quatf a( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Quatf b( 1.5f,  0.2f, 0.0f, 0.7f );
+    const Quatf c( 1.5f, -0.2f, 0.1f, 1.0f );
+    const Quatf d( 1.5f,  0.0f,-0.2f, 0.2f );
+    const Quatf e( 0.0f,  1.5f,-0.2f, 0.2f );
+    const Quatf f( 1.5f, -0.2f, 0.0f, 1.0f );
 
     EXPECT_EQ( a, f );
     EXPECT_EQ( a, a );
@@ -104,12 +104,12 @@ TEST(Math, Quaternion_Equality)
 
 TEST(Math, Quaternion_Inequality)
 {
-    const Quat a( 1.5f, -0.2f, 0.0f, 1.0f );
-    const Quat b( 1.5f,  0.2f, 0.0f, 0.7f );
-    const Quat c( 1.5f, -0.2f, 0.1f, 1.0f );
-    const Quat d( 1.5f,  0.0f,-0.2f, 0.2f );
-    const Quat e( 0.0f,  1.5f,-0.2f, 0.2f );
-    const Quat f( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Quatf a( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Quatf b( 1.5f,  0.2f, 0.0f, 0.7f );
+    const Quatf c( 1.5f, -0.2f, 0.1f, 1.0f );
+    const Quatf d( 1.5f,  0.0f,-0.2f, 0.2f );
+    const Quatf e( 0.0f,  1.5f,-0.2f, 0.2f );
+    const Quatf f( 1.5f, -0.2f, 0.0f, 1.0f );
 
     EXPECT_TRUE( a != b );
     EXPECT_TRUE( a != c );
@@ -121,69 +121,69 @@ TEST(Math, Quaternion_Inequality)
 
 TEST(Math, Quaternion_Addition)
 {
-    const Quat a(  1.0f, 2.0f, 3.0f,  4.0f );
-    const Quat b( -1.5f, 2.5f, 3.5f, -4.2f );
-    const Quat r = a + b;
+    const Quatf a(  1.0f, 2.0f, 3.0f,  4.0f );
+    const Quatf b( -1.5f, 2.5f, 3.5f, -4.2f );
+    const Quatf r = a + b;
 
-    EXPECT_EQ( Quat( -0.5f, 4.5f, 6.5f, -0.2f ), r );
+    EXPECT_EQ( Quatf( -0.5f, 4.5f, 6.5f, -0.2f ), r );
 }
 
 TEST(Math, Quaternion_SelfAddition)
 {
-    const Quat a(  1.0f, 2.0f, 3.0f,  4.0f );
-    const Quat b( -1.5f, 2.5f, 3.5f, -4.2f );
+    const Quatf a(  1.0f, 2.0f, 3.0f,  4.0f );
+    const Quatf b( -1.5f, 2.5f, 3.5f, -4.2f );
 
-    Quat r  = a;
+    Quatf r  = a;
          r += b;  
 
-    EXPECT_EQ( Quat( -0.5f, 4.5f, 6.5f, -0.2f ), r );
+    EXPECT_EQ( Quatf( -0.5f, 4.5f, 6.5f, -0.2f ), r );
 }
 
 TEST(Math, Quaternion_Subtraction)
 {
-    const Quat a(  1.0f, 2.0f, 3.0f,  4.0f );
-    const Quat b( -1.5f, 2.5f, 3.2f, -4.2f );
-    const Quat r = a - b;
+    const Quatf a(  1.0f, 2.0f, 3.0f,  4.0f );
+    const Quatf b( -1.5f, 2.5f, 3.2f, -4.2f );
+    const Quatf r = a - b;
 
-    EXPECT_EQ( Quat( 2.5f, -0.5f, -0.2f, 8.2f ), r );
+    EXPECT_EQ( Quatf( 2.5f, -0.5f, -0.2f, 8.2f ), r );
 }
 
 TEST(Math, Quaternion_SelfSubtraction)
 {
-    const Quat a(  1.0f, 2.0f, 3.0f,  4.0f );
-    const Quat b( -1.5f, 2.5f, 3.2f, -4.2f );
+    const Quatf a(  1.0f, 2.0f, 3.0f,  4.0f );
+    const Quatf b( -1.5f, 2.5f, 3.2f, -4.2f );
 
-    Quat r  = a;
+    Quatf r  = a;
          r -= b;
 
-    EXPECT_EQ( Quat( 2.5f, -0.5f, -0.2f, 8.2f ), r );
+    EXPECT_EQ( Quatf( 2.5f, -0.5f, -0.2f, 8.2f ), r );
 }
 
 
 TEST(Math, Quaternion_Multiply)
 {
-    const Quat a(  1.0f, 2.0f, 3.0f,  4.0f );
-    const Quat b( -1.5f, 2.5f, 3.5f, -4.5f );
-    const Quat r = a * b;
+    const Quatf a(  1.0f, 2.0f, 3.0f,  4.0f );
+    const Quatf b( -1.5f, 2.5f, 3.5f, -4.5f );
+    const Quatf r = a * b;
 
-    EXPECT_EQ( Quat( 1.0f, -28.0f, 18.0f, -11.0f ), r );
+    EXPECT_EQ( Quatf( 1.0f, -28.0f, 18.0f, -11.0f ), r );
 }
 
 TEST(Math, Quaternion_SelfMultiply)
 {
-    const Quat a(  1.0f, 2.0f, 3.0f,  4.0f );
-    const Quat b( -1.5f, 2.5f, 3.5f, -4.5f );
+    const Quatf a(  1.0f, 2.0f, 3.0f,  4.0f );
+    const Quatf b( -1.5f, 2.5f, 3.5f, -4.5f );
 
-    Quat r  = a;
+    Quatf r  = a;
          r *= b;  
 
-    EXPECT_EQ( Quat( 1.0f, -28.0f, 18.0f, -11.0f ), r );
+    EXPECT_EQ( Quatf( 1.0f, -28.0f, 18.0f, -11.0f ), r );
 }
 
 TEST(Math, Quaternion_X)
 {
-    const Quat a( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat b( 1.5f, 2.5f, 3.5f, 4.5f );
+    const Quatf a( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf b( 1.5f, 2.5f, 3.5f, 4.5f );
 
     EXPECT_FLOAT_EQ( 2.0f, a.x() );
     EXPECT_FLOAT_EQ( 2.5f, b.x() );
@@ -191,8 +191,8 @@ TEST(Math, Quaternion_X)
 
 TEST(Math, Quaternion_Y)
 {
-    const Quat a( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat b( 1.5f, 2.5f, 3.5f, 4.5f );
+    const Quatf a( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf b( 1.5f, 2.5f, 3.5f, 4.5f );
 
     EXPECT_FLOAT_EQ( 3.0f, a.y() );
     EXPECT_FLOAT_EQ( 3.5f, b.y() );
@@ -200,8 +200,8 @@ TEST(Math, Quaternion_Y)
 
 TEST(Math, Quaternion_Z)
 {
-    const Quat a( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat b( 1.5f, 2.5f, 3.5f, 4.5f );
+    const Quatf a( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf b( 1.5f, 2.5f, 3.5f, 4.5f );
 
     EXPECT_FLOAT_EQ( 4.0f, a.z() );
     EXPECT_FLOAT_EQ( 4.5f, b.z() );
@@ -209,8 +209,8 @@ TEST(Math, Quaternion_Z)
 
 TEST(Math, Quaternion_W)
 {
-    const Quat a( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat b( 1.5f, 2.5f, 3.5f, 4.5f );
+    const Quatf a( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf b( 1.5f, 2.5f, 3.5f, 4.5f );
 
     EXPECT_FLOAT_EQ( 1.0f, a.w() );
     EXPECT_FLOAT_EQ( 1.5f, b.w() );
@@ -218,7 +218,7 @@ TEST(Math, Quaternion_W)
 
 TEST(Math,Quaternion_Normal)
 {
-    const Quat q( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf q( 1.0f, 2.0f, 3.0f, 4.0f );
 
     // norm of quaternion[ 1+2i+3j+4k ]
     EXPECT_FLOAT_EQ( sqrtf( 30.0f ), normal( q ) );
@@ -226,28 +226,28 @@ TEST(Math,Quaternion_Normal)
 
 TEST(Math,Quaternion_Conjugate)
 {
-    const Quat q( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat c = conjugate( q );
+    const Quatf q( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf c = conjugate( q );
 
     // conjugate of quaternion[ 1+2i+3j+4k ]
-    EXPECT_EQ( Quat( 1.0f, -2.0f, -3.0f, -4.0f ), c );
+    EXPECT_EQ( Quatf( 1.0f, -2.0f, -3.0f, -4.0f ), c );
 }
 
 TEST(Math,Quaternion_Inverse)
 {
-    const Quat q( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat c = inverse( q );
+    const Quatf q( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf c = inverse( q );
 
     // conjugate of quaternion[ 1+2i+3j+4k ]
-    EXPECT_EQ( Quat( 1.0f, -2.0f, -3.0f, -4.0f ), c );
+    EXPECT_EQ( Quatf( 1.0f, -2.0f, -3.0f, -4.0f ), c );
 }
 
 TEST(Math,Quaternion_Unit)
 {
-    const Quat q( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Quat r = normalize( q );
+    const Quatf q( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Quatf r = normalize( q );
 
-    EXPECT_EQ( Quat( 1.0f / sqrtf( 30.0f ),
+    EXPECT_EQ( Quatf( 1.0f / sqrtf( 30.0f ),
                      sqrtf( 2.0f / 15.0f ),
                      sqrtf( 3.0f / 10.0f ),
                      2.0f * sqrtf( 2.0f / 15.0f ) ),
@@ -257,7 +257,7 @@ TEST(Math,Quaternion_Unit)
 
 TEST(Math, Quaternion_Zero)
 {
-    const Quat q = Quat::ZERO;
+    const Quatf q = Quatf::ZERO;
 
     EXPECT_FLOAT_EQ( q.x(), 0.0f );
     EXPECT_FLOAT_EQ( q.y(), 0.0f );
@@ -267,7 +267,7 @@ TEST(Math, Quaternion_Zero)
 
 TEST(Math, Quaternion_Identity)
 {
-    const Quat q = Quat::IDENTITY;
+    const Quatf q = Quatf::IDENTITY;
 
     EXPECT_FLOAT_EQ( q.x(), 0.0f );
     EXPECT_FLOAT_EQ( q.y(), 0.0f );
@@ -277,10 +277,23 @@ TEST(Math, Quaternion_Identity)
 
 TEST(Math, Quaternion_Lerp)
 {
-    const Quat a( 1.0f, 2.0f, 3.0f, 5.0f );
-    const Quat b( 2.0f, 4.0f, 6.0f, 10.0f );
+    const Quatf a( 1.0f, 2.0f, 3.0f, 5.0f );
+    const Quatf b( 2.0f, 4.0f, 6.0f, 10.0f );
 
-    EXPECT_TRUE( QuaternionEquals( Quat( 1.0f, 2.0f, 3.0f, 5.0f ), lerp( a, b, 0.0f ) ) );
-    EXPECT_TRUE( QuaternionEquals( Quat( 1.5f, 3.0f, 4.5f, 7.5f ), lerp( a, b, 0.5f ) ) );
-    EXPECT_TRUE( QuaternionEquals( Quat( 2.0f, 4.0f, 6.0f, 10.0f ), lerp( a, b, 1.0f ) ) );
+    EXPECT_TRUE( QuaternionEquals( Quatf( 1.0f, 2.0f, 3.0f, 5.0f ), lerp( a, b, 0.0f ) ) );
+    EXPECT_TRUE( QuaternionEquals( Quatf( 1.5f, 3.0f, 4.5f, 7.5f ), lerp( a, b, 0.5f ) ) );
+    EXPECT_TRUE( QuaternionEquals( Quatf( 2.0f, 4.0f, 6.0f, 10.0f ), lerp( a, b, 1.0f ) ) );
+}
+
+TEST(Math, Quaternion_ConstantExpressions)
+{
+    constexpr Quatf a( 1.0f, 2.0f, 3.0f, 4.0f );
+    constexpr Quatf b = conjugate( a ) * Quatf::IDENTITY + Quatf::ZERO;
+    constexpr Quatf c = lerp( a, b, 0.5f );
+
+    static_assert( b.w() == 1.0f && b.x() == -2.0f, "conjugate must be a constant expression" );
+    static_assert( c.x() == 0.0f && c.w() == 1.0f, "lerp must be a constant expression" );
+    static_assert( ( a * inverse( a ) ).w() == 30.0f, "" );
+
+    EXPECT_EQ( Quatf( 1.0f, 0.0f, 0.0f, 0.0f ), c );
 }
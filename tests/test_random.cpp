@@ -0,0 +1,350 @@
+/**
+ * Unit tests for the random number generators and their engines
+ */
+#include <gtest/gtest.h>
+#include <smath/random.h>
+#include <smath/memory.h>
+
+#include <cmath>
+#include <cstddef>
+#include <stdint.h>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+TEST(Math,Random_MersenneTwisterReferenceSequence)
+{
+    // Reference values for MT19937 with the default seed
+    Math::MersenneTwister engine;
+    EXPECT_EQ( 3499211612u, engine.next() );
+
+    for ( int i = 1; i < 9999; ++i )
+    {
+        engine.next();
+    }
+
+    EXPECT_EQ( 4123659995u, engine.next() );
+}
+
+TEST(Math,Random_SplitMix64ReferenceSequence)
+{
+    Math::SplitMix64 engine( 0 );
+
+    EXPECT_EQ( 0xe220a8397b1dcdafull, engine.next64() );
+    EXPECT_EQ( 0x6e789e6aa1b965f4ull, engine.next64() );
+    EXPECT_EQ( 0x06c45d188009454full, engine.next64() );
+}
+
+TEST(Math,Random_Xoshiro256ReferenceSequence)
+{
+    Math::Xoshiro256 engine;
+    engine.seed( 1, 2, 3, 4 );
+
+    EXPECT_EQ( 11520ull, engine.next64() );
+    EXPECT_EQ( 0ull, engine.next64() );
+    EXPECT_EQ( 1509978240ull, engine.next64() );
+    EXPECT_EQ( 1215971899390074240ull, engine.next64() );
+}
+
+TEST(Math,Random_Xoshiro256Jump)
+{
+    Math::Xoshiro256 a( 11 ), b( 11 ), c( 11 );
+    b.jump();
+    c.jump();
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        uint64_t value = b.next64();
+
+        EXPECT_NE( a.next64(), value );
+        EXPECT_EQ( value, c.next64() );
+    }
+}
+
+TEST(Math,Random_Pcg32ReferenceSequence)
+{
+    Math::Pcg32 engine( 42, 54 );
+
+    EXPECT_EQ( 0xa15c02b7u, engine.next() );
+    EXPECT_EQ( 0x7b47f409u, engine.next() );
+    EXPECT_EQ( 0xba1d3330u, engine.next() );
+    EXPECT_EQ( 0x83d2f293u, engine.next() );
+}
+
+TEST(Math,Random_Pcg32Streams)
+{
+    Math::Pcg32 a( 42, 1 ), b( 42, 2 );
+    int same = 0;
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        same += ( a.next() == b.next() ) ? 1 : 0;
+    }
+
+    EXPECT_LT( same, 2 );
+}
+
+TEST(Math,Random_SameSeedSameSequence)
+{
+    Random a( 42 ), b( 42 );
+    SmallRandom c( 42 ), d( 42 );
+    FastRandom e( 42 ), f( 42 );
+    TRandom<Math::Pcg32> g( 42 ), h( 42 );
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        EXPECT_EQ( a.nextUInt(), b.nextUInt() );
+        EXPECT_EQ( c.nextUInt(), d.nextUInt() );
+        EXPECT_EQ( e.nextUInt(), f.nextUInt() );
+        EXPECT_EQ( g.nextUInt(), h.nextUInt() );
+    }
+}
+
+TEST(Math,Random_StateIsInline)
+{
+    // Random stays naturally aligned so plain new and std::vector work
+    EXPECT_LT( sizeof( Random ), 2600u );
+    EXPECT_LE( std::alignment_of<Random>::value, std::alignment_of<std::max_align_t>::value );
+    EXPECT_EQ( 0u, sizeof( AlignedRandom ) % Math::CacheLineSize );
+    EXPECT_EQ( Math::CacheLineSize, std::alignment_of<AlignedRandom>::value );
+    EXPECT_LE( sizeof( SmallRandom ), 16u );
+    EXPECT_LE( sizeof( FastRandom ), 48u );
+
+    EXPECT_TRUE( std::is_nothrow_move_constructible<Random>::value );
+    EXPECT_TRUE( std::is_nothrow_move_assignable<SmallRandom>::value );
+    EXPECT_TRUE( std::is_trivially_copyable<SmallRandom>::value );
+}
+
+TEST(Math,Random_CopyContinuesSequence)
+{
+    Random a( 7 );
+
+    for ( int i = 0; i < 700; ++i )     // past the first regeneration
+    {
+        a.nextUInt();
+    }
+
+    Random b( a );
+    Random c( 1 );
+    c = a;
+
+    for ( int i = 0; i < 100; ++i )
+    {
+        unsigned int expected = a.nextUInt();
+
+        EXPECT_EQ( expected, b.nextUInt() );
+        EXPECT_EQ( expected, c.nextUInt() );
+    }
+}
+
+TEST(Math,Random_AssignmentCopiesPendingGaussian)
+{
+    Random a( 3 );
+    a.nextGaussian();                   // leaves the second value pending
+
+    Random b( 99 );
+    b = a;
+
+    Random c( 99 );
+    c = std::move( a );
+
+    Random reference( 3 );
+    reference.nextGaussian();
+    float pending = reference.nextGaussian();
+
+    EXPECT_EQ( pending, b.nextGaussian() );
+    EXPECT_EQ( pending, c.nextGaussian() );
+}
+
+TEST(Math,Random_ContiguousArrays)
+{
+    std::vector<SmallRandom> small;
+    std::vector<Random> plain( 4, Random( 1 ) );
+    Math::AlignedVector<AlignedRandom, Math::CacheLineSize> large;
+
+    for ( uint32_t i = 0; i < 16; ++i )
+    {
+        small.push_back( SmallRandom( i ) );
+        large.push_back( AlignedRandom( i ) );
+    }
+
+    EXPECT_EQ( Random( 1 ).nextUInt(), plain[3].nextUInt() );
+
+    for ( uint32_t i = 0; i < 16; ++i )
+    {
+        SmallRandom smallReference( i );
+        Random largeReference( i );
+
+        EXPECT_EQ( smallReference.nextUInt(), small[i].nextUInt() );
+        EXPECT_EQ( largeReference.nextUInt(), large[i].nextUInt() );
+        EXPECT_EQ( 0u, reinterpret_cast<uintptr_t>( &large[i] ) % Math::CacheLineSize );
+    }
+}
+
+TEST(Math,Random_FloatRanges)
+{
+    SmallRandom random( 5 );
+
+    for ( int i = 0; i < 10000; ++i )
+    {
+        float a = random.nextFloat();
+        float b = random.nextFloat2();
+        double c = random.nextDouble();
+        int d = random.nextInt( 10, 20 );
+
+        EXPECT_TRUE( a >= 0.0f && a <= 1.0f );
+        EXPECT_TRUE( b >= 0.0f && b <= 1.0f );
+        EXPECT_TRUE( c >= 0.0 && c < 1.0 );
+        EXPECT_TRUE( d >= 10 && d <= 20 );
+    }
+}
+
+TEST(Math,Random_NextBytesFillsExactlyCount)
+{
+    for ( size_t count = 0; count <= 9; ++count )
+    {
+        Random random( 3 ), reference( 3 );
+        std::vector<uint8_t> bytes( 12, 0xAB );
+
+        random.nextBytes( bytes, count );
+
+        // Little endian bytes of consecutive values, the tail from one more
+        for ( size_t i = 0; i < count; i += 4 )
+        {
+            uint32_t v = reference.nextUInt();
+
+            for ( size_t j = i; j < count && j < i + 4; ++j, v >>= 8 )
+            {
+                EXPECT_EQ( static_cast<uint8_t>( v & 0xFF ), bytes[j] );
+            }
+        }
+
+        for ( size_t i = count; i < bytes.size(); ++i )
+        {
+            EXPECT_EQ( 0xAB, bytes[i] );
+        }
+
+        EXPECT_EQ( reference.nextUInt(), random.nextUInt() );
+    }
+}
+
+TEST(Math,Random_NextDoubleAndBoolUseTheEngine)
+{
+    Random a( 8 ), b( 8 );
+    bool finerThanFloat = false;
+    int trues = 0;
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        double d = a.nextDouble();
+
+        // A float part would leave every value a multiple of 2^-24
+        finerThanFloat = finerThanFloat || d * 16777216.0 != std::floor( d * 16777216.0 );
+        EXPECT_EQ( d, b.nextDouble() );
+
+        bool value = a.nextBool();
+        EXPECT_EQ( value, b.nextBool() );
+        trues += value ? 1 : 0;
+    }
+
+    EXPECT_TRUE( finerThanFloat );
+    EXPECT_GT( trues, 400 );
+    EXPECT_LT( trues, 600 );
+}
+
+namespace
+{
+    template<typename Engine>
+    double meanOfFloats( uint32_t seed, int count )
+    {
+        TRandom<Engine> random( seed );
+        double sum = 0.0;
+
+        for ( int i = 0; i < count; ++i )
+        {
+            sum += random.nextFloat();
+        }
+
+        return sum / count;
+    }
+}
+
+TEST(Math,Random_EnginesAreUniform)
+{
+    EXPECT_NEAR( 0.5, meanOfFloats<Math::MersenneTwister>( 1, 100000 ), 0.01 );
+    EXPECT_NEAR( 0.5, meanOfFloats<Math::Xoshiro256>( 1, 100000 ), 0.01 );
+    EXPECT_NEAR( 0.5, meanOfFloats<Math::Pcg32>( 1, 100000 ), 0.01 );
+    EXPECT_NEAR( 0.5, meanOfFloats<Math::SplitMix64>( 1, 100000 ), 0.01 );
+}
+
+TEST(Math,Random_BoundedIntsStayInRange)
+{
+    FastRandom random( 9 );
+
+    for ( int i = 0; i < 10000; ++i )
+    {
+        int a = random.nextInt( -5, 5 );
+        int b = random.nextInt( 7 );
+        unsigned int c = random.nextUInt( 3u );
+        unsigned int d = random.nextUInt( 100u, 200u );
+
+        EXPECT_TRUE( a >= -5 && a <= 5 );
+        EXPECT_TRUE( b >= 0 && b <= 7 );
+        EXPECT_LE( c, 3u );
+        EXPECT_TRUE( d >= 100u && d <= 200u );
+    }
+
+    EXPECT_EQ( 4, random.nextInt( 4, 4 ) );
+    EXPECT_EQ( 0u, random.nextUInt( 0u ) );
+
+    // Full ranges don't overflow
+    random.nextInt( std::numeric_limits<int>::min(), std::numeric_limits<int>::max() );
+    random.nextUInt( 0u, std::numeric_limits<unsigned int>::max() );
+}
+
+TEST(Math,Random_BoundedIntsAreUniform)
+{
+    // Three buckets of a range that doesn't divide 2^32
+    Random random( 21 );
+    int counts[3] = { 0, 0, 0 };
+
+    for ( int i = 0; i < 300000; ++i )
+    {
+        counts[ random.nextInt( 0, 2 ) ]++;
+    }
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        EXPECT_NEAR( 100000, counts[i], 1500 );
+    }
+
+    // A range of 3 * 2^30: taking the value modulo the range would put the
+    // lower third of the range twice as often as the rest
+    const unsigned int range = 3u << 30;
+    int lowerThird = 0;
+
+    for ( int i = 0; i < 300000; ++i )
+    {
+        lowerThird += random.nextUInt( range - 1 ) < ( 1u << 30 ) ? 1 : 0;
+    }
+
+    EXPECT_NEAR( 100000, lowerThird, 1500 );
+}
+
+TEST(Math,Random_NextIntsMatchesNextInt)
+{
+    std::vector<int> values( 1000 );
+    Random batch( 33 ), single( 33 );
+
+    batch.nextInts( &values[0], values.size(), -100, 100 );
+
+    // Same values as generating them one at a time
+    for ( size_t i = 0; i < values.size(); ++i )
+    {
+        EXPECT_EQ( single.nextInt( -100, 100 ), values[i] );
+    }
+
+    batch.nextInts( &values[0], values.size(), 3, 3 );
+    EXPECT_EQ( 3, values[999] );
+}
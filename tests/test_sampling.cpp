@@ -0,0 +1,235 @@
+/**
+ * Unit tests for shuffling, sampling and alias tables
+ */
+#include <gtest/gtest.h>
+#include <smath/sampling.h>
+#include <smath/random.h>
+
+#include <algorithm>
+#include <set>
+#include <stdint.h>
+#include <vector>
+
+namespace
+{
+    std::vector<int> iota( int count )
+    {
+        std::vector<int> values( count );
+
+        for ( int i = 0; i < count; ++i )
+        {
+            values[i] = i;
+        }
+
+        return values;
+    }
+}
+
+TEST(Math,Sampling_ShuffleIsAPermutation)
+{
+    FastRandom random( 1 );
+    std::vector<int> values = iota( 100 );
+
+    Math::shuffle( values.begin(), values.end(), random );
+
+    EXPECT_NE( iota( 100 ), values );
+
+    std::sort( values.begin(), values.end() );
+    EXPECT_EQ( iota( 100 ), values );
+
+    // Empty and single element ranges are left alone
+    std::vector<int> empty, one( 1, 7 );
+    Math::shuffle( empty.begin(), empty.end(), random );
+    Math::shuffle( one.begin(), one.end(), random );
+
+    EXPECT_EQ( 7, one[0] );
+}
+
+TEST(Math,Sampling_ShuffleIsUniform)
+{
+    // Each of the 6 orderings of 3 elements should be equally likely
+    FastRandom random( 2 );
+    int counts[6] = { 0, 0, 0, 0, 0, 0 };
+
+    for ( int i = 0; i < 60000; ++i )
+    {
+        int values[3] = { 0, 1, 2 };
+        Math::shuffle( values, values + 3, random );
+
+        counts[ values[0] * 2 + ( values[1] > values[2] ? 1 : 0 ) ]++;
+    }
+
+    for ( int i = 0; i < 6; ++i )
+    {
+        EXPECT_NEAR( 10000, counts[i], 500 );
+    }
+}
+
+TEST(Math,Sampling_PartialShuffle)
+{
+    FastRandom random( 3 );
+    std::vector<int> values = iota( 50 );
+
+    std::vector<int>::iterator end =
+        Math::partialShuffle( values.begin(), values.end(), 10, random );
+
+    EXPECT_EQ( 10, end - values.begin() );
+
+    std::sort( values.begin(), values.end() );
+    EXPECT_EQ( iota( 50 ), values );
+
+    end = Math::partialShuffle( values.begin(), values.end(), 500, random );
+    EXPECT_EQ( values.end(), end );
+}
+
+TEST(Math,Sampling_SampleIndices)
+{
+    SmallRandom random( 4 );
+    std::vector<uint32_t> indices;
+
+    // Sparse (Floyd) and dense (partial shuffle) selections
+    const uint32_t Counts[] = { 0, 1, 10, 400, 1000, 5000 };
+
+    for ( size_t c = 0; c < sizeof( Counts ) / sizeof( Counts[0] ); ++c )
+    {
+        Math::sampleIndices( 1000, Counts[c], random, indices );
+
+        std::set<uint32_t> unique( indices.begin(), indices.end() );
+
+        EXPECT_EQ( std::min( Counts[c], 1000u ), indices.size() );
+        EXPECT_EQ( indices.size(), unique.size() );
+        EXPECT_TRUE( unique.empty() || *unique.rbegin() < 1000u );
+    }
+}
+
+TEST(Math,Sampling_SampleIndicesIsUniform)
+{
+    SmallRandom random( 5 );
+    std::vector<uint32_t> indices;
+    std::vector<int> counts( 20, 0 );
+
+    for ( int i = 0; i < 20000; ++i )
+    {
+        Math::sampleIndices( 20, 2, random, indices );
+
+        counts[ indices[0] ]++;
+        counts[ indices[1] ]++;
+    }
+
+    for ( size_t i = 0; i < counts.size(); ++i )
+    {
+        EXPECT_NEAR( 2000, counts[i], 200 );
+    }
+}
+
+TEST(Math,Sampling_ReservoirKeepsFirstValues)
+{
+    FastRandom random( 6 );
+    Math::ReservoirSampler<int> sampler( 10 );
+
+    for ( int i = 0; i < 5; ++i )
+    {
+        sampler.add( i, random );
+    }
+
+    EXPECT_EQ( 5u, sampler.seen() );
+    EXPECT_EQ( iota( 5 ), sampler.samples() );
+
+    sampler.reset();
+    EXPECT_EQ( 0u, sampler.seen() );
+    EXPECT_TRUE( sampler.samples().empty() );
+}
+
+TEST(Math,Sampling_ReservoirIsUniform)
+{
+    FastRandom random( 7 );
+    std::vector<int> counts( 100, 0 );
+
+    // Every value of the stream should end up in the sample equally often
+    for ( int trial = 0; trial < 10000; ++trial )
+    {
+        Math::ReservoirSampler<int> sampler( 5 );
+
+        for ( int i = 0; i < 100; ++i )
+        {
+            sampler.add( i, random );
+        }
+
+        ASSERT_EQ( 5u, sampler.samples().size() );
+
+        for ( size_t i = 0; i < sampler.samples().size(); ++i )
+        {
+            counts[ sampler.samples()[i] ]++;
+        }
+    }
+
+    for ( size_t i = 0; i < counts.size(); ++i )
+    {
+        EXPECT_NEAR( 500, counts[i], 100 );
+    }
+}
+
+TEST(Math,Sampling_AliasTableProbabilities)
+{
+    const float Weights[] = { 1.0f, 0.0f, 3.0f, 4.0f, 2.0f };
+    Math::AliasTable table;
+
+    table.build( Weights, 5 );
+
+    EXPECT_EQ( 5u, table.size() );
+    EXPECT_NEAR( 0.1, table.probability( 0 ), 1e-6 );
+    EXPECT_NEAR( 0.0, table.probability( 1 ), 1e-6 );
+    EXPECT_NEAR( 0.3, table.probability( 2 ), 1e-6 );
+    EXPECT_NEAR( 0.4, table.probability( 3 ), 1e-6 );
+    EXPECT_NEAR( 0.2, table.probability( 4 ), 1e-6 );
+}
+
+TEST(Math,Sampling_AliasTableSamples)
+{
+    std::vector<float> weights;
+    weights.push_back( 1.0f );
+    weights.push_back( 0.0f );
+    weights.push_back( 3.0f );
+    weights.push_back( 6.0f );
+
+    Math::AliasTable table( weights );
+    FastRandom random( 8 );
+    std::vector<uint32_t> samples( 100000 );
+    int counts[4] = { 0, 0, 0, 0 };
+
+    table.sample( random, &samples[0], samples.size() );
+
+    for ( size_t i = 0; i < samples.size(); ++i )
+    {
+        ASSERT_LT( samples[i], 4u );
+        counts[ samples[i] ]++;
+    }
+
+    EXPECT_NEAR( 10000, counts[0], 600 );
+    EXPECT_EQ( 0, counts[1] );
+    EXPECT_NEAR( 30000, counts[2], 900 );
+    EXPECT_NEAR( 60000, counts[3], 900 );
+}
+
+TEST(Math,Sampling_AliasTableDegenerateWeights)
+{
+    FastRandom random( 9 );
+
+    // All zero weights fall back to uniform
+    std::vector<float> zeros( 4, 0.0f );
+    Math::AliasTable uniform( zeros );
+
+    for ( uint32_t i = 0; i < 4; ++i )
+    {
+        EXPECT_NEAR( 0.25, uniform.probability( i ), 1e-6 );
+    }
+
+    // A single outcome is always chosen
+    std::vector<float> one( 1, 5.0f );
+    Math::AliasTable single( one );
+
+    EXPECT_EQ( 0u, single.sample( random ) );
+
+    Math::AliasTable empty;
+    EXPECT_TRUE( empty.empty() );
+}
@@ -0,0 +1,185 @@
+/**
+ * Unit tests for sampling points in and on shapes
+ */
+#include <gtest/gtest.h>
+#include <smath/shapesampling.h>
+#include <smath/random.h>
+
+#include <cmath>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector2<float> Vec2f;
+typedef TVector3<float> Vec3f;
+#endif
+
+namespace
+{
+    const float Tolerance = 1e-4f;
+    const int Samples = 20000;
+}
+
+TEST(Math,ShapeSampling_MapToSphereCorners)
+{
+    Vec3f top = Math::mapToSphere( 0.0f, 0.0f );
+    Vec3f side = Math::mapToSphere( 0.5f, 0.25f );
+
+    EXPECT_NEAR( 1.0f, top.z(), Tolerance );
+    EXPECT_NEAR( 0.0f, side.x(), Tolerance );
+    EXPECT_NEAR( 1.0f, side.y(), Tolerance );
+    EXPECT_NEAR( 0.0f, side.z(), Tolerance );
+
+    TVector3<double> d = Math::mapToSphere( 0.25, 0.5 );
+    EXPECT_NEAR( 1.0, lengthSquared( d ), 1e-9 );
+}
+
+TEST(Math,ShapeSampling_OnSphere)
+{
+    FastRandom random( 1 );
+    Vec3f mean( 0.0f, 0.0f, 0.0f );
+
+    for ( int i = 0; i < Samples; ++i )
+    {
+        Vec3f p = Math::randomOnSphere( random );
+
+        EXPECT_NEAR( 1.0f, length( p ), Tolerance );
+        mean += p;
+    }
+
+    mean /= static_cast<float>( Samples );
+    EXPECT_LT( length( mean ), 0.03f );
+}
+
+TEST(Math,ShapeSampling_InSphere)
+{
+    FastRandom random( 2 );
+    int inner = 0;
+
+    for ( int i = 0; i < Samples; ++i )
+    {
+        float r = length( Math::randomInSphere( random ) );
+
+        EXPECT_LE( r, 1.0f + Tolerance );
+        inner += r < 0.5f ? 1 : 0;
+    }
+
+    // The inner half radius ball holds an eighth of the volume
+    EXPECT_NEAR( Samples / 8, inner, Samples / 100 );
+}
+
+TEST(Math,ShapeSampling_InDisk)
+{
+    FastRandom random( 3 );
+    int inner = 0;
+    int quadrants[4] = { 0, 0, 0, 0 };
+
+    for ( int i = 0; i < Samples; ++i )
+    {
+        Vec2f p = Math::randomInDisk( random );
+        float r = length( p );
+
+        EXPECT_LE( r, 1.0f + Tolerance );
+        inner += r < 0.5f ? 1 : 0;
+        quadrants[ ( p.x() < 0.0f ? 1 : 0 ) + ( p.y() < 0.0f ? 2 : 0 ) ]++;
+    }
+
+    // The inner half radius disk holds a quarter of the area
+    EXPECT_NEAR( Samples / 4, inner, Samples / 50 );
+
+    for ( int i = 0; i < 4; ++i )
+    {
+        EXPECT_NEAR( Samples / 4, quadrants[i], Samples / 50 );
+    }
+
+    // The center of the square maps to the center of the disk
+    Vec2f center = Math::mapToDisk( 0.5f, 0.5f );
+    EXPECT_NEAR( 0.0f, length( center ), Tolerance );
+}
+
+TEST(Math,ShapeSampling_CosineHemisphere)
+{
+    FastRandom random( 4 );
+    double meanCos = 0.0;
+
+    for ( int i = 0; i < Samples; ++i )
+    {
+        Vec3f d = Math::randomCosineHemisphere( random );
+
+        EXPECT_NEAR( 1.0f, length( d ), Tolerance );
+        EXPECT_GE( d.z(), 0.0f );
+        meanCos += d.z();
+    }
+
+    // E[cos] for a cosine weighted hemisphere is 2/3
+    EXPECT_NEAR( 2.0 / 3.0, meanCos / Samples, 0.01 );
+}
+
+TEST(Math,ShapeSampling_OnTriangle)
+{
+    const Vec3f a( 0.0f, 0.0f, 1.0f ), b( 2.0f, 0.0f, 1.0f ), c( 0.0f, 2.0f, 1.0f );
+    FastRandom random( 5 );
+    Vec3f mean( 0.0f, 0.0f, 0.0f );
+
+    for ( int i = 0; i < Samples; ++i )
+    {
+        Vec3f p = Math::randomOnTriangle( random, a, b, c );
+
+        EXPECT_GE( p.x(), -Tolerance );
+        EXPECT_GE( p.y(), -Tolerance );
+        EXPECT_LE( p.x() + p.y(), 2.0f + Tolerance );
+        EXPECT_NEAR( 1.0f, p.z(), Tolerance );
+
+        mean += p;
+    }
+
+    // Uniform points average to the centroid
+    mean /= static_cast<float>( Samples );
+    EXPECT_NEAR( 2.0f / 3.0f, mean.x(), 0.02f );
+    EXPECT_NEAR( 2.0f / 3.0f, mean.y(), 0.02f );
+}
+
+TEST(Math,ShapeSampling_Arrays)
+{
+    const size_t Count = 150;     // not a multiple of the block size
+    std::vector<float> x( Count ), y( Count ), z( Count );
+    FastRandom random( 6 );
+
+    Math::randomOnSphere( random, &x[0], &y[0], &z[0], Count );
+
+    for ( size_t i = 0; i < Count; ++i )
+    {
+        EXPECT_NEAR( 1.0f, length( Vec3f( x[i], y[i], z[i] ) ), Tolerance );
+    }
+
+    Math::randomInSphere( random, &x[0], &y[0], &z[0], Count );
+
+    for ( size_t i = 0; i < Count; ++i )
+    {
+        EXPECT_LE( length( Vec3f( x[i], y[i], z[i] ) ), 1.0f + Tolerance );
+    }
+
+    Math::randomInDisk( random, &x[0], &y[0], Count );
+
+    for ( size_t i = 0; i < Count; ++i )
+    {
+        EXPECT_LE( length( Vec2f( x[i], y[i] ) ), 1.0f + Tolerance );
+    }
+
+    Math::randomCosineHemisphere( random, &x[0], &y[0], &z[0], Count );
+
+    for ( size_t i = 0; i < Count; ++i )
+    {
+        EXPECT_GE( z[i], 0.0f );
+        EXPECT_NEAR( 1.0f, length( Vec3f( x[i], y[i], z[i] ) ), Tolerance );
+    }
+
+    const Vec3f a( 0.0f, 0.0f, 0.0f ), b( 1.0f, 0.0f, 0.0f ), c( 0.0f, 1.0f, 0.0f );
+    Math::randomOnTriangle( random, a, b, c, &x[0], &y[0], &z[0], Count );
+
+    for ( size_t i = 0; i < Count; ++i )
+    {
+        EXPECT_LE( x[i] + y[i], 1.0f + Tolerance );
+        EXPECT_GE( x[i], 0.0f );
+        EXPECT_GE( y[i], 0.0f );
+    }
+}
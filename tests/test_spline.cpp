@@ -0,0 +1,247 @@
+/**
+ * Unit tests for the spline curves and arc length tables
+ */
+#include <gtest/gtest.h>
+#include <smath/spline.h>
+#include <smath/interpolation.h>
+#include "unittesthelpers.h"
+
+#include <cmath>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector2<float> Vec2f;
+typedef TVector3<float> Vec3f;
+typedef TQuaternion<float> Quatf;
+#endif
+
+namespace
+{
+    std::vector<Vec3f> makePath()
+    {
+        std::vector<Vec3f> points;
+
+        points.push_back( Vec3f( 0.0f, 0.0f, 0.0f ) );
+        points.push_back( Vec3f( 1.0f, 2.0f, 0.0f ) );
+        points.push_back( Vec3f( 1.5f, 2.0f, 1.0f ) );
+        points.push_back( Vec3f( 6.0f, -1.0f, 2.0f ) );
+        points.push_back( Vec3f( 7.0f, 0.0f, 2.0f ) );
+
+        return points;
+    }
+}
+
+TEST(Math,Spline_CatmullRomPassesThroughPoints)
+{
+    std::vector<Vec3f> points = makePath();
+    const float Alphas[] = { 0.0f, 0.5f, 1.0f };
+
+    for ( int a = 0; a < 3; ++a )
+    {
+        Math::Spline<Vec3f> spline = Math::createCatmullRom( &points[0], points.size(), Alphas[a] );
+
+        ASSERT_EQ( points.size() - 1, spline.segmentCount() );
+
+        for ( size_t i = 0; i < points.size(); ++i )
+        {
+            const float t = static_cast<float>( i ) / spline.segmentCount();
+            EXPECT_TRUE( VectorNear( points[i], spline.evaluate( t ), 1e-5f ) );
+        }
+
+        // Clamped outside [0,1]
+        EXPECT_TRUE( VectorNear( points.front(), spline.evaluate( -1.0f ), 1e-5f ) );
+        EXPECT_TRUE( VectorNear( points.back(), spline.evaluate( 2.0f ), 1e-5f ) );
+    }
+}
+
+TEST(Math,Spline_CatmullRomIsSmooth)
+{
+    std::vector<Vec3f> points = makePath();
+    Math::Spline<Vec3f> spline = Math::createCatmullRom( &points[0], points.size() );
+
+    // Same tangent direction on both sides of each interior point. The
+    // speed changes, as segments of different lengths share t evenly.
+    for ( size_t i = 1; i + 1 < points.size(); ++i )
+    {
+        const float t = static_cast<float>( i ) / spline.segmentCount();
+
+        const Vec3f before = spline.derivative( t - 1e-5f );
+        const Vec3f after  = spline.derivative( t + 1e-5f );
+
+        EXPECT_TRUE( VectorNear( before / std::sqrt( lengthSquared( before ) ),
+                           after / std::sqrt( lengthSquared( after ) ), 1e-3f ) );
+    }
+}
+
+TEST(Math,Spline_UniformCatmullRomTangents)
+{
+    const Vec2f points[] = { Vec2f( 0.0f, 0.0f ), Vec2f( 1.0f, 0.0f ), Vec2f( 3.0f, 1.0f ) };
+    Math::Spline<Vec2f> spline = Math::createCatmullRom( points, 3, 0.0f );
+
+    // Tangent at an interior point is half the chord of its neighbours,
+    // per segment, and there are two segments
+    EXPECT_NEAR( 3.0f, spline.derivative( 0.5f ).x(), 1e-4f );
+    EXPECT_NEAR( 1.0f, spline.derivative( 0.5f ).y(), 1e-4f );
+}
+
+TEST(Math,Spline_Bezier)
+{
+    const Vec2f points[] = { Vec2f( 0.0f, 0.0f ), Vec2f( 0.0f, 1.0f ), Vec2f( 1.0f, 1.0f ),
+                            Vec2f( 1.0f, 0.0f ), Vec2f( 2.0f, -1.0f ), Vec2f( 3.0f, 0.0f ),
+                            Vec2f( 4.0f, 0.0f ) };
+    Math::Spline<Vec2f> spline = Math::createBezier( points, 7 );
+
+    ASSERT_EQ( 2u, spline.segmentCount() );
+
+    EXPECT_EQ( points[0], spline.evaluate( 0.0f ) );
+    EXPECT_EQ( points[3], spline.evaluate( 0.5f ) );
+    EXPECT_EQ( points[6], spline.evaluate( 1.0f ) );
+
+    // (b0 + 3 b1 + 3 b2 + b3) / 8 at the middle of a segment
+    EXPECT_EQ( Vec2f( 0.5f, 0.75f ), spline.evaluate( 0.25f ) );
+
+    // The end tangents point at the neighbouring control points
+    EXPECT_EQ( Vec2f( 0.0f, 6.0f ), spline.derivative( 0.0f ) );
+}
+
+TEST(Math,Spline_BSpline)
+{
+    const Vec2f points[] = { Vec2f( 0.0f, 0.0f ), Vec2f( 1.0f, 6.0f ), Vec2f( 2.0f, 0.0f ),
+                            Vec2f( 3.0f, 6.0f ), Vec2f( 4.0f, 0.0f ) };
+    Math::Spline<Vec2f> spline = Math::createBSpline( points, 5 );
+
+    ASSERT_EQ( 2u, spline.segmentCount() );
+
+    // Starts at ( p0 + 4 p1 + p2 ) / 6 and does not interpolate
+    EXPECT_EQ( Vec2f( 1.0f, 4.0f ), spline.evaluate( 0.0f ) );
+    EXPECT_EQ( Vec2f( 2.0f, 2.0f ), spline.evaluate( 0.5f ) );
+    EXPECT_EQ( Vec2f( 3.0f, 4.0f ), spline.evaluate( 1.0f ) );
+
+    // Second derivative is continuous, so equally spaced collinear
+    // points give a straight line traversed at constant speed
+    const Vec2f line[] = { Vec2f( 0.0f, 0.0f ), Vec2f( 1.0f, 0.0f ), Vec2f( 2.0f, 0.0f ),
+                          Vec2f( 3.0f, 0.0f ), Vec2f( 4.0f, 0.0f ), Vec2f( 5.0f, 0.0f ) };
+    Math::Spline<Vec2f> straight = Math::createBSpline( line, 6 );
+
+    EXPECT_NEAR( 1.75f, straight.evaluate( 0.25f ).x(), 1e-5f );
+    EXPECT_NEAR( 3.0f, straight.derivative( 0.8f ).x(), 1e-4f );
+}
+
+TEST(Math,Spline_HermiteMatchesScalarHermite)
+{
+    const Vec2f points[]   = { Vec2f( 1.0f, -2.0f ), Vec2f( 4.0f, 3.0f ) };
+    const Vec2f tangents[] = { Vec2f( 0.0f, 0.0f ), Vec2f( 0.0f, 0.0f ) };
+    Math::Spline<Vec2f> spline = Math::createHermite( points, tangents, 2 );
+
+    for ( int i = 0; i <= 10; ++i )
+    {
+        const float t = i / 10.0f;
+
+        EXPECT_NEAR( Math::hermite( 1.0f, 4.0f, t ), spline.evaluate( t ).x(), 1e-5f );
+        EXPECT_NEAR( Math::hermite( -2.0f, 3.0f, t ), spline.evaluate( t ).y(), 1e-5f );
+    }
+
+    const Vec2f slopes[] = { Vec2f( 1.0f, 0.0f ), Vec2f( 0.0f, -2.0f ) };
+    Math::Spline<Vec2f> shaped = Math::createHermite( points, slopes, 2 );
+
+    EXPECT_EQ( slopes[0], shaped.derivative( 0.0f ) );
+    EXPECT_EQ( slopes[1], shaped.derivative( 1.0f ) );
+}
+
+TEST(Math,Spline_Quaternions)
+{
+    const Quatf rotations[] = { Quatf( 1.0f, 0.0f, 0.0f, 0.0f ),
+                               Quatf( 0.7071068f, 0.7071068f, 0.0f, 0.0f ),
+                               // Same rotation as ( 0, 1, 0, 0 ), the far hemisphere
+                               Quatf( 0.0f, -1.0f, 0.0f, 0.0f ),
+                               Quatf( 0.0f, 0.7071068f, 0.7071068f, 0.0f ) };
+    Math::Spline<Quatf> spline = Math::createCatmullRom( rotations, 4 );
+
+    for ( int i = 0; i <= 30; ++i )
+    {
+        EXPECT_NEAR( 1.0f, normal( spline.evaluate( i / 30.0f ) ), 1e-5f );
+    }
+
+    // Passes through the third rotation, with its sign flipped
+    const Quatf third = spline.evaluate( 2.0f / 3.0f );
+    EXPECT_NEAR( 0.0f, third.w(), 1e-5f );
+    EXPECT_NEAR( 1.0f, third.x(), 1e-5f );
+
+    // Takes the short way from the second to the third rotation
+    const Quatf between = spline.evaluate( 0.5f );
+    EXPECT_GT( between.w(), 0.0f );
+    EXPECT_GT( between.x(), between.w() );
+}
+
+TEST(Math,Spline_BatchMatchesSingle)
+{
+    std::vector<Vec3f> points = makePath();
+    Math::Spline<Vec3f> spline = Math::createCatmullRom( &points[0], points.size() );
+    spline.computeArcLength();
+
+    std::vector<float> t( 57 ), distances( 57 );
+    std::vector<Vec3f> byParameter( t.size() ), byDistance( t.size() );
+
+    for ( size_t i = 0; i < t.size(); ++i )
+    {
+        t[i] = i / 56.0f;
+        distances[i] = t[i] * spline.length();
+    }
+
+    spline.evaluate( &t[0], &byParameter[0], t.size() );
+    spline.evaluateAtDistance( &distances[0], &byDistance[0], t.size(), 1 );
+
+    for ( size_t i = 0; i < t.size(); ++i )
+    {
+        EXPECT_EQ( spline.evaluate( t[i] ), byParameter[i] );
+        EXPECT_EQ( spline.evaluateAtDistance( distances[i], 1 ), byDistance[i] );
+    }
+}
+
+TEST(Math,Spline_ArcLengthOfStraightLine)
+{
+    // Unevenly spaced points on a line, so t does not move at constant speed
+    const Vec3f points[] = { Vec3f( 0.0f, 0.0f, 0.0f ), Vec3f( 0.5f, 0.0f, 0.0f ),
+                            Vec3f( 4.0f, 0.0f, 0.0f ), Vec3f( 10.0f, 0.0f, 0.0f ) };
+    Math::Spline<Vec3f> spline = Math::createCatmullRom( points, 4, 0.0f );
+
+    spline.computeArcLength();
+
+    EXPECT_NEAR( 10.0f, spline.length(), 1e-4f );
+
+    for ( int i = 0; i <= 20; ++i )
+    {
+        const float distance = i * 0.5f;
+        EXPECT_NEAR( distance, spline.evaluateAtDistance( distance, 2 ).x(), 1e-4f );
+    }
+
+    EXPECT_EQ( 0.0f, spline.parameterAtDistance( -1.0f ) );
+    EXPECT_EQ( 1.0f, spline.parameterAtDistance( 11.0f ) );
+}
+
+TEST(Math,Spline_ArcLengthOfCircle)
+{
+    // Four Bezier quarter circles of radius 2
+    const float k = 2.0f * 0.5522847498f;
+    const Vec2f points[] = { Vec2f( 2.0f, 0.0f ), Vec2f( 2.0f, k ), Vec2f( k, 2.0f ),
+                            Vec2f( 0.0f, 2.0f ), Vec2f( -k, 2.0f ), Vec2f( -2.0f, k ),
+                            Vec2f( -2.0f, 0.0f ), Vec2f( -2.0f, -k ), Vec2f( -k, -2.0f ),
+                            Vec2f( 0.0f, -2.0f ), Vec2f( k, -2.0f ), Vec2f( 2.0f, -k ),
+                            Vec2f( 2.0f, 0.0f ) };
+    Math::Spline<Vec2f> spline = Math::createBezier( points, 13 );
+
+    spline.computeArcLength( 4 );
+    EXPECT_NEAR( 4.0f * Math::Pi, spline.length(), 2e-3f );
+
+    // Newton steps move the point to the requested distance
+    const float distance = 1.3f;
+    const float coarse = spline.parameterAtDistance( distance );
+    const float fine   = spline.parameterAtDistance( distance, 2 );
+
+    Math::Spline<Vec2f> reference = spline;
+    reference.computeArcLength( 256 );
+    const float exact = reference.parameterAtDistance( distance );
+
+    EXPECT_LT( std::fabs( fine - exact ), 1e-6f );
+    EXPECT_LE( std::fabs( fine - exact ), std::fabs( coarse - exact ) );
+}
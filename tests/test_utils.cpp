@@ -52,6 +52,13 @@ TEST(Math,Utils_EqualsClose_ZeroEdges)
     EXPECT_TRUE( equalsClose( 0.0f,-0.0000000000f  ) );
 }
 
+TEST(Math,Utils_EqualsClose_ConstantExpression)
+{
+    static_assert( equalsClose( 1.0f, 1.000001f ), "equalsClose must be a constant expression" );
+    static_assert( !equalsClose( 1.0, 1.001 ), "" );
+    static_assert( equalsClose( 42, 42 ), "" );
+}
+
 //===========================================================================
 // Close equals zero
 //===========================================================================
@@ -8,29 +8,29 @@
 #include "unittesthelpers.h"
 
 #ifndef MATH_TYPEDEFS
-typedef TVector2<float> Vec2;
+typedef TVector2<float> Vec2f;
 #endif
 
 TEST(Math, Vector2_DefaultContructor)
 {
-    const Vec2 v;
+    const Vec2f v;
     EXPECT_TRUE( true );      // test here just to make sure it compiles
 }
 
 TEST(Math, Vector2_SizeTest)
 {
-    const Vec2 v( 1.0f, 2.0f );
+    const Vec2f v( 1.0f, 2.0f );
     EXPECT_EQ( sizeof(float) * 2, sizeof(v) );
 }
 
 TEST(Math, Vector2_MemoryArrayTest)
 {
     // Makes sure that a vector is laid out linearly in memory
-    Vec2 v[3];
+    Vec2f v[3];
 
-    v[0] = Vec2( 1.0f, 2.0f );
-    v[1] = Vec2( 3.0f, 4.0f );
-    v[2] = Vec2( 5.0f, 6.0f );
+    v[0] = Vec2f( 1.0f, 2.0f );
+    v[1] = Vec2f( 3.0f, 4.0f );
+    v[2] = Vec2f( 5.0f, 6.0f );
 
     const float * pVals = v[0].const_ptr();
 
@@ -45,7 +45,7 @@ TEST(Math, Vector2_MemoryArrayTest)
 TEST(Math, Vector2_PointerConstructor)
 {
     float values[5] = { 3.0f, 2.0f, 5.0f, -3.0f, 6.0f };
-    Vec2 v( &values[1] );
+    Vec2f v( &values[1] );
 
     EXPECT_FLOAT_EQ(  2.0f, v[0] );
     EXPECT_FLOAT_EQ(  5.0f, v[1] );
@@ -53,7 +53,7 @@ TEST(Math, Vector2_PointerConstructor)
 
 TEST(Math, Vector2_ValueConstructor)
 {
-    const Vec2 v( 1.0f, -2.0f );
+    const Vec2f v( 1.0f, -2.0f );
 
     EXPECT_FLOAT_EQ(  1.0f, v[0] );
     EXPECT_FLOAT_EQ( -2.0f, v[1] );
@@ -61,8 +61,8 @@ TEST(Math, Vector2_ValueConstructor)
 
 TEST(Math, Vector2_CopyConstructor)
 {
-    const Vec2 a( 1.0f, -2.0f );
-    const Vec2 b( a );
+    const Vec2f a( 1.0f, -2.0f );
+    const Vec2f b( a );
 
     EXPECT_FLOAT_EQ(  1.0f, b[0] );
     EXPECT_FLOAT_EQ( -2.0f, b[1] );
@@ -70,7 +70,7 @@ TEST(Math, Vector2_CopyConstructor)
 
 TEST(Math, Vector2_ConstIndexOperatorRead)
 {
-    const Vec2 v( 1.0f, -2.0f );
+    const Vec2f v( 1.0f, -2.0f );
 
     EXPECT_FLOAT_EQ(  1.0f, v[0] );
     EXPECT_FLOAT_EQ( -2.0f, v[1] );
@@ -78,17 +78,17 @@ TEST(Math, Vector2_ConstIndexOperatorRead)
 
 TEST(Math, Vector2_IndexOperatorWrite)
 {
-    Vec2 v( 1.0f, -2.0f );
+    Vec2f v( 1.0f, -2.0f );
 
     v[0] = 2.0f;
     v[1] = 0.2f;
 
-    EXPECT_EQ( Vec2( 2.0f, 0.2f ), v );
+    EXPECT_EQ( Vec2f( 2.0f, 0.2f ), v );
 }
 
 TEST(Math, Vector2_ConstPointerAccess)
 {
-    Vec2 v( 1.0f, 2.0f );
+    Vec2f v( 1.0f, 2.0f );
     const float * ptr = v.ptr();
 
     EXPECT_FLOAT_EQ( 1.0f, ptr[0] );
@@ -97,7 +97,7 @@ TEST(Math, Vector2_ConstPointerAccess)
 
 TEST(Math, Vector2_ConstConstPointerAccess)
 {
-    Vec2 v( 1.0f, 2.0f );
+    Vec2f v( 1.0f, 2.0f );
     const float * ptr = v.const_ptr();
 
     EXPECT_FLOAT_EQ( 1.0f, ptr[0] );
@@ -106,35 +106,35 @@ TEST(Math, Vector2_ConstConstPointerAccess)
 
 TEST(Math, Vector2_NonConstPointerReadAndWrite)
 {
-    Vec2 v( 1.0f, 2.0f );
+    Vec2f v( 1.0f, 2.0f );
     float * ptr = v.ptr();
 
-    EXPECT_EQ( Vec2( 1.0f, 2.0f ), v );
+    EXPECT_EQ( Vec2f( 1.0f, 2.0f ), v );
 
     ptr[0] = 5.0f;
     ptr[1] = 6.0f;
 
-    EXPECT_EQ( Vec2( 5.0f, 6.0f ), v );
+    EXPECT_EQ( Vec2f( 5.0f, 6.0f ), v );
 }
 
 TEST(Math, Vector2_Assignment)
 {
-    Vec2 a( 1.0f, 2.0f );
-    const Vec2 b( 3.0f, 4.0f );
+    Vec2f a( 1.0f, 2.0f );
+    const Vec2f b( 3.0f, 4.0f );
     
     a = b;
 
-    EXPECT_NE( Vec2( 1.0f, 2.0f ), a );
-    EXPECT_EQ( Vec2( 3.0f, 4.0f ), a );
+    EXPECT_NE( Vec2f( 1.0f, 2.0f ), a );
+    EXPECT_EQ( Vec2f( 3.0f, 4.0f ), a );
 }
 
 TEST(Math, Vector2_EqualityOperator)
 {
-    const Vec2 a( 1.5f, -0.2f );
-    const Vec2 b( 1.5f,  0.2f );
-    const Vec2 c( 0.5f, -0.2f );
-    const Vec2 e( 0.0f,  0.5f );
-    const Vec2 f( 1.5f, -0.2f );
+    const Vec2f a( 1.5f, -0.2f );
+    const Vec2f b( 1.5f,  0.2f );
+    const Vec2f c( 0.5f, -0.2f );
+    const Vec2f e( 0.0f,  0.5f );
+    const Vec2f f( 1.5f, -0.2f );
 
     EXPECT_EQ( a, f );
     EXPECT_EQ( a, a );
@@ -147,19 +147,19 @@ TEST(Math, Vector2_EqualityOperator)
 
 TEST(Math, Vector2_EqualityOperatorPrecision)
 {
-    const Vec2 a( 2.2f, -0.333f );
-    const Vec2 b( 4.4f/2.0f, -0.999f/3.0f );
+    const Vec2f a( 2.2f, -0.333f );
+    const Vec2f b( 4.4f/2.0f, -0.999f/3.0f );
 
     EXPECT_EQ( a, b );
 }
 
 TEST(Math, Vector2_InequalityOperator)
 {
-    const Vec2 a( 1.5f, -0.2f );
-    const Vec2 b( 1.5f,  0.2f );
-    const Vec2 c( 0.5f, -0.2f );
-    const Vec2 e( 0.0f,  0.5f );
-    const Vec2 f( 1.5f, -0.2f );
+    const Vec2f a( 1.5f, -0.2f );
+    const Vec2f b( 1.5f,  0.2f );
+    const Vec2f c( 0.5f, -0.2f );
+    const Vec2f e( 0.0f,  0.5f );
+    const Vec2f f( 1.5f, -0.2f );
 
     EXPECT_TRUE( a != b );
     EXPECT_TRUE( a != c );
@@ -171,36 +171,36 @@ TEST(Math, Vector2_InequalityOperator)
 
 TEST(Math, Vector2_Negation)
 {
-    Vec2 a( 2.0f, 0.0f );
+    Vec2f a( 2.0f, 0.0f );
     a = -a;
 
-    EXPECT_EQ( Vec2( -2.0f, -0.0f ), a );
-    EXPECT_EQ( Vec2( -2.0f,  0.0f ), a );    // close
+    EXPECT_EQ( Vec2f( -2.0f, -0.0f ), a );
+    EXPECT_EQ( Vec2f( -2.0f,  0.0f ), a );    // close
 }
 
 TEST(Math, Vector2_AdditionOperator)
 {
-    const Vec2 a( 3.0f, 5.0f );
-    const Vec2 b(-4.0f, 6.0f );
+    const Vec2f a( 3.0f, 5.0f );
+    const Vec2f b(-4.0f, 6.0f );
 
-    EXPECT_EQ( Vec2( -1.0f, 11.0f ), a + b );
+    EXPECT_EQ( Vec2f( -1.0f, 11.0f ), a + b );
 }
 
 TEST(Math, Vector2_SelfAdditionOperator)
 {
-          Vec2 a( 3.0f, 5.0f );
-    const Vec2 b(-4.0f, 6.0f );
+          Vec2f a( 3.0f, 5.0f );
+    const Vec2f b(-4.0f, 6.0f );
 
     a += b;
 
-    EXPECT_EQ( Vec2( -1.0f, 11.0f ), a );
+    EXPECT_EQ( Vec2f( -1.0f, 11.0f ), a );
 }
 
 TEST(Math, Vector2_SubtractionOperator)
 {
-    const Vec2 a( 5.0f, 2.0f );
-    const Vec2 b(-1.0f, 3.0f );
-    const Vec2 c = a - b;
+    const Vec2f a( 5.0f, 2.0f );
+    const Vec2f b(-1.0f, 3.0f );
+    const Vec2f c = a - b;
     
     EXPECT_FLOAT_EQ(   6.0f, c[0] );
     EXPECT_FLOAT_EQ(  -1.0f, c[1] );
@@ -208,8 +208,8 @@ TEST(Math, Vector2_SubtractionOperator)
 
 TEST(Math, Vector2_SelfSubtractionOperator)
 {
-    Vec2       a( 5.0f, 2.0f );
-    const Vec2 b(-1.0f, 3.0f );
+    Vec2f       a( 5.0f, 2.0f );
+    const Vec2f b(-1.0f, 3.0f );
     a -= b;
     
     EXPECT_FLOAT_EQ(   6.0f, a[0] );
@@ -218,40 +218,40 @@ TEST(Math, Vector2_SelfSubtractionOperator)
 
 TEST(Math, Vector2_MultiplyOperator)
 {
-    const Vec2 a( 3.0f, 5.0f );
-    const Vec2 b = a * 2.0f;
+    const Vec2f a( 3.0f, 5.0f );
+    const Vec2f b = a * 2.0f;
 
-    EXPECT_EQ( Vec2( 6.0f, 10.0f ), b );
+    EXPECT_EQ( Vec2f( 6.0f, 10.0f ), b );
 }
 
 TEST(Math, Vector2_SelfMultiplyOperator)
 {
-    Vec2 a( 3.0f, 5.0f );
+    Vec2f a( 3.0f, 5.0f );
     a *= 2.0f;
 
-    EXPECT_EQ( Vec2( 6.0f, 10.0f ), a );
+    EXPECT_EQ( Vec2f( 6.0f, 10.0f ), a );
 }
 
 TEST(Math, Vector2_DivisionOperator)
 {
-    const Vec2 a( 3.0f, 5.0f );
-    const Vec2 b = a / 2.0f;
+    const Vec2f a( 3.0f, 5.0f );
+    const Vec2f b = a / 2.0f;
 
-    EXPECT_EQ( Vec2( 1.5f, 2.5f ), b );
+    EXPECT_EQ( Vec2f( 1.5f, 2.5f ), b );
 }
 
 TEST(Math, Vector2_SelfDivisionOperator)
 {
-    Vec2 a( 3.0f, 5.0f );
+    Vec2f a( 3.0f, 5.0f );
     a /= 2.0f;
 
-    EXPECT_EQ( Vec2( 1.5f, 2.5f ), a );
+    EXPECT_EQ( Vec2f( 1.5f, 2.5f ), a );
 }
 
 TEST(Math, Vector2_XAccessor)
 {
-    Vec2 a( 1.0f, 2.0f );
-    Vec2 b( 6.0f, 5.0f );
+    Vec2f a( 1.0f, 2.0f );
+    Vec2f b( 6.0f, 5.0f );
 
     EXPECT_FLOAT_EQ( 1.0f, a.x() );
     EXPECT_FLOAT_EQ( 6.0f, b.x() );
@@ -259,8 +259,8 @@ TEST(Math, Vector2_XAccessor)
 
 TEST(Math, Vector2_YAccessor)
 {
-    Vec2 a( 1.0f, 2.0f );
-    Vec2 b( 6.0f, 5.0f );
+    Vec2f a( 1.0f, 2.0f );
+    Vec2f b( 6.0f, 5.0f );
 
     EXPECT_FLOAT_EQ( 2.0f, a.y() );
     EXPECT_FLOAT_EQ( 5.0f, b.y() );
@@ -268,7 +268,7 @@ TEST(Math, Vector2_YAccessor)
 
 TEST(Math, Vector2_ZeroVector)
 {
-    const Vec2 a = Vec2::ZERO;
+    const Vec2f a = Vec2f::ZERO;
 
     EXPECT_FLOAT_EQ( a[0], 0.0f );
     EXPECT_FLOAT_EQ( a[1], 0.0f );
@@ -276,15 +276,15 @@ TEST(Math, Vector2_ZeroVector)
 
 TEST(Math, Vector2_ZeroVectorIsZeroValueConstructed)
 {
-    const Vec2 a( 0.0f, 0.0f );
-    const Vec2 z = Vec2::ZERO;
+    const Vec2f a( 0.0f, 0.0f );
+    const Vec2f z = Vec2f::ZERO;
 
     EXPECT_EQ( a, z );
 }
 
 TEST(Math, Vector2_Length)
 {
-    const Vec2 a( 1.0f, 2.0f );
+    const Vec2f a( 1.0f, 2.0f );
     EXPECT_FLOAT_EQ( 2.23606798f, length( a ) );
 }
 
@@ -295,7 +295,7 @@ TEST(Math, Vector2_LengthZero)
 
 TEST(Math, Vector2_SquaredLength)
 {
-    const Vec2 a( 1.0f, 2.0f );
+    const Vec2f a( 1.0f, 2.0f );
     EXPECT_FLOAT_EQ( 5.0f, lengthSquared( a ) );
 }
 
@@ -306,47 +306,81 @@ TEST(Math, Vector2_SquareLengthZero)
 
 TEST(Math, Vector2_Normalization)
 {
-    const Vec2 a( 3.0f, 1.0f );
-    const Vec2 n = normalized( a );
+    const Vec2f a( 3.0f, 1.0f );
+    const Vec2f n = normalized( a );
 
     EXPECT_TRUE(
             VectorEquals( 
-                Vec2( 0.948683298f, 0.316227766f ),
+                Vec2f( 0.948683298f, 0.316227766f ),
                 n )
     );
 }
 
+TEST(Math, Vector2_Integer)
+{
+    typedef TVector2<int> Vec2i;
+
+    const Vec2i a( 3, -4 );
+    const Vec2i b( 2, 5 );
+
+    EXPECT_EQ( Vec2i( 5, 1 ), a + b );
+    EXPECT_EQ( Vec2i( 1, -9 ), a - b );
+    EXPECT_EQ( Vec2i( 6, -8 ), a * 2 );
+    EXPECT_EQ( Vec2i( 1, -2 ), a / 2 );
+    EXPECT_EQ( 25, lengthSquared( a ) );
+    EXPECT_EQ( Vec2i( 2, -4 ), min( a, b ) );
+}
+
 TEST(Math, Vector2_Lerp)
 {
-    const Vec2 a( 1.0f, 2.0f );
-    const Vec2 b( 2.0f, 4.0f );
+    const Vec2f a( 1.0f, 2.0f );
+    const Vec2f b( 2.0f, 4.0f );
 
-    EXPECT_TRUE( VectorEquals( Vec2( 1.0f, 2.0f ), lerp( a, b, 0.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec2( 1.5f, 3.0f ), lerp( a, b, 0.5f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec2( 2.0f, 4.0f ), lerp( a, b, 1.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec2f( 1.0f, 2.0f ), lerp( a, b, 0.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec2f( 1.5f, 3.0f ), lerp( a, b, 0.5f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec2f( 2.0f, 4.0f ), lerp( a, b, 1.0f ) ) );
 }
 
 TEST(Math, Vector2_Min)
 {
-    const Vec2 a( 1.0f, 3.0f );
-    const Vec2 b( 1.5f, 2.0f );
+    const Vec2f a( 1.0f, 3.0f );
+    const Vec2f b( 1.5f, 2.0f );
 
-    EXPECT_TRUE( VectorEquals( Vec2( 1.0f, 2.0f ), min( a, b ) ) );
+    EXPECT_TRUE( VectorEquals( Vec2f( 1.0f, 2.0f ), min( a, b ) ) );
 }
 
 TEST(Math, Vector2_Max)
 {
-    const Vec2 a( 1.0f, 3.0f );
-    const Vec2 b( 1.5f, 2.0f );
+    const Vec2f a( 1.0f, 3.0f );
+    const Vec2f b( 1.5f, 2.0f );
 
-    EXPECT_TRUE( VectorEquals( Vec2( 1.5f, 3.0f ), max( a, b ) ) );
+    EXPECT_TRUE( VectorEquals( Vec2f( 1.5f, 3.0f ), max( a, b ) ) );
 }
 
 TEST(Math, Vector2_Clamp)
 {
-    const Vec2 a( 1.5f, 1.5f );
-    const Vec2 min( 1.0f, 2.0f );
-    const Vec2 max( 2.0f, 3.0f );
+    const Vec2f a( 1.5f, 1.5f );
+    const Vec2f min( 1.0f, 2.0f );
+    const Vec2f max( 2.0f, 3.0f );
+
+    EXPECT_TRUE( VectorEquals( Vec2f( 1.5f, 2.0f ), clamp( a, min, max ) ) );
+}
+
+TEST(Math, Vector2_Swizzle)
+{
+    constexpr Vec2f a( 1.0f, 2.0f );
+
+    static_assert( a.yx() == Vec2f( 2.0f, 1.0f ), "swizzles must be constant expressions" );
+
+    EXPECT_EQ( Vec2f( 1.0f, 1.0f ), a.xx() );
+    EXPECT_EQ( TVector3<float>( 2.0f, 1.0f, 2.0f ), a.yxy() );
+    EXPECT_EQ( TVector4<float>( 1.0f, 2.0f, 2.0f, 1.0f ), a.xyyx() );
+}
+
+TEST(Math, Vector2_SwizzleWrite)
+{
+    Vec2f a( 1.0f, 2.0f );
+    a.yx( a );
 
-    EXPECT_TRUE( VectorEquals( Vec2( 1.5f, 2.0f ), clamp( a, min, max ) ) );
+    EXPECT_EQ( Vec2f( 2.0f, 1.0f ), a );
 }
@@ -6,30 +6,32 @@
 #include <smath/vector.h>
 #include "unittesthelpers.h"
 
+#include <cmath>
+
 #ifndef MATH_TYPEDEFS
-typedef TVector3<float> Vec3;
+typedef TVector3<float> Vec3f;
 #endif
 
 TEST(Math, Vector3_DefaultContructor)
 {
-    const Vec3 v;
+    const Vec3f v;
     EXPECT_TRUE( true );      // test here just to make sure it compiles
 }
 
 TEST(Math, Vector3_SizeTest)
 {
-    const Vec3 v( 1.0f, 2.0f, 3.0f );
+    const Vec3f v( 1.0f, 2.0f, 3.0f );
     EXPECT_EQ( sizeof(float) * 3, sizeof(v) );
 }
 
 TEST(Math, Vector3_MemoryArrayTest)
 {
     // Makes sure that a vector is laid out linearly in memory
-    Vec3 v[3];
+    Vec3f v[3];
 
-    v[0] = Vec3( 1.0f, 2.0f, 3.0f );
-    v[1] = Vec3( 4.0f, 5.0f, 6.0f );
-    v[2] = Vec3( 7.0f, 8.0f, 9.0f );
+    v[0] = Vec3f( 1.0f, 2.0f, 3.0f );
+    v[1] = Vec3f( 4.0f, 5.0f, 6.0f );
+    v[2] = Vec3f( 7.0f, 8.0f, 9.0f );
 
     const float * pVals = v[0].const_ptr();
 
@@ -47,7 +49,7 @@ TEST(Math, Vector3_MemoryArrayTest)
 TEST(Math, Vector3_PointerConstructor)
 {
     float values[5] = { 3.0f, 2.0f, 5.0f, -3.0f, 6.0f };
-    Vec3 v( &values[1] );
+    Vec3f v( &values[1] );
 
     EXPECT_FLOAT_EQ(  2.0f, v[0] );
     EXPECT_FLOAT_EQ(  5.0f, v[1] );
@@ -56,7 +58,7 @@ TEST(Math, Vector3_PointerConstructor)
 
 TEST(Math, Vector3_ValueConstructor)
 {
-    const Vec3 v( 1.0f, -2.0f, 0.2f );
+    const Vec3f v( 1.0f, -2.0f, 0.2f );
 
     EXPECT_FLOAT_EQ(  1.0f, v[0] );
     EXPECT_FLOAT_EQ( -2.0f, v[1] );
@@ -65,8 +67,8 @@ TEST(Math, Vector3_ValueConstructor)
 
 TEST(Math, Vector3_CopyConstructor)
 {
-    const Vec3 a( 1.0f, -2.0f, 0.2f );
-    const Vec3 b( a );
+    const Vec3f a( 1.0f, -2.0f, 0.2f );
+    const Vec3f b( a );
 
     EXPECT_FLOAT_EQ(  1.0f, b[0] );
     EXPECT_FLOAT_EQ( -2.0f, b[1] );
@@ -75,7 +77,7 @@ TEST(Math, Vector3_CopyConstructor)
 
 TEST(Math, Vector3_ConstIndexOperatorRead)
 {
-    const Vec3 v( 1.0f, -2.0f, 0.2f );
+    const Vec3f v( 1.0f, -2.0f, 0.2f );
 
     EXPECT_FLOAT_EQ(  1.0f, v[0] );
     EXPECT_FLOAT_EQ( -2.0f, v[1] );
@@ -84,18 +86,18 @@ TEST(Math, Vector3_ConstIndexOperatorRead)
 
 TEST(Math, Vector3_IndexOperatorWrite)
 {
-    Vec3 v( 1.0f, -2.0f, 0.2f );
+    Vec3f v( 1.0f, -2.0f, 0.2f );
 
     v[0] = 2.0f;
     v[1] = 0.2f;
     v[2] = -1.0f;
 
-    EXPECT_EQ( Vec3( 2.0f, 0.2f, -1.0f ), v );
+    EXPECT_EQ( Vec3f( 2.0f, 0.2f, -1.0f ), v );
 }
 
 TEST(Math, Vector3_ConstPointerAccess)
 {
-    Vec3 v( 1.0f, 2.0f, 3.0f );
+    Vec3f v( 1.0f, 2.0f, 3.0f );
     const float * ptr = v.ptr();
 
     EXPECT_FLOAT_EQ( 1.0f, ptr[0] );
@@ -105,7 +107,7 @@ TEST(Math, Vector3_ConstPointerAccess)
 
 TEST(Math, Vector3_ConstConstPointerAccess)
 {
-    Vec3 v( 1.0f, 2.0f, 3.0f );
+    Vec3f v( 1.0f, 2.0f, 3.0f );
     const float * ptr = v.const_ptr();
 
     EXPECT_FLOAT_EQ( 1.0f, ptr[0] );
@@ -115,37 +117,37 @@ TEST(Math, Vector3_ConstConstPointerAccess)
 
 TEST(Math, Vector3_NonConstPointerReadAndWrite)
 {
-    Vec3 v( 1.0f, 2.0f, 3.0f );
+    Vec3f v( 1.0f, 2.0f, 3.0f );
     float * ptr = v.ptr();
 
-    EXPECT_EQ( Vec3( 1.0f, 2.0f, 3.0f ), v );
+    EXPECT_EQ( Vec3f( 1.0f, 2.0f, 3.0f ), v );
 
     ptr[0] = 5.0f;
     ptr[1] = 6.0f;
     ptr[2] = 7.0f;
 
-    EXPECT_EQ( Vec3( 5.0f, 6.0f, 7.0f ), v );
+    EXPECT_EQ( Vec3f( 5.0f, 6.0f, 7.0f ), v );
 }
 
 TEST(Math, Vector3_Assignment)
 {
-    Vec3 a( 1.0f, 2.0f, 3.0f );
-    const Vec3 b( 3.0f, 4.0f, 5.0f );
+    Vec3f a( 1.0f, 2.0f, 3.0f );
+    const Vec3f b( 3.0f, 4.0f, 5.0f );
     
     a = b;
 
-    EXPECT_NE( Vec3( 1.0f, 2.0f, 3.0f ), a );
-    EXPECT_EQ( Vec3( 3.0f, 4.0f, 5.0f ), a );
+    EXPECT_NE( Vec3f( 1.0f, 2.0f, 3.0f ), a );
+    EXPECT_EQ( Vec3f( 3.0f, 4.0f, 5.0f ), a );
 }
 
 TEST(Math, Vector3_EqualityOperator)
 {
-    const Vec3 a( 1.5f, -0.2f, 0.0f );
-    const Vec3 b( 1.5f,  0.2f, 0.0f );
-    const Vec3 c( 1.5f, -0.2f, 0.1f );
-    const Vec3 d( 1.5f,  0.0f,-0.2f );
-    const Vec3 e( 0.0f,  1.5f,-0.2f );
-    const Vec3 f( 1.5f, -0.2f, 0.0f );
+    const Vec3f a( 1.5f, -0.2f, 0.0f );
+    const Vec3f b( 1.5f,  0.2f, 0.0f );
+    const Vec3f c( 1.5f, -0.2f, 0.1f );
+    const Vec3f d( 1.5f,  0.0f,-0.2f );
+    const Vec3f e( 0.0f,  1.5f,-0.2f );
+    const Vec3f f( 1.5f, -0.2f, 0.0f );
 
     EXPECT_EQ( a, f );
     EXPECT_EQ( a, a );
@@ -160,8 +162,8 @@ TEST(Math, Vector3_EqualityOperator)
 TEST(Math, Vector3_EqualityOperatorPrecision)
 {
 #ifdef MATH_FUZZY_EQUALS
-    const Vec3 a( 2.2f, -0.333f, 1.5f );
-    const Vec3 b( 4.4f/2.0f, -0.999f/3.0f, 0.5f * 3.0f );
+    const Vec3f a( 2.2f, -0.333f, 1.5f );
+    const Vec3f b( 4.4f/2.0f, -0.999f/3.0f, 0.5f * 3.0f );
 
     EXPECT_EQ( a, b );
 #endif
@@ -169,12 +171,12 @@ TEST(Math, Vector3_EqualityOperatorPrecision)
 
 TEST(Math, Vector3_InequalityOperator)
 {
-    const Vec3 a( 1.5f, -0.2f, 0.0f );
-    const Vec3 b( 1.5f,  0.2f, 0.0f );
-    const Vec3 c( 1.5f, -0.2f, 0.1f );
-    const Vec3 d( 1.5f,  0.0f,-0.2f );
-    const Vec3 e( 0.0f,  1.5f,-0.2f );
-    const Vec3 f( 1.5f, -0.2f, 0.0f );
+    const Vec3f a( 1.5f, -0.2f, 0.0f );
+    const Vec3f b( 1.5f,  0.2f, 0.0f );
+    const Vec3f c( 1.5f, -0.2f, 0.1f );
+    const Vec3f d( 1.5f,  0.0f,-0.2f );
+    const Vec3f e( 0.0f,  1.5f,-0.2f );
+    const Vec3f f( 1.5f, -0.2f, 0.0f );
 
     EXPECT_TRUE( a != b );
     EXPECT_TRUE( a != c );
@@ -187,36 +189,36 @@ TEST(Math, Vector3_InequalityOperator)
 
 TEST(Math, Vector3_Negation)
 {
-    Vec3 a( 2.0f, 0.0f, -1.0f );
+    Vec3f a( 2.0f, 0.0f, -1.0f );
     a = -a;
 
-    EXPECT_EQ( Vec3( -2.0f, -0.0f, 1.0f ), a );
-    EXPECT_EQ( Vec3( -2.0f,  0.0f, 1.0f ), a );    // close
+    EXPECT_EQ( Vec3f( -2.0f, -0.0f, 1.0f ), a );
+    EXPECT_EQ( Vec3f( -2.0f,  0.0f, 1.0f ), a );    // close
 }
 
 TEST(Math, Vector3_AdditionOperator)
 {
-    const Vec3 a( 3.0f, 5.0f, 9.0f );
-    const Vec3 b(-4.0f, 6.0f, 3.0f );
+    const Vec3f a( 3.0f, 5.0f, 9.0f );
+    const Vec3f b(-4.0f, 6.0f, 3.0f );
 
-    EXPECT_EQ( Vec3( -1.0f, 11.0f, 12.0f ), a + b );
+    EXPECT_EQ( Vec3f( -1.0f, 11.0f, 12.0f ), a + b );
 }
 
 TEST(Math, Vector3_SelfAdditionOperator)
 {
-          Vec3 a( 3.0f, 5.0f, 9.0f );
-    const Vec3 b(-4.0f, 6.0f, 3.0f );
+          Vec3f a( 3.0f, 5.0f, 9.0f );
+    const Vec3f b(-4.0f, 6.0f, 3.0f );
 
     a += b;
 
-    EXPECT_EQ( Vec3( -1.0f, 11.0f, 12.0f ), a );
+    EXPECT_EQ( Vec3f( -1.0f, 11.0f, 12.0f ), a );
 }
 
 TEST(Math, Vector3_SubtractionOperator)
 {
-    const Vec3 a( 5.0f, 2.0f, -4.0f );
-    const Vec3 b(-1.0f, 3.0f,  8.0f );
-    const Vec3 c = a - b;
+    const Vec3f a( 5.0f, 2.0f, -4.0f );
+    const Vec3f b(-1.0f, 3.0f,  8.0f );
+    const Vec3f c = a - b;
     
     EXPECT_FLOAT_EQ(   6.0f, c[0] );
     EXPECT_FLOAT_EQ(  -1.0f, c[1] );
@@ -225,8 +227,8 @@ TEST(Math, Vector3_SubtractionOperator)
 
 TEST(Math, Vector3_SelfSubtractionOperator)
 {
-    Vec3       a( 5.0f, 2.0f, -4.0f );
-    const Vec3 b(-1.0f, 3.0f,  8.0f );
+    Vec3f       a( 5.0f, 2.0f, -4.0f );
+    const Vec3f b(-1.0f, 3.0f,  8.0f );
     a -= b;
     
     EXPECT_FLOAT_EQ(   6.0f, a[0] );
@@ -236,40 +238,40 @@ TEST(Math, Vector3_SelfSubtractionOperator)
 
 TEST(Math, Vector3_MultiplyOperator)
 {
-    const Vec3 a( 3.0f, 5.0f, 9.0f );
-    const Vec3 b = a * 2.0f;
+    const Vec3f a( 3.0f, 5.0f, 9.0f );
+    const Vec3f b = a * 2.0f;
 
-    EXPECT_EQ( Vec3( 6.0f, 10.0f, 18.0f ), b );
+    EXPECT_EQ( Vec3f( 6.0f, 10.0f, 18.0f ), b );
 }
 
 TEST(Math, Vector3_SelfMultiplyOperator)
 {
-    Vec3 a( 3.0f, 5.0f, 9.0f );
+    Vec3f a( 3.0f, 5.0f, 9.0f );
     a *= 2.0f;
 
-    EXPECT_EQ( Vec3( 6.0f, 10.0f, 18.0f ), a );
+    EXPECT_EQ( Vec3f( 6.0f, 10.0f, 18.0f ), a );
 }
 
 TEST(Math, Vector3_DivisionOperator)
 {
-    const Vec3 a( 3.0f, 5.0f, 9.0f );
-    const Vec3 b = a / 2.0f;
+    const Vec3f a( 3.0f, 5.0f, 9.0f );
+    const Vec3f b = a / 2.0f;
 
-    EXPECT_EQ( Vec3( 1.5f, 2.5f, 4.5f ), b );
+    EXPECT_EQ( Vec3f( 1.5f, 2.5f, 4.5f ), b );
 }
 
 TEST(Math, Vector3_SelfDivisionOperator)
 {
-    Vec3 a( 3.0f, 5.0f, 9.0f );
+    Vec3f a( 3.0f, 5.0f, 9.0f );
     a /= 2.0f;
 
-    EXPECT_EQ( Vec3( 1.5f, 2.5f, 4.5f ), a );
+    EXPECT_EQ( Vec3f( 1.5f, 2.5f, 4.5f ), a );
 }
 
 TEST(Math, Vector3_XAccessor)
 {
-    Vec3 a( 1.0f, 2.0f, 3.0f );
-    Vec3 b( 6.0f, 5.0f, 4.0f );
+    Vec3f a( 1.0f, 2.0f, 3.0f );
+    Vec3f b( 6.0f, 5.0f, 4.0f );
 
     EXPECT_FLOAT_EQ( 1.0f, a.x() );
     EXPECT_FLOAT_EQ( 6.0f, b.x() );
@@ -277,8 +279,8 @@ TEST(Math, Vector3_XAccessor)
 
 TEST(Math, Vector3_YAccessor)
 {
-    Vec3 a( 1.0f, 2.0f, 3.0f );
-    Vec3 b( 6.0f, 5.0f, 4.0f );
+    Vec3f a( 1.0f, 2.0f, 3.0f );
+    Vec3f b( 6.0f, 5.0f, 4.0f );
 
     EXPECT_FLOAT_EQ( 2.0f, a.y() );
     EXPECT_FLOAT_EQ( 5.0f, b.y() );
@@ -286,8 +288,8 @@ TEST(Math, Vector3_YAccessor)
 
 TEST(Math, Vector3_ZAccessor)
 {
-    Vec3 a( 1.0f, 2.0f, 3.0f );
-    Vec3 b( 6.0f, 5.0f, 4.0f );
+    Vec3f a( 1.0f, 2.0f, 3.0f );
+    Vec3f b( 6.0f, 5.0f, 4.0f );
 
     EXPECT_FLOAT_EQ( 3.0f, a.z() );
     EXPECT_FLOAT_EQ( 4.0f, b.z() );
@@ -295,7 +297,7 @@ TEST(Math, Vector3_ZAccessor)
 
 TEST(Math, Vector3_ZeroVector)
 {
-    const Vec3 a = Vec3::ZERO;
+    const Vec3f a = Vec3f::ZERO;
 
     EXPECT_FLOAT_EQ( a[0], 0.0f );
     EXPECT_FLOAT_EQ( a[1], 0.0f );
@@ -304,38 +306,38 @@ TEST(Math, Vector3_ZeroVector)
 
 TEST(Math, Vector3_ZeroVectorIsZeroValueConstructed)
 {
-    const Vec3 a( 0.0f, 0.0f, 0.0f );
-    const Vec3 z = Vec3::ZERO;
+    const Vec3f a( 0.0f, 0.0f, 0.0f );
+    const Vec3f z = Vec3f::ZERO;
 
     EXPECT_EQ( a, z );
 }
 
 TEST(Math, Vector3_CrossProductZero)
 {
-    EXPECT_EQ( Vec3::ZERO, cross( Vec3::ZERO, Vec3( 1.0f, 2.0f, 3.0f ) ) );
+    EXPECT_EQ( Vec3f::ZERO, cross( Vec3f::ZERO, Vec3f( 1.0f, 2.0f, 3.0f ) ) );
 }
 
 TEST(Math, Vector3_CrossProduct)
 {
-    const Vec3 a( 1.0f, 3.0f, -4.0f );
-    const Vec3 b( 2.0f, -5.0f, 8.0f );
-    const Vec3 r( 4.0f, -16.0f, -11.0f );
+    const Vec3f a( 1.0f, 3.0f, -4.0f );
+    const Vec3f b( 2.0f, -5.0f, 8.0f );
+    const Vec3f r( 4.0f, -16.0f, -11.0f );
 
     EXPECT_EQ( r, cross( a, b ) );
 }
 
 TEST(Math, Vector3_SimpleDotProduct2D)
 {
-    const Vec3 a( 60, 80, 0 );
-    const Vec3 b( 30, 40, 0 );
+    const Vec3f a( 60, 80, 0 );
+    const Vec3f b( 30, 40, 0 );
 
     EXPECT_FLOAT_EQ( 5000.0f, dot( a, b ) );
 }
 
 TEST(Math, Vector3_SimpleDotProduct3D)
 {
-    const Vec3 a( 60, 80, 100 );
-    const Vec3 b( 30, 40, 50 );
+    const Vec3f a( 60, 80, 100 );
+    const Vec3f b( 30, 40, 50 );
 
     EXPECT_FLOAT_EQ( 10000.0f, dot( a, b ) );
 }
@@ -344,9 +346,9 @@ TEST(Math, Vector3_DotOppositeIsNegative)
 {
     // Tests axiom that dot product of opposite vectors is the
     // negative
-    const Vec3 a( 60, 80, 100 );
-    const Vec3 b( 30, 40, 50 );
-    const Vec3 c( -30, -40, -50 );
+    const Vec3f a( 60, 80, 100 );
+    const Vec3f b( 30, 40, 50 );
+    const Vec3f c( -30, -40, -50 );
 
     EXPECT_FLOAT_EQ( -1 * dot(a,b), dot(a,c) );
 }
@@ -355,8 +357,8 @@ TEST(Math, Vector3_DotSameOrientIsLengthMul)
 {
     // Tests axiom that dot product of two vectors with the same
     // oriention is the product of their lengths
-    const Vec3 a( 2.0f, 2.0f, 2.0f );
-    const Vec3 b( 4.0f, 4.0f, 4.0f );
+    const Vec3f a( 2.0f, 2.0f, 2.0f );
+    const Vec3f b( 4.0f, 4.0f, 4.0f );
 
     float dotVal = dot( a, b );
     float lenVal = length( a ) * length( b );
@@ -366,8 +368,8 @@ TEST(Math, Vector3_DotSameOrientIsLengthMul)
 
 TEST(Math, Vector3_PerpendicularDotsAreZero)
 {
-    const Vec3 a( 25.0f, 50.0f, -25.0f );
-    const Vec3 b( -125.0f, 50.0f, -25.0f );
+    const Vec3f a( 25.0f, 50.0f, -25.0f );
+    const Vec3f b( -125.0f, 50.0f, -25.0f );
 
     EXPECT_FLOAT_EQ( dot( a, b ), 0.0f );
     EXPECT_FLOAT_EQ( 90.0f, angleBetween( a, b ) );
@@ -375,7 +377,7 @@ TEST(Math, Vector3_PerpendicularDotsAreZero)
 
 TEST(Math, Vector3_Length)
 {
-    const Vec3 a( 1.0f, 2.0f, 3.0f );
+    const Vec3f a( 1.0f, 2.0f, 3.0f );
     EXPECT_FLOAT_EQ( 3.741657f, length( a ) );
 }
 
@@ -386,7 +388,7 @@ TEST(Math, Vector3_LengthZero)
 
 TEST(Math, Vector3_SquaredLength)
 {
-    const Vec3 a( 1.0f, 2.0f, 3.0f );
+    const Vec3f a( 1.0f, 2.0f, 3.0f );
     EXPECT_FLOAT_EQ( 14.0f, lengthSquared( a ) );
 }
 
@@ -397,54 +399,63 @@ TEST(Math, Vector3_SquareLengthZero)
 
 TEST(Math, Vector3_AngleBetween)
 {
-    Vec3 a( 3.0f,  5.0f, 6.0f );
-    Vec3 b( 1.0f, -2.0f, 4.0f );
+    Vec3f a( 3.0f,  5.0f, 6.0f );
+    Vec3f b( 1.0f, -2.0f, 4.0f );
 
     EXPECT_FLOAT_EQ( 63.679333f, angleBetween( a, b ) );
 }
 
 TEST(Math, Vector3_Normalization)
 {
-    const Vec3 a( 3.0f, 1.0f, 2.0f );
-    const Vec3 n = normalized( a );
+    const Vec3f a( 3.0f, 1.0f, 2.0f );
+    const Vec3f n = normalized( a );
 
     ::testing::AssertionResult result =
-        VectorEquals( Vec3( 0.801784f, 0.267261f, 0.534522f ),
+        VectorEquals( Vec3f( 0.801784f, 0.267261f, 0.534522f ),
                              n );
 
     EXPECT_TRUE( result );
 }
 
+TEST(Math, Vector3_NormalizationFast)
+{
+    const Vec3f a( 3.0f, 1.0f, 2.0f );
+    const Vec3f n = normalizedFast( a );
+
+    EXPECT_TRUE( VectorEquals( normalized( a ), n ) );
+    EXPECT_NEAR( 1.0f, length( n ), 1e-6f );
+}
+
 TEST(Math, Vector3_RotateAroundXZero)
 {
-    const Vec3 a( 4.0f, -5.0f, 2.5f );
+    const Vec3f a( 4.0f, -5.0f, 2.5f );
     EXPECT_EQ( a, rotateAroundX( a, 0.0f ) );
 }
 
 TEST(Math, Vector3_RotateAroundX)
 {
     // First trial
-    const Vec3 a( 0.0f, 1.0f, 0.0f );
-    EXPECT_TRUE( VectorEquals( Vec3( 0.0f,  0.707106f,  0.707106f ), rotateAroundX( a, 45.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec3( 0.0f,  0.0f,       1.0f ),      rotateAroundX( a, 90.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec3( 0.0f, -1.0f,       0.0f ),      rotateAroundX( a, 180.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec3( 0.0f, -0.707106f, -0.707106f ), rotateAroundX( a, 225.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec3( 0.0f,  0.0f,      -1.0f ),      rotateAroundX( a, 270.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec3( 0.0f,  0.707106f, -0.707106f ), rotateAroundX( a, 315.0f ) ) );
+    const Vec3f a( 0.0f, 1.0f, 0.0f );
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f,  0.707106f,  0.707106f ), rotateAroundX( a, 45.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f,  0.0f,       1.0f ),      rotateAroundX( a, 90.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f, -1.0f,       0.0f ),      rotateAroundX( a, 180.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f, -0.707106f, -0.707106f ), rotateAroundX( a, 225.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f,  0.0f,      -1.0f ),      rotateAroundX( a, 270.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f,  0.707106f, -0.707106f ), rotateAroundX( a, 315.0f ) ) );
 
     // Second trial... moving shouldn't efect rotation at all
-    const Vec3 b( 2.0f, 1.0f, 0.0f );
-    VectorEquals( Vec3( 2.0f,  0.707106f,  0.707106f ), rotateAroundX( b, 45.0f ) );
-    VectorEquals( Vec3( 2.0f,  0.0f,       1.0f ),      rotateAroundX( b, 90.0f ) );
-    VectorEquals( Vec3( 2.0f, -1.0f,       0.0f ),      rotateAroundX( b, 180.0f ) );
-    VectorEquals( Vec3( 2.0f, -0.707106f, -0.707106f ), rotateAroundX( b, 225.0f ) );
-    VectorEquals( Vec3( 2.0f,  0.0f,      -1.0f ),      rotateAroundX( b, 270.0f ) );
-    VectorEquals( Vec3( 2.0f,  0.707106f, -0.707106f ), rotateAroundX( b, 315.0f ) );
+    const Vec3f b( 2.0f, 1.0f, 0.0f );
+    VectorEquals( Vec3f( 2.0f,  0.707106f,  0.707106f ), rotateAroundX( b, 45.0f ) );
+    VectorEquals( Vec3f( 2.0f,  0.0f,       1.0f ),      rotateAroundX( b, 90.0f ) );
+    VectorEquals( Vec3f( 2.0f, -1.0f,       0.0f ),      rotateAroundX( b, 180.0f ) );
+    VectorEquals( Vec3f( 2.0f, -0.707106f, -0.707106f ), rotateAroundX( b, 225.0f ) );
+    VectorEquals( Vec3f( 2.0f,  0.0f,      -1.0f ),      rotateAroundX( b, 270.0f ) );
+    VectorEquals( Vec3f( 2.0f,  0.707106f, -0.707106f ), rotateAroundX( b, 315.0f ) );
 }
 
 TEST(Math, Vector3_RotateAroundYZero)
 {
-    const Vec3 a( 4.0f, -5.0f, 2.5f );
+    const Vec3f a( 4.0f, -5.0f, 2.5f );
     EXPECT_EQ( a, rotateAroundY( a, 0.0f ) );
 }
 
@@ -454,47 +465,138 @@ TEST(Math, Vector3_RotateAroundY)
 
 TEST(Math, Vector3_RotateAroundZZero)
 {
-    const Vec3 a( 4.0f, -5.0f, 2.5f );
+    const Vec3f a( 4.0f, -5.0f, 2.5f );
     EXPECT_EQ( a, rotateAroundZ( a, 0.0f ) );
 }
 
 TEST(Math, Vector3_RotateAroundAxisZero)
 {
-    const Vec3 a( 4.0f, -5.0f, 2.5f );
-    EXPECT_EQ( a, rotateAround( a, Vec3( 1.0f, 1.0f, 1.0f ), 0.0f ) );
+    const Vec3f a( 4.0f, -5.0f, 2.5f );
+    EXPECT_EQ( a, rotateAround( a, Vec3f( 1.0f, 1.0f, 1.0f ), 0.0f ) );
+}
+
+TEST(Math, Vector3_RotateAroundAxis)
+{
+    // A third of a turn around the diagonal cycles the basis vectors
+    const Vec3f axis( 1.0f, 1.0f, 1.0f );
+
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f, 1.0f, 0.0f ),
+                               rotateAround( Vec3f( 1.0f, 0.0f, 0.0f ), axis, 120.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 0.0f, 0.0f, 1.0f ),
+                               rotateAround( Vec3f( 0.0f, 1.0f, 0.0f ), axis, 120.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 1.0f, 0.0f, 0.0f ),
+                               rotateAround( Vec3f( 0.0f, 0.0f, 1.0f ), axis, 120.0f ) ) );
+}
+
+TEST(Math, Vector3_DoublePrecision)
+{
+    typedef TVector3<double> Vec3d;
+
+    const Vec3d a( 3.0, 1.0, 2.0 );
+    const Vec3d n = normalized( a );
+
+    EXPECT_DOUBLE_EQ( std::sqrt( 14.0 ), length( a ) );
+    EXPECT_DOUBLE_EQ( 3.0 / std::sqrt( 14.0 ), n[0] );
+    EXPECT_DOUBLE_EQ( 1.0 / std::sqrt( 14.0 ), n[1] );
+    EXPECT_DOUBLE_EQ( 2.0 / std::sqrt( 14.0 ), n[2] );
+    EXPECT_NEAR( 63.67933810, angleBetween( Vec3d( 3.0, 5.0, 6.0 ), Vec3d( 1.0, -2.0, 4.0 ) ), 1e-8 );
+
+    // Doubles keep their precision at planetary distances
+    const Vec3d far( 6.4e6, 0.0, 1.0e-3 );
+    EXPECT_DOUBLE_EQ( 1.0e-3, ( far - Vec3d( 6.4e6, 0.0, 0.0 ) )[2] );
+
+    const Vec3d r = rotateAroundZ( Vec3d( 1.0, 0.0, 0.0 ), 90.0 );
+    EXPECT_NEAR( 0.0, r[0], 1e-15 );
+    EXPECT_NEAR( 1.0, r[1], 1e-15 );
+
+    const Vec3d c = rotateAround( Vec3d( 1.0, 0.0, 0.0 ), Vec3d( 1.0, 1.0, 1.0 ), 120.0 );
+    EXPECT_NEAR( 0.0, c[0], 1e-15 );
+    EXPECT_NEAR( 1.0, c[1], 1e-15 );
+    EXPECT_NEAR( 0.0, c[2], 1e-15 );
+
+    const Vec3d x = rotateAroundX( Vec3d( 0.0, 1.0, 0.0 ), 90.0 );
+    EXPECT_NEAR( 1.0, x[2], 1e-15 );
+
+    const Vec3d y = rotateAroundY( Vec3d( 0.0, 0.0, 1.0 ), 90.0 );
+    EXPECT_NEAR( 1.0, y[0], 1e-15 );
 }
 
 TEST(Math, Vector3_Lerp)
 {
-    const Vec3 a( 1.0f, 2.0f, 3.0f );
-    const Vec3 b( 2.0f, 4.0f, 6.0f );
+    const Vec3f a( 1.0f, 2.0f, 3.0f );
+    const Vec3f b( 2.0f, 4.0f, 6.0f );
 
-    EXPECT_TRUE( VectorEquals( Vec3( 1.0f, 2.0f, 3.0f ), lerp( a, b, 0.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec3( 1.5f, 3.0f, 4.5f ), lerp( a, b, 0.5f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec3( 2.0f, 4.0f, 6.0f ), lerp( a, b, 1.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 1.0f, 2.0f, 3.0f ), lerp( a, b, 0.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 1.5f, 3.0f, 4.5f ), lerp( a, b, 0.5f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 2.0f, 4.0f, 6.0f ), lerp( a, b, 1.0f ) ) );
 }
 
 TEST(Math, Vector3_Min)
 {
-    const Vec3 a( 1.0f, 3.0f, 5.0f );
-    const Vec3 b( 1.5f, 2.0f, 6.5f );
+    const Vec3f a( 1.0f, 3.0f, 5.0f );
+    const Vec3f b( 1.5f, 2.0f, 6.5f );
 
-    EXPECT_TRUE( VectorEquals( Vec3( 1.0f, 2.0f, 5.0f ), min( a, b ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 1.0f, 2.0f, 5.0f ), min( a, b ) ) );
 }
 
 TEST(Math, Vector3_Max)
 {
-    const Vec3 a( 1.0f, 3.0f, 5.0f );
-    const Vec3 b( 1.5f, 2.0f, 6.5f );
+    const Vec3f a( 1.0f, 3.0f, 5.0f );
+    const Vec3f b( 1.5f, 2.0f, 6.5f );
 
-    EXPECT_TRUE( VectorEquals( Vec3( 1.5f, 3.0f, 6.5f ), max( a, b ) ) );
+    EXPECT_TRUE( VectorEquals( Vec3f( 1.5f, 3.0f, 6.5f ), max( a, b ) ) );
 }
 
 TEST(Math, Vector3_Clamp)
 {
-    const Vec3 a( 1.5f, 1.5f, 4.5f );
-    const Vec3 min( 1.0f, 2.0f, 3.0f );
-    const Vec3 max( 2.0f, 3.0f, 4.0f );
+    const Vec3f a( 1.5f, 1.5f, 4.5f );
+    const Vec3f min( 1.0f, 2.0f, 3.0f );
+    const Vec3f max( 2.0f, 3.0f, 4.0f );
+
+    EXPECT_TRUE( VectorEquals( Vec3f( 1.5f, 2.0f, 4.0f ), clamp( a, min, max ) ) );
+}
+
+TEST(Math, Vector3_ConstantExpressions)
+{
+    constexpr Vec3f a( 1.0f, 2.0f, 3.0f );
+    constexpr Vec3f b( 4.0f, 5.0f, 6.0f );
+    constexpr Vec3f c = cross( a, b ) + a * 2.0f - Vec3f::ZERO;
+
+    static_assert( dot( a, b ) == 32.0f, "dot must be a constant expression" );
+    static_assert( lengthSquared( a ) == 14.0f, "lengthSquared must be a constant expression" );
+    static_assert( c == Vec3f( -1.0f, 10.0f, 3.0f ), "cross must be a constant expression" );
+    static_assert( ( -a ).x() == -1.0f && ( b / 2.0f ).z() == 3.0f, "" );
+
+    EXPECT_EQ( Vec3f( -1.0f, 10.0f, 3.0f ), c );
+}
+
+TEST(Math, Vector3_Swizzle)
+{
+    constexpr Vec3f a( 1.0f, 2.0f, 3.0f );
+
+    static_assert( a.zxy() == Vec3f( 3.0f, 1.0f, 2.0f ), "swizzles must be constant expressions" );
+    static_assert( dot( a.xzy(), a ) == 13.0f, "" );
+
+    EXPECT_EQ( TVector2<float>( 1.0f, 3.0f ), a.xz() );
+    EXPECT_EQ( Vec3f( 3.0f, 3.0f, 1.0f ), a.zzx() );
+    EXPECT_EQ( TVector4<float>( 3.0f, 2.0f, 1.0f, 1.0f ), a.zyxx() );
+
+    // Swizzles of a non-const vector still deduce in the free functions
+    Vec3f b( 4.0f, 5.0f, 6.0f );
+    EXPECT_EQ( 32.0f, dot( a, b.xyz() ) );
+}
+
+TEST(Math, Vector3_SwizzleWrite)
+{
+    Vec3f a( 1.0f, 2.0f, 3.0f );
+
+    a.zx( TVector2<float>( 7.0f, 8.0f ) );
+    EXPECT_EQ( Vec3f( 8.0f, 2.0f, 7.0f ), a );
+
+    // The source is read before any component is written
+    a.zyx( a );
+    EXPECT_EQ( Vec3f( 7.0f, 2.0f, 8.0f ), a );
 
-    EXPECT_TRUE( VectorEquals( Vec3( 1.5f, 2.0f, 4.0f ), clamp( a, min, max ) ) );
+    a.yz( a.xy() );
+    EXPECT_EQ( Vec3f( 7.0f, 7.0f, 2.0f ), a );
 }
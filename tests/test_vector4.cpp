@@ -8,29 +8,29 @@
 #include "unittesthelpers.h"
 
 #ifndef MATH_TYPEDEFS
-typedef TVector4<float> Vec4;
+typedef TVector4<float> Vec4f;
 #endif
 
 TEST(Math, Vector4_DefaultContructor)
 {
-    const Vec4 v;
+    const Vec4f v;
     EXPECT_TRUE( true );      // test here just to make sure it compiles
 }
 
 TEST(Math, Vector4_SizeTest)
 {
-    const Vec4 v( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Vec4f v( 1.0f, 2.0f, 3.0f, 4.0f );
     EXPECT_EQ( sizeof(float) * 4, sizeof(v) );
 }
 
 TEST(Math, Vector4_MemoryArrayTest)
 {
     // Makes sure that a vector is laid out linearly in memory
-    Vec4 v[3];
+    Vec4f v[3];
 
-    v[0] = Vec4( 1.0f, 2.0f, 3.0f, 4.0f );
-    v[1] = Vec4( 5.0f, 6.0f, 7.0f, 8.0f );
-    v[2] = Vec4( 9.0f, 10.0f, 11.0f, 12.0f );
+    v[0] = Vec4f( 1.0f, 2.0f, 3.0f, 4.0f );
+    v[1] = Vec4f( 5.0f, 6.0f, 7.0f, 8.0f );
+    v[2] = Vec4f( 9.0f, 10.0f, 11.0f, 12.0f );
 
     const float * pVals = v[0].const_ptr();
 
@@ -51,7 +51,7 @@ TEST(Math, Vector4_MemoryArrayTest)
 TEST(Math, Vector4_PointerConstructor)
 {
     float values[6] = { 3.0f, 2.0f, 5.0f, -3.0f, 6.0f, 8.0f };
-    Vec4 v( &values[1] );
+    Vec4f v( &values[1] );
 
     EXPECT_FLOAT_EQ(  2.0f, v[0] );
     EXPECT_FLOAT_EQ(  5.0f, v[1] );
@@ -61,7 +61,7 @@ TEST(Math, Vector4_PointerConstructor)
 
 TEST(Math, Vector4_ValueConstructor)
 {
-    const Vec4 v( 1.0f, -2.0f, 0.2f, 3.5f );
+    const Vec4f v( 1.0f, -2.0f, 0.2f, 3.5f );
 
     EXPECT_FLOAT_EQ(  1.0f, v[0] );
     EXPECT_FLOAT_EQ( -2.0f, v[1] );
@@ -71,8 +71,8 @@ TEST(Math, Vector4_ValueConstructor)
 
 TEST(Math, Vector4_CopyConstructor)
 {
-    const Vec4 a( 1.0f, -2.0f, 0.2f, 3.5f );
-    const Vec4 b( a );
+    const Vec4f a( 1.0f, -2.0f, 0.2f, 3.5f );
+    const Vec4f b( a );
 
     EXPECT_FLOAT_EQ(  1.0f, b[0] );
     EXPECT_FLOAT_EQ( -2.0f, b[1] );
@@ -82,7 +82,7 @@ TEST(Math, Vector4_CopyConstructor)
 
 TEST(Math, Vector4_ConstIndexOperatorRead)
 {
-    const Vec4 v( 1.0f, -2.0f, 0.2f, 3.5f );
+    const Vec4f v( 1.0f, -2.0f, 0.2f, 3.5f );
 
     EXPECT_FLOAT_EQ(  1.0f, v[0] );
     EXPECT_FLOAT_EQ( -2.0f, v[1] );
@@ -92,19 +92,19 @@ TEST(Math, Vector4_ConstIndexOperatorRead)
 
 TEST(Math, Vector4_IndexOperatorWrite)
 {
-    Vec4 v( 1.0f, -2.0f, 0.2f, 3.5f );
+    Vec4f v( 1.0f, -2.0f, 0.2f, 3.5f );
 
     v[0] = 2.0f;
     v[1] = 0.2f;
     v[2] = -1.0f;
     v[3] = -2.5f;
 
-    EXPECT_EQ( Vec4( 2.0f, 0.2f, -1.0f, -2.5f ), v );
+    EXPECT_EQ( Vec4f( 2.0f, 0.2f, -1.0f, -2.5f ), v );
 }
 
 TEST(Math, Vector4_ConstPointerAccess)
 {
-    Vec4 v( 1.0f, 2.0f, 3.0f, 7.5f );
+    Vec4f v( 1.0f, 2.0f, 3.0f, 7.5f );
     const float * ptr = v.ptr();
 
     EXPECT_FLOAT_EQ( 1.0f, ptr[0] );
@@ -115,7 +115,7 @@ TEST(Math, Vector4_ConstPointerAccess)
 
 TEST(Math, Vector4_ConstConstPointerAccess)
 {
-    Vec4 v( 1.0f, 2.0f, 3.0f, 7.5f );
+    Vec4f v( 1.0f, 2.0f, 3.0f, 7.5f );
     const float * ptr = v.const_ptr();
 
     EXPECT_FLOAT_EQ( 1.0f, ptr[0] );
@@ -126,38 +126,38 @@ TEST(Math, Vector4_ConstConstPointerAccess)
 
 TEST(Math, Vector4_NonConstPointerReadAndWrite)
 {
-    Vec4 v( 1.0f, 2.0f, 3.0f, 7.5f );
+    Vec4f v( 1.0f, 2.0f, 3.0f, 7.5f );
     float * ptr = v.ptr();
 
-    EXPECT_EQ( Vec4( 1.0f, 2.0f, 3.0f, 7.5f ), v );
+    EXPECT_EQ( Vec4f( 1.0f, 2.0f, 3.0f, 7.5f ), v );
 
     ptr[0] = 5.0f;
     ptr[1] = 6.0f;
     ptr[2] = 7.0f;
     ptr[3] = 9.2f;
 
-    EXPECT_EQ( Vec4( 5.0f, 6.0f, 7.0f, 9.2f ), v );
+    EXPECT_EQ( Vec4f( 5.0f, 6.0f, 7.0f, 9.2f ), v );
 }
 
 TEST(Math, Vector4_Assignment)
 {
-    Vec4 a( 1.0f, 2.0f, 3.0f, 0.1f );
-    const Vec4 b( 3.0f, 4.0f, 5.0f, 2.2f );
+    Vec4f a( 1.0f, 2.0f, 3.0f, 0.1f );
+    const Vec4f b( 3.0f, 4.0f, 5.0f, 2.2f );
     
     a = b;
 
-    EXPECT_NE( Vec4( 1.0f, 2.0f, 3.0f, 0.1f ), a );
-    EXPECT_EQ( Vec4( 3.0f, 4.0f, 5.0f, 2.2f ), a );
+    EXPECT_NE( Vec4f( 1.0f, 2.0f, 3.0f, 0.1f ), a );
+    EXPECT_EQ( Vec4f( 3.0f, 4.0f, 5.0f, 2.2f ), a );
 }
 
 TEST(Math, Vector4_EqualityOperator)
 {
-    const Vec4 a( 1.5f, -0.2f, 0.0f, 1.0f );
-    const Vec4 b( 1.5f,  0.2f, 0.0f, 0.7f );
-    const Vec4 c( 1.5f, -0.2f, 0.1f, 1.0f );
-    const Vec4 d( 1.5f,  0.0f,-0.2f, 0.2f );
-    const Vec4 e( 0.0f,  1.5f,-0.2f, 0.2f );
-    const Vec4 f( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Vec4f a( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Vec4f b( 1.5f,  0.2f, 0.0f, 0.7f );
+    const Vec4f c( 1.5f, -0.2f, 0.1f, 1.0f );
+    const Vec4f d( 1.5f,  0.0f,-0.2f, 0.2f );
+    const Vec4f e( 0.0f,  1.5f,-0.2f, 0.2f );
+    const Vec4f f( 1.5f, -0.2f, 0.0f, 1.0f );
 
     EXPECT_EQ( a, f );
     EXPECT_EQ( a, a );
@@ -171,20 +171,20 @@ TEST(Math, Vector4_EqualityOperator)
 
 TEST(Math, Vector4_EqualityOperatorPrecision)
 {
-    const Vec4 a( 2.2f, -0.333f, 1.5f, 0.0f );
-    const Vec4 b( 4.4f/2.0f, -0.999f/3.0f, 0.5f * 3.0f, 0.0f / 1.0f );
+    const Vec4f a( 2.2f, -0.333f, 1.5f, 0.0f );
+    const Vec4f b( 4.4f/2.0f, -0.999f/3.0f, 0.5f * 3.0f, 0.0f / 1.0f );
 
     EXPECT_EQ( a, b );
 }
 
 TEST(Math, Vector4_InequalityOperator)
 {
-    const Vec4 a( 1.5f, -0.2f, 0.0f, 1.0f );
-    const Vec4 b( 1.5f,  0.2f, 0.0f, 0.7f );
-    const Vec4 c( 1.5f, -0.2f, 0.1f, 1.0f );
-    const Vec4 d( 1.5f,  0.0f,-0.2f, 0.2f );
-    const Vec4 e( 0.0f,  1.5f,-0.2f, 0.2f );
-    const Vec4 f( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Vec4f a( 1.5f, -0.2f, 0.0f, 1.0f );
+    const Vec4f b( 1.5f,  0.2f, 0.0f, 0.7f );
+    const Vec4f c( 1.5f, -0.2f, 0.1f, 1.0f );
+    const Vec4f d( 1.5f,  0.0f,-0.2f, 0.2f );
+    const Vec4f e( 0.0f,  1.5f,-0.2f, 0.2f );
+    const Vec4f f( 1.5f, -0.2f, 0.0f, 1.0f );
 
     EXPECT_TRUE( a != b );
     EXPECT_TRUE( a != c );
@@ -197,85 +197,85 @@ TEST(Math, Vector4_InequalityOperator)
 
 TEST(Math, Vector4_Negation)
 {
-    Vec4 a( 2.0f, 0.0f, -1.0f, 3.5f );
+    Vec4f a( 2.0f, 0.0f, -1.0f, 3.5f );
     a = -a;
 
-    EXPECT_EQ( Vec4( -2.0f, -0.0f, 1.0f, -3.5f ), a );
-    EXPECT_EQ( Vec4( -2.0f,  0.0f, 1.0f, -3.5f ), a );    // close
+    EXPECT_EQ( Vec4f( -2.0f, -0.0f, 1.0f, -3.5f ), a );
+    EXPECT_EQ( Vec4f( -2.0f,  0.0f, 1.0f, -3.5f ), a );    // close
 }
 
 TEST(Math, Vector4_AdditionOperator)
 {
-    const Vec4 a( 3.0f, 5.0f, 9.0f, 1.0f );
-    const Vec4 b(-4.0f, 6.0f, 3.0f, 2.0f );
+    const Vec4f a( 3.0f, 5.0f, 9.0f, 1.0f );
+    const Vec4f b(-4.0f, 6.0f, 3.0f, 2.0f );
 
-    EXPECT_EQ( Vec4( -1.0f, 11.0f, 12.0f, 3.0f ), a + b );
+    EXPECT_EQ( Vec4f( -1.0f, 11.0f, 12.0f, 3.0f ), a + b );
 }
 
 TEST(Math, Vector4_SelfAdditionOperator)
 {
-          Vec4 a( 3.0f, 5.0f, 9.0f, 1.0f );
-    const Vec4 b(-4.0f, 6.0f, 3.0f, 2.0f );
+          Vec4f a( 3.0f, 5.0f, 9.0f, 1.0f );
+    const Vec4f b(-4.0f, 6.0f, 3.0f, 2.0f );
 
     a += b;
 
-    EXPECT_EQ( Vec4( -1.0f, 11.0f, 12.0f, 3.0f ), a );
+    EXPECT_EQ( Vec4f( -1.0f, 11.0f, 12.0f, 3.0f ), a );
 }
 
 TEST(Math, Vector4_SubtractionOperator)
 {
-    const Vec4 a( 5.0f, 2.0f, -4.0f,  0.0f );
-    const Vec4 b(-1.0f, 3.0f,  8.0f, -2.0f );
-    const Vec4 c = a - b;
+    const Vec4f a( 5.0f, 2.0f, -4.0f,  0.0f );
+    const Vec4f b(-1.0f, 3.0f,  8.0f, -2.0f );
+    const Vec4f c = a - b;
     
-    EXPECT_EQ( Vec4( 6.0f, -1.0f, -12.0f, 2.0f ), c );
+    EXPECT_EQ( Vec4f( 6.0f, -1.0f, -12.0f, 2.0f ), c );
 }
 
 TEST(Math, Vector4_SelfSubtractionOperator)
 {
-          Vec4 a( 5.0f, 2.0f, -4.0f,  0.0f );
-    const Vec4 b(-1.0f, 3.0f,  8.0f, -2.0f );
+          Vec4f a( 5.0f, 2.0f, -4.0f,  0.0f );
+    const Vec4f b(-1.0f, 3.0f,  8.0f, -2.0f );
     a -= b;
  
-    EXPECT_EQ( Vec4( 6.0f, -1.0f, -12.0f, 2.0f ), a );
+    EXPECT_EQ( Vec4f( 6.0f, -1.0f, -12.0f, 2.0f ), a );
 }
 
 TEST(Math, Vector4_MultiplyOperator)
 {
-    const Vec4 a( 3.0f, 5.0f, 9.0f, 3.5f );
-    const Vec4 b = a * 2.0f;
+    const Vec4f a( 3.0f, 5.0f, 9.0f, 3.5f );
+    const Vec4f b = a * 2.0f;
 
-    EXPECT_EQ( Vec4( 6.0f, 10.0f, 18.0f, 7.0f ), b );
+    EXPECT_EQ( Vec4f( 6.0f, 10.0f, 18.0f, 7.0f ), b );
 }
 
 TEST(Math, Vector4_SelfMultiplyOperator)
 {
-    Vec4 a( 3.0f, 5.0f, 9.0f, 3.5f );
+    Vec4f a( 3.0f, 5.0f, 9.0f, 3.5f );
     a *= 2.0f;
 
-    EXPECT_EQ( Vec4( 6.0f, 10.0f, 18.0f, 7.0f ), a );
+    EXPECT_EQ( Vec4f( 6.0f, 10.0f, 18.0f, 7.0f ), a );
 }
 
 TEST(Math, Vector4_DivisionOperator)
 {
-    const Vec4 a( 3.0f, 5.0f, 9.0f, 6.0f );
-    const Vec4 b = a / 2.0f;
+    const Vec4f a( 3.0f, 5.0f, 9.0f, 6.0f );
+    const Vec4f b = a / 2.0f;
 
-    EXPECT_EQ( Vec4( 1.5f, 2.5f, 4.5f, 3.0f ), b );
+    EXPECT_EQ( Vec4f( 1.5f, 2.5f, 4.5f, 3.0f ), b );
 }
 
 TEST(Math, Vector4_SelfDivisionOperator)
 {
-    Vec4 a( 3.0f, 5.0f, 9.0f, 6.0f );
+    Vec4f a( 3.0f, 5.0f, 9.0f, 6.0f );
     a /= 2.0f;
 
-    EXPECT_EQ( Vec4( 1.5f, 2.5f, 4.5f, 3. ), a );
+    EXPECT_EQ( Vec4f( 1.5f, 2.5f, 4.5f, 3. ), a );
 }
 
 TEST(Math, Vector4_XAccessor)
 {
-    Vec4 a( 1.0f, 2.0f, 3.0f, 9.0f );
-    Vec4 b( 6.0f, 5.0f, 4.0f, 8.0f );
+    Vec4f a( 1.0f, 2.0f, 3.0f, 9.0f );
+    Vec4f b( 6.0f, 5.0f, 4.0f, 8.0f );
 
     EXPECT_FLOAT_EQ( 1.0f, a.x() );
     EXPECT_FLOAT_EQ( 6.0f, b.x() );
@@ -283,8 +283,8 @@ TEST(Math, Vector4_XAccessor)
 
 TEST(Math, Vector4_YAccessor)
 {
-    Vec4 a( 1.0f, 2.0f, 3.0f, 9.0f );
-    Vec4 b( 6.0f, 5.0f, 4.0f, 8.0f );
+    Vec4f a( 1.0f, 2.0f, 3.0f, 9.0f );
+    Vec4f b( 6.0f, 5.0f, 4.0f, 8.0f );
 
     EXPECT_FLOAT_EQ( 2.0f, a.y() );
     EXPECT_FLOAT_EQ( 5.0f, b.y() );
@@ -292,8 +292,8 @@ TEST(Math, Vector4_YAccessor)
 
 TEST(Math, Vector4_ZAccessor)
 {
-    Vec4 a( 1.0f, 2.0f, 3.0f, 9.0f );
-    Vec4 b( 6.0f, 5.0f, 4.0f, 8.0f );
+    Vec4f a( 1.0f, 2.0f, 3.0f, 9.0f );
+    Vec4f b( 6.0f, 5.0f, 4.0f, 8.0f );
 
     EXPECT_FLOAT_EQ( 3.0f, a.z() );
     EXPECT_FLOAT_EQ( 4.0f, b.z() );
@@ -301,8 +301,8 @@ TEST(Math, Vector4_ZAccessor)
 
 TEST(Math, Vector4_WAccessor)
 {
-    Vec4 a( 1.0f, 2.0f, 3.0f, 9.0f );
-    Vec4 b( 6.0f, 5.0f, 4.0f, 8.0f );
+    Vec4f a( 1.0f, 2.0f, 3.0f, 9.0f );
+    Vec4f b( 6.0f, 5.0f, 4.0f, 8.0f );
 
     EXPECT_FLOAT_EQ( 9.0f, a.w() );
     EXPECT_FLOAT_EQ( 8.0f, b.w() );
@@ -310,7 +310,7 @@ TEST(Math, Vector4_WAccessor)
 
 TEST(Math, Vector4_ZeroVector)
 {
-    const Vec4 a = Vec4::ZERO;
+    const Vec4f a = Vec4f::ZERO;
 
     EXPECT_FLOAT_EQ( 0.0f, a[0] );
     EXPECT_FLOAT_EQ( 0.0f, a[1] );
@@ -320,15 +320,15 @@ TEST(Math, Vector4_ZeroVector)
 
 TEST(Math, Vector4_ZeroVectorIsZeroValueConstructed)
 {
-    const Vec4 a( 0.0f, 0.0f, 0.0f, 0.0f );
-    const Vec4 z = Vec4::ZERO;
+    const Vec4f a( 0.0f, 0.0f, 0.0f, 0.0f );
+    const Vec4f z = Vec4f::ZERO;
 
     EXPECT_EQ( a, z );
 }
 
 TEST(Math, Vector4_Length)
 {
-    const Vec4 a( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Vec4f a( 1.0f, 2.0f, 3.0f, 4.0f );
     EXPECT_FLOAT_EQ( 5.47722558f, length( a ) );
 }
 
@@ -339,7 +339,7 @@ TEST(Math, Vector4_LengthZero)
 
 TEST(Math, Vector4_SquaredLength)
 {
-    const Vec4 a( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Vec4f a( 1.0f, 2.0f, 3.0f, 4.0f );
     EXPECT_FLOAT_EQ( 30.0f, lengthSquared( a ) );
 }
 
@@ -350,12 +350,12 @@ TEST(Math, Vector4_SquareLengthZero)
 
 TEST(Math, Vector4_Normalization)
 {
-    const Vec4 a( 3.0f, 1.0f, 2.0f,-4.0f );
-    const Vec4 n = normalized( a );
+    const Vec4f a( 3.0f, 1.0f, 2.0f,-4.0f );
+    const Vec4f n = normalized( a );
 
     EXPECT_TRUE(
         VectorEquals(
-            Vec4( 0.547722557f, 0.182574186f, 0.365148371f, -0.730296743f),
+            Vec4f( 0.547722557f, 0.182574186f, 0.365148371f, -0.730296743f),
             n )
     );
 }
@@ -367,36 +367,58 @@ TEST(Math, Vector4_Serialization)
 
 TEST(Math, Vector4_Lerp)
 {
-    const Vec4 a( 1.0f, 2.0f, 3.0f, 5.0f );
-    const Vec4 b( 2.0f, 4.0f, 6.0f, 10.0f );
+    const Vec4f a( 1.0f, 2.0f, 3.0f, 5.0f );
+    const Vec4f b( 2.0f, 4.0f, 6.0f, 10.0f );
     
-    EXPECT_TRUE( VectorEquals( Vec4( 1.0f, 2.0f, 3.0f, 5.0f ), lerp( a, b, 0.0f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec4( 1.5f, 3.0f, 4.5f, 7.5f ), lerp( a, b, 0.5f ) ) );
-    EXPECT_TRUE( VectorEquals( Vec4( 2.0f, 4.0f, 6.0f, 10.0f ), lerp( a, b, 1.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec4f( 1.0f, 2.0f, 3.0f, 5.0f ), lerp( a, b, 0.0f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec4f( 1.5f, 3.0f, 4.5f, 7.5f ), lerp( a, b, 0.5f ) ) );
+    EXPECT_TRUE( VectorEquals( Vec4f( 2.0f, 4.0f, 6.0f, 10.0f ), lerp( a, b, 1.0f ) ) );
 }
 
 TEST(Math, Vector4_Min)
 {
-    const Vec4 a( 1.0f, 3.0f, 5.0f, 7.0f );
-    const Vec4 b( 1.5f, 2.0f, 6.5f, 6.5f );
+    const Vec4f a( 1.0f, 3.0f, 5.0f, 7.0f );
+    const Vec4f b( 1.5f, 2.0f, 6.5f, 6.5f );
 
-    EXPECT_TRUE( VectorEquals( Vec4( 1.0f, 2.0f, 5.0f, 6.5f ), min( a, b ) ) );
+    EXPECT_TRUE( VectorEquals( Vec4f( 1.0f, 2.0f, 5.0f, 6.5f ), min( a, b ) ) );
 }
 
 TEST(Math, Vector4_Max)
 {
-    const Vec4 a( 1.0f, 3.0f, 5.0f, 7.0f );
-    const Vec4 b( 1.5f, 2.0f, 6.5f, 6.5f );
+    const Vec4f a( 1.0f, 3.0f, 5.0f, 7.0f );
+    const Vec4f b( 1.5f, 2.0f, 6.5f, 6.5f );
 
-    EXPECT_TRUE( VectorEquals( Vec4( 1.5f, 3.0f, 6.5f, 7.0f ), max( a, b ) ) );
+    EXPECT_TRUE( VectorEquals( Vec4f( 1.5f, 3.0f, 6.5f, 7.0f ), max( a, b ) ) );
 }
 
 TEST(Math, Vector4_Clamp)
 {
-    const Vec4 a( 1.5f, 1.5f, 4.5f, 2.5f );
-    const Vec4 min( 1.0f, 2.0f, 3.0f, 4.0f );
-    const Vec4 max( 2.0f, 3.0f, 4.0f, 5.0f );
+    const Vec4f a( 1.5f, 1.5f, 4.5f, 2.5f );
+    const Vec4f min( 1.0f, 2.0f, 3.0f, 4.0f );
+    const Vec4f max( 2.0f, 3.0f, 4.0f, 5.0f );
 
-    EXPECT_TRUE( VectorEquals( Vec4( 1.5f, 2.0f, 4.0f, 4.0f ), clamp( a, min, max ) ) );
+    EXPECT_TRUE( VectorEquals( Vec4f( 1.5f, 2.0f, 4.0f, 4.0f ), clamp( a, min, max ) ) );
 }
 
+
+TEST(Math, Vector4_Swizzle)
+{
+    constexpr Vec4f a( 1.0f, 2.0f, 3.0f, 4.0f );
+
+    static_assert( a.wzyx() == Vec4f( 4.0f, 3.0f, 2.0f, 1.0f ), "swizzles must be constant expressions" );
+
+    EXPECT_EQ( TVector2<float>( 4.0f, 1.0f ), a.wx() );
+    EXPECT_EQ( TVector3<float>( 1.0f, 2.0f, 3.0f ), a.xyz() );
+    EXPECT_EQ( Vec4f( 2.0f, 2.0f, 4.0f, 4.0f ), a.yyww() );
+}
+
+TEST(Math, Vector4_SwizzleWrite)
+{
+    Vec4f a( 1.0f, 2.0f, 3.0f, 4.0f );
+
+    a.wzyx( a );
+    EXPECT_EQ( Vec4f( 4.0f, 3.0f, 2.0f, 1.0f ), a );
+
+    a.xyz( TVector3<float>( 0.0f, 0.0f, 0.0f ) );
+    EXPECT_EQ( Vec4f( 0.0f, 0.0f, 0.0f, 1.0f ), a );
+}
@@ -0,0 +1,139 @@
+/**
+ * Unit tests for vertex welding
+ */
+#include <gtest/gtest.h>
+#include <smath/weld.h>
+
+#include <cstdlib>
+#include <vector>
+
+#ifndef MATH_TYPEDEFS
+typedef TVector3<float> Vec3f;
+#endif
+
+TEST(Math,Weld_Empty)
+{
+    std::vector<uint32_t> remap;
+    std::vector<Vec3f> welded;
+
+    EXPECT_EQ( 0u, Math::weldVertices( NULL, 0, remap, welded ) );
+    EXPECT_TRUE( remap.empty() );
+    EXPECT_TRUE( welded.empty() );
+}
+
+TEST(Math,Weld_ExactDuplicates)
+{
+    const Vec3f v[] = { Vec3f( 1.0f, 2.0f, 3.0f ),
+                       Vec3f( 4.0f, 5.0f, 6.0f ),
+                       Vec3f( 1.0f, 2.0f, 3.0f ),
+                       Vec3f( -0.0f, 0.0f, 0.0f ),
+                       Vec3f( 0.0f, 0.0f, -0.0f ),
+                       Vec3f( 4.0f, 5.0f, 6.0f ) };
+
+    std::vector<uint32_t> remap;
+    std::vector<Vec3f> welded;
+
+    EXPECT_EQ( 3u, Math::weldVertices( v, 6, remap, welded, 0.0f ) );
+
+    const uint32_t expected[] = { 0, 1, 0, 2, 2, 1 };
+    EXPECT_EQ( std::vector<uint32_t>( expected, expected + 6 ), remap );
+
+    EXPECT_EQ( v[0], welded[0] );
+    EXPECT_EQ( v[1], welded[1] );
+    EXPECT_EQ( v[3], welded[2] );
+}
+
+TEST(Math,Weld_WithinEpsilon)
+{
+    // Straddle the cell boundaries on purpose
+    const float e = 0.01f;
+    const Vec3f v[] = { Vec3f( 0.0199f, 1.0f, 1.0f ),
+                       Vec3f( 0.0201f, 1.0f, 1.0f ),
+                       Vec3f( 0.0199f, 1.005f, 0.996f ),
+                       Vec3f( 0.0400f, 1.0f, 1.0f ) };
+
+    std::vector<uint32_t> remap;
+    std::vector<Vec3f> welded;
+
+    EXPECT_EQ( 2u, Math::weldVertices( v, 4, remap, welded, e ) );
+    EXPECT_EQ( 0u, remap[0] );
+    EXPECT_EQ( 0u, remap[1] );
+    EXPECT_EQ( 0u, remap[2] );
+    EXPECT_EQ( 1u, remap[3] );
+}
+
+TEST(Math,Weld_DefaultEpsilonMatchesEquality)
+{
+    const Vec3f v[] = { Vec3f( 1.0f, 1.0f, 1.0f ),
+                       Vec3f( 1.0f + 5e-6f, 1.0f, 1.0f ),
+                       Vec3f( 1.0f + 5e-5f, 1.0f, 1.0f ) };
+
+    std::vector<uint32_t> remap;
+    std::vector<Vec3f> welded;
+
+    Math::weldVertices( v, 3, remap, welded );
+
+    EXPECT_EQ( remap[0], remap[1] );
+    EXPECT_NE( remap[0], remap[2] );
+}
+
+TEST(Math,Weld_Mesh)
+{
+    // Two triangles of a quad with unshared vertices
+    std::vector<Vec3f> vertices;
+    vertices.push_back( Vec3f( 0.0f, 0.0f, 0.0f ) );
+    vertices.push_back( Vec3f( 1.0f, 0.0f, 0.0f ) );
+    vertices.push_back( Vec3f( 1.0f, 1.0f, 0.0f ) );
+    vertices.push_back( Vec3f( 0.0f, 0.0f, 0.0f ) );
+    vertices.push_back( Vec3f( 1.0f, 1.0f, 0.0f ) );
+    vertices.push_back( Vec3f( 0.0f, 1.0f, 0.0f ) );
+
+    std::vector<uint32_t> indices;
+    for ( uint32_t i = 0; i < 6; ++i )
+    {
+        indices.push_back( i );
+    }
+
+    EXPECT_EQ( 4u, Math::weldMesh( vertices, indices ) );
+    EXPECT_EQ( 4u, vertices.size() );
+
+    const uint32_t expected[] = { 0, 1, 2, 0, 2, 3 };
+    EXPECT_EQ( std::vector<uint32_t>( expected, expected + 6 ), indices );
+}
+
+TEST(Math,Weld_ParallelMatchesSerial)
+{
+    // Jittered copies of a lattice, large enough to be split between threads
+    std::srand( 1234 );
+    std::vector<Vec3f> v;
+
+    for ( int copy = 0; copy < 4; ++copy )
+    {
+        for ( int x = 0; x < 40; ++x )
+        {
+            for ( int y = 0; y < 40; ++y )
+            {
+                for ( int z = 0; z < 40; ++z )
+                {
+                    float jitter = ( std::rand() / float( RAND_MAX ) - 0.5f ) * 1e-3f;
+                    v.push_back( Vec3f( x * 0.1f + jitter, y * 0.1f, z * 0.1f - jitter ) );
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> serialRemap, parallelRemap;
+    std::vector<Vec3f> serialWelded, parallelWelded;
+
+    size_t n = Math::weldVertices( &v[0], v.size(), serialRemap, serialWelded, 2e-3f, 1 );
+    Math::weldVertices( &v[0], v.size(), parallelRemap, parallelWelded, 2e-3f, 4 );
+
+    EXPECT_EQ( 40u * 40u * 40u, n );
+    EXPECT_EQ( serialRemap, parallelRemap );
+    EXPECT_TRUE( serialWelded == parallelWelded );
+
+    for ( size_t i = 0; i < v.size(); ++i )
+    {
+        EXPECT_EQ( i % n, parallelRemap[i] );
+    }
+}
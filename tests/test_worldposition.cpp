@@ -0,0 +1,176 @@
+/**
+ * Unit tests for high precision world positions and rebasing
+ */
+#include <gtest/gtest.h>
+#include <smath/worldposition.h>
+#include <smath/matrixutils.h>
+#include <smath/cpu.h>
+#include "unittesthelpers.h"
+
+#include <cmath>
+#include <vector>
+
+using Math::WorldPosition;
+
+#ifndef MATH_TYPEDEFS
+typedef TVector3<float> Vec3f;
+typedef TVector3<double> Vec3d;
+#endif
+
+namespace
+{
+    // Somewhere in a world 1000 km across, to well below a float ulp
+    Vec3d nextPosition( unsigned int& state )
+    {
+        double c[3];
+
+        for ( int i = 0; i < 3; ++i )
+        {
+            c[i] = nextTestDouble( state ) * 5.0e5 + nextTestDouble( state ) * 1.0e-3;
+        }
+
+        return Vec3d( c[0], c[1], c[2] );
+    }
+}
+
+TEST(Math,WorldPosition_Split)
+{
+    const Vec3d position( 712345.678901234, -498765.4321, 250000.000123 );
+    const WorldPosition p( position );
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        EXPECT_EQ( static_cast<float>( position[i] ), p.high()[i] );
+        EXPECT_NEAR( position[i], p.toDouble()[i], 1e-8 );
+    }
+
+    // A camera a few meters away sees the offset to float precision, where
+    // plain float positions would be off by centimeters
+    const Vec3d offset( 1.5, 0.25, -3.125 );
+    const Vec3f relative = p.relativeTo( WorldPosition( position - offset ) );
+
+    for ( int i = 0; i < 3; ++i )
+    {
+        EXPECT_NEAR( offset[i], relative[i], 1e-6 );
+    }
+
+    EXPECT_EQ( Vec3f( 0, 0, 0 ), p.relativeTo( p ) );
+}
+
+TEST(Math,WorldPosition_Move)
+{
+    const Vec3f step( 1.0e-3f, -2.5e-4f, 3.0e-5f );
+    const Vec3d start( 1.0e6, -6.4e6, 3.0e5 );
+
+    WorldPosition p( start );
+
+    for ( int i = 0; i < 10000; ++i )
+    {
+        p += step;
+    }
+
+    // Float positions would not move at all, the steps are below half an
+    // ulp. Each step rounds at 48 bits, so the error grows slowly with the
+    // number of steps.
+    for ( int i = 0; i < 3; ++i )
+    {
+        EXPECT_EQ( static_cast<float>( start[i] ), static_cast<float>( start[i] ) + step[i] );
+        EXPECT_NEAR( start[i] + 10000.0 * step[i], p.toDouble()[i], 1e-4 );
+        EXPECT_LE( std::fabs( p.low()[i] ), 0.5 * std::fabs( p.high()[i] ) * 1.2e-7 );
+    }
+}
+
+TEST(Math,WorldPosition_Matrices)
+{
+    const WorldPosition origin( Vec3d( 1.0e6, 2.0e6, -3.0e6 ) );
+
+    const TMatrix4<float> model =
+        Math::rebase( Math::createTranslation( 1.0e6 + 0.5, 2.0e6 - 0.25, -3.0e6 + 0.125 ), origin );
+
+    EXPECT_EQ( 0.5f, model.at( 0, 3 ) );
+    EXPECT_EQ( -0.25f, model.at( 1, 3 ) );
+    EXPECT_EQ( 0.125f, model.at( 2, 3 ) );
+    EXPECT_EQ( 1.0f, model.at( 0, 0 ) );
+    EXPECT_EQ( 1.0f, model.at( 3, 3 ) );
+
+    // The eye is at the origin of camera relative space, so only the
+    // rotation of the view is left
+    const Vec3d eye( 1.0e6, 2.0e6, -3.0e6 );
+    const TMatrix4<double> view =
+        Math::createLookAt( eye, eye + Vec3d( 1.0, 0.0, 0.0 ), Vec3d( 0.0, 1.0, 0.0 ) );
+    const TMatrix4<float> relative = Math::cameraRelativeView( view );
+
+    for ( unsigned int r = 0; r < 4; ++r )
+    {
+        for ( unsigned int c = 0; c < 3; ++c )
+        {
+            EXPECT_EQ( static_cast<float>( view.at( r, c ) ), relative.at( r, c ) );
+        }
+    }
+
+    EXPECT_EQ( 0.0f, relative.at( 0, 3 ) );
+    EXPECT_EQ( 0.0f, relative.at( 1, 3 ) );
+    EXPECT_EQ( 0.0f, relative.at( 2, 3 ) );
+    EXPECT_EQ( 1.0f, relative.at( 3, 3 ) );
+}
+
+TEST(Math,WorldPosition_BatchEveryLevel)
+{
+    unsigned int state = 13;
+
+    std::vector<Vec3d> positions( LevelTestCount );
+
+    for ( size_t i = 0; i < LevelTestCount; ++i )
+    {
+        positions[i] = nextPosition( state );
+    }
+
+    const Vec3d eye = positions[7] + Vec3d( 10.0, -2.0, 0.5 );
+    const WorldPosition origin( eye );
+
+    forEachInstructionSet( [&]()
+    {
+        std::vector<Vec3f> high( LevelTestCount ), low( LevelTestCount ), out( LevelTestCount );
+
+        Math::batch::split( &positions[0], &high[0], &low[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            const WorldPosition expected( positions[i] );
+
+            for ( int c = 0; c < 3; ++c )
+            {
+                ASSERT_EQ( bitsOf( expected.high()[c] ), bitsOf( high[i][c] ) );
+                ASSERT_EQ( bitsOf( expected.low()[c] ), bitsOf( low[i][c] ) );
+            }
+        }
+
+        Math::batch::rebase( &high[0], &low[0], origin, &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            const Vec3f expected = WorldPosition( high[i], low[i] ).relativeTo( origin );
+
+            for ( int c = 0; c < 3; ++c )
+            {
+                ASSERT_EQ( bitsOf( expected[c] ), bitsOf( out[i][c] ) );
+            }
+        }
+
+        // Near the eye the result is as good as rebasing in double
+        for ( int c = 0; c < 3; ++c )
+        {
+            EXPECT_NEAR( positions[7][c] - eye[c], out[7][c], 1e-6 );
+        }
+
+        Math::batch::rebase( &positions[0], eye, &out[0], LevelTestCount );
+
+        for ( size_t i = 0; i < LevelTestCount; ++i )
+        {
+            for ( int c = 0; c < 3; ++c )
+            {
+                ASSERT_EQ( static_cast<float>( positions[i][c] - eye[c] ), out[i][c] );
+            }
+        }
+    } );
+}
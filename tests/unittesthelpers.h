@@ -2,6 +2,10 @@
 #include <smath/vector.h>
 #include <smath/matrix.h>
 #include <smath/quaternion.h>
+#include <smath/cpu.h>
+
+#include <cstring>
+#include <stdint.h>
 
 using namespace testing;
 
@@ -198,3 +202,67 @@ bool MatrixEquals( const TMatrix4<T>& a, const TMatrix4<T>& b )
             << "Actual: "   << b << std::endl;
     }
 }
+
+::testing::AssertionResult VectorNear( const TVector3<float>& expected,
+                                       const TVector3<float>& actual,
+                                       float tolerance )
+{
+    if ( lengthSquared( expected - actual ) <= tolerance * tolerance )
+    {
+        return ::testing::AssertionSuccess();
+    }
+
+    return ::testing::AssertionFailure() << expected << " != " << actual;
+}
+
+// Odd sized so every level runs both its vector loop and scalar tail
+const size_t LevelTestCount = 203;
+
+/**
+ * Returns the next value of a fixed linear congruential sequence, uniform
+ * in [-1,1) with 24 significant bits so that it converts to float exactly.
+ */
+double nextTestDouble( unsigned int& state )
+{
+    state = state * 1664525u + 1013904223u;
+    return static_cast<double>( state >> 8 ) / 16777216.0 * 2.0 - 1.0;
+}
+
+float nextTestFloat( unsigned int& state )
+{
+    return static_cast<float>( nextTestDouble( state ) );
+}
+
+/**
+ * Returns the bits of a float, to compare results exactly, including NaNs
+ * and the sign of zero.
+ */
+uint32_t bitsOf( float value )
+{
+    uint32_t bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    return bits;
+}
+
+/**
+ * Calls check() once for every instruction set level that this build and
+ * CPU can run, with that level active, then restores the default level.
+ */
+template<typename Check>
+void forEachInstructionSet( Check check )
+{
+    for ( int level = Math::ISA_SCALAR; level <= Math::ISA_AVX512; ++level )
+    {
+        Math::InstructionSet isa = static_cast<Math::InstructionSet>( level );
+
+        if ( Math::setInstructionSet( isa ) != isa )
+        {
+            continue;
+        }
+
+        SCOPED_TRACE( Math::instructionSetName( isa ) );
+        check();
+    }
+
+    Math::resetInstructionSet();
+}
@@ -0,0 +1,317 @@
+#!/usr/bin/env python3
+#
+# Copyright 2010-2014 Scott MacDonald
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Performance regression gate for smath_bench.
+
+Runs the benchmark suite pinned to a single core with several repetitions,
+and compares the per-repetition times of every benchmark against a baseline
+recorded earlier on the same machine. A benchmark regresses when its median time
+is more than --threshold slower than the baseline *and* a one-sided
+Mann-Whitney U test says the slowdown is significant at --alpha. Requiring both
+keeps noisy benchmarks from failing the gate on a single slow repetition, and
+keeps statistically real but negligible changes from failing it either.
+
+Typical use:
+
+    # Record a baseline (Release build, quiet machine)
+    tools/bench_gate.py --bench build/smath_bench \\
+        --baseline benchmarks/baselines/linux-x86_64-gnu.json --update
+
+    # Compare against it, exits with status 1 on regressions
+    tools/bench_gate.py --bench build/smath_bench \\
+        --baseline benchmarks/baselines/linux-x86_64-gnu.json
+
+Baselines are checked in per platform, see benchmarks/baselines/README.md.
+With --skip-missing, a platform without one exits with status 77, which
+CTest reports as skipped. Benchmarks that the baseline does not cover fail
+the gate rather than passing unmeasured; record the baseline again after
+adding benchmarks. Only the Python standard library is required.
+"""
+
+import argparse
+import json
+import math
+import os
+import platform
+import shutil
+import subprocess
+import sys
+import tempfile
+
+# Benchmarks measured by default: one cache resident and one larger size of
+# every throughput benchmark, plus the fixed size benchmarks
+DEFAULT_FILTER = r"/(4096|65536)$|Random_Construct"
+
+# Exit status that CTest treats as a skipped test (SKIP_RETURN_CODE)
+EXIT_SKIPPED = 77
+
+TIME_UNITS_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def run_benchmarks(bench, bench_filter, repetitions, core, min_time):
+    """Runs smath_bench and returns its parsed JSON output."""
+    fd, out_path = tempfile.mkstemp(suffix=".json")
+    os.close(fd)
+
+    cmd = [bench,
+           "--benchmark_filter=" + bench_filter,
+           "--benchmark_repetitions=%d" % repetitions,
+           "--benchmark_enable_random_interleaving=true",
+           "--benchmark_out=" + out_path,
+           "--benchmark_out_format=json"]
+
+    if min_time:
+        cmd.append("--benchmark_min_time=%g" % min_time)
+
+    if core is not None:
+        if shutil.which("taskset"):
+            cmd = ["taskset", "-c", str(core)] + cmd
+        else:
+            print("warning: taskset not found, benchmarks will not be pinned",
+                  file=sys.stderr)
+
+    try:
+        if subprocess.call(cmd, stdout=subprocess.DEVNULL) != 0:
+            raise RuntimeError("%s failed" % bench)
+
+        with open(out_path) as f:
+            return json.load(f)
+    finally:
+        os.remove(out_path)
+
+
+def collect_samples(results):
+    """Groups the per-repetition results of a Google Benchmark JSON report
+    by benchmark name. Returns {name: {"time_ns": [...], "items_per_second":
+    [...]}}."""
+    samples = {}
+
+    for b in results.get("benchmarks", []):
+        # Skip the mean/median/stddev aggregates, only raw repetitions are
+        # useful for the significance test
+        if b.get("run_type", "iteration") != "iteration" or "error_occurred" in b:
+            continue
+
+        name = b.get("run_name", b["name"])
+        scale = TIME_UNITS_TO_NS[b.get("time_unit", "ns")]
+        entry = samples.setdefault(name, {"time_ns": [], "items_per_second": []})
+
+        entry["time_ns"].append(b["real_time"] * scale)
+
+        if "items_per_second" in b:
+            entry["items_per_second"].append(b["items_per_second"])
+
+    return samples
+
+
+def median(values):
+    s = sorted(values)
+    n = len(s)
+    return s[n // 2] if n % 2 else 0.5 * (s[n // 2 - 1] + s[n // 2])
+
+
+def mann_whitney_greater(current, baseline):
+    """One-sided Mann-Whitney U test of the hypothesis that `current` tends
+    to be larger than `baseline`. Returns the p-value, using the normal
+    approximation with tie and continuity corrections."""
+    n1, n2 = len(current), len(baseline)
+
+    if n1 == 0 or n2 == 0:
+        return 1.0
+
+    # Rank the pooled samples, averaging the ranks of ties
+    pooled = sorted([(v, 0) for v in current] + [(v, 1) for v in baseline])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+
+        rank = 0.5 * (i + j) + 1.0
+        for k in range(i, j + 1):
+            ranks[k] = rank
+
+        t = j - i + 1
+        tie_term += t * t * t - t
+        i = j + 1
+
+    r1 = sum(r for r, (_, group) in zip(ranks, pooled) if group == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2.0
+
+    n = n1 + n2
+    mean = n1 * n2 / 2.0
+    var = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+
+    if var <= 0.0:
+        return 1.0
+
+    z = (u1 - mean - 0.5) / math.sqrt(var)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def load_baseline(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+def write_baseline(path, results, samples):
+    context = results.get("context", {})
+    baseline = {
+        "format": 1,
+        "context": {
+            "host_name": context.get("host_name"),
+            "num_cpus": context.get("num_cpus"),
+            "mhz_per_cpu": context.get("mhz_per_cpu"),
+            "library_build_type": context.get("library_build_type"),
+            "machine": platform.machine(),
+            "system": platform.system(),
+        },
+        "benchmarks": samples,
+    }
+
+    directory = os.path.dirname(path)
+    if directory and not os.path.isdir(directory):
+        os.makedirs(directory)
+
+    with open(path, "w") as f:
+        json.dump(baseline, f, indent=1, sort_keys=True)
+        f.write("\n")
+
+
+def compare(samples, baseline, threshold, alpha):
+    """Prints a comparison table and returns the names of the regressed
+    benchmarks and of the benchmarks missing from the baseline."""
+    regressions = []
+    unmeasured = []
+    base = baseline["benchmarks"]
+
+    print("%-48s %12s %12s %8s %10s %8s  %s" %
+          ("benchmark", "base ns", "now ns", "change", "items/s", "p", "status"))
+
+    for name in sorted(samples):
+        if name not in base:
+            print("%-48s %12s %12.1f %8s %10s %8s  NOT IN BASELINE" %
+                  (name, "-", median(samples[name]["time_ns"]), "", "", ""))
+            unmeasured.append(name)
+            continue
+
+        now = samples[name]["time_ns"]
+        then = base[name]["time_ns"]
+        change = median(now) / median(then) - 1.0
+        p = mann_whitney_greater(now, then)
+
+        if change > threshold and p < alpha:
+            status = "REGRESSION"
+            regressions.append(name)
+        elif change < -threshold and mann_whitney_greater(then, now) < alpha:
+            status = "faster"
+        else:
+            status = "ok"
+
+        # Throughput change, for the benchmarks that report items processed
+        items_now = samples[name].get("items_per_second")
+        items_then = base[name].get("items_per_second")
+
+        if items_now and items_then:
+            items = "%+9.1f%%" % (100.0 * (median(items_now) / median(items_then) - 1.0))
+        else:
+            items = "-"
+
+        print("%-48s %12.1f %12.1f %+7.1f%% %10s %8.4f  %s" %
+              (name, median(then), median(now), 100.0 * change, items, p, status))
+
+    for name in sorted(set(base) - set(samples)):
+        print("%-48s %12.1f %12s %8s %10s %8s  missing" %
+              (name, median(base[name]["time_ns"]), "-", "", "", ""))
+
+    return regressions, unmeasured
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare smath_bench results against a stored baseline.")
+    parser.add_argument("--bench", required=True,
+                        help="path to the smath_bench executable")
+    parser.add_argument("--baseline", required=True,
+                        help="baseline JSON file to compare against or update")
+    parser.add_argument("--update", action="store_true",
+                        help="record a new baseline instead of comparing")
+    parser.add_argument("--filter", default=DEFAULT_FILTER,
+                        help="benchmark filter regex (default: %(default)s)")
+    parser.add_argument("--repetitions", type=int, default=10,
+                        help="repetitions of every benchmark (default: 10)")
+    parser.add_argument("--core", type=int, default=0,
+                        help="CPU core to pin to, -1 to disable (default: 0)")
+    parser.add_argument("--min-time", type=float, default=0.05,
+                        help="minimum seconds per repetition (default: 0.05)")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="slowdown that counts as a regression (default: 0.05)")
+    parser.add_argument("--alpha", type=float, default=0.01,
+                        help="significance level (default: 0.01)")
+    parser.add_argument("--skip-missing", action="store_true",
+                        help="exit with status 77 (skipped) if there is no baseline")
+    args = parser.parse_args()
+
+    if not args.update and not os.path.exists(args.baseline):
+        print("baseline %s does not exist" % args.baseline, file=sys.stderr)
+        return EXIT_SKIPPED if args.skip_missing else 2
+
+    if args.repetitions < 5:
+        print("warning: fewer than 5 repetitions cannot show significance",
+              file=sys.stderr)
+
+    core = None if args.core < 0 else args.core
+    try:
+        results = run_benchmarks(args.bench, args.filter, args.repetitions,
+                                 core, args.min_time)
+    except (OSError, RuntimeError, ValueError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 2
+
+    samples = collect_samples(results)
+
+    if args.update:
+        write_baseline(args.baseline, results, samples)
+        print("wrote %d benchmarks to %s" % (len(samples), args.baseline))
+        return 0
+
+    regressions, unmeasured = compare(samples, load_baseline(args.baseline),
+                                      args.threshold, args.alpha)
+
+    if regressions:
+        print("\n%d benchmark(s) regressed by more than %.0f%%:" %
+              (len(regressions), 100.0 * args.threshold))
+        for name in regressions:
+            print("  " + name)
+
+    if unmeasured:
+        print("\n%d benchmark(s) are not in the baseline, record it again "
+              "with --update:" % len(unmeasured))
+        for name in unmeasured:
+            print("  " + name)
+
+    if regressions or unmeasured:
+        return 1
+
+    print("\nno regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())